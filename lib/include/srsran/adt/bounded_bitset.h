@@ -218,14 +218,16 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    get_bitrange_(startpos, endpos);
+    for (size_t i = startpos / bits_per_word; i <= (endpos - 1) / bits_per_word; ++i) {
+      word_t mask = range_word_mask_(i, startpos, endpos);
+      if (value) {
+        buffer[i] |= mask;
+      } else {
+        buffer[i] &= ~mask;
       }
     }
     return *this;
@@ -273,9 +275,12 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    get_bitrange_(start, stop);
+    for (size_t i = start / bits_per_word; i <= (stop - 1) / bits_per_word; ++i) {
+      if ((buffer[i] & range_word_mask_(i, start, stop)) != static_cast<word_t>(0)) {
         return true;
       }
     }
@@ -288,13 +293,22 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += popcount_(buffer[i]);
+    }
+    return result;
+  }
+
+  /// Counts the bits set within the range [startpos, endpos), e.g. the PRBs of an RBG.
+  size_t count(size_t startpos, size_t endpos) const
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    get_bitrange_(startpos, endpos);
+    size_t result = 0;
+    for (size_t i = startpos / bits_per_word; i <= (endpos - 1) / bits_per_word; ++i) {
+      result += popcount_(buffer[i] & range_word_mask_(i, startpos, endpos));
     }
     return result;
   }
@@ -457,6 +471,43 @@ private:
 
   static word_t maskbit(size_t pos) noexcept { return (static_cast<word_t>(1)) << (pos % bits_per_word); }
 
+  /// Converts a range of positions [startpos, endpos) into the range of bit indexes that it occupies in the buffer
+  void get_bitrange_(size_t& startpos, size_t& endpos) const noexcept
+  {
+    if (reversed) {
+      size_t startbit = size() - endpos;
+      endpos          = size() - startpos;
+      startpos        = startbit;
+    }
+  }
+
+  /// Mask of the bits of the buffer word i that fall within the range of bit indexes [startbit, endbit)
+  static word_t range_word_mask_(size_t i, size_t startbit, size_t endbit) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (i == startbit / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(startbit % bits_per_word);
+    }
+    if (i == (endbit - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((endbit - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
+  static size_t popcount_(word_t w) noexcept
+  {
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
+    int c = 0;
+    for (; w > 0; c++) {
+      w &= w - 1;
+    }
+    return c;
+#endif
+  }
+
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
 
   int find_last_(size_t startpos, size_t endpos, bool value) const noexcept
@@ -26,6 +26,8 @@
 #include "expected.h"
 #include "srsran/support/srsran_assert.h"
 #include <array>
+#include <limits>
+#include <vector>
 
 namespace srsran {
 
@@ -331,6 +333,99 @@ private:
   K next_id = 0;
 };
 
+/**
+ * Operates like a static_circular_map, but keeps the inserted objects out of line. Only the index of each object is
+ * stored in the circular map, so that its footprint doesn't depend on the object size. The object storage grows with
+ * the number of objects held at the same time, and is reused once they are erased
+ * @tparam K type of ID/key
+ * @tparam T object being inserted. Erased objects are reset to T{}, to release the resources they hold
+ * @tparam N size of the circular map
+ */
+template <typename K, typename T, size_t N>
+class pooled_circular_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+  using index_t               = uint16_t;
+  static const index_t no_obj = std::numeric_limits<index_t>::max();
+  static_assert(N < no_obj, "Map size too big for the object indices");
+
+public:
+  pooled_circular_map() { std::fill(slots.begin(), slots.end(), no_obj); }
+
+  bool contains(K id) const
+  {
+    index_t obj_idx = slots[id % N];
+    return obj_idx != no_obj and objs[obj_idx].first == id;
+  }
+
+  bool insert(K id, T&& obj)
+  {
+    index_t& obj_idx = slots[id % N];
+    if (obj_idx != no_obj) {
+      return false;
+    }
+    if (free_objs.empty()) {
+      obj_idx = objs.size();
+      objs.emplace_back(id, std::move(obj));
+    } else {
+      obj_idx = free_objs.back();
+      free_objs.pop_back();
+      objs[obj_idx].first  = id;
+      objs[obj_idx].second = std::move(obj);
+    }
+    count++;
+    return true;
+  }
+
+  bool erase(K id)
+  {
+    if (not contains(id)) {
+      return false;
+    }
+    index_t& obj_idx     = slots[id % N];
+    objs[obj_idx].second = T{};
+    free_objs.push_back(obj_idx);
+    obj_idx = no_obj;
+    --count;
+    return true;
+  }
+
+  void clear()
+  {
+    std::fill(slots.begin(), slots.end(), no_obj);
+    objs.clear();
+    free_objs.clear();
+    count = 0;
+  }
+
+  T& operator[](K id)
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[slots[id % N]].second;
+  }
+  const T& operator[](K id) const
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[slots[id % N]].second;
+  }
+
+  size_t size() const { return count; }
+  bool   empty() const { return count == 0; }
+  bool   full() const { return count == N; }
+  size_t capacity() const { return N; }
+
+private:
+  std::array<index_t, N>        slots;
+  std::vector<std::pair<K, T> > objs;
+  std::vector<index_t>          free_objs;
+  size_t                        count = 0;
+};
+
+// std::fill takes no_obj by reference, so it needs a definition
+template <typename K, typename T, size_t N>
+const typename pooled_circular_map<K, T, N>::index_t pooled_circular_map<K, T, N>::no_obj;
+
 } // namespace srsran
 
 #endif // SRSRAN_ID_MAP_H
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Hash map for integer keys, with the objects stored in a single array with open addressing and linear probing.
+ * A lookup is one hash and, with the load factor kept below 1/2, about one or two contiguous slot
+ * reads, instead of the bucket and node indirections of std::unordered_map.
+ * Keys can be sparse and have their entropy in any bits (e.g. IPv4 addresses in network byte order).
+ * Note: Insertions that grow the map and erasures move the other objects, invalidating pointers to them.
+ * @tparam K integer key type
+ * @tparam T object stored in the map. Must be default constructible and movable
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value, "Map key must be an integer");
+
+  // The presence flag shares the cache line of the key, so that a lookup touches a single slot
+  struct slot_t {
+    K    key     = 0;
+    bool present = false;
+    T    obj;
+  };
+
+public:
+  using key_type    = K;
+  using mapped_type = T;
+
+  /// Allocates the slots for nof_reserved objects without growing
+  explicit flat_hash_map(size_t nof_reserved = 8) { rehash(2 * nof_reserved); }
+
+  size_t size() const { return nof_objs; }
+  bool   empty() const { return nof_objs == 0; }
+  size_t capacity() const { return slots.size(); }
+
+  bool contains(K key) const { return find(key) != nullptr; }
+
+  /// Returns the object of the given key, or nullptr if the key is not present
+  T* find(K key)
+  {
+    for (size_t idx = slot_of(key); slots[idx].present; idx = (idx + 1) & mask) {
+      if (slots[idx].key == key) {
+        return &slots[idx].obj;
+      }
+    }
+    return nullptr;
+  }
+  const T* find(K key) const { return const_cast<flat_hash_map<K, T>*>(this)->find(key); }
+
+  /// Inserts the key with the given object. Returns false, and leaves the map unchanged, if the key is already present
+  bool insert(K key, T obj)
+  {
+    if (contains(key)) {
+      return false;
+    }
+    emplace_new(key) = std::move(obj);
+    return true;
+  }
+
+  /// Returns the object of the given key, default constructing it first if the key is not present
+  T& operator[](K key)
+  {
+    T* obj = find(key);
+    return obj != nullptr ? *obj : emplace_new(key);
+  }
+
+  bool erase(K key)
+  {
+    size_t idx = slot_of(key);
+    for (; slots[idx].present; idx = (idx + 1) & mask) {
+      if (slots[idx].key == key) {
+        break;
+      }
+    }
+    if (not slots[idx].present) {
+      return false;
+    }
+    // Shift back the objects of the probe sequence that follows, so that no tombstones are needed
+    for (size_t next = (idx + 1) & mask; slots[next].present; next = (next + 1) & mask) {
+      // The object can fill the hole, unless its home slot is cyclically in ]idx, next]
+      size_t home     = slot_of(slots[next].key);
+      bool   can_move = next > idx ? (home <= idx or home > next) : (home <= idx and home > next);
+      if (can_move) {
+        slots[idx] = std::move(slots[next]);
+        idx        = next;
+      }
+    }
+    slots[idx].obj     = T{};
+    slots[idx].present = false;
+    nof_objs--;
+    return true;
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i].present) {
+        slots[i].obj     = T{};
+        slots[i].present = false;
+      }
+    }
+    nof_objs = 0;
+  }
+
+  /// Calls f(key, obj) for all the objects of the map, in no particular order
+  template <typename F>
+  void for_each(F&& f)
+  {
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i].present) {
+        f(slots[i].key, slots[i].obj);
+      }
+    }
+  }
+
+private:
+  size_t slot_of(K key) const
+  {
+    // Finalizer of MurmurHash3, so that keys that only differ in a few bits are spread over the whole table
+    uint64_t h = static_cast<uint64_t>(key);
+    h ^= h >> 33U;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33U;
+    return static_cast<size_t>(h >> hash_shift);
+  }
+
+  T& emplace_new(K key)
+  {
+    if (2 * (nof_objs + 1) > slots.size()) {
+      rehash(2 * slots.size());
+    }
+    size_t idx = slot_of(key);
+    while (slots[idx].present) {
+      idx = (idx + 1) & mask;
+    }
+    slots[idx].key     = key;
+    slots[idx].present = true;
+    nof_objs++;
+    return slots[idx].obj;
+  }
+
+  void rehash(size_t min_capacity)
+  {
+    size_t   new_capacity = 8;
+    uint32_t log2_cap     = 3;
+    while (new_capacity < min_capacity) {
+      new_capacity *= 2;
+      log2_cap++;
+    }
+    std::vector<slot_t> old_slots(new_capacity);
+    old_slots.swap(slots);
+    mask       = new_capacity - 1;
+    hash_shift = 64 - log2_cap;
+    nof_objs   = 0;
+    for (size_t i = 0; i < old_slots.size(); ++i) {
+      if (old_slots[i].present) {
+        emplace_new(old_slots[i].key) = std::move(old_slots[i].obj);
+      }
+    }
+  }
+
+  std::vector<slot_t> slots;
+  size_t              nof_objs   = 0;
+  size_t              mask       = 0;
+  uint32_t            hash_shift = 64;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
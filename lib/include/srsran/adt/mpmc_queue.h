@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPMC_QUEUE_H
+#define SRSRAN_MPMC_QUEUE_H
+
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Bounded queue that supports multiple concurrent producers and consumers without locks, based on D. Vyukov's
+ * bounded MPMC queue. Features:
+ * - no allocations after construction. Each slot holds a sequence number that tells producers and consumers whether
+ *   the slot is free or holds an element for their turn
+ * - try_push/try_pop never block. They fail when the queue is full/empty
+ * - elements pushed by the same thread are popped in the same order
+ * @tparam T stored type. It must be default constructible and move assignable
+ */
+template <typename T>
+class mpmc_bounded_queue
+{
+public:
+  /// Creates a queue with capacity rounded up to the next power of two
+  explicit mpmc_bounded_queue(size_t capacity_) : cap(next_pow2(capacity_)), buffer(new cell_t[cap])
+  {
+    srsran_assert(capacity_ > 0, "Invalid queue capacity");
+    for (size_t i = 0; i < cap; ++i) {
+      buffer[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  mpmc_bounded_queue(const mpmc_bounded_queue&) = delete;
+  mpmc_bounded_queue& operator=(const mpmc_bounded_queue&) = delete;
+
+  bool try_push(const T& t)
+  {
+    T copy(t);
+    return try_push(std::move(copy));
+  }
+
+  bool try_push(T&& t)
+  {
+    cell_t* cell;
+    size_t  pos = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell          = &buffer[pos & (cap - 1)];
+      size_t    seq = cell->seq.load(std::memory_order_acquire);
+      ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)pos;
+      if (dif == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // full
+        return false;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(t);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& t)
+  {
+    cell_t* cell;
+    size_t  pos = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell          = &buffer[pos & (cap - 1)];
+      size_t    seq = cell->seq.load(std::memory_order_acquire);
+      ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // empty
+        return false;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    t = std::move(cell->data);
+    cell->seq.store(pos + cap, std::memory_order_release);
+    return true;
+  }
+
+  /// Number of stored elements. Only a snapshot if other threads are pushing or popping
+  size_t size() const
+  {
+    size_t tail = dequeue_pos.load(std::memory_order_relaxed);
+    size_t head = enqueue_pos.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+  bool   empty() const { return size() == 0; }
+  size_t capacity() const { return cap; }
+
+private:
+  static size_t next_pow2(size_t n)
+  {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1U;
+    }
+    return p;
+  }
+
+  struct cell_t {
+    std::atomic<size_t> seq;
+    T                   data;
+  };
+
+  // Producer and consumer indexes are padded to separate cache lines to avoid false sharing. Padding is used instead
+  // of alignas, as C++14 operator new does not honour extended alignments
+  static const size_t cache_line_size = 64;
+
+  const size_t              cap;
+  std::unique_ptr<cell_t[]> buffer;
+  char                      pad0[cache_line_size];
+  std::atomic<size_t>       enqueue_pos{0};
+  char                      pad1[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t>       dequeue_pos{0};
+  char                      pad2[cache_line_size - sizeof(std::atomic<size_t>)];
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPMC_QUEUE_H
@@ -24,6 +24,9 @@
 
 #include "memblock_cache.h"
 #include "srsran/adt/circular_buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <thread>
 
 namespace srsran {
@@ -73,6 +76,18 @@ class concurrent_fixed_memory_pool
 public:
   const static size_t BLOCK_SIZE = ObjSize;
 
+  /// Block usage of the pool.
+  struct occupancy_t {
+    size_t nof_blocks;
+    size_t nof_used_blocks;
+    /// Maximum number of blocks in use at the same time since the previous read. The usage is only sampled when a
+    /// thread cache exchanges blocks with the central cache, when the pool runs out and on each read, so peaks
+    /// shorter than a batch of blocks per thread may be missed.
+    size_t max_used_blocks;
+    /// Number of allocations that found the pool empty since the previous read.
+    size_t nof_failures;
+  };
+
   concurrent_fixed_memory_pool(const concurrent_fixed_memory_pool&) = delete;
   concurrent_fixed_memory_pool(concurrent_fixed_memory_pool&&)      = delete;
   concurrent_fixed_memory_pool& operator=(const concurrent_fixed_memory_pool&) = delete;
@@ -103,17 +118,21 @@ public:
       std::array<void*, batch_steal_size> popped_blocks;
       size_t                              n = central_mem_cache.try_pop(popped_blocks);
       for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
+        new (popped_blocks[i]) obj_storage_t;
         worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
       }
       node = worker_ctxt->cache.try_pop();
+      update_max_used_blocks();
     }
 
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     if (node == nullptr) {
+      nof_failures.fetch_add(1, std::memory_order_relaxed);
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
       print_error("Error allocating buffer in pool of ObjSize=%zd", ObjSize);
-    }
 #endif
+      return nullptr;
+    }
+    worker_ctxt->count_allocation();
     return node;
   }
 
@@ -137,8 +156,22 @@ public:
 
     if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
+      update_max_used_blocks();
       central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
     }
+    worker_ctxt->count_deallocation();
+  }
+
+  /// Reads the block usage of the pool, and restarts the peak usage and failure counts.
+  occupancy_t read_occupancy()
+  {
+    occupancy_t ret;
+    ret.nof_blocks      = size();
+    ret.nof_used_blocks = get_nof_used_blocks();
+    ret.max_used_blocks = std::max(max_used_blocks.exchange(ret.nof_used_blocks, std::memory_order_relaxed),
+                                   ret.nof_used_blocks);
+    ret.nof_failures    = nof_failures.exchange(0, std::memory_order_relaxed);
+    return ret;
   }
 
   void enable_logger(bool enabled)
@@ -166,15 +199,37 @@ public:
   }
 
 private:
+  /// Per thread block cache and usage counters. The counters are only written by the owning thread, so that the
+  /// allocation path does not contend on shared atomics. The pool adds them up when its occupancy is read.
   struct worker_ctxt {
-    std::thread::id    id;
-    free_memblock_list cache;
+    std::thread::id       id;
+    free_memblock_list    cache;
+    std::atomic<uint64_t> nof_allocs{0};
+    std::atomic<uint64_t> nof_deallocs{0};
 
-    worker_ctxt() : id(std::this_thread::get_id()) {}
+    worker_ctxt() : id(std::this_thread::get_id())
+    {
+      pool_type*                  pool = pool_type::get_instance();
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->workers.push_back(this);
+    }
     ~worker_ctxt()
     {
-      concurrent_free_memblock_list& central_cache = pool_type::get_instance()->central_mem_cache;
-      central_cache.steal_blocks(cache, cache.size());
+      pool_type* pool = pool_type::get_instance();
+      pool->central_mem_cache.steal_blocks(cache, cache.size());
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->retired_allocs += nof_allocs.load(std::memory_order_relaxed);
+      pool->retired_deallocs += nof_deallocs.load(std::memory_order_relaxed);
+      pool->workers.erase(std::find(pool->workers.begin(), pool->workers.end(), this));
+    }
+
+    void count_allocation()
+    {
+      nof_allocs.store(nof_allocs.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    void count_deallocation()
+    {
+      nof_deallocs.store(nof_deallocs.load(std::memory_order_relaxed) + 1, std::memory_order_release);
     }
   };
 
@@ -184,6 +239,32 @@ private:
     return &worker_cache;
   }
 
+  /// Adds up the usage counters of all threads. The deallocations are read first, so that a block freed by another
+  /// thread than the one that allocated it is never counted as freed and not allocated.
+  size_t get_nof_used_blocks()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t                    deallocs = retired_deallocs;
+    for (const worker_ctxt* w : workers) {
+      deallocs += w->nof_deallocs.load(std::memory_order_acquire);
+    }
+    uint64_t allocs = retired_allocs;
+    for (const worker_ctxt* w : workers) {
+      allocs += w->nof_allocs.load(std::memory_order_acquire);
+    }
+    return allocs > deallocs ? allocs - deallocs : 0;
+  }
+
+  /// Samples the block usage into the peak usage. Only called on the paths that already access the central cache.
+  void update_max_used_blocks()
+  {
+    size_t nof_used = get_nof_used_blocks();
+    size_t max_used = max_used_blocks.load(std::memory_order_relaxed);
+    while (nof_used > max_used and
+           not max_used_blocks.compare_exchange_weak(max_used, nof_used, std::memory_order_relaxed)) {
+    }
+  }
+
   /// Formats and prints the input string and arguments into the configured output stream.
   template <typename... Args>
   void print_error(const char* str, Args&&... args)
@@ -197,10 +278,16 @@ private:
 
   size_t                local_growth_thres = 0;
   srslog::basic_logger* logger             = nullptr;
+  std::atomic<size_t>   max_used_blocks{0};
+  std::atomic<size_t>   nof_failures{0};
 
   concurrent_free_memblock_list                central_mem_cache;
   std::mutex                                   mutex;
   std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
+  /// Thread caches alive and usage counts of the threads that exited, protected by the mutex.
+  std::vector<worker_ctxt*> workers;
+  uint64_t                  retired_allocs   = 0;
+  uint64_t                  retired_deallocs = 0;
 };
 
 } // namespace srsran
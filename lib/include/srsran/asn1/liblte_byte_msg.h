@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LIBLTE_BYTE_MSG_H
+#define SRSRAN_LIBLTE_BYTE_MSG_H
+
+#include "srsran/asn1/liblte_common.h"
+#include "srsran/common/byte_buffer.h"
+#include "srsran/support/srsran_assert.h"
+#include <string.h>
+
+namespace srsran {
+
+/******************************************************************************
+ * liblte byte messages of byte buffers
+ *
+ * The liblte NAS functions pack and unpack messages in a LIBLTE_BYTE_MSG_STRUCT,
+ * which holds the largest NAS message. Byte buffers of the smaller size classes
+ * do not, so the messages are copied between the two at the call boundary.
+ * Only the message content is copied, which is a few tens of bytes for most
+ * NAS messages.
+ *****************************************************************************/
+
+/// Copy of the content of a byte buffer, for the liblte unpack and parse functions
+class liblte_rx_byte_msg
+{
+public:
+  explicit liblte_rx_byte_msg(const byte_buffer_t& buf)
+  {
+    srsran_always_assert(buf.N_bytes <= sizeof(msg.msg),
+                         "Unpacking a NAS message of %d bytes, larger than the %zd bytes of a liblte message",
+                         buf.N_bytes,
+                         sizeof(msg.msg));
+    msg.N_bytes = buf.N_bytes;
+    memcpy(msg.msg, buf.msg, buf.N_bytes);
+  }
+  liblte_rx_byte_msg(const liblte_rx_byte_msg&) = delete;
+  liblte_rx_byte_msg& operator=(const liblte_rx_byte_msg&) = delete;
+
+  LIBLTE_BYTE_MSG_STRUCT* get() { return &msg; }
+
+private:
+  LIBLTE_BYTE_MSG_STRUCT msg;
+};
+
+/// liblte byte message for the pack functions. It is copied to the byte buffer when it goes out of scope, e.g. at the
+/// end of the pack call. The message must fit in the size class of the byte buffer.
+class liblte_tx_byte_msg
+{
+public:
+  explicit liblte_tx_byte_msg(byte_buffer_t* buf_) : buf(buf_) { msg.N_bytes = 0; }
+  liblte_tx_byte_msg(const liblte_tx_byte_msg&) = delete;
+  liblte_tx_byte_msg& operator=(const liblte_tx_byte_msg&) = delete;
+  ~liblte_tx_byte_msg()
+  {
+    srsran_always_assert(msg.N_bytes <= buf->buffer_size - buf->get_headroom(),
+                         "Packed a NAS message of %d bytes into a byte buffer of %d bytes",
+                         msg.N_bytes,
+                         buf->buffer_size);
+    buf->N_bytes = msg.N_bytes;
+    memcpy(buf->msg, msg.msg, msg.N_bytes);
+  }
+
+  LIBLTE_BYTE_MSG_STRUCT* get() { return &msg; }
+
+private:
+  byte_buffer_t*         buf;
+  LIBLTE_BYTE_MSG_STRUCT msg;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LIBLTE_BYTE_MSG_H
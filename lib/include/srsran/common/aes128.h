@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_AES128_H
+#define SRSRAN_AES128_H
+
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+
+namespace srsran {
+
+/**
+ * 128-EEA2 (AES-CTR) and 128-EIA2 (AES-CMAC) with a key that is expanded once, when set, rather than for every PDU.
+ * The AES implementation is selected at runtime: VAES or AES-NI when the CPU supports them, and mbedtls otherwise.
+ * Batches of PDUs are processed together, so that the AES rounds of several blocks are in flight at the same time
+ * even when the PDUs are short.
+ * Once the key is set, the engine is only read, and can be used by several threads at the same time.
+ */
+class aes128_engine
+{
+public:
+  enum class impl_t { generic, aesni, vaes };
+
+  /// Implementations are ordered by speed. The engine uses impl_, or the best implementation supported by the CPU if
+  /// impl_ is not supported.
+  explicit aes128_engine(impl_t impl_ = impl_t::vaes);
+  aes128_engine(const aes128_engine&) = delete;
+  aes128_engine& operator=(const aes128_engine&) = delete;
+
+  /// Expands the 16-byte key and derives the CMAC subkeys.
+  void set_key(const uint8_t* key);
+
+  /// Ciphers (or deciphers) msg_len bytes of msg into out, which may point to msg.
+  void
+  eea2(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out) const;
+  /// Computes the 4-byte MAC of msg_len bytes of msg.
+  void
+  eia2(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac) const;
+
+  void eea2_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+  void eia2_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+
+  impl_t             get_impl() const { return impl; }
+  static const char* get_impl_name(impl_t impl);
+  /// Best implementation supported by the CPU.
+  static impl_t get_hw_impl();
+
+private:
+  void encrypt_block(const uint8_t* in, uint8_t* out) const;
+
+  impl_t impl;
+  // Round keys of the AES-NI/VAES implementations
+  alignas(16) uint8_t round_keys[11 * 16] = {};
+  // Key schedule of the mbedtls implementation
+  aes_context sw_ctx = {};
+  // CMAC subkeys
+  alignas(16) uint8_t k1[16] = {};
+  alignas(16) uint8_t k2[16] = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_AES128_H
@@ -166,23 +166,96 @@ private:
   uint32_t               capacity;
 };
 
-/// Type of global byte buffer pool
-using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t)>;
+/// Bytes before each byte buffer in the pool blocks, which record the size class of the buffer
+const size_t byte_buffer_block_prefix_size = detail::max_alignment;
 
-/// Function used to generate unique byte buffers
-inline unique_byte_buffer_t make_byte_buffer() noexcept
+/// Size of the pool blocks of the byte buffers with the given buffer size. A block holds the prefix, the byte buffer
+/// and its payload.
+constexpr size_t byte_buffer_block_size(size_t buffer_size)
 {
-  return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t());
+  return byte_buffer_block_prefix_size + sizeof(byte_buffer_t) + buffer_size;
 }
 
+#ifndef SRSRAN_BYTE_BUFFER_CLASS_POOL_SIZE
+#define SRSRAN_BYTE_BUFFER_CLASS_POOL_SIZE 4096
+#endif
+
+/// Number of byte buffers preallocated for each of the small and medium size classes, set with the
+/// BYTE_BUFFER_CLASS_POOL_SIZE CMake option. With 0, all the byte buffers are of the large size class.
+const size_t byte_buffer_class_pool_size = SRSRAN_BYTE_BUFFER_CLASS_POOL_SIZE;
+
+/// Type of global byte buffer pool, which holds the byte buffers of the large size class
+using byte_buffer_pool = concurrent_fixed_memory_pool<byte_buffer_block_size(SRSRAN_MAX_BUFFER_SIZE_BYTES)>;
+/// Types of the global pools of the small and medium byte buffers
+using small_byte_buffer_pool  = concurrent_fixed_memory_pool<byte_buffer_block_size(byte_buffer_t::small_buffer_size)>;
+using medium_byte_buffer_pool = concurrent_fixed_memory_pool<byte_buffer_block_size(byte_buffer_t::medium_buffer_size)>;
+
+/// Occupancy of the pool of a byte buffer size class.
+struct byte_buffer_pool_metrics_t {
+  /// Size of the buffers, header room included.
+  uint32_t buffer_size;
+  /// Number of buffers allocated by the pool.
+  uint32_t nof_buffers;
+  /// Number of buffers currently in use.
+  uint32_t nof_used_buffers;
+  /// Maximum number of buffers in use at the same time since the previous read.
+  uint32_t max_used_buffers;
+  /// Number of allocations that found the pool empty since the previous read.
+  uint32_t nof_failures;
+};
+
+/// Occupancy of the global byte buffer pools.
+struct byte_buffer_pools_metrics_t {
+  byte_buffer_pool_metrics_t small;
+  byte_buffer_pool_metrics_t medium;
+  byte_buffer_pool_metrics_t large;
+};
+
+void get_byte_buffer_pools_metrics(byte_buffer_pools_metrics_t& metrics);
+
+/// Function used to generate unique byte buffers, of the large size class
+unique_byte_buffer_t make_byte_buffer() noexcept;
+
+/// Generates a byte buffer of the smallest size class with, at least, the given tailroom. Falls back to the larger
+/// size classes when the pool of the class is empty.
+unique_byte_buffer_t make_byte_buffer_with_tailroom(uint32_t tailroom) noexcept;
+
+/// Tailroom kept in the receive byte buffers of the medium size class, for the trailers added to the packet down the
+/// stack
+const uint32_t rx_byte_buffer_spare_tailroom = 64;
+
+/// Size of the overflow area that receives the bytes of a packet beyond get_rx_byte_buffer_capacity()
+const uint32_t rx_byte_buffer_overflow_size =
+    SRSRAN_MAX_BUFFER_SIZE_BYTES - byte_buffer_t::medium_buffer_size + rx_byte_buffer_spare_tailroom;
+
+/// Generates a byte buffer to receive a packet of unknown size, e.g. from a socket or the TUN interface, of the medium
+/// size class if available. This avoids pinning a large byte buffer per queued packet, without copying the packet.
+/// The bytes of the packet beyond get_rx_byte_buffer_capacity() are received in an overflow area, and moved with the
+/// rest of the packet to a large byte buffer by merge_rx_byte_buffer_overflow().
+unique_byte_buffer_t make_rx_byte_buffer() noexcept;
+
+/// Bytes of packet, from msg, that the receive byte buffer holds
+uint32_t get_rx_byte_buffer_capacity(const byte_buffer_t& buf);
+
+/// Moves the packet of N_bytes in the receive byte buffer, whose bytes beyond get_rx_byte_buffer_capacity() are in the
+/// overflow area, to a large byte buffer. Returns false, leaving the byte buffer as is, if there is no large byte
+/// buffer available.
+bool merge_rx_byte_buffer_overflow(unique_byte_buffer_t& buf, const uint8_t* overflow) noexcept;
+
 inline unique_byte_buffer_t make_byte_buffer(uint32_t size, uint8_t value) noexcept
 {
-  return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t(size, value));
+  unique_byte_buffer_t buffer = make_byte_buffer();
+  if (buffer == nullptr or buffer->get_tailroom() < size) {
+    return nullptr;
+  }
+  buffer->N_bytes = size;
+  std::fill(buffer->msg, buffer->msg + size, value);
+  return buffer;
 }
 
 inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 {
-  std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
+  std::unique_ptr<byte_buffer_t> buffer = make_byte_buffer();
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
   }
@@ -191,7 +264,7 @@ inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 
 inline unique_byte_buffer_t make_byte_buffer(const uint8_t* payload, uint32_t len, const char* debug_ctxt) noexcept
 {
-  std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
+  std::unique_ptr<byte_buffer_t> buffer = make_byte_buffer_with_tailroom(len);
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
   } else {
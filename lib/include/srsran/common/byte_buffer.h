@@ -24,8 +24,16 @@
 
 #include "common.h"
 #include "srsran/adt/span.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 //#define SRSRAN_BUFFER_POOL_LOG_ENABLED
 #define SRSRAN_BUFFER_POOL_LOG_NAME_LEN 128
@@ -85,6 +93,14 @@ private:
  * Generic byte buffer with headroom to accommodate packet headers and custom
  * copy constructors & assignment operators for quick copying. Byte buffer
  * holds a next pointer to support linked lists.
+ * The byte buffer object is a header, and the bytes are stored in a separate
+ * payload of buffer_size bytes. The byte buffers of the pools are placed in
+ * a pool block together with their payload, which is sized for the size
+ * class of the pool. Byte buffers created otherwise, e.g. on the stack, own
+ * their payload: SRSRAN_MAX_BUFFER_SIZE_BYTES by default, the header room and
+ * the given content otherwise, and the size of the source for copies.
+ * A byte buffer may also be shared by several byte_buffer_slice, which count
+ * their references in the byte buffer.
  *****************************************************************************/
 class byte_buffer_t
 {
@@ -92,8 +108,11 @@ public:
   using iterator       = uint8_t*;
   using const_iterator = const uint8_t*;
 
-  uint32_t N_bytes = 0;
-  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+  /// Buffer sizes of the small and medium size classes, header room included. The large size class has the full
+  /// SRSRAN_MAX_BUFFER_SIZE_BYTES.
+  static const uint32_t small_buffer_size  = 2048;
+  static const uint32_t medium_buffer_size = 4096;
+
   uint8_t* msg = nullptr;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
   char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
@@ -104,35 +123,60 @@ public:
     buffer_latency_calc tp;
   } md;
 
-  byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
+  // Number of byte_buffer_slice that share the byte buffer
+  std::atomic<uint32_t> nof_slice_refs{0};
+
+  // Bytes of the payload, header room included
+  uint32_t buffer_size = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+  uint32_t N_bytes     = 0;
+  uint8_t* buffer      = nullptr;
+
+  byte_buffer_t() : byte_buffer_t(owned_payload_tag{}, SRSRAN_MAX_BUFFER_SIZE_BYTES, 0) {}
+  /// Byte buffer with size bytes of content, in a payload with room for the content and the header only
+  explicit byte_buffer_t(uint32_t size) :
+    byte_buffer_t(owned_payload_tag{}, SRSRAN_BUFFER_HEADER_OFFSET + size, size)
+  {}
+  byte_buffer_t(uint32_t size, uint8_t val) : byte_buffer_t(size) { std::fill(msg, msg + N_bytes, val); }
+  /// Byte buffer in the payload of payload_size bytes, which must outlive it. Used by the byte buffer pools.
+  byte_buffer_t(uint8_t* payload, uint32_t payload_size) :
+    msg(&payload[SRSRAN_BUFFER_HEADER_OFFSET]), buffer_size(payload_size), buffer(payload)
   {
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
 #endif
   }
-  explicit byte_buffer_t(uint32_t size) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), N_bytes(size)
+  byte_buffer_t(const byte_buffer_t& buf) : byte_buffer_t(owned_payload_tag{}, buf.buffer_size, 0)
   {
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
-#endif
+    // the payload has the size of the one of buf, which fits its content
+    copy_from(buf);
   }
-  byte_buffer_t(uint32_t size, uint8_t val) : byte_buffer_t(size) { std::fill(msg, msg + N_bytes, val); }
-  byte_buffer_t(const byte_buffer_t& buf) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), md(buf.md), N_bytes(buf.N_bytes)
+
+  /// Copies the content of buf, which must fit in this buffer, as the byte buffer may be of a smaller size class.
+  /// Use copy_from() when it may not fit.
+  byte_buffer_t& operator=(const byte_buffer_t& buf)
   {
-    // copy actual contents
-    memcpy(msg, buf.msg, N_bytes);
+    bool copied = copy_from(buf);
+    srsran_always_assert(copied, "Byte buffer of %d bytes does not fit %d bytes", buffer_size, buf.N_bytes);
+    return *this;
   }
 
-  byte_buffer_t& operator=(const byte_buffer_t& buf)
+  /// Copies the content and metadata of buf. Keeps the headroom of buf, unless the content would not fit with it.
+  /// Returns false, leaving the buffer as is, if the content of buf does not fit in this buffer.
+  bool copy_from(const byte_buffer_t& buf)
   {
     // avoid self assignment
-    if (&buf == this)
-      return *this;
-    msg     = &buffer[buf.msg - &(*buf.buffer)];
-    N_bytes = buf.N_bytes;
-    md      = buf.md;
+    if (&buf == this) {
+      return true;
+    }
+    if (buf.N_bytes > buffer_size) {
+      return false;
+    }
+    N_bytes           = buf.N_bytes;
+    uint32_t headroom = std::min(static_cast<uint32_t>(buf.msg - buf.buffer), buffer_size - N_bytes);
+    msg               = &buffer[headroom];
+    md                = buf.md;
     memcpy(msg, buf.msg, N_bytes);
-    return *this;
+    return true;
   }
 
   void clear()
@@ -143,7 +187,7 @@ public:
   }
   uint32_t get_headroom() { return msg - buffer; }
   // Returns the remaining space from what is reported to be the length of msg
-  uint32_t                  get_tailroom() const { return (sizeof(buffer) - (msg - buffer) - N_bytes); }
+  uint32_t                  get_tailroom() const { return (buffer_size - (msg - buffer) - N_bytes); }
   std::chrono::microseconds get_latency_us() const { return md.tp.get_latency_us(); }
 
   std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
@@ -152,10 +196,15 @@ public:
 
   void set_timestamp(std::chrono::high_resolution_clock::time_point tp_) { md.tp.set_timestamp(tp_); }
 
-  void append_bytes(uint8_t* buf, uint32_t size)
+  /// Appends size bytes to the content. Returns false, leaving the buffer as is, if they do not fit in the tailroom.
+  bool append_bytes(const uint8_t* buf, uint32_t size)
   {
+    if (size > get_tailroom()) {
+      return false;
+    }
     memcpy(&msg[N_bytes], buf, size);
     N_bytes += size;
+    return true;
   }
 
   // vector-like interface
@@ -169,11 +218,28 @@ public:
   iterator       end() { return msg + N_bytes; }
   const_iterator end() const { return msg + N_bytes; }
 
-  void* operator new(size_t sz);
-  void* operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept;
+  // byte buffers are allocated from the pools with make_byte_buffer() and make_byte_buffer_with_tailroom()
+  void* operator new(size_t sz)   = delete;
   void* operator new[](size_t sz) = delete;
   void  operator delete(void* ptr);
   void  operator delete[](void* ptr) = delete;
+
+private:
+  struct owned_payload_tag {};
+
+  /// Byte buffer that owns a payload of payload_size bytes, up to SRSRAN_MAX_BUFFER_SIZE_BYTES, with n_bytes of content
+  byte_buffer_t(owned_payload_tag, uint32_t payload_size, uint32_t n_bytes) :
+    buffer_size(std::min(payload_size, (uint32_t)SRSRAN_MAX_BUFFER_SIZE_BYTES)), owned_payload(new uint8_t[buffer_size])
+  {
+    buffer  = owned_payload.get();
+    msg     = &buffer[SRSRAN_BUFFER_HEADER_OFFSET];
+    N_bytes = std::min(n_bytes, buffer_size - SRSRAN_BUFFER_HEADER_OFFSET);
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+#endif
+  }
+
+  std::unique_ptr<uint8_t[]> owned_payload;
 };
 
 struct bit_buffer_t {
@@ -237,6 +303,198 @@ inline const_byte_span make_span(const unique_byte_buffer_t& b)
   return const_byte_span{b->msg, b->N_bytes};
 }
 
+/******************************************************************************
+ * Byte buffer slice
+ *
+ * Reference counted view of a part of the content of a byte buffer. Several
+ * slices share one byte buffer without copying its content, e.g. the RLC PDUs
+ * that carry segments of the same SDU. The byte buffer is freed with its last
+ * slice. The content of a shared byte buffer must not be modified.
+ *****************************************************************************/
+class byte_buffer_slice
+{
+public:
+  using const_iterator = const uint8_t*;
+
+  byte_buffer_slice() = default;
+  /// Takes the ownership of the byte buffer, and views all its content
+  explicit byte_buffer_slice(unique_byte_buffer_t buf_) : buf(buf_.release())
+  {
+    if (buf != nullptr) {
+      buf->nof_slice_refs.store(1, std::memory_order_relaxed);
+      ptr = buf->msg;
+      len = buf->N_bytes;
+    }
+  }
+  /// Views len_ bytes of the content of other, from offset
+  byte_buffer_slice(const byte_buffer_slice& other, uint32_t offset, uint32_t len_) :
+    buf(other.buf), ptr(other.ptr + offset), len(len_)
+  {
+    assert(offset + len_ <= other.len);
+    acquire();
+  }
+  byte_buffer_slice(const byte_buffer_slice& other) : buf(other.buf), ptr(other.ptr), len(other.len) { acquire(); }
+  byte_buffer_slice(byte_buffer_slice&& other) noexcept : buf(other.buf), ptr(other.ptr), len(other.len)
+  {
+    other.buf = nullptr;
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+  byte_buffer_slice& operator=(byte_buffer_slice other) noexcept
+  {
+    std::swap(buf, other.buf);
+    std::swap(ptr, other.ptr);
+    std::swap(len, other.len);
+    return *this;
+  }
+  ~byte_buffer_slice() { reset(); }
+
+  void reset()
+  {
+    if (buf != nullptr and buf->nof_slice_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete buf;
+    }
+    buf = nullptr;
+    ptr = nullptr;
+    len = 0;
+  }
+
+  const uint8_t* data() const { return ptr; }
+  uint32_t       size() const { return len; }
+  bool           empty() const { return len == 0; }
+  const_iterator begin() const { return ptr; }
+  const_iterator end() const { return ptr + len; }
+
+  /// Metadata of the viewed byte buffer. The slice must not be null.
+  const byte_buffer_t::buffer_metadata_t& metadata() const { return buf->md; }
+
+  /// Splits the first n bytes off the slice, into a new slice of the same byte buffer
+  byte_buffer_slice take_front(uint32_t n)
+  {
+    assert(n <= len);
+    if (n == len) {
+      return std::move(*this);
+    }
+    byte_buffer_slice front(*this, 0, n);
+    ptr += n;
+    len -= n;
+    return front;
+  }
+
+  /// Hands over the byte buffer, with the content of the slice, if the slice is its only reference. Otherwise, returns
+  /// nullptr and keeps the slice.
+  unique_byte_buffer_t try_release()
+  {
+    if (buf == nullptr or buf->nof_slice_refs.load(std::memory_order_acquire) != 1) {
+      return nullptr;
+    }
+    buf->msg     = ptr;
+    buf->N_bytes = len;
+    unique_byte_buffer_t ret(buf);
+    buf = nullptr;
+    ptr = nullptr;
+    len = 0;
+    return ret;
+  }
+
+private:
+  void acquire()
+  {
+    if (buf != nullptr) {
+      buf->nof_slice_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  byte_buffer_t* buf = nullptr;
+  uint8_t*       ptr = nullptr;
+  uint32_t       len = 0;
+};
+
+/******************************************************************************
+ * Byte buffer chain
+ *
+ * Packet made of a sequence of byte buffer slices, e.g. a RLC PDU made of
+ * segments of several SDUs, or a SDU reassembled from the segments of several
+ * PDUs. The content is only copied when it is gathered into a contiguous
+ * buffer. The first slices are stored in place, to avoid heap allocations in
+ * the common case.
+ *****************************************************************************/
+class byte_buffer_chain
+{
+public:
+  static const uint32_t nof_inline_slices = 4;
+
+  byte_buffer_chain() = default;
+  byte_buffer_chain(const byte_buffer_chain&) = delete;
+  byte_buffer_chain(byte_buffer_chain&& other) noexcept :
+    inline_slices(std::move(other.inline_slices)),
+    extra_slices(std::move(other.extra_slices)),
+    nof_slices(other.nof_slices),
+    nof_bytes(other.nof_bytes)
+  {
+    other.clear();
+  }
+  byte_buffer_chain& operator=(const byte_buffer_chain&) = delete;
+  byte_buffer_chain& operator=(byte_buffer_chain&& other) noexcept
+  {
+    if (this != &other) {
+      inline_slices = std::move(other.inline_slices);
+      extra_slices  = std::move(other.extra_slices);
+      nof_slices    = other.nof_slices;
+      nof_bytes     = other.nof_bytes;
+      other.clear();
+    }
+    return *this;
+  }
+
+  /// Appends the slice at the end of the packet. Empty slices are dropped.
+  void append(byte_buffer_slice slice)
+  {
+    if (slice.empty()) {
+      return;
+    }
+    nof_bytes += slice.size();
+    if (nof_slices < nof_inline_slices) {
+      inline_slices[nof_slices] = std::move(slice);
+    } else {
+      extra_slices.push_back(std::move(slice));
+    }
+    nof_slices++;
+  }
+
+  void clear()
+  {
+    for (uint32_t i = 0; i < std::min(nof_slices, nof_inline_slices); ++i) {
+      inline_slices[i].reset();
+    }
+    extra_slices.clear();
+    nof_slices = 0;
+    nof_bytes  = 0;
+  }
+
+  uint32_t                 size() const { return nof_bytes; }
+  bool                     empty() const { return nof_bytes == 0; }
+  uint32_t                 get_nof_slices() const { return nof_slices; }
+  const byte_buffer_slice& slice(uint32_t idx) const
+  {
+    return idx < nof_inline_slices ? inline_slices[idx] : extra_slices[idx - nof_inline_slices];
+  }
+
+  /// Copies len bytes of the packet, from offset, into dst. Returns the number of bytes copied.
+  uint32_t copy_to(uint8_t* dst, uint32_t offset, uint32_t len) const;
+  uint32_t copy_to(uint8_t* dst) const { return copy_to(dst, 0, nof_bytes); }
+
+  /// Returns the packet in one byte buffer, with the metadata of the first slice, and clears the chain. The byte
+  /// buffer of a chain of one slice is handed over without copy, if the slice is its only reference.
+  unique_byte_buffer_t gather();
+
+private:
+  std::array<byte_buffer_slice, nof_inline_slices> inline_slices;
+  std::vector<byte_buffer_slice>                   extra_slices;
+  uint32_t                                         nof_slices = 0;
+  uint32_t                                         nof_bytes  = 0;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_BYTE_BUFFER_H
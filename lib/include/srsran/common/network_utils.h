@@ -27,6 +27,8 @@
 #include "srsran/common/threads.h"
 
 #include <arpa/inet.h>
+#include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <netinet/in.h>
@@ -173,6 +175,54 @@ private:
   std::condition_variable        rem_cvar;
 };
 
+/// Datagrams received, or sent, by a socket with one recvmmsg(...) or sendmmsg(...) call
+struct socket_batch_metrics_t {
+  uint64_t nof_calls   = 0;
+  uint64_t nof_packets = 0;
+  uint32_t max_batch   = 0; ///< Largest batch since the last read of the metrics
+};
+
+/// Counts the batches of a socket. Written by the thread doing the I/O, and read by any other thread
+class socket_batch_counter
+{
+public:
+  void add_batch(uint32_t nof_packets);
+  /// Reads the counters, and restarts the largest batch
+  void get_metrics(socket_batch_metrics_t& metrics);
+
+private:
+  std::atomic<uint64_t> nof_calls{0};
+  std::atomic<uint64_t> nof_packets{0};
+  std::atomic<uint32_t> max_batch{0};
+};
+
+/**
+ * Sends the datagrams of a UDP socket in batches, with one sendmmsg(...) call. The datagrams are queued until the
+ * batch is full, or until flush() is called. The sender is not thread-safe.
+ */
+class udp_batch_sender
+{
+public:
+  static const uint32_t max_batch_size = 32;
+
+  explicit udp_batch_sender(srslog::basic_logger& logger_) : logger(logger_) {}
+
+  void                  set_fd(int fd_) { fd = fd_; }
+  void                  push(srsran::unique_byte_buffer_t pdu, const sockaddr_in& dest);
+  /// Sends the queued datagrams
+  void                  flush();
+  bool                  empty() const { return nof_pending == 0; }
+  socket_batch_counter& get_counter() { return counter; }
+
+private:
+  srslog::basic_logger&                                    logger;
+  int                                                      fd          = -1;
+  uint32_t                                                 nof_pending = 0;
+  std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
+  std::array<sockaddr_in, max_batch_size>                  dests;
+  socket_batch_counter                                     counter;
+};
+
 /// Function signature for SDU byte buffers received from SCTP socket
 using sctp_recv_callback_t =
     srsran::move_callback<void(srsran::unique_byte_buffer_t, const sockaddr_in&, const sctp_sndrcvinfo&, int)>;
@@ -195,10 +245,14 @@ socket_manager_itf::recv_callback_t
 make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, sctp_recv_callback_t rx_callback);
 
 /**
- * Similar to make_sctp_sdu_handler, but for any sockaddr_in-based socket type
+ * Similar to make_sctp_sdu_handler, but for any sockaddr_in-based datagram socket. The datagrams that are waiting in
+ * the socket are received in batches with one recvmmsg(...) call, into buffers that are allocated in advance.
+ * @param rx_batches optional counter of the received batches
  */
-socket_manager_itf::recv_callback_t
-make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
+socket_manager_itf::recv_callback_t make_sdu_handler(srslog::basic_logger&      logger,
+                                                     srsran::task_queue_handle& queue,
+                                                     recvfrom_callback_t        rx_callback,
+                                                     socket_batch_counter*      rx_batches = nullptr);
 
 inline socket_manager& get_rx_io_manager()
 {
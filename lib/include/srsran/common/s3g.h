@@ -72,6 +72,17 @@ void s3g_deinitialize(S3G_STATE* state);
 
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/* Round functions of the FSM and the LFSR.
+ * s3g_s1/s3g_s2: S-Boxes S1 and S2, see sections 3.3.1 and 3.3.2.
+ * s3g_mul_alpha/s3g_div_alpha: multiplication and division by alpha, see
+ * sections 3.4.2 and 3.4.3.
+ */
+
+uint32_t s3g_s1(uint32_t w);
+uint32_t s3g_s2(uint32_t w);
+uint32_t s3g_mul_alpha(uint8_t c);
+uint32_t s3g_div_alpha(uint8_t c);
+
 /* f8.
  * Input key: 128 bit Confidentiality Key.
  * Input count:32-bit Count, Frame dependent input.
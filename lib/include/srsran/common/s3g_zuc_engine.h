@@ -0,0 +1,85 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_S3G_ZUC_ENGINE_H
+#define SRSRAN_S3G_ZUC_ENGINE_H
+
+#include "srsran/common/security.h"
+
+namespace srsran {
+
+/**
+ * 128-EEA1/128-EIA1 (SNOW 3G) and 128-EEA3/128-EIA3 (ZUC) with table-based round functions.
+ * The batch functions generate the keystreams of several PDUs at the same time, one PDU per SIMD lane: 16 lanes with
+ * AVX512, 8 with AVX2 and 4 with SSE or NEON. PDUs are grouped by length, so that the lanes of a group run for a
+ * similar number of words. Builds without SIMD, and single PDU calls, use one lane.
+ * Once the key is set, the engines are only read, and can be used by several threads at the same time.
+ */
+class s3g_engine
+{
+public:
+  /// Loads the 16-byte key.
+  void set_key(const uint8_t* key);
+
+  /// Ciphers (or deciphers) msg_len bytes of msg into out, which may point to msg.
+  void
+  eea1(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out) const;
+  /// Computes the 4-byte MAC of msg_len bytes of msg.
+  void
+  eia1(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac) const;
+
+  void eea1_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+  void eia1_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+
+  /// Number of PDUs processed at the same time by the batch functions.
+  static uint32_t get_nof_lanes();
+
+private:
+  // Key as the words k0..k3 of the SNOW 3G initialization
+  uint32_t k[4] = {};
+};
+
+class zuc_engine
+{
+public:
+  /// Loads the 16-byte key.
+  void set_key(const uint8_t* key);
+
+  /// Ciphers (or deciphers) msg_len bytes of msg into out, which may point to msg.
+  void
+  eea3(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out) const;
+  /// Computes the 4-byte MAC of msg_len bytes of msg.
+  void
+  eia3(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac) const;
+
+  void eea3_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+  void eia3_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+
+  /// Number of PDUs processed at the same time by the batch functions.
+  static uint32_t get_nof_lanes();
+
+private:
+  uint8_t key[16] = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_S3G_ZUC_ENGINE_H
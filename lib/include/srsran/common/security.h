@@ -97,6 +97,15 @@ typedef enum {
 } security_direction_t;
 static const char security_direction_text[INTEGRITY_ALGORITHM_ID_N_ITEMS][20] = {"Uplink", "Downlink"};
 
+/// PDU of a batch of ciphering or integrity operations that share key, bearer and direction. For ciphering, out
+/// receives msg_len bytes and may point to msg. For integrity, out receives the 4-byte MAC.
+struct security_pdu_t {
+  uint32_t       count;
+  const uint8_t* msg;
+  uint32_t       msg_len;
+  uint8_t*       out;
+};
+
 using as_key_t = std::array<uint8_t, 32>;
 struct k_enb_context_t {
   as_key_t k_enb;
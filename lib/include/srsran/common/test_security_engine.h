@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TEST_SECURITY_ENGINE_H
+#define SRSRAN_TEST_SECURITY_ENGINE_H
+
+#include "srsran/common/s3g_zuc_engine.h"
+#include "srsran/common/test_common.h"
+#include <cstring>
+#include <vector>
+
+namespace srsran {
+
+template <typename Engine>
+using engine_single_fn_t =
+    void (Engine::*)(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t*, uint32_t, uint8_t*) const;
+template <typename Engine>
+using engine_batch_fn_t = void (Engine::*)(uint8_t bearer, uint8_t direction, const security_pdu_t*, uint32_t) const;
+
+/**
+ * Checks a ciphering algorithm of a security engine used by PDCP, once per PDU and in batches that fill all lanes and
+ * leave one PDU over. The engines work on whole bytes, so the bits past len_bits are cleared before the comparison.
+ */
+template <typename Engine>
+int test_engine_ciphering(engine_single_fn_t<Engine> cipher,
+                          engine_batch_fn_t<Engine>  cipher_batch,
+                          const uint8_t*             key,
+                          uint32_t                   count,
+                          uint8_t                    bearer,
+                          uint8_t                    direction,
+                          const uint8_t*             msg,
+                          const uint8_t*             ct,
+                          uint32_t                   len_bits)
+{
+  uint32_t len_bytes = (len_bits + 7) / 8;
+  uint32_t nof_pdus  = 2 * Engine::get_nof_lanes() + 1;
+  Engine   engine;
+  engine.set_key(key);
+
+  std::vector<std::vector<uint8_t> > outs(nof_pdus, std::vector<uint8_t>(len_bytes));
+  std::vector<security_pdu_t>        pdus;
+  for (std::vector<uint8_t>& out : outs) {
+    pdus.push_back({count, msg, len_bytes, out.data()});
+  }
+
+  (engine.*cipher)(count, bearer, direction, msg, len_bytes, outs[0].data());
+  (engine.*cipher_batch)(bearer, direction, pdus.data(), 1);
+  (engine.*cipher_batch)(bearer, direction, &pdus[1], nof_pdus - 1);
+  for (std::vector<uint8_t>& out : outs) {
+    if (len_bits % 8 != 0) {
+      out[len_bytes - 1] &= 0xFF << (8 - len_bits % 8);
+    }
+    TESTASSERT(memcmp(ct, out.data(), len_bytes) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * Checks an integrity algorithm of a security engine used by PDCP, once per PDU and in a batch that fills all lanes
+ * and leaves one PDU over.
+ */
+template <typename Engine>
+int test_engine_integrity(engine_single_fn_t<Engine> integrity,
+                          engine_batch_fn_t<Engine>  integrity_batch,
+                          const uint8_t*             key,
+                          uint32_t                   count,
+                          uint8_t                    bearer,
+                          uint8_t                    direction,
+                          const uint8_t*             msg,
+                          uint32_t                   len_bytes,
+                          const uint8_t*             mt)
+{
+  uint32_t nof_pdus = 2 * Engine::get_nof_lanes() + 1;
+  Engine   engine;
+  engine.set_key(key);
+
+  std::vector<uint8_t>        macs(4 * nof_pdus);
+  std::vector<security_pdu_t> pdus;
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    pdus.push_back({count, msg, len_bytes, &macs[4 * i]});
+  }
+
+  (engine.*integrity)(count, bearer, direction, msg, len_bytes, &macs[0]);
+  TESTASSERT(memcmp(&macs[0], mt, 4) == 0);
+  (engine.*integrity_batch)(bearer, direction, pdus.data(), nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    TESTASSERT(memcmp(&macs[4 * i], mt, 4) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+#endif // SRSRAN_TEST_SECURITY_ENGINE_H
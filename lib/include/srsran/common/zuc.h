@@ -55,5 +55,7 @@ typedef struct {
 
 void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
+/* the S-box layer of F, S0 and S1 applied to the bytes of x */
+u32 zuc_sbox(u32 x);
 
 #endif // SRSRAN_ZUC_H
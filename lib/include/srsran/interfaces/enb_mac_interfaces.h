@@ -33,6 +33,7 @@ struct mac_args_t {
   sched_interface::sched_args_t sched;
   int                           lcid_padding;
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
+  uint32_t                      nof_softbuffer_ues; ///< Number of UEs with HARQ softbuffers reserved per cell
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
 };
@@ -29,6 +29,8 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
@@ -47,11 +49,13 @@ struct pdcp_metrics_t {
 };
 
 struct stack_metrics_t {
-  mac_metrics_t  mac;
-  rrc_metrics_t  rrc;
-  rlc_metrics_t  rlc;
-  pdcp_metrics_t pdcp;
-  s1ap_metrics_t s1ap;
+  mac_metrics_t                       mac;
+  rrc_metrics_t                       rrc;
+  rlc_metrics_t                       rlc;
+  pdcp_metrics_t                      pdcp;
+  s1ap_metrics_t                      s1ap;
+  gtpu_metrics_t                      gtpu;
+  srsran::byte_buffer_pools_metrics_t buffer_pools;
 };
 
 struct enb_metrics_t {
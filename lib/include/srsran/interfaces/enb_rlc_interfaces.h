@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_RLC_INTERFACES_H
 #define SRSRAN_ENB_RLC_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
@@ -38,6 +39,10 @@ public:
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
+
+  /* MAC calls RLC to push all RLC PDUs demultiplexed from one MAC PDU of a user, in order of arrival.
+   * The user is looked up once and the buffer state is updated once per LCID. */
+  virtual void write_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus) = 0;
 };
 
 // RLC interface for PDCP
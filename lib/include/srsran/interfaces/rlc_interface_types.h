@@ -283,6 +283,13 @@ public:
   }
 };
 
+/// Location of a received RLC PDU inside a demultiplexed MAC PDU
+struct rlc_pdu_ref_t {
+  uint32_t lcid;
+  uint8_t* payload;
+  uint32_t nof_bytes;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_RLC_INTERFACE_TYPES_H
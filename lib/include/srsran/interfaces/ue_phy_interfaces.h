@@ -42,6 +42,8 @@ struct cfr_args_t {
   float             strength         = 1.0f;
   float             auto_target_papr = 7.0f;
   float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  uint32_t          iterations       = 1;
+  bool              measure_metrics  = false;
 };
 
 struct phy_args_t {
@@ -23,6 +23,7 @@
 #define SRSRAN_PDU_QUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/timers.h"
@@ -42,7 +43,9 @@ public:
     virtual void process_pdu(uint8_t* buff, uint32_t len, channel_t channel, int ul_nof_prbs = -1) = 0;
   };
 
-  pdu_queue(srslog::basic_logger& logger) : pool(DEFAULT_POOL_SIZE), callback(NULL), logger(logger) {}
+  pdu_queue(srslog::basic_logger& logger) :
+    pool(DEFAULT_POOL_SIZE), pdu_q(DEFAULT_POOL_SIZE), callback(NULL), logger(logger)
+  {}
   void init(process_callback* callback);
 
   uint8_t* request(uint32_t len);
@@ -68,8 +71,9 @@ private:
 
   } pdu_t;
 
-  buffer_pool<pdu_t>                               pool;
-  static_blocking_queue<pdu_t*, DEFAULT_POOL_SIZE> pdu_q;
+  buffer_pool<pdu_t> pool;
+  // Decoded PDUs are pushed by the PHY workers and popped by the stack thread without taking a lock
+  mpmc_bounded_queue<pdu_t*> pdu_q;
 
   process_callback*     callback;
   srslog::basic_logger& logger;
@@ -28,6 +28,8 @@
 
 #define CFR_EMA_INIT_AVG_PWR 0.1
 
+#define SRSRAN_CFR_MAX_ITERATIONS 4
+
 /**
  * @brief CFR manual threshold or PAPR limiting with CMA or EMA power averaging
  */
@@ -51,6 +53,10 @@ typedef struct SRSRAN_API {
   float    alpha;     ///< Alpha parameter of the clipping algorithm
   bool     dc_sc;     ///< Take into account the DC subcarrier for the filter BW
 
+  // Iterative clipping and filtering, 0 and 1 both mean a single pass
+  uint32_t nof_iterations;  ///< Number of clipping and filtering iterations, up to SRSRAN_CFR_MAX_ITERATIONS
+  bool     measure_metrics; ///< Enable / disable the per-iteration PAPR, EVM and ACPR measurements
+
   // SRSRAN_CFR_THR_MANUAL mode parameters
   float manual_thr; ///< Fixed threshold used in SRSRAN_CFR_THR_MANUAL mode
 
@@ -60,6 +66,25 @@ typedef struct SRSRAN_API {
   float ema_alpha;        ///< EMA alpha parameter for avg power calculation, used in SRSRAN_CFR_THR_AUTO_EMA mode
 } srsran_cfr_cfg_t;
 
+/**
+ * @brief CFR metrics of a single clipping and filtering iteration, averaged over the processed symbols
+ */
+typedef struct SRSRAN_API {
+  float papr_db; ///< PAPR of the iteration output, in dB
+  float evm;     ///< RMS EVM of the iteration output with respect to the CFR input, in percent
+  float acpr_db; ///< ACPR of the clipped signal before the filter, in dB
+} srsran_cfr_iter_metrics_t;
+
+/**
+ * @brief CFR metrics, averaged over the symbols processed since the last srsran_cfr_get_metrics() call
+ */
+typedef struct SRSRAN_API {
+  uint32_t                  nof_symbols;    ///< Number of symbols the metrics are averaged over
+  uint32_t                  nof_iterations; ///< Number of valid entries in iter
+  float                     papr_in_db;     ///< PAPR of the CFR input, in dB
+  srsran_cfr_iter_metrics_t iter[SRSRAN_CFR_MAX_ITERATIONS];
+} srsran_cfr_metrics_t;
+
 typedef struct SRSRAN_API {
   srsran_cfr_cfg_t cfg;
   float            max_papr_lin;
@@ -72,12 +97,21 @@ typedef struct SRSRAN_API {
   float* abs_buffer_in;  ///< Store the input absolute value
   float* abs_buffer_out; ///< Store the output absolute value
   cf_t*  peak_buffer;
+  cf_t*  ref_buffer; ///< Copy of the input, reference of the EVM metrics when the symbols are processed in place
 
   float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
   float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
 
   // Power average buffers, used in SRSRAN_CFR_THR_AUTO_CMA mode
   uint64_t cma_n;
+
+  // Metric accumulators, in linear units
+  uint32_t nof_iterations;
+  uint32_t metrics_n;
+  float    papr_in_acc;
+  float    papr_acc[SRSRAN_CFR_MAX_ITERATIONS];
+  float    evm_acc[SRSRAN_CFR_MAX_ITERATIONS];
+  float    acpr_acc[SRSRAN_CFR_MAX_ITERATIONS];
 } srsran_cfr_t;
 
 SRSRAN_API int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg);
@@ -85,6 +119,9 @@ SRSRAN_API int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg);
 /**
  * @brief Applies the CFR algorithm to the time domain OFDM symbols
  *
+ * The clipping and filtering is repeated cfg.nof_iterations times with the same threshold, each iteration clipping
+ * the regrowth of the peaks caused by the filter of the previous one.
+ *
  * @attention This function must be called once per symbol, and it will process q->symbol_sz samples
  *
  * @param[in]  q    The CFR object and configuration
@@ -96,6 +133,17 @@ SRSRAN_API void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out);
 
 SRSRAN_API void srsran_cfr_free(srsran_cfr_t* q);
 
+/**
+ * @brief Gets the CFR metrics averaged since the previous call and resets the accumulators.
+ *
+ * @attention this is not thread-safe, it must be called from the thread processing the symbols
+ *
+ * @param[in]  q        the CFR object
+ * @param[out] metrics  the averaged metrics, all zero if cfg.measure_metrics is disabled
+ * @return SRSRAN_SUCCESS if successful, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int srsran_cfr_get_metrics(srsran_cfr_t* q, srsran_cfr_metrics_t* metrics);
+
 /**
  * @brief Checks the validity of the CFR algorithm parameters.
  *
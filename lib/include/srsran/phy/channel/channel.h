@@ -27,10 +27,14 @@
 #include "fading.h"
 #include "hst.h"
 #include "rlf.h"
+#include "srsran/common/threads.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace srsran {
 
@@ -39,7 +43,8 @@ class channel
 public:
   struct args_t {
     // General
-    bool enable = false;
+    bool     enable      = false;
+    uint32_t nof_workers = 0; ///< Extra threads processing channels in parallel, 0 runs all channels in the caller
 
     // AWGN options
     bool  awgn_enable            = false;
@@ -76,18 +81,57 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  /// Thread processing its share of the channels on every run() call
+  class worker_t : public thread
+  {
+  public:
+    worker_t(channel* parent_, uint32_t worker_idx_) :
+      thread("CHANNEL_" + std::to_string(worker_idx_)), parent(parent_), worker_idx(worker_idx_)
+    {}
+
+  private:
+    void run_thread() override { parent->worker_loop(worker_idx); }
+
+    channel* parent     = nullptr;
+    uint32_t worker_idx = 0;
+  };
+
+  /// Processes a single channel (antenna/link) with its own models and buffers
+  void run_channel(uint32_t i);
+
+  /// Processes all the channels assigned to a worker, the caller thread is worker 0
+  void run_worker_channels(uint32_t worker_idx);
+
+  void worker_loop(uint32_t worker_idx);
+
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]       = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]        = {};
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Current run() call, shared with the workers
+  cf_t**             run_in        = nullptr;
+  cf_t**             run_out       = nullptr;
+  uint32_t           run_len       = 0;
+  srsran_timestamp_t run_ts        = {};
+  cf_t               run_hst_phase = {};
+
+  // Worker pool
+  std::vector<std::unique_ptr<worker_t> > workers;
+  std::mutex                              workers_mutex;
+  std::condition_variable                 workers_cvar;
+  std::condition_variable                 done_cvar;
+  uint64_t                                run_count     = 0;
+  uint32_t                                pending_count = 0;
+  bool                                    workers_quit  = false;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
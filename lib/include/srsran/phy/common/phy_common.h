@@ -424,6 +424,16 @@ SRSRAN_API uint32_t srsran_sfidx_tdd_nof_dw(srsran_tdd_config_t tdd_config);
 
 SRSRAN_API uint32_t srsran_tdd_nof_harq(srsran_tdd_config_t tdd_config);
 
+/**
+ * Returns the number of subframes between a PDSCH transmission and its HARQ-ACK.
+ * Check TS 36.213 v10.13.0 Table 10.1.3.1-1.
+ *
+ * @param tdd_config TDD configuration.
+ * @param sf_idx Subframe number of the PDSCH transmission, must be in range [0,SRSRAN_NOF_SF_X_FRAME[.
+ * @return Returns the HARQ-ACK delay in subframes, or 0 if the subframe carries no PDSCH.
+ */
+SRSRAN_API uint32_t srsran_tdd_dl_harq_ack_delay(srsran_tdd_config_t tdd_config, uint32_t sf_idx);
+
 SRSRAN_API uint32_t srsran_sfidx_tdd_nof_dw_slot(srsran_tdd_config_t tdd_config, uint32_t slot, srsran_cp_t cp);
 
 SRSRAN_API bool srsran_sfidx_isvalid(uint32_t sf_idx);
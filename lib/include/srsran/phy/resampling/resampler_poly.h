@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         resampler_poly.h
+ *
+ *  Description:  Rational L/M resampler using a polyphase filter bank. Every
+ *                output sample is computed as a SIMD dot product between the
+ *                input history and one of the L filter branches.
+ *
+ *  Reference:    Multirate Signal Processing for Communication Systems
+ *                fredric j. harris
+ *****************************************************************************/
+
+#ifndef SRSRAN_RESAMPLER_POLY_H
+#define SRSRAN_RESAMPLER_POLY_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Polyphase resampler internal buffers and state
+ */
+typedef struct {
+  uint32_t interp;     ///< Interpolation factor L, zero if the resampler is not initialised
+  uint32_t decim;      ///< Decimation factor M
+  uint32_t nof_taps;   ///< Number of taps per polyphase branch
+  float*   filter;     ///< L branches of nof_taps time-reversed coefficients
+  cf_t*    buffer;     ///< Input samples, starting with the history required by the filter
+  uint32_t buffer_sz;  ///< Maximum number of samples in buffer
+  uint32_t buffer_len; ///< Number of samples currently in buffer
+  uint64_t t;          ///< Next output time relative to buffer start, in units of 1/L input samples
+  uint32_t delay;      ///< Prototype filter group delay, in units of 1/L input samples
+} srsran_resampler_poly_t;
+
+/**
+ * Initialise a polyphase resampler that changes the sampling rate by interp/decim. The ratio is reduced to its
+ * irreducible form.
+ * @param q Object pointer
+ * @param interp Interpolation factor L
+ * @param decim Decimation factor M
+ * @param max_nsamples Maximum number of input samples given in a single call
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int
+srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim, uint32_t max_nsamples);
+
+/**
+ * @brief Resets the internal resampler state
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * Get the delay of the next output sample with respect to the next input sample, in number of input samples. The
+ * output sample times are compensated for the filter group delay, so the delay is zero after a reset and remains
+ * around the group delay while the resampler runs with the input samples it requires.
+ * @param q Object pointer
+ * @return The delay in number of input samples
+ */
+SRSRAN_API double srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * Get the delay of the next output sample with respect to the next input sample, in seconds. The delay is given in
+ * input samples, so the input sampling rate is derived from the output one and the resampling ratio.
+ * @param q Object pointer
+ * @param output_srate Output sampling rate in Hz
+ * @return The delay in seconds
+ */
+SRSRAN_API double srsran_resampler_poly_get_delay_s(const srsran_resampler_poly_t* q, double output_srate);
+
+/**
+ * Get the number of input samples that need to be provided for being able to produce exactly nof_output samples
+ * @param q Object pointer
+ * @param nof_output Number of desired output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * Get the number of output samples that will be produced when nof_input input samples are provided
+ * @param q Object pointer
+ * @param nof_input Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input);
+
+/**
+ * @brief Run the polyphase resampler. Input samples that are not needed for producing max_output samples are kept
+ * for the next call.
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param nof_input Number of input samples. Together with the input kept from the previous calls, it shall not exceed
+ * the initialised maximum. An input that does not fit is an assertion failure, it is truncated in release builds
+ * @param output Points at the output complex buffer
+ * @param max_output Maximum number of samples to write in the output
+ * @return The number of samples written in the output
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              uint32_t                 nof_input,
+                                              cf_t*                    output,
+                                              uint32_t                 max_output);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RESAMPLER_POLY_H
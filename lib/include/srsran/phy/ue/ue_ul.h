@@ -125,6 +125,8 @@ SRSRAN_API int srsran_ue_ul_set_cell(srsran_ue_ul_t* q, srsran_cell_t cell);
 
 SRSRAN_API int srsran_ue_ul_set_cfr(srsran_ue_ul_t* q, const srsran_cfr_cfg_t* cfr);
 
+SRSRAN_API int srsran_ue_ul_get_cfr_metrics(srsran_ue_ul_t* q, srsran_cfr_metrics_t* metrics);
+
 SRSRAN_API int srsran_ue_ul_pregen_signals(srsran_ue_ul_t* q, srsran_ue_ul_cfg_t* cfg);
 
 SRSRAN_API int srsran_ue_ul_dci_to_pusch_grant(srsran_ue_ul_t*       q,
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         iq_converter.h
+ *
+ *  Description:  Conversion between complex float baseband samples and the
+ *                integer I/Q wire formats used by the RF front-ends and the
+ *                file/ZMQ backends: sc16, packed sc12 (3 bytes per sample)
+ *                and sc8. Values exceeding the integer range are saturated
+ *                and counted.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_IQ_CONVERTER_H
+#define SRSRAN_IQ_CONVERTER_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum SRSRAN_API {
+  SRSRAN_IQ_FORMAT_FC32 = 0, ///< Complex float, 8 bytes per sample
+  SRSRAN_IQ_FORMAT_SC16,     ///< Complex 16-bit integer, 4 bytes per sample
+  SRSRAN_IQ_FORMAT_SC12,     ///< Packed complex 12-bit integer, 3 bytes per sample
+  SRSRAN_IQ_FORMAT_SC8,      ///< Complex 8-bit integer, 2 bytes per sample
+  SRSRAN_IQ_FORMAT_INVALID
+} srsran_iq_format_t;
+
+/**
+ * @brief I/Q converter state
+ */
+typedef struct SRSRAN_API {
+  srsran_iq_format_t format;        ///< Wire format
+  float              scale;         ///< Integer value that corresponds to a float amplitude of 1.0
+  int32_t            max_value;     ///< Largest integer sent on the wire, the components are clipped to it
+  uint64_t           nof_saturated; ///< Number of I or Q components saturated when converting to the wire format
+} srsran_iq_converter_t;
+
+/**
+ * Initialise an I/Q converter.
+ * @param q Object
+ * @param format Wire format
+ * @param scale Integer value that corresponds to a float amplitude of 1.0. If 0, the largest integer of the format
+ * @param max_value Largest integer accepted by the device, e.g. 2047 for 12-bit samples carried in 16-bit words. If 0
+ * or beyond the format range, the largest integer of the format
+ * @return SRSRAN_SUCCESS if the format is valid, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int
+srsran_iq_converter_init(srsran_iq_converter_t* q, srsran_iq_format_t format, float scale, int32_t max_value);
+
+/**
+ * Converts complex float samples into the wire format. Saturated components are added to q->nof_saturated.
+ * @param q Object
+ * @param in Complex float samples
+ * @param out Wire buffer, at least srsran_iq_format_sample_sz(q->format) * nsamples bytes long
+ * @param nsamples Number of complex samples
+ */
+SRSRAN_API void srsran_iq_converter_to_wire(srsran_iq_converter_t* q, const cf_t* in, void* out, uint32_t nsamples);
+
+/**
+ * Converts samples in wire format into complex float.
+ * @param q Object
+ * @param in Wire buffer
+ * @param out Complex float samples
+ * @param nsamples Number of complex samples
+ */
+SRSRAN_API void srsran_iq_converter_from_wire(srsran_iq_converter_t* q, const void* in, cf_t* out, uint32_t nsamples);
+
+/**
+ * Returns and resets the number of saturated components since the last call.
+ */
+SRSRAN_API uint64_t srsran_iq_converter_get_saturated(srsran_iq_converter_t* q);
+
+/**
+ * @return The number of bytes used by one complex sample in the given format, 0 if the format is invalid
+ */
+SRSRAN_API uint32_t srsran_iq_format_sample_sz(srsran_iq_format_t format);
+
+/**
+ * Parses a format name (fc32, sc16, sc12 or sc8).
+ * @return The format or SRSRAN_IQ_FORMAT_INVALID if the name is not recognised
+ */
+SRSRAN_API srsran_iq_format_t srsran_iq_format_from_str(const char* str);
+
+SRSRAN_API const char* srsran_iq_format_to_str(srsran_iq_format_t format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_IQ_CONVERTER_H
@@ -104,6 +104,8 @@ SRSRAN_API cf_t srsran_vec_dot_prod_conj_ccc_simd(const cf_t* x, const cf_t* y,
 
 SRSRAN_API cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len);
 
+SRSRAN_API cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len);
+
 #ifdef ENABLE_C16
 SRSRAN_API c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len);
 #endif /* ENABLE_C16 */
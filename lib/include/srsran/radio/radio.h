@@ -26,6 +26,7 @@
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
 #include "srsran/srslog/srslog.h"
@@ -112,6 +113,10 @@ private:
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
+  // Polyphase resamplers, used when the ratio between the device and the baseband sampling rates is not integer
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {};
+
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
   uint32_t          tx_adv_nsamples    = 0;
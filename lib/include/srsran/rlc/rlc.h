@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_H
 #define SRSRAN_RLC_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -73,6 +74,7 @@ public:
   uint32_t read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   int      get_increment_sequence_num();
   void     write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  void     write_pdus(span<const rlc_pdu_ref_t> pdus);
   void     write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu);
   void     write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes);
   void     write_pdu_pcch(srsran::unique_byte_buffer_t pdu);
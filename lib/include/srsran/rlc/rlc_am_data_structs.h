@@ -125,10 +125,10 @@ public:
   using iterator       = typename list_type::iterator;
   using const_iterator = typename list_type::const_iterator;
 
-  const uint32_t       rlc_sn     = invalid_rlc_sn;
-  uint32_t             retx_count = 0;
-  HeaderType           header     = {};
-  unique_byte_buffer_t buf        = nullptr;
+  const uint32_t    rlc_sn     = invalid_rlc_sn;
+  uint32_t          retx_count = 0;
+  HeaderType        header     = {};
+  byte_buffer_chain buf; ///< PDU payload, made of slices of the SDUs
 
   explicit rlc_amd_tx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
   rlc_amd_tx_pdu(const rlc_amd_tx_pdu&)           = delete;
@@ -113,8 +113,8 @@ private:
 
   rlc_am_config_t cfg = {};
 
-  // TX SDU buffers
-  unique_byte_buffer_t tx_sdu;
+  // Untransmitted part of the SDU being segmented, shared with the PDUs of its segments
+  byte_buffer_slice tx_sdu;
 
   /****************************************************************************
    * State variables and counters
@@ -186,6 +186,7 @@ private:
   void handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
   void handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
   void reassemble_rx_sdus();
+  void deliver_rx_sdu();
   bool inside_rx_window(const int16_t sn);
   void debug_state();
   void print_rx_segments();
@@ -202,8 +203,8 @@ private:
    ***************************************************************************/
   rlc_am_config_t cfg = {};
 
-  // RX SDU buffers
-  unique_byte_buffer_t rx_sdu;
+  // Segments of the SDU being reassembled, in the buffers of their PDUs
+  byte_buffer_chain rx_sdu;
 
   /****************************************************************************
    * State variables and counters
@@ -220,9 +221,9 @@ private:
   // Mutex to protect members
   std::mutex mutex;
 
-  // Rx windows
-  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  // Rx windows. The segments of a SN are indexed like the SN in rx_window, as they are within the same window
+  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE>                               rx_window;
+  srsran::static_circular_map<uint32_t, rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
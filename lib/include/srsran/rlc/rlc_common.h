@@ -46,6 +46,9 @@ namespace srsran {
 #define RLC_AM_NR_TYP_NACKS 512  // Expected number of NACKs in status PDU before expanding space by alloc
 #define RLC_AM_NR_MAX_NACKS 2048 // Maximum number of NACKs in status PDU
 
+#define RLC_UM_LTE_MAX_RX_MOD 1024 // Rx counter modulus of UMD PDUs with 10 bit SN
+#define RLC_UM_NR_MAX_RX_MOD 4096  // Rx counter modulus of UMD PDUs with 12 bit SN
+
 #define RlcDebug(fmt, ...) logger.debug("%s: " fmt, rb_name, ##__VA_ARGS__)
 #define RlcInfo(fmt, ...) logger.info("%s: " fmt, rb_name, ##__VA_ARGS__)
 #define RlcWarning(fmt, ...) logger.warning("%s: " fmt, rb_name, ##__VA_ARGS__)
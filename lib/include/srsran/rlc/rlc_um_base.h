@@ -87,7 +87,7 @@ protected:
     rlc_um_base_tx(rlc_um_base* parent_);
     virtual ~rlc_um_base_tx();
     virtual bool     configure(const rlc_config_t& cfg, std::string rb_name) = 0;
-    uint32_t         build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
+    virtual uint32_t build_data_pdu(uint8_t* payload, uint32_t nof_bytes)    = 0;
     void             stop();
     void             reestablish();
     void             empty_queue();
@@ -122,8 +122,6 @@ protected:
     srsran::rolling_average<double> mean_pdu_latency_us;
 #endif
 
-    virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
-
     // helper functions
     virtual void debug_state() = 0;
     virtual void reset()       = 0;
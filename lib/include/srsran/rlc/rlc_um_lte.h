@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_UM_LTE_H
 #define SRSRAN_RLC_UM_LTE_H
 
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/rlc/rlc_um_base.h"
@@ -30,6 +31,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <vector>
 
 namespace srsran {
 
@@ -57,7 +59,7 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
@@ -71,6 +73,15 @@ private:
      ***************************************************************************/
     uint32_t vt_us = 0; // Send state. SN to be assigned for next PDU.
 
+    // Gather list of the SDU segments that make up the PDU under construction. The header length is only known once
+    // all segments are selected, so payload bytes are copied straight into the MAC buffer after the header is written.
+    struct tx_segment_t {
+      const uint8_t* ptr;
+      uint32_t       len;
+    };
+    std::vector<tx_segment_t>         tx_segments;
+    std::vector<unique_byte_buffer_t> tx_sdus_done; // fully segmented SDUs kept alive until their bytes are copied
+
     // Metrics
     void debug_state();
   };
@@ -95,8 +106,10 @@ private:
   private:
     void reset();
 
-    // Rx window
-    std::map<uint32_t, rlc_umd_pdu_t> rx_window;
+    // Rx window, indexed by SN. It spans the whole SN space, so that PDUs above the window never collide with the
+    // PDUs still waiting for reordering. The PDUs, whose headers have room for RLC_AM_WINDOW_SIZE LIs, are stored out
+    // of line
+    srsran::pooled_circular_map<uint32_t, rlc_umd_pdu_t, RLC_UM_LTE_MAX_RX_MOD> rx_window;
 
     // RX SDU buffers
     uint32_t vr_ur_in_rx_sdu = 0;
@@ -129,6 +142,7 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  rlc_umd_pdu_header_t* header);
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
 
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload);
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
 bool     rlc_um_end_aligned(uint8_t fi);
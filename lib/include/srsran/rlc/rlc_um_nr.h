@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_UM_NR_H
 #define SRSRAN_RLC_UM_NR_H
 
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/interfaces/ue_interfaces.h"
@@ -61,12 +62,13 @@ private:
     rlc_um_nr_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
 
   private:
-    void reset();
+    void     reset();
+    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
 
     uint32_t TX_Next = 0; // send state as defined in TS 38.322 v15.3 Section 7
                           // It holds the value of the SN to be assigned for the next newly generated UMD PDU with
@@ -122,7 +124,9 @@ private:
       uint32_t                             next_expected_so;
       uint32_t                             total_sdu_length;
     } rlc_umd_pdu_segments_nr_t;
-    std::map<uint32_t, rlc_umd_pdu_segments_nr_t> rx_window;
+    // Indexed by SN over the whole SN space, with the segments stored out of line. Look up the SNs of the window, the
+    // map can't be iterated
+    srsran::pooled_circular_map<uint32_t, rlc_umd_pdu_segments_nr_t, RLC_UM_NR_MAX_RX_MOD> rx_window;
 
     void update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments, const rlc_umd_pdu_nr_t& rx_pdu);
 
@@ -38,6 +38,9 @@ public:
   void init(srsue::rlc_interface_pdcp* rlc_, srsue::rrc_interface_pdcp* rrc_, srsue::gw_interface_pdcp* gw_);
   void stop();
 
+  // Cipher the DRBs added from now on in the given security workers
+  void set_security_pool(pdcp_security_pool* security_pool_) { security_pool = security_pool_; }
+
   // Stack interface
   bool is_lcid_enabled(uint32_t lcid);
 
@@ -84,6 +87,7 @@ private:
   srsue::gw_interface_pdcp*  gw     = nullptr;
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
+  pdcp_security_pool*        security_pool = nullptr;
 
   using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
   pdcp_map_t pdcp_array, pdcp_array_mrb;
@@ -23,9 +23,11 @@
 #define SRSRAN_PDCP_ENTITY_BASE_H
 
 #include "srsran/adt/accumulators.h"
+#include "srsran/common/aes128.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
+#include "srsran/common/s3g_zuc_engine.h"
 #include "srsran/common/security.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
@@ -33,6 +35,7 @@
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include <memory>
 
 namespace srsran {
 
@@ -55,6 +58,34 @@ typedef enum {
 } pdcp_d_c_t;
 static const char pdcp_d_c_text[PDCP_D_C_N_ITEMS][20] = {"Control PDU", "Data PDU"};
 
+/****************************************************************************
+ * PDCP ciphering keys
+ * Ciphering algorithm and key of a bearer. Entities replace it on every key
+ * change instead of modifying it, so that the PDUs queued in the security
+ * workers keep the keys they were assigned.
+ ***************************************************************************/
+class pdcp_cipher
+{
+public:
+  pdcp_cipher(CIPHERING_ALGORITHM_ID_ENUM algo_, const uint8_t* k_enc);
+  pdcp_cipher(const pdcp_cipher&) = delete;
+  pdcp_cipher& operator=(const pdcp_cipher&) = delete;
+
+  CIPHERING_ALGORITHM_ID_ENUM get_algo() const { return algo; }
+
+  /// Ciphers (or deciphers) msg_len bytes of msg into out, which may point to msg.
+  void cipher(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out)
+      const;
+  void cipher_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const;
+
+private:
+  CIPHERING_ALGORITHM_ID_ENUM algo;
+  // Expanded key, for the engine of algo
+  srsran::aes128_engine aes;
+  srsran::s3g_engine    s3g;
+  srsran::zuc_engine    zuc;
+};
+
 /****************************************************************************
  * PDCP Entity interface
  * Common interface for LTE and NR PDCP entities
@@ -168,6 +199,11 @@ protected:
   std::string   rb_name;
 
   srsran::as_security_config_t sec_cfg = {};
+  // Expanded ciphering and integrity keys of the bearer
+  std::shared_ptr<const pdcp_cipher> cipher_keys;
+  srsran::aes128_engine              aes_int;
+  srsran::s3g_engine                 s3g_int;
+  srsran::zuc_engine                 zuc_int;
 
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
@@ -29,6 +29,7 @@
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/upper/pdcp_entity_base.h"
+#include "srsran/upper/pdcp_security_pool.h"
 
 namespace srsue {
 
@@ -110,7 +111,7 @@ private:
  * Class for LTE PDCP entities
  ***************************************************************************/
 
-class pdcp_entity_lte final : public pdcp_entity_base
+class pdcp_entity_lte final : public pdcp_entity_base, public pdcp_security_user
 {
 public:
   pdcp_entity_lte(srsue::rlc_interface_pdcp* rlc_,
@@ -155,6 +156,10 @@ public:
 
   size_t nof_discard_timers() const { return undelivered_sdus != nullptr ? undelivered_sdus->nof_discard_timers() : 0; }
 
+  // Security workers, which cipher the PDUs of DRBs when set before the bearer is configured
+  void set_security_pool(pdcp_security_pool* security_pool_) { security_pool = security_pool_; }
+  void write_secured_pdu(unique_byte_buffer_t pdu, uint32_t count, uint32_t tag, bool is_tx) override;
+
 private:
   srsue::rlc_interface_pdcp* rlc = nullptr;
   srsue::rrc_interface_pdcp* rrc = nullptr;
@@ -172,6 +177,17 @@ private:
   void handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu);
 
+  // Lower/upper layer delivery, once the PDU is ciphered/deciphered
+  void pass_to_rlc(srsran::unique_byte_buffer_t pdu);
+  void pass_to_gw(srsran::unique_byte_buffer_t pdu, uint32_t count);
+
+  // Security offloading
+  bool
+  offload_security(srsran::unique_byte_buffer_t& pdu, uint32_t offset, uint32_t count, bool is_tx, bool do_cipher);
+  pdcp_security_pool*                   security_pool = nullptr;
+  std::shared_ptr<pdcp_security_bearer> security_bearer;
+  uint32_t                              tx_security_epoch = 0; // Incremented when the Tx PDUs in the workers are stale
+
   // Discard callback (discardTimer)
   class discard_callback;
 
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_SECURITY_POOL_H
+#define SRSRAN_PDCP_SECURITY_POOL_H
+
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/threads.h"
+#include "srsran/upper/pdcp_entity_base.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsran {
+
+class pdcp_security_pool;
+class pdcp_security_bearer;
+
+/// Bearer side of the PDCP security workers
+class pdcp_security_user
+{
+public:
+  virtual ~pdcp_security_user() = default;
+
+  /// Called in the stack thread with the PDUs of the bearer once they are ciphered or deciphered, in the order they
+  /// were pushed.
+  virtual void write_secured_pdu(unique_byte_buffer_t pdu, uint32_t count, uint32_t tag, bool is_tx) = 0;
+};
+
+/// PDU waiting to be ciphered or deciphered by a security worker
+struct pdcp_security_job_t {
+  std::shared_ptr<pdcp_security_bearer> bearer;
+  std::shared_ptr<const pdcp_cipher>    keys;
+  unique_byte_buffer_t                  pdu;
+  uint32_t                              offset    = 0; ///< First ciphered byte of the PDU
+  uint32_t                              count     = 0;
+  uint32_t                              tag       = 0; ///< Opaque to the pool, returned to the bearer
+  uint8_t                               bearer_id = 0; ///< Bearer input of the cipher, i.e. bearer ID - 1
+  uint8_t                               direction = 0;
+  bool                                  is_tx     = true;
+};
+
+/// Binding of a bearer to one of the security workers. The jobs in flight hold a reference to it, so that the
+/// bearer can be released while they are in the workers. The PDUs of a released bearer are dropped.
+class pdcp_security_bearer
+{
+public:
+  pdcp_security_bearer(pdcp_security_pool* pool_, uint32_t worker_idx_, pdcp_security_user* user_) :
+    pool(pool_), worker_idx(worker_idx_), user(user_)
+  {}
+
+  /// Queues the PDU of the job in the worker of the bearer, without blocking. If the worker queue is full while the
+  /// bearer has PDUs in flight, the PDU is processed in the calling thread and returned after those PDUs, to keep
+  /// their order. Returns false and leaves the job untouched if the queue is full and the bearer has no PDUs in
+  /// flight, in which case the caller processes the PDU itself.
+  bool push(pdcp_security_job_t& job);
+  /// Number of PDUs of the bearer in the workers, or waiting to be returned to the stack thread.
+  uint32_t nof_pending() const { return nof_pending_jobs + deferred_jobs.size(); }
+  /// Drops the PDUs in flight. Called by the bearer when it is destroyed.
+  void release();
+
+private:
+  friend class pdcp_security_pool;
+
+  void return_deferred_jobs();
+
+  pdcp_security_pool* pool;
+  uint32_t            worker_idx;
+  pdcp_security_user* user;
+  uint32_t            nof_pending_jobs = 0;
+
+  // PDUs processed in the stack thread while the worker queue was full, returned after the PDUs in the worker
+  std::vector<pdcp_security_job_t> deferred_jobs;
+};
+
+/**
+ * Worker threads that cipher and decipher the PDCP PDUs of data bearers, out of the stack thread.
+ * Each bearer is bound to one worker, and the workers return the PDUs to the stack thread through one task queue
+ * each. The PDUs of a bearer are therefore ciphered, and delivered, in the order of their COUNTs. Consecutive PDUs of a
+ * bearer that wait in the same worker are ciphered in one batch.
+ * The pool must outlive the bearers bound to it.
+ */
+class pdcp_security_pool
+{
+public:
+  static const uint32_t default_queue_size = 4096;
+
+  pdcp_security_pool(srsran::task_sched_handle task_sched,
+                     uint32_t                  nof_workers,
+                     uint32_t                  queue_size = default_queue_size,
+                     int32_t                   prio       = -1);
+  pdcp_security_pool(const pdcp_security_pool&) = delete;
+  pdcp_security_pool& operator=(const pdcp_security_pool&) = delete;
+  ~pdcp_security_pool();
+
+  void stop();
+
+  /// Binds a new bearer to the least loaded worker.
+  std::shared_ptr<pdcp_security_bearer> bind_bearer(pdcp_security_user* user);
+
+  uint32_t get_nof_workers() const { return workers.size(); }
+
+private:
+  friend class pdcp_security_bearer;
+
+  /// Maximum number of PDUs ciphered in one batch
+  static const uint32_t max_batch_size = 32;
+
+  class worker_t : public srsran::thread
+  {
+  public:
+    worker_t(pdcp_security_pool* parent_, uint32_t idx, uint32_t queue_size);
+
+    void stop();
+
+    srsran::dyn_blocking_queue<pdcp_security_job_t> pending_jobs;
+    srsran::task_queue_handle                       done_queue;
+    uint32_t                                        nof_bearers = 0;
+
+    // Jobs processed by the worker, waiting to be returned in the stack thread
+    std::mutex                       done_mutex;
+    std::vector<pdcp_security_job_t> done_jobs;
+
+  private:
+    void run_thread() override;
+
+    pdcp_security_pool* parent;
+  };
+
+  static void process(pdcp_security_job_t* jobs, uint32_t nof_jobs);
+  void        return_done_jobs(worker_t& worker);
+
+  srslog::basic_logger&                  logger;
+  std::vector<std::unique_ptr<worker_t>> workers;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_SECURITY_POOL_H
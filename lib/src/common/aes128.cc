@@ -0,0 +1,487 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/aes128.h"
+#include <algorithm>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AES128_HAVE_X86
+#include <immintrin.h>
+// The AES-NI and VAES code is built for its own target, and only called when the CPU supports it
+#define AESNI_TARGET __attribute__((target("aes,sse4.1")))
+#define VAES_TARGET __attribute__((target("vaes,avx2,aes,sse4.1")))
+#endif // defined(__x86_64__) || defined(__i386__)
+
+namespace srsran {
+
+namespace {
+
+/// Number of CMAC messages whose AES rounds are interleaved by the AES-NI and VAES implementations
+const uint32_t CMAC_NOF_LANES = 4;
+
+/// Header of the 128-EIA2 input message, or first half of the 128-EEA2 counter block. 33.401 Annex B.1.3 and B.2.3
+void security_header(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t* hdr)
+{
+  hdr[0] = (count >> 24) & 0xFF;
+  hdr[1] = (count >> 16) & 0xFF;
+  hdr[2] = (count >> 8) & 0xFF;
+  hdr[3] = count & 0xFF;
+  hdr[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+  hdr[5] = 0;
+  hdr[6] = 0;
+  hdr[7] = 0;
+}
+
+uint32_t cmac_nof_blocks(const security_pdu_t& pdu)
+{
+  return (pdu.msg_len + 8 + 15) / 16;
+}
+
+/// Writes the block idx of the CMAC input, made of the 8-byte header followed by the message. The last block is
+/// padded and masked with the CMAC subkey, as per RFC4493.
+void cmac_block(const uint8_t*        hdr,
+                const security_pdu_t& pdu,
+                uint32_t              idx,
+                const uint8_t*        k1,
+                const uint8_t*        k2,
+                uint8_t*              blk)
+{
+  uint32_t start = idx * 16;
+  uint32_t end   = std::min(start + 16, pdu.msg_len + 8);
+  uint32_t pos   = start;
+
+  memset(blk, 0, 16);
+  for (; pos < 8 and pos < end; ++pos) {
+    blk[pos - start] = hdr[pos];
+  }
+  if (pos < end) {
+    memcpy(&blk[pos - start], &pdu.msg[pos - 8], end - pos);
+  }
+
+  if (idx + 1 == cmac_nof_blocks(pdu)) {
+    const uint8_t* k = k1;
+    if (end - start < 16) {
+      blk[end - start] = 0x80;
+      k                = k2;
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+      blk[i] ^= k[i];
+    }
+  }
+}
+
+/// CMAC subkey derivation, RFC4493 section 2.3
+void cmac_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < 15; ++i) {
+    out[i] = (in[i] << 1) | ((in[i + 1] >> 7) & 0x01);
+  }
+  out[15] = in[15] << 1;
+  if (in[0] & 0x80) {
+    out[15] ^= 0x87;
+  }
+}
+
+#ifdef AES128_HAVE_X86
+
+/// Number of counter blocks ciphered together by the AES-NI and VAES implementations
+const uint32_t AESNI_NOF_BLOCKS = 8;
+const uint32_t VAES_NOF_BLOCKS  = 16;
+
+/// AES-CTR counter block and the message bytes that its keystream ciphers
+struct ctr_block_t {
+  uint64_t       nonce;   // Bytes 0-7 of the counter block
+  uint64_t       counter; // Bytes 8-15 of the counter block, in big-endian order
+  const uint8_t* in;
+  uint8_t*       out;
+  uint32_t       len;
+};
+
+/// Splits a batch of PDUs into counter blocks, and hands them to flush in groups of nof_blocks.
+template <typename Flush>
+void ctr_batch(uint8_t               bearer,
+               uint8_t               direction,
+               const security_pdu_t* pdus,
+               uint32_t              nof_pdus,
+               uint32_t              nof_blocks,
+               const Flush&          flush)
+{
+  ctr_block_t blocks[VAES_NOF_BLOCKS];
+  uint32_t    n = 0;
+
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    uint8_t  hdr[8];
+    uint64_t nonce;
+    security_header(pdus[i].count, bearer, direction, hdr);
+    memcpy(&nonce, hdr, sizeof(nonce));
+
+    uint64_t ctr = 0;
+    for (uint32_t offset = 0; offset < pdus[i].msg_len; offset += 16, ++ctr) {
+      blocks[n++] = {nonce,
+                     __builtin_bswap64(ctr),
+                     &pdus[i].msg[offset],
+                     &pdus[i].out[offset],
+                     std::min(16U, pdus[i].msg_len - offset)};
+      if (n == nof_blocks) {
+        flush(blocks, n);
+        n = 0;
+      }
+    }
+  }
+  if (n > 0) {
+    flush(blocks, n);
+  }
+}
+
+AESNI_TARGET inline __m128i aesni_expand_step(__m128i key, __m128i assist)
+{
+  assist = _mm_shuffle_epi32(assist, 0xff);
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, assist);
+}
+
+AESNI_TARGET void aesni_expand_key(const uint8_t* key, uint8_t* round_keys)
+{
+  __m128i* rk = (__m128i*)round_keys;
+
+  rk[0]  = _mm_loadu_si128((const __m128i*)key);
+  rk[1]  = aesni_expand_step(rk[0], _mm_aeskeygenassist_si128(rk[0], 0x01));
+  rk[2]  = aesni_expand_step(rk[1], _mm_aeskeygenassist_si128(rk[1], 0x02));
+  rk[3]  = aesni_expand_step(rk[2], _mm_aeskeygenassist_si128(rk[2], 0x04));
+  rk[4]  = aesni_expand_step(rk[3], _mm_aeskeygenassist_si128(rk[3], 0x08));
+  rk[5]  = aesni_expand_step(rk[4], _mm_aeskeygenassist_si128(rk[4], 0x10));
+  rk[6]  = aesni_expand_step(rk[5], _mm_aeskeygenassist_si128(rk[5], 0x20));
+  rk[7]  = aesni_expand_step(rk[6], _mm_aeskeygenassist_si128(rk[6], 0x40));
+  rk[8]  = aesni_expand_step(rk[7], _mm_aeskeygenassist_si128(rk[7], 0x80));
+  rk[9]  = aesni_expand_step(rk[8], _mm_aeskeygenassist_si128(rk[8], 0x1b));
+  rk[10] = aesni_expand_step(rk[9], _mm_aeskeygenassist_si128(rk[9], 0x36));
+}
+
+AESNI_TARGET void aesni_encrypt_block(const uint8_t* round_keys, const uint8_t* in, uint8_t* out)
+{
+  const __m128i* rk = (const __m128i*)round_keys;
+
+  __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), rk[0]);
+  for (uint32_t r = 1; r < 10; ++r) {
+    b = _mm_aesenc_si128(b, rk[r]);
+  }
+  _mm_storeu_si128((__m128i*)out, _mm_aesenclast_si128(b, rk[10]));
+}
+
+AESNI_TARGET inline __m128i aesni_counter_block(const ctr_block_t& blk)
+{
+  return _mm_set_epi64x((long long)blk.counter, (long long)blk.nonce);
+}
+
+AESNI_TARGET inline void aesni_ctr_xor(const ctr_block_t& blk, __m128i keystream)
+{
+  if (blk.len == 16) {
+    _mm_storeu_si128((__m128i*)blk.out, _mm_xor_si128(_mm_loadu_si128((const __m128i*)blk.in), keystream));
+    return;
+  }
+  uint8_t ks[16];
+  _mm_storeu_si128((__m128i*)ks, keystream);
+  for (uint32_t i = 0; i < blk.len; ++i) {
+    blk.out[i] = blk.in[i] ^ ks[i];
+  }
+}
+
+AESNI_TARGET void aesni_ctr_flush(const uint8_t* round_keys, const ctr_block_t* blocks, uint32_t n)
+{
+  const __m128i* rk = (const __m128i*)round_keys;
+  __m128i        b[AESNI_NOF_BLOCKS];
+
+  for (uint32_t i = 0; i < n; ++i) {
+    b[i] = _mm_xor_si128(aesni_counter_block(blocks[i]), rk[0]);
+  }
+  for (uint32_t r = 1; r < 10; ++r) {
+    __m128i k = rk[r];
+    for (uint32_t i = 0; i < n; ++i) {
+      b[i] = _mm_aesenc_si128(b[i], k);
+    }
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    aesni_ctr_xor(blocks[i], _mm_aesenclast_si128(b[i], rk[10]));
+  }
+}
+
+/// Ciphers two counter blocks per instruction, using the 256-bit VAES instructions
+VAES_TARGET void vaes_ctr_flush(const uint8_t* round_keys, const ctr_block_t* blocks, uint32_t n)
+{
+  const __m128i* rk      = (const __m128i*)round_keys;
+  uint32_t       nof_ymm = (n + 1) / 2;
+  __m256i        b[VAES_NOF_BLOCKS / 2];
+
+  __m256i k = _mm256_broadcastsi128_si256(rk[0]);
+  for (uint32_t i = 0; i < nof_ymm; ++i) {
+    __m128i lo = aesni_counter_block(blocks[2 * i]);
+    __m128i hi = (2 * i + 1 < n) ? aesni_counter_block(blocks[2 * i + 1]) : lo;
+    b[i]       = _mm256_xor_si256(_mm256_set_m128i(hi, lo), k);
+  }
+  for (uint32_t r = 1; r < 10; ++r) {
+    k = _mm256_broadcastsi128_si256(rk[r]);
+    for (uint32_t i = 0; i < nof_ymm; ++i) {
+      b[i] = _mm256_aesenc_epi128(b[i], k);
+    }
+  }
+  k = _mm256_broadcastsi128_si256(rk[10]);
+  for (uint32_t i = 0; i < nof_ymm; ++i) {
+    b[i] = _mm256_aesenclast_epi128(b[i], k);
+    aesni_ctr_xor(blocks[2 * i], _mm256_castsi256_si128(b[i]));
+    if (2 * i + 1 < n) {
+      aesni_ctr_xor(blocks[2 * i + 1], _mm256_extracti128_si256(b[i], 1));
+    }
+  }
+}
+
+/// CMAC of up to CMAC_NOF_LANES PDUs at a time. Each lane chains the blocks of one PDU, and is refilled with the next
+/// PDU of the batch when done.
+AESNI_TARGET void aesni_eia2_batch(const uint8_t*        round_keys,
+                                   const uint8_t*        k1,
+                                   const uint8_t*        k2,
+                                   uint8_t               bearer,
+                                   uint8_t               direction,
+                                   const security_pdu_t* pdus,
+                                   uint32_t              nof_pdus)
+{
+  struct lane_t {
+    const security_pdu_t* pdu;
+    uint32_t              idx;
+    uint32_t              nof_blocks;
+    uint8_t               hdr[8];
+  };
+  const __m128i* rk = (const __m128i*)round_keys;
+  lane_t         lanes[CMAC_NOF_LANES];
+  __m128i        state[CMAC_NOF_LANES];
+  uint32_t       next_pdu   = 0;
+  uint32_t       nof_active = 0;
+
+  auto start_pdu = [&](uint32_t l) {
+    if (next_pdu == nof_pdus) {
+      lanes[l].pdu = nullptr;
+      return;
+    }
+    lanes[l].pdu        = &pdus[next_pdu++];
+    lanes[l].idx        = 0;
+    lanes[l].nof_blocks = cmac_nof_blocks(*lanes[l].pdu);
+    security_header(lanes[l].pdu->count, bearer, direction, lanes[l].hdr);
+    state[l] = _mm_setzero_si128();
+    nof_active++;
+  };
+  for (uint32_t l = 0; l < CMAC_NOF_LANES; ++l) {
+    start_pdu(l);
+  }
+
+  while (nof_active > 0) {
+    for (uint32_t l = 0; l < CMAC_NOF_LANES; ++l) {
+      if (lanes[l].pdu == nullptr) {
+        continue;
+      }
+      __m128i m;
+      if (lanes[l].idx > 0 and lanes[l].idx + 1 < lanes[l].nof_blocks) {
+        m = _mm_loadu_si128((const __m128i*)&lanes[l].pdu->msg[lanes[l].idx * 16 - 8]);
+      } else {
+        uint8_t blk[16];
+        cmac_block(lanes[l].hdr, *lanes[l].pdu, lanes[l].idx, k1, k2, blk);
+        m = _mm_loadu_si128((const __m128i*)blk);
+      }
+      state[l] = _mm_xor_si128(_mm_xor_si128(state[l], m), rk[0]);
+    }
+    // Idle lanes are ciphered as well, as their state is discarded
+    for (uint32_t r = 1; r < 10; ++r) {
+      for (uint32_t l = 0; l < CMAC_NOF_LANES; ++l) {
+        state[l] = _mm_aesenc_si128(state[l], rk[r]);
+      }
+    }
+    for (uint32_t l = 0; l < CMAC_NOF_LANES; ++l) {
+      state[l] = _mm_aesenclast_si128(state[l], rk[10]);
+      if (lanes[l].pdu == nullptr or ++lanes[l].idx < lanes[l].nof_blocks) {
+        continue;
+      }
+      uint8_t t[16];
+      _mm_storeu_si128((__m128i*)t, state[l]);
+      memcpy(lanes[l].pdu->out, t, 4);
+      nof_active--;
+      start_pdu(l);
+    }
+  }
+}
+
+aes128_engine::impl_t detect_hw_impl()
+{
+  __builtin_cpu_init();
+  if (not __builtin_cpu_supports("aes") or not __builtin_cpu_supports("sse4.1")) {
+    return aes128_engine::impl_t::generic;
+  }
+  if (__builtin_cpu_supports("vaes") and __builtin_cpu_supports("avx2")) {
+    return aes128_engine::impl_t::vaes;
+  }
+  return aes128_engine::impl_t::aesni;
+}
+
+#else // AES128_HAVE_X86
+
+aes128_engine::impl_t detect_hw_impl()
+{
+  return aes128_engine::impl_t::generic;
+}
+
+#endif // AES128_HAVE_X86
+
+} // namespace
+
+aes128_engine::aes128_engine(impl_t impl_) : impl(std::min(impl_, get_hw_impl())) {}
+
+aes128_engine::impl_t aes128_engine::get_hw_impl()
+{
+  static const impl_t hw_impl = detect_hw_impl();
+  return hw_impl;
+}
+
+const char* aes128_engine::get_impl_name(impl_t impl_)
+{
+  switch (impl_) {
+    case impl_t::aesni:
+      return "AES-NI";
+    case impl_t::vaes:
+      return "VAES";
+    default:
+      break;
+  }
+  return "generic";
+}
+
+void aes128_engine::set_key(const uint8_t* key)
+{
+#ifdef AES128_HAVE_X86
+  if (impl != impl_t::generic) {
+    aesni_expand_key(key, round_keys);
+  } else
+#endif // AES128_HAVE_X86
+  {
+    aes_setkey_enc(&sw_ctx, key, 128);
+  }
+
+  // Subkey generation, RFC4493 section 2.3
+  uint8_t zero[16] = {};
+  uint8_t L[16];
+  encrypt_block(zero, L);
+  cmac_subkey(L, k1);
+  cmac_subkey(k1, k2);
+}
+
+void aes128_engine::encrypt_block(const uint8_t* in, uint8_t* out) const
+{
+#ifdef AES128_HAVE_X86
+  if (impl != impl_t::generic) {
+    aesni_encrypt_block(round_keys, in, out);
+    return;
+  }
+#endif // AES128_HAVE_X86
+  // mbedtls does not modify the context when ciphering
+  aes_crypt_ecb(const_cast<aes_context*>(&sw_ctx), AES_ENCRYPT, in, out);
+}
+
+void aes128_engine::eea2(uint32_t       count,
+                         uint8_t        bearer,
+                         uint8_t        direction,
+                         const uint8_t* msg,
+                         uint32_t       msg_len,
+                         uint8_t*       out) const
+{
+  security_pdu_t pdu = {count, msg, msg_len, out};
+  eea2_batch(bearer, direction, &pdu, 1);
+}
+
+void aes128_engine::eia2(uint32_t       count,
+                         uint8_t        bearer,
+                         uint8_t        direction,
+                         const uint8_t* msg,
+                         uint32_t       msg_len,
+                         uint8_t*       mac) const
+{
+  security_pdu_t pdu = {count, msg, msg_len, mac};
+  eia2_batch(bearer, direction, &pdu, 1);
+}
+
+void aes128_engine::eea2_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  switch (impl) {
+#ifdef AES128_HAVE_X86
+    case impl_t::vaes:
+      ctr_batch(bearer, direction, pdus, nof_pdus, VAES_NOF_BLOCKS, [this](const ctr_block_t* blocks, uint32_t n) {
+        vaes_ctr_flush(round_keys, blocks, n);
+      });
+      return;
+    case impl_t::aesni:
+      ctr_batch(bearer, direction, pdus, nof_pdus, AESNI_NOF_BLOCKS, [this](const ctr_block_t* blocks, uint32_t n) {
+        aesni_ctr_flush(round_keys, blocks, n);
+      });
+      return;
+#endif // AES128_HAVE_X86
+    default:
+      break;
+  }
+
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    uint8_t nonce_cnt[16]  = {};
+    uint8_t stream_blk[16] = {};
+    size_t  nc_off         = 0;
+    security_header(pdus[i].count, bearer, direction, nonce_cnt);
+    aes_crypt_ctr(const_cast<aes_context*>(&sw_ctx),
+                  pdus[i].msg_len,
+                  &nc_off,
+                  nonce_cnt,
+                  stream_blk,
+                  pdus[i].msg,
+                  pdus[i].out);
+  }
+}
+
+void aes128_engine::eia2_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+#ifdef AES128_HAVE_X86
+  if (impl != impl_t::generic) {
+    aesni_eia2_batch(round_keys, k1, k2, bearer, direction, pdus, nof_pdus);
+    return;
+  }
+#endif // AES128_HAVE_X86
+
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    uint8_t hdr[8];
+    uint8_t t[16] = {};
+    uint8_t blk[16];
+    security_header(pdus[i].count, bearer, direction, hdr);
+    for (uint32_t idx = 0, nof_blocks = cmac_nof_blocks(pdus[i]); idx < nof_blocks; ++idx) {
+      cmac_block(hdr, pdus[i], idx, k1, k2, blk);
+      for (uint32_t j = 0; j < 16; ++j) {
+        t[j] ^= blk[j];
+      }
+      encrypt_block(t, t);
+    }
+    memcpy(pdus[i].out, t, 4);
+  }
+}
+
+} // namespace srsran
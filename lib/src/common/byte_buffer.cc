@@ -24,25 +24,177 @@
 
 namespace srsran {
 
-void* byte_buffer_t::operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept
+static_assert(byte_buffer_class_pool_size == 0 or byte_buffer_class_pool_size > 16,
+              "The pools of the small and medium byte buffers need more buffers than a thread steals at once");
+
+namespace {
+
+/// Size class of a byte buffer, recorded in the prefix of its pool block
+enum class buffer_size_class_t : uint8_t { small, medium, large };
+
+/// Global pool of a byte buffer size class. The pools of the small and medium classes have
+/// byte_buffer_class_pool_size buffers
+template <typename Pool>
+Pool* get_pool()
 {
-  assert(sz == sizeof(byte_buffer_t));
-  return byte_buffer_pool::get_instance()->allocate_node(sz);
+  return Pool::get_instance(byte_buffer_class_pool_size);
 }
 
-void* byte_buffer_t::operator new(size_t sz)
+template <>
+byte_buffer_pool* get_pool<byte_buffer_pool>()
 {
-  assert(sz == sizeof(byte_buffer_t));
-  void* ptr = byte_buffer_pool::get_instance()->allocate_node(sz);
-  if (ptr == nullptr) {
-    throw std::bad_alloc();
+  return byte_buffer_pool::get_instance();
+}
+
+/// Creates a byte buffer in a block of the pool, followed by its payload of BufferSize bytes
+template <typename Pool, uint32_t BufferSize>
+byte_buffer_t* create_buffer(buffer_size_class_t size_class)
+{
+  static_assert(byte_buffer_block_size(BufferSize) <= Pool::BLOCK_SIZE, "Byte buffer does not fit in the pool block");
+  uint8_t* block = static_cast<uint8_t*>(get_pool<Pool>()->allocate_node(Pool::BLOCK_SIZE));
+  if (block == nullptr) {
+    return nullptr;
   }
-  return ptr;
+  block[0]         = static_cast<uint8_t>(size_class);
+  uint8_t* obj     = block + byte_buffer_block_prefix_size;
+  uint8_t* payload = obj + sizeof(byte_buffer_t);
+  return ::new (obj) byte_buffer_t(payload, BufferSize);
+}
+
+template <typename Pool>
+void read_pool_metrics(byte_buffer_pool_metrics_t& metrics, uint32_t buffer_size)
+{
+  typename Pool::occupancy_t occupancy = get_pool<Pool>()->read_occupancy();
+  metrics.buffer_size                  = buffer_size;
+  metrics.nof_buffers                  = occupancy.nof_blocks;
+  metrics.nof_used_buffers             = occupancy.nof_used_blocks;
+  metrics.max_used_buffers             = occupancy.max_used_blocks;
+  metrics.nof_failures                 = occupancy.nof_failures;
 }
 
+} // namespace
+
 void byte_buffer_t::operator delete(void* ptr)
 {
-  byte_buffer_pool::get_instance()->deallocate_node(ptr);
+  if (ptr == nullptr) {
+    return;
+  }
+  uint8_t* block = static_cast<uint8_t*>(ptr) - byte_buffer_block_prefix_size;
+  switch (static_cast<buffer_size_class_t>(block[0])) {
+    case buffer_size_class_t::small:
+      get_pool<small_byte_buffer_pool>()->deallocate_node(block);
+      break;
+    case buffer_size_class_t::medium:
+      get_pool<medium_byte_buffer_pool>()->deallocate_node(block);
+      break;
+    default:
+      byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+  }
+}
+
+unique_byte_buffer_t make_byte_buffer() noexcept
+{
+  return unique_byte_buffer_t(
+      create_buffer<byte_buffer_pool, SRSRAN_MAX_BUFFER_SIZE_BYTES>(buffer_size_class_t::large));
+}
+
+unique_byte_buffer_t make_byte_buffer_with_tailroom(uint32_t tailroom) noexcept
+{
+  uint32_t       buffer_size = SRSRAN_BUFFER_HEADER_OFFSET + tailroom;
+  byte_buffer_t* buf         = nullptr;
+  if (byte_buffer_class_pool_size > 0) {
+    if (buffer_size <= byte_buffer_t::small_buffer_size) {
+      buf = create_buffer<small_byte_buffer_pool, byte_buffer_t::small_buffer_size>(buffer_size_class_t::small);
+    }
+    if (buf == nullptr and buffer_size <= byte_buffer_t::medium_buffer_size) {
+      buf = create_buffer<medium_byte_buffer_pool, byte_buffer_t::medium_buffer_size>(buffer_size_class_t::medium);
+    }
+  }
+  if (buf == nullptr) {
+    return make_byte_buffer();
+  }
+  return unique_byte_buffer_t(buf);
+}
+
+unique_byte_buffer_t make_rx_byte_buffer() noexcept
+{
+  return make_byte_buffer_with_tailroom(byte_buffer_t::medium_buffer_size - SRSRAN_BUFFER_HEADER_OFFSET);
+}
+
+uint32_t get_rx_byte_buffer_capacity(const byte_buffer_t& buf)
+{
+  uint32_t room = buf.buffer_size - (buf.msg - buf.buffer);
+  // the large byte buffers are not merged any further, so they receive packets up to their whole room
+  return buf.buffer_size < SRSRAN_MAX_BUFFER_SIZE_BYTES ? room - rx_byte_buffer_spare_tailroom : room;
+}
+
+bool merge_rx_byte_buffer_overflow(unique_byte_buffer_t& buf, const uint8_t* overflow) noexcept
+{
+  uint32_t capacity = get_rx_byte_buffer_capacity(*buf);
+  if (buf->N_bytes <= capacity) {
+    return true;
+  }
+  unique_byte_buffer_t merged = make_byte_buffer();
+  if (merged == nullptr) {
+    return false;
+  }
+  merged->N_bytes = buf->N_bytes;
+  merged->md      = buf->md;
+  memcpy(merged->msg, buf->msg, capacity);
+  memcpy(merged->msg + capacity, overflow, buf->N_bytes - capacity);
+  buf = std::move(merged);
+  return true;
+}
+
+const uint32_t byte_buffer_chain::nof_inline_slices;
+
+uint32_t byte_buffer_chain::copy_to(uint8_t* dst, uint32_t offset, uint32_t len) const
+{
+  uint32_t nof_copied = 0;
+  for (uint32_t i = 0; i < nof_slices and nof_copied < len; ++i) {
+    const byte_buffer_slice& s = slice(i);
+    if (offset >= s.size()) {
+      offset -= s.size();
+      continue;
+    }
+    uint32_t n = std::min(s.size() - offset, len - nof_copied);
+    memcpy(dst + nof_copied, s.data() + offset, n);
+    nof_copied += n;
+    offset = 0;
+  }
+  return nof_copied;
+}
+
+unique_byte_buffer_t byte_buffer_chain::gather()
+{
+  unique_byte_buffer_t buf;
+  if (nof_slices == 1) {
+    buf = inline_slices[0].try_release();
+  }
+  if (buf == nullptr) {
+    buf = make_byte_buffer_with_tailroom(nof_bytes);
+    if (buf != nullptr and buf->get_tailroom() >= nof_bytes) {
+      if (nof_slices > 0) {
+        buf->md = inline_slices[0].metadata();
+      }
+      buf->N_bytes = copy_to(buf->msg);
+    } else {
+      buf = nullptr;
+    }
+  }
+  clear();
+  return buf;
+}
+
+void get_byte_buffer_pools_metrics(byte_buffer_pools_metrics_t& metrics)
+{
+  metrics = {};
+  if (byte_buffer_class_pool_size > 0) {
+    read_pool_metrics<small_byte_buffer_pool>(metrics.small, byte_buffer_t::small_buffer_size);
+    read_pool_metrics<medium_byte_buffer_pool>(metrics.medium, byte_buffer_t::medium_buffer_size);
+  }
+  read_pool_metrics<byte_buffer_pool>(metrics.large, SRSRAN_MAX_BUFFER_SIZE_BYTES);
 }
 
 } // namespace srsran
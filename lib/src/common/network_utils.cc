@@ -21,6 +21,7 @@
 
 #include "srsran/common/network_utils.h"
 
+#include <algorithm>
 #include <netinet/sctp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -649,28 +650,60 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 }
 
 /**
- * Description: Functor for the case the received data is
- * in the form of unique_byte_buffer, and a recvfrom(...) call is used
+ * Description: Functor for the case the received data is in the form of unique_byte_buffer, and a recvmmsg(...) call
+ * is used to receive all the datagrams waiting in the socket. The buffers are allocated ahead of the reception, and the
+ * ones that are not filled are kept for the next call
  */
 class recvfrom_pdu_task
 {
 public:
   using callback_t = recvfrom_callback_t;
-  explicit recvfrom_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
-    logger(logger), queue(queue_), func(std::move(func_))
+
+  static const uint32_t max_batch_size = 32;
+
+  explicit recvfrom_pdu_task(srslog::basic_logger&      logger,
+                             srsran::task_queue_handle& queue_,
+                             callback_t                 func_,
+                             socket_batch_counter*      rx_batches_) :
+    logger(logger),
+    queue(queue_),
+    func(std::move(func_)),
+    rx_batches(rx_batches_)
   {}
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    std::array<mmsghdr, max_batch_size>              msgs;
+    std::array<std::array<iovec, 2>, max_batch_size> iovs;
+    std::array<sockaddr_in, max_batch_size>          froms;
+    uint8_t*                                         overflows = get_thread_overflows();
+    uint32_t                                         nof_bufs  = 0;
+    for (; nof_bufs < max_batch_size; ++nof_bufs) {
+      if (pdus[nof_bufs] == nullptr) {
+        pdus[nof_bufs] = srsran::make_rx_byte_buffer();
+        if (pdus[nof_bufs] == nullptr) {
+          break;
+        }
+      }
+      // The datagram is received in the byte buffer, and the bytes that do not fit in it in the overflow area
+      uint32_t capacity          = srsran::get_rx_byte_buffer_capacity(*pdus[nof_bufs]);
+      mmsghdr& msg               = msgs[nof_bufs];
+      iovs[nof_bufs][0].iov_base = pdus[nof_bufs]->msg;
+      iovs[nof_bufs][0].iov_len  = capacity;
+      iovs[nof_bufs][1].iov_base = overflows + nof_bufs * srsran::rx_byte_buffer_overflow_size;
+      iovs[nof_bufs][1].iov_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - capacity;
+      msg                        = {};
+      msg.msg_hdr.msg_iov        = iovs[nof_bufs].data();
+      msg.msg_hdr.msg_iovlen     = iovs[nof_bufs][1].iov_len > 0 ? 2 : 1;
+      msg.msg_hdr.msg_name       = &froms[nof_bufs];
+      msg.msg_hdr.msg_namelen    = sizeof(sockaddr_in);
+    }
+    if (nof_bufs == 0) {
       logger.error("Unable to allocate byte buffer");
       return true;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
@@ -679,26 +712,115 @@ public:
       logger.debug("Socket timeout reached");
       return true;
     }
+    if (rx_batches != nullptr) {
+      rx_batches->add_batch(n_recv);
+    }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      srsran::unique_byte_buffer_t pdu = std::move(pdus[i]);
+      pdu->N_bytes                     = msgs[i].msg_len;
+      if (not srsran::merge_rx_byte_buffer_overflow(pdu, overflows + i * srsran::rx_byte_buffer_overflow_size)) {
+        logger.error("Unable to allocate byte buffer for a datagram of %d bytes", pdu->N_bytes);
+        continue;
+      }
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+      // Defer handling of received packet to provided queue
+      const sockaddr_in& from = froms[i];
+      queue.push(
+          std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    }
 
+    // Keep the unused buffers in front, to fill them first in the next call
+    std::rotate(pdus.begin(), pdus.begin() + n_recv, pdus.end());
     return true;
   }
 
 private:
-  srslog::basic_logger&      logger;
-  srsran::task_queue_handle& queue;
-  callback_t                 func;
+  /// Overflow areas of the byte buffers of a batch. The overflows are merged before the call returns, so all the
+  /// sockets read by a thread share the same areas
+  static uint8_t* get_thread_overflows()
+  {
+    thread_local std::vector<uint8_t> overflows(max_batch_size * srsran::rx_byte_buffer_overflow_size);
+    return overflows.data();
+  }
+
+  srslog::basic_logger&                                    logger;
+  srsran::task_queue_handle&                               queue;
+  callback_t                                               func;
+  socket_batch_counter*                                    rx_batches;
+  std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
 };
 
-socket_manager_itf::recv_callback_t
-make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback)
+socket_manager_itf::recv_callback_t make_sdu_handler(srslog::basic_logger&      logger,
+                                                     srsran::task_queue_handle& queue,
+                                                     recvfrom_callback_t        rx_callback,
+                                                     socket_batch_counter*      rx_batches)
 {
-  return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
+  return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback), rx_batches));
+}
+
+/***************************************************************
+ *                 Batched socket I/O
+ **************************************************************/
+
+void socket_batch_counter::add_batch(uint32_t nof_packets_)
+{
+  nof_calls.fetch_add(1, std::memory_order_relaxed);
+  nof_packets.fetch_add(nof_packets_, std::memory_order_relaxed);
+  uint32_t max = max_batch.load(std::memory_order_relaxed);
+  while (nof_packets_ > max and not max_batch.compare_exchange_weak(max, nof_packets_, std::memory_order_relaxed)) {
+  }
+}
+
+void socket_batch_counter::get_metrics(socket_batch_metrics_t& metrics)
+{
+  metrics.nof_calls   = nof_calls.load(std::memory_order_relaxed);
+  metrics.nof_packets = nof_packets.load(std::memory_order_relaxed);
+  metrics.max_batch   = max_batch.exchange(0, std::memory_order_relaxed);
+}
+
+void udp_batch_sender::push(srsran::unique_byte_buffer_t pdu, const sockaddr_in& dest)
+{
+  pdus[nof_pending]  = std::move(pdu);
+  dests[nof_pending] = dest;
+  nof_pending++;
+  if (nof_pending == max_batch_size) {
+    flush();
+  }
+}
+
+void udp_batch_sender::flush()
+{
+  std::array<mmsghdr, max_batch_size> msgs;
+  std::array<iovec, max_batch_size>   iovs;
+  for (uint32_t i = 0; i < nof_pending; ++i) {
+    mmsghdr& msg            = msgs[i];
+    iovs[i].iov_base        = pdus[i]->msg;
+    iovs[i].iov_len         = pdus[i]->N_bytes;
+    msg                     = {};
+    msg.msg_hdr.msg_iov     = &iovs[i];
+    msg.msg_hdr.msg_iovlen  = 1;
+    msg.msg_hdr.msg_name    = &dests[i];
+    msg.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+  }
+
+  // sendmmsg(...) stops at the first datagram that fails, which is dropped
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_pending) {
+    int ret = sendmmsg(fd, &msgs[nof_sent], nof_pending - nof_sent, 0);
+    if (ret < 0) {
+      logger.error("Error sending datagram to %s: %s", net_utils::get_ip(dests[nof_sent]).c_str(), strerror(errno));
+      ret = 1;
+    } else {
+      counter.add_batch(ret);
+    }
+    nof_sent += ret;
+  }
+
+  for (uint32_t i = 0; i < nof_pending; ++i) {
+    pdus[i].reset();
+  }
+  nof_pending = 0;
 }
 
 } // namespace srsran
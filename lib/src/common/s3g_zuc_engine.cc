@@ -0,0 +1,902 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/s3g_zuc_engine.h"
+#include "srsran/common/s3g.h"
+#include "srsran/common/zuc.h"
+#include "srsran/phy/utils/simd.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+namespace {
+
+/// Number of keystream words of each lane generated between two passes over the PDUs
+const uint32_t CHUNK_NOF_WORDS = 64;
+/// Maximum number of lanes of any build
+const uint32_t MAX_NOF_LANES = 16;
+
+/// Operations on the 32-bit words of a single stream
+struct scalar_lanes {
+  using vec_t                     = uint32_t;
+  static const uint32_t nof_lanes = 1;
+
+  static vec_t load(const uint32_t* x) { return *x; }
+  static void  store(uint32_t* x, vec_t a) { *x = a; }
+  static vec_t set1(uint32_t x) { return x; }
+  static vec_t add(vec_t a, vec_t b) { return a + b; }
+  static vec_t bit_and(vec_t a, vec_t b) { return a & b; }
+  static vec_t bit_or(vec_t a, vec_t b) { return a | b; }
+  static vec_t bit_xor(vec_t a, vec_t b) { return a ^ b; }
+  template <int n>
+  static vec_t sll(vec_t a)
+  {
+    return a << n;
+  }
+  template <int n>
+  static vec_t srl(vec_t a)
+  {
+    return a >> n;
+  }
+  static vec_t lookup(const uint32_t* table, vec_t idx) { return table[idx]; }
+};
+
+#if SRSRAN_SIMD_I_SIZE
+/// Operations on the 32-bit words of SRSRAN_SIMD_I_SIZE streams, one per SIMD lane
+struct simd_lanes {
+  using vec_t                     = simd_i_t;
+  static const uint32_t nof_lanes = SRSRAN_SIMD_I_SIZE;
+
+  static vec_t load(const uint32_t* x) { return srsran_simd_i_load((int*)x); }
+  static void  store(uint32_t* x, vec_t a) { srsran_simd_i_store((int*)x, a); }
+  static vec_t set1(uint32_t x) { return srsran_simd_i_set1((int)x); }
+  static vec_t add(vec_t a, vec_t b) { return srsran_simd_i_add(a, b); }
+  static vec_t bit_and(vec_t a, vec_t b) { return srsran_simd_i_and(a, b); }
+  static vec_t bit_or(vec_t a, vec_t b) { return srsran_simd_i_or(a, b); }
+  static vec_t bit_xor(vec_t a, vec_t b) { return srsran_simd_i_xor(a, b); }
+  template <int n>
+  static vec_t sll(vec_t a)
+  {
+    return srsran_simd_i_sll(a, n);
+  }
+  template <int n>
+  static vec_t srl(vec_t a)
+  {
+    return srsran_simd_i_srl(a, n);
+  }
+  static vec_t lookup(const uint32_t* table, vec_t idx) { return srsran_simd_i_gather((const int*)table, idx); }
+};
+using batch_lanes = simd_lanes;
+#else  // SRSRAN_SIMD_I_SIZE
+using batch_lanes = scalar_lanes;
+#endif // SRSRAN_SIMD_I_SIZE
+
+static_assert(batch_lanes::nof_lanes <= MAX_NOF_LANES, "Too many lanes for the per-lane state of the MAC operations");
+
+template <typename Lanes, int n>
+typename Lanes::vec_t rotl(typename Lanes::vec_t a)
+{
+  return Lanes::bit_or(Lanes::template sll<n>(a), Lanes::template srl<32 - n>(a));
+}
+
+/// Substitution of the 4 bytes of w, with one lookup table per byte position, most significant byte first
+template <typename Lanes>
+typename Lanes::vec_t sbox_lookup(const uint32_t (&table)[4][256], typename Lanes::vec_t w)
+{
+  typename Lanes::vec_t byte_mask = Lanes::set1(0xFF);
+
+  typename Lanes::vec_t r = Lanes::lookup(table[0], Lanes::template srl<24>(w));
+  r = Lanes::bit_xor(r, Lanes::lookup(table[1], Lanes::bit_and(Lanes::template srl<16>(w), byte_mask)));
+  r = Lanes::bit_xor(r, Lanes::lookup(table[2], Lanes::bit_and(Lanes::template srl<8>(w), byte_mask)));
+  return Lanes::bit_xor(r, Lanes::lookup(table[3], Lanes::bit_and(w, byte_mask)));
+}
+
+uint32_t get_be32(const uint8_t* p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+void put_be32(uint32_t w, uint8_t* p)
+{
+  p[0] = (w >> 24) & 0xFF;
+  p[1] = (w >> 16) & 0xFF;
+  p[2] = (w >> 8) & 0xFF;
+  p[3] = w & 0xFF;
+}
+
+/*******************************************************************************
+ * SNOW 3G
+ ******************************************************************************/
+
+/// SNOW 3G round functions as lookup tables: S1 and S2 split by input byte, and the multiplication and division by
+/// alpha of the LFSR feedback.
+struct s3g_tables_t {
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+
+  s3g_tables_t()
+  {
+    // S1 and S2 mix the substitutions of the 4 bytes linearly, so a word is the XOR of the outputs for each of its
+    // bytes alone, once the contribution of the other three (zero) bytes is removed from all but one of them
+    uint32_t s1_zero = s3g_s1(0);
+    uint32_t s2_zero = s3g_s2(0);
+    for (uint32_t x = 0; x < 256; ++x) {
+      for (uint32_t b = 0; b < 4; ++b) {
+        s1[b][x] = s3g_s1(x << (24 - 8 * b)) ^ (b > 0 ? s1_zero : 0);
+        s2[b][x] = s3g_s2(x << (24 - 8 * b)) ^ (b > 0 ? s2_zero : 0);
+      }
+      mul_alpha[x] = s3g_mul_alpha(x);
+      div_alpha[x] = s3g_div_alpha(x);
+    }
+  }
+};
+
+const s3g_tables_t& get_s3g_tables()
+{
+  static const s3g_tables_t tables;
+  return tables;
+}
+
+struct s3g_iv_t {
+  uint32_t w[4];
+};
+
+/// SNOW 3G keystream generator for Lanes::nof_lanes streams with the same key and different IVs.
+/// See "Specification of the 3GPP Confidentiality and Integrity Algorithms UEA2 & UIA2, Document 2", section 4.
+template <typename Lanes>
+class s3g_stream
+{
+  using vec_t = typename Lanes::vec_t;
+
+  struct state_t {
+    vec_t lfsr[16];
+    vec_t r1, r2, r3;
+  };
+
+public:
+  static const uint32_t N = Lanes::nof_lanes;
+  using key_t             = const uint32_t*;
+  using iv_t              = s3g_iv_t;
+
+  s3g_stream(key_t k, const iv_t* ivs) : tables(get_s3g_tables())
+  {
+    alignas(64) uint32_t words[16][N];
+    for (uint32_t l = 0; l < N; ++l) {
+      const uint32_t* iv = ivs[l].w;
+      for (uint32_t i = 0; i < 4; ++i) {
+        words[i][l]      = k[i] ^ 0xffffffff;
+        words[i + 4][l]  = k[i];
+        words[i + 8][l]  = k[i] ^ 0xffffffff;
+        words[i + 12][l] = k[i];
+      }
+      words[15][l] ^= iv[0];
+      words[12][l] ^= iv[1];
+      words[10][l] ^= iv[2];
+      words[9][l] ^= iv[3];
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+      state.lfsr[i] = Lanes::load(words[i]);
+    }
+    state.r1 = state.r2 = state.r3 = Lanes::set1(0);
+
+    // Initialization mode, 32 clocks
+    init_block(state, make_clock_sequence());
+    init_block(state, make_clock_sequence());
+    // First keystream mode clock, whose output is discarded
+    clock_fsm(state, 0);
+    clock_lfsr(state, 0, Lanes::set1(0));
+    pos = 1;
+  }
+
+  /// Writes nof_words keystream words of each lane into ks, with the words of all lanes for a clock next to each
+  /// other (ks[word * N + lane]).
+  void keystream(uint32_t* ks, uint32_t nof_words)
+  {
+    // The state is worked on in a local copy, with the LFSR ring starting at s_0, so that it can stay in registers
+    state_t st = state;
+    for (uint32_t i = 0; i < 16; ++i) {
+      st.lfsr[i] = state.lfsr[(pos + i) & 15];
+    }
+
+    uint32_t i = 0;
+    for (; i + 16 <= nof_words; i += 16) {
+      keystream_block(st, &ks[i * N], make_clock_sequence());
+    }
+    for (uint32_t p = 0; i < nof_words; ++i, ++p) {
+      keystream_clock(st, p, &ks[i * N]);
+    }
+
+    state = st;
+    pos   = nof_words % 16;
+  }
+
+private:
+  /// The LFSR registers are stored in a ring to avoid shifting them at every clock: at clock p of a block of 16
+  /// clocks, s_i is stored at (p + i) % 16, and the ring is back at its start at the end of the block.
+  static vec_t& s(state_t& st, uint32_t p, uint32_t i) { return st.lfsr[(p + i) & 15]; }
+
+  static std::make_index_sequence<16> make_clock_sequence() { return {}; }
+
+  vec_t clock_fsm(state_t& st, uint32_t p) const
+  {
+    vec_t f = Lanes::bit_xor(Lanes::add(s(st, p, 15), st.r1), st.r2);
+    vec_t r = Lanes::add(st.r2, Lanes::bit_xor(st.r3, s(st, p, 5)));
+    st.r3   = sbox_lookup<Lanes>(tables.s2, st.r2);
+    st.r2   = sbox_lookup<Lanes>(tables.s1, st.r1);
+    st.r1   = r;
+    return f;
+  }
+
+  void clock_lfsr(state_t& st, uint32_t p, vec_t f) const
+  {
+    vec_t s0  = s(st, p, 0);
+    vec_t s11 = s(st, p, 11);
+    vec_t v   = Lanes::bit_xor(Lanes::template sll<8>(s0), Lanes::lookup(tables.mul_alpha, Lanes::template srl<24>(s0)));
+    v         = Lanes::bit_xor(v, s(st, p, 2));
+    v         = Lanes::bit_xor(v, Lanes::template srl<8>(s11));
+    v         = Lanes::bit_xor(v, Lanes::lookup(tables.div_alpha, Lanes::bit_and(s11, Lanes::set1(0xFF))));
+    s(st, p, 0) = Lanes::bit_xor(v, f);
+  }
+
+  void init_clock(state_t& st, uint32_t p) const { clock_lfsr(st, p, clock_fsm(st, p)); }
+
+  void keystream_clock(state_t& st, uint32_t p, uint32_t* ks) const
+  {
+    vec_t f = clock_fsm(st, p);
+    Lanes::store(ks, Lanes::bit_xor(f, s(st, p, 0)));
+    clock_lfsr(st, p, Lanes::set1(0));
+  }
+
+  /// Blocks of 16 clocks, unrolled so that the positions of the LFSR registers are known at compile time
+  template <std::size_t... p>
+  void init_block(state_t& st, std::index_sequence<p...>) const
+  {
+    int expand[] = {(init_clock(st, p), 0)...};
+    (void)expand;
+  }
+
+  template <std::size_t... p>
+  void keystream_block(state_t& st, uint32_t* ks, std::index_sequence<p...>) const
+  {
+    int expand[] = {(keystream_clock(st, p, &ks[p * N]), 0)...};
+    (void)expand;
+  }
+
+  const s3g_tables_t& tables;
+  state_t             state;
+  uint32_t            pos = 0;
+};
+
+/// Multiplication by a fixed element p of GF(2^64), MUL64 of UIA2 section 4.3.4, using the products of p with each
+/// value of each 4-bit digit of the other operand.
+class gf64_multiplier
+{
+public:
+  explicit gf64_multiplier(uint64_t p)
+  {
+    for (uint32_t j = 0; j < 16; ++j) {
+      uint64_t p_xi[4];
+      for (uint32_t b = 0; b < 4; ++b) {
+        p_xi[b] = p;
+        p       = mul_x(p);
+      }
+      table[j][0] = 0;
+      for (uint32_t d = 1; d < 16; ++d) {
+        table[j][d] = table[j][d & (d - 1)] ^ p_xi[__builtin_ctz(d)];
+      }
+    }
+  }
+
+  uint64_t mul(uint64_t v) const
+  {
+    uint64_t r = 0;
+    for (uint32_t j = 0; j < 16; ++j) {
+      r ^= table[j][(v >> (4 * j)) & 0xF];
+    }
+    return r;
+  }
+
+  static uint64_t mul_x(uint64_t v) { return (v << 1) ^ ((0 - (v >> 63)) & 0x1b); }
+
+  static uint64_t mul(uint64_t v, uint64_t p)
+  {
+    uint64_t r = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+      r ^= v & (0 - ((p >> i) & 1));
+      v = mul_x(v);
+    }
+    return r;
+  }
+
+private:
+  uint64_t table[16][16];
+};
+
+/// 128-EEA1 and 128-EEA3: the message is XORed with the keystream
+struct cipher_op {
+  static uint32_t nof_words(const security_pdu_t& pdu) { return (pdu.msg_len + 3) / 4; }
+
+  static void process(uint32_t              lane,
+                      const security_pdu_t& pdu,
+                      uint32_t              first_word,
+                      uint32_t              nof_words,
+                      const uint32_t*       ks,
+                      uint32_t              stride)
+  {
+    for (uint32_t i = 0; i < nof_words; ++i) {
+      uint32_t pos = (first_word + i) * 4;
+      if (pos >= pdu.msg_len) {
+        break;
+      }
+      uint32_t k = ks[i * stride];
+      uint32_t n = std::min(4U, pdu.msg_len - pos);
+      for (uint32_t b = 0; b < n; ++b) {
+        pdu.out[pos + b] = pdu.msg[pos + b] ^ ((k >> (24 - 8 * b)) & 0xFF);
+      }
+    }
+  }
+};
+
+/// 128-EEA1, 33.401 Annex B.1.2
+struct eea1_op : public cipher_op {
+  uint8_t bearer;
+  uint8_t direction;
+
+  eea1_op(uint8_t bearer_, uint8_t direction_) : bearer(bearer_), direction(direction_) {}
+
+  void make_iv(const security_pdu_t& pdu, s3g_iv_t& iv) const
+  {
+    iv.w[3] = pdu.count;
+    iv.w[2] = ((bearer & 0x1F) << 27) | ((direction & 0x01) << 26);
+    iv.w[1] = iv.w[3];
+    iv.w[0] = iv.w[2];
+  }
+};
+
+/// 128-EIA1, 33.401 Annex B.2.2. The MAC is computed from the first 5 words of the keystream, see UIA2 section 4.
+struct eia1_op {
+  uint8_t bearer;
+  uint8_t direction;
+
+  eia1_op(uint8_t bearer_, uint8_t direction_) : bearer(bearer_), direction(direction_) {}
+
+  void make_iv(const security_pdu_t& pdu, s3g_iv_t& iv) const
+  {
+    uint32_t fresh = (uint32_t)(bearer & 0x1F) << 27;
+    uint32_t dir   = direction & 0x01;
+    iv.w[3]        = pdu.count;
+    iv.w[2]        = fresh;
+    iv.w[1]        = pdu.count ^ (dir << 31);
+    iv.w[0]        = fresh ^ (dir << 15);
+  }
+
+  static uint32_t nof_words(const security_pdu_t& pdu) { return 5; }
+
+  static void process(uint32_t              lane,
+                      const security_pdu_t& pdu,
+                      uint32_t              first_word,
+                      uint32_t              nof_words,
+                      const uint32_t*       ks,
+                      uint32_t              stride)
+  {
+    if (first_word != 0) {
+      return;
+    }
+    uint64_t        p = ((uint64_t)ks[0] << 32) | ks[stride];
+    uint64_t        q = ((uint64_t)ks[2 * stride] << 32) | ks[3 * stride];
+    gf64_multiplier p_mul(p);
+
+    // Horner evaluation of the message, in 64-bit blocks, with the last block padded with zeros
+    uint64_t eval = 0;
+    for (uint32_t pos = 0; pos < pdu.msg_len; pos += 8) {
+      uint64_t m = 0;
+      uint32_t n = std::min(8U, pdu.msg_len - pos);
+      for (uint32_t b = 0; b < n; ++b) {
+        m |= (uint64_t)pdu.msg[pos + b] << (56 - 8 * b);
+      }
+      eval = p_mul.mul(eval ^ m);
+    }
+    eval ^= (uint64_t)pdu.msg_len * 8;
+    eval = gf64_multiplier::mul(eval, q);
+
+    put_be32((uint32_t)(eval >> 32) ^ ks[4 * stride], pdu.out);
+  }
+};
+
+/*******************************************************************************
+ * ZUC
+ ******************************************************************************/
+
+/// S-box layer of the ZUC F function, as a lookup table per byte that places the substituted byte in its position
+struct zuc_tables_t {
+  uint32_t sbox[4][256];
+
+  zuc_tables_t()
+  {
+    for (uint32_t x = 0; x < 256; ++x) {
+      for (uint32_t b = 0; b < 4; ++b) {
+        sbox[b][x] = zuc_sbox(x << (24 - 8 * b)) & (0xFF000000 >> (8 * b));
+      }
+    }
+  }
+};
+
+const zuc_tables_t& get_zuc_tables()
+{
+  static const zuc_tables_t tables;
+  return tables;
+}
+
+/// Constants D of the key loading
+const uint32_t zuc_d[16] = {0x44D7,
+                            0x26BC,
+                            0x626B,
+                            0x135E,
+                            0x5789,
+                            0x35E2,
+                            0x7135,
+                            0x09AF,
+                            0x4D78,
+                            0x2F13,
+                            0x6BC4,
+                            0x1AF1,
+                            0x5E26,
+                            0x3C4D,
+                            0x789A,
+                            0x47AC};
+
+struct zuc_iv_t {
+  uint8_t b[16];
+};
+
+/// ZUC keystream generator for Lanes::nof_lanes streams with the same key and different IVs.
+/// See "Specification of the 3GPP Confidentiality and Integrity Algorithms 128-EEA3 & 128-EIA3, Document 2", section 3.
+template <typename Lanes>
+class zuc_stream
+{
+  using vec_t = typename Lanes::vec_t;
+
+  struct state_t {
+    vec_t lfsr[16];
+    vec_t r1, r2;
+  };
+
+  /// Output of the bit reorganization
+  struct brc_t {
+    vec_t x0, x1, x2, x3;
+  };
+
+public:
+  static const uint32_t N = Lanes::nof_lanes;
+  using key_t             = const uint8_t*;
+  using iv_t              = zuc_iv_t;
+
+  zuc_stream(key_t key, const iv_t* ivs) : tables(get_zuc_tables())
+  {
+    alignas(64) uint32_t words[16][N];
+    for (uint32_t l = 0; l < N; ++l) {
+      for (uint32_t i = 0; i < 16; ++i) {
+        words[i][l] = ((uint32_t)key[i] << 23) | (zuc_d[i] << 8) | ivs[l].b[i];
+      }
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+      state.lfsr[i] = Lanes::load(words[i]);
+    }
+    state.r1 = state.r2 = Lanes::set1(0);
+
+    // Initialization mode, 32 clocks
+    init_block(state, make_clock_sequence());
+    init_block(state, make_clock_sequence());
+    // First working mode clock, whose output is discarded
+    brc_t x = bit_reorganization(state, 0);
+    f(state, x);
+    s(state, 0, 0) = lfsr_feedback(state, 0);
+    pos            = 1;
+  }
+
+  /// Writes nof_words keystream words of each lane into ks, with the words of all lanes for a clock next to each
+  /// other (ks[word * N + lane]).
+  void keystream(uint32_t* ks, uint32_t nof_words)
+  {
+    // The state is worked on in a local copy, with the LFSR ring starting at s_0, so that it can stay in registers
+    state_t st = state;
+    for (uint32_t i = 0; i < 16; ++i) {
+      st.lfsr[i] = state.lfsr[(pos + i) & 15];
+    }
+
+    uint32_t i = 0;
+    for (; i + 16 <= nof_words; i += 16) {
+      keystream_block(st, &ks[i * N], make_clock_sequence());
+    }
+    for (uint32_t p = 0; i < nof_words; ++i, ++p) {
+      keystream_clock(st, p, &ks[i * N]);
+    }
+
+    state = st;
+    pos   = nof_words % 16;
+  }
+
+private:
+  /// The LFSR registers are stored in a ring to avoid shifting them at every clock: at clock p of a block of 16
+  /// clocks, s_i is stored at (p + i) % 16, and the ring is back at its start at the end of the block.
+  static vec_t& s(state_t& st, uint32_t p, uint32_t i) { return st.lfsr[(p + i) & 15]; }
+
+  static std::make_index_sequence<16> make_clock_sequence() { return {}; }
+
+  /// Addition modulo 2^31 - 1
+  static vec_t add_mod(vec_t a, vec_t b)
+  {
+    vec_t c = Lanes::add(a, b);
+    return Lanes::add(Lanes::bit_and(c, Lanes::set1(0x7FFFFFFF)), Lanes::template srl<31>(c));
+  }
+
+  /// Multiplication by 2^k modulo 2^31 - 1
+  template <int k>
+  static vec_t mul_pow2(vec_t x)
+  {
+    return Lanes::bit_and(Lanes::bit_or(Lanes::template sll<k>(x), Lanes::template srl<31 - k>(x)),
+                          Lanes::set1(0x7FFFFFFF));
+  }
+
+  static vec_t lfsr_feedback(state_t& st, uint32_t p)
+  {
+    vec_t v = add_mod(s(st, p, 0), mul_pow2<8>(s(st, p, 0)));
+    v       = add_mod(v, mul_pow2<20>(s(st, p, 4)));
+    v       = add_mod(v, mul_pow2<21>(s(st, p, 10)));
+    v       = add_mod(v, mul_pow2<17>(s(st, p, 13)));
+    return add_mod(v, mul_pow2<15>(s(st, p, 15)));
+  }
+
+  static brc_t bit_reorganization(state_t& st, uint32_t p)
+  {
+    brc_t x;
+    x.x0 = Lanes::bit_or(Lanes::template sll<1>(Lanes::bit_and(s(st, p, 15), Lanes::set1(0x7FFF8000))),
+                         Lanes::bit_and(s(st, p, 14), Lanes::set1(0xFFFF)));
+    x.x1 = Lanes::bit_or(Lanes::template sll<16>(s(st, p, 11)), Lanes::template srl<15>(s(st, p, 9)));
+    x.x2 = Lanes::bit_or(Lanes::template sll<16>(s(st, p, 7)), Lanes::template srl<15>(s(st, p, 5)));
+    x.x3 = Lanes::bit_or(Lanes::template sll<16>(s(st, p, 2)), Lanes::template srl<15>(s(st, p, 0)));
+    return x;
+  }
+
+  static vec_t l1(vec_t x)
+  {
+    vec_t r = Lanes::bit_xor(x, rotl<Lanes, 2>(x));
+    r       = Lanes::bit_xor(r, rotl<Lanes, 10>(x));
+    r       = Lanes::bit_xor(r, rotl<Lanes, 18>(x));
+    return Lanes::bit_xor(r, rotl<Lanes, 24>(x));
+  }
+
+  static vec_t l2(vec_t x)
+  {
+    vec_t r = Lanes::bit_xor(x, rotl<Lanes, 8>(x));
+    r       = Lanes::bit_xor(r, rotl<Lanes, 14>(x));
+    r       = Lanes::bit_xor(r, rotl<Lanes, 22>(x));
+    return Lanes::bit_xor(r, rotl<Lanes, 30>(x));
+  }
+
+  vec_t f(state_t& st, const brc_t& x) const
+  {
+    vec_t w  = Lanes::add(Lanes::bit_xor(x.x0, st.r1), st.r2);
+    vec_t w1 = Lanes::add(st.r1, x.x1);
+    vec_t w2 = Lanes::bit_xor(st.r2, x.x2);
+    st.r1 = sbox_lookup<Lanes>(tables.sbox, l1(Lanes::bit_or(Lanes::template sll<16>(w1), Lanes::template srl<16>(w2))));
+    st.r2 = sbox_lookup<Lanes>(tables.sbox, l2(Lanes::bit_or(Lanes::template sll<16>(w2), Lanes::template srl<16>(w1))));
+    return w;
+  }
+
+  void init_clock(state_t& st, uint32_t p) const
+  {
+    brc_t x = bit_reorganization(st, p);
+    vec_t w = f(st, x);
+    s(st, p, 0) = add_mod(lfsr_feedback(st, p), Lanes::template srl<1>(w));
+  }
+
+  void keystream_clock(state_t& st, uint32_t p, uint32_t* ks) const
+  {
+    brc_t x = bit_reorganization(st, p);
+    Lanes::store(ks, Lanes::bit_xor(f(st, x), x.x3));
+    s(st, p, 0) = lfsr_feedback(st, p);
+  }
+
+  /// Blocks of 16 clocks, unrolled so that the positions of the LFSR registers are known at compile time
+  template <std::size_t... p>
+  void init_block(state_t& st, std::index_sequence<p...>) const
+  {
+    int expand[] = {(init_clock(st, p), 0)...};
+    (void)expand;
+  }
+
+  template <std::size_t... p>
+  void keystream_block(state_t& st, uint32_t* ks, std::index_sequence<p...>) const
+  {
+    int expand[] = {(keystream_clock(st, p, &ks[p * N]), 0)...};
+    (void)expand;
+  }
+
+  const zuc_tables_t& tables;
+  state_t             state;
+  uint32_t            pos = 0;
+};
+
+/// 128-EEA3, 33.401 Annex B.1.4
+struct eea3_op : public cipher_op {
+  uint8_t bearer;
+  uint8_t direction;
+
+  eea3_op(uint8_t bearer_, uint8_t direction_) : bearer(bearer_), direction(direction_) {}
+
+  void make_iv(const security_pdu_t& pdu, zuc_iv_t& iv) const
+  {
+    put_be32(pdu.count, &iv.b[0]);
+    iv.b[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+    iv.b[5] = iv.b[6] = iv.b[7] = 0;
+    std::copy(&iv.b[0], &iv.b[8], &iv.b[8]);
+  }
+};
+
+/// 128-EIA3, 33.401 Annex B.2.4. The MAC is accumulated as the keystream words are generated, since each message
+/// word needs the keystream word at its position and the next one.
+struct eia3_op {
+  uint8_t bearer;
+  uint8_t direction;
+
+  eia3_op(uint8_t bearer_, uint8_t direction_) : bearer(bearer_), direction(direction_) {}
+  // Accumulated MAC and last keystream word of each lane
+  uint32_t t[MAX_NOF_LANES];
+  uint32_t prev_ks[MAX_NOF_LANES];
+
+  void make_iv(const security_pdu_t& pdu, zuc_iv_t& iv) const
+  {
+    put_be32(pdu.count, &iv.b[0]);
+    iv.b[4] = (bearer & 0x1F) << 3;
+    iv.b[5] = iv.b[6] = iv.b[7] = 0;
+    put_be32(pdu.count, &iv.b[8]);
+    iv.b[8] ^= (direction & 0x01) << 7;
+    iv.b[12] = iv.b[4];
+    iv.b[13] = 0;
+    iv.b[14] = (direction & 0x01) << 7;
+    iv.b[15] = 0;
+  }
+
+  static uint32_t nof_words(const security_pdu_t& pdu) { return (pdu.msg_len * 8 + 64 + 31) / 32; }
+
+  void process(uint32_t              lane,
+               const security_pdu_t& pdu,
+               uint32_t              first_word,
+               uint32_t              nof_ks_words,
+               const uint32_t*       ks,
+               uint32_t              stride)
+  {
+    uint32_t nof_bits = pdu.msg_len * 8;
+    uint32_t last     = nof_words(pdu) - 1;
+
+    for (uint32_t i = 0; i < nof_ks_words and first_word + i <= last; ++i) {
+      uint32_t idx = first_word + i;
+      uint32_t cur = ks[i * stride];
+      if (idx == 0) {
+        t[lane] = 0;
+      } else {
+        // Keystream bits from the start of word idx - 1, from which the word at any of its bit positions is taken
+        uint64_t window = ((uint64_t)prev_ks[lane] << 32) | cur;
+        uint32_t m_idx  = idx - 1;
+        if (m_idx * 32 < nof_bits) {
+          t[lane] ^= message_word_mac(message_word(pdu, m_idx), window);
+        }
+        if (m_idx == nof_bits / 32) {
+          t[lane] ^= (uint32_t)(window >> (32 - nof_bits % 32));
+        }
+        if (idx == last) {
+          put_be32(t[lane] ^ cur, pdu.out);
+        }
+      }
+      prev_ks[lane] = cur;
+    }
+  }
+
+  /// Message bits 32 * idx to 32 * idx + 31, with zeros past the end of the message
+  static uint32_t message_word(const security_pdu_t& pdu, uint32_t idx)
+  {
+    uint32_t m = 0;
+    for (uint32_t b = 0, pos = idx * 4; b < 4 and pos < pdu.msg_len; ++b, ++pos) {
+      m |= (uint32_t)pdu.msg[pos] << (24 - 8 * b);
+    }
+    return m;
+  }
+
+  /// XOR of the keystream words at the positions of the message bits set in m
+  static uint32_t message_word_mac(uint32_t m, uint64_t window)
+  {
+    uint32_t t = 0;
+    for (uint32_t j = 0; j < 32; ++j) {
+      t ^= (uint32_t)(window >> (32 - j)) & (0 - ((m >> (31 - j)) & 1));
+    }
+    return t;
+  }
+};
+
+/*******************************************************************************
+ * Multi-buffer processing
+ ******************************************************************************/
+
+/// Runs the keystream of up to Stream::N PDUs at the same time, one per lane, and hands it to op in chunks of
+/// CHUNK_NOF_WORDS words per lane. Lanes without PDU run on an all-zero IV.
+template <typename Stream, typename Op>
+void process_group(typename Stream::key_t key, Op& op, const security_pdu_t* const* pdus, uint32_t nof_pdus)
+{
+  typename Stream::iv_t ivs[Stream::N] = {};
+  uint32_t              nof_words      = 0;
+  for (uint32_t l = 0; l < nof_pdus; ++l) {
+    op.make_iv(*pdus[l], ivs[l]);
+    nof_words = std::max(nof_words, op.nof_words(*pdus[l]));
+  }
+
+  Stream               stream(key, ivs);
+  alignas(64) uint32_t ks[CHUNK_NOF_WORDS * Stream::N];
+  for (uint32_t w = 0; w < nof_words; w += CHUNK_NOF_WORDS) {
+    uint32_t n = std::min(CHUNK_NOF_WORDS, nof_words - w);
+    stream.keystream(ks, n);
+    for (uint32_t l = 0; l < nof_pdus; ++l) {
+      op.process(l, *pdus[l], w, n, &ks[l], Stream::N);
+    }
+  }
+}
+
+/// Processes the PDUs in groups of batch_lanes::nof_lanes. The PDUs are sorted by length first, so that the lanes of
+/// a group are busy for a similar number of clocks. A single PDU left over runs on its own.
+template <template <typename> class Stream, typename Op>
+void process_batch(typename Stream<batch_lanes>::key_t key, Op& op, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  std::vector<const security_pdu_t*> sorted(nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    sorted[i] = &pdus[i];
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const security_pdu_t* a, const security_pdu_t* b) {
+    return a->msg_len > b->msg_len;
+  });
+
+  for (uint32_t i = 0; i < nof_pdus; i += batch_lanes::nof_lanes) {
+    uint32_t n = std::min(nof_pdus - i, (uint32_t)batch_lanes::nof_lanes);
+    if (n == 1) {
+      process_group<Stream<scalar_lanes> >(key, op, &sorted[i], 1);
+    } else {
+      process_group<Stream<batch_lanes> >(key, op, &sorted[i], n);
+    }
+  }
+}
+
+template <template <typename> class Stream, typename Op>
+void process_pdu(typename Stream<scalar_lanes>::key_t key,
+                 Op&                                  op,
+                 uint32_t                             count,
+                 const uint8_t*                       msg,
+                 uint32_t                             msg_len,
+                 uint8_t*                             out)
+{
+  security_pdu_t        pdu     = {count, msg, msg_len, out};
+  const security_pdu_t* pdu_ptr = &pdu;
+  process_group<Stream<scalar_lanes> >(key, op, &pdu_ptr, 1);
+}
+
+} // namespace
+
+/*******************************************************************************
+ * s3g_engine
+ ******************************************************************************/
+
+uint32_t s3g_engine::get_nof_lanes()
+{
+  return batch_lanes::nof_lanes;
+}
+
+void s3g_engine::set_key(const uint8_t* key)
+{
+  for (uint32_t i = 0; i < 4; ++i) {
+    k[3 - i] = get_be32(&key[4 * i]);
+  }
+}
+
+void s3g_engine::eea1(uint32_t       count,
+                      uint8_t        bearer,
+                      uint8_t        direction,
+                      const uint8_t* msg,
+                      uint32_t       msg_len,
+                      uint8_t*       out) const
+{
+  eea1_op op(bearer, direction);
+  process_pdu<s3g_stream>(k, op, count, msg, msg_len, out);
+}
+
+void s3g_engine::eia1(uint32_t       count,
+                      uint8_t        bearer,
+                      uint8_t        direction,
+                      const uint8_t* msg,
+                      uint32_t       msg_len,
+                      uint8_t*       mac) const
+{
+  eia1_op op(bearer, direction);
+  process_pdu<s3g_stream>(k, op, count, msg, msg_len, mac);
+}
+
+void s3g_engine::eea1_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  eea1_op op(bearer, direction);
+  process_batch<s3g_stream>(k, op, pdus, nof_pdus);
+}
+
+void s3g_engine::eia1_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  eia1_op op(bearer, direction);
+  process_batch<s3g_stream>(k, op, pdus, nof_pdus);
+}
+
+/*******************************************************************************
+ * zuc_engine
+ ******************************************************************************/
+
+uint32_t zuc_engine::get_nof_lanes()
+{
+  return batch_lanes::nof_lanes;
+}
+
+void zuc_engine::set_key(const uint8_t* key_)
+{
+  std::copy(key_, key_ + 16, key);
+}
+
+void zuc_engine::eea3(uint32_t       count,
+                      uint8_t        bearer,
+                      uint8_t        direction,
+                      const uint8_t* msg,
+                      uint32_t       msg_len,
+                      uint8_t*       out) const
+{
+  eea3_op op(bearer, direction);
+  process_pdu<zuc_stream>(key, op, count, msg, msg_len, out);
+}
+
+void zuc_engine::eia3(uint32_t       count,
+                      uint8_t        bearer,
+                      uint8_t        direction,
+                      const uint8_t* msg,
+                      uint32_t       msg_len,
+                      uint8_t*       mac) const
+{
+  eia3_op op(bearer, direction);
+  process_pdu<zuc_stream>(key, op, count, msg, msg_len, mac);
+}
+
+void zuc_engine::eea3_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  eea3_op op(bearer, direction);
+  process_batch<zuc_stream>(key, op, pdus, nof_pdus);
+}
+
+void zuc_engine::eia3_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  eia3_op op(bearer, direction);
+  process_batch<zuc_stream>(key, op, pdus, nof_pdus);
+}
+
+} // namespace srsran
@@ -187,6 +187,12 @@ u32 L2(u32 X)
   return (X ^ ROT(X, 8) ^ ROT(X, 14) ^ ROT(X, 22) ^ ROT(X, 30));
 }
 
+/* S-box layer */
+u32 zuc_sbox(u32 x)
+{
+  return MAKEU32(S0[x >> 24], S1[(x >> 16) & 0xFF], S0[(x >> 8) & 0xFF], S1[x & 0xFF]);
+}
+
 /* F */
 u32 F(zuc_state_t* state)
 {
@@ -197,8 +203,8 @@ u32 F(zuc_state_t* state)
   u  = L1((W1 << 16) | (W2 >> 16));
   v  = L2((W2 << 16) | (W1 >> 16));
 
-  state->F_R1 = MAKEU32(S0[u >> 24], S1[(u >> 16) & 0xFF], S0[(u >> 8) & 0xFF], S1[u & 0xFF]);
-  state->F_R2 = MAKEU32(S0[v >> 24], S1[(v >> 16) & 0xFF], S0[(v >> 8) & 0xFF], S1[v & 0xFF]);
+  state->F_R1 = zuc_sbox(u);
+  state->F_R2 = zuc_sbox(v);
   return W;
 }
 
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/mac/pdu_queue.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+/// Checks that the PDUs of each producer, identified by the number of PRBs of the grant, are received in order
+class pdu_checker : public pdu_queue::process_callback
+{
+public:
+  pdu_checker(pdu_queue& queue_, uint32_t nof_producers) : queue(queue_), next_seq(nof_producers, 0) {}
+
+  void process_pdu(uint8_t* buff, uint32_t len, pdu_queue::channel_t channel, int ul_nof_prbs) override
+  {
+    TESTASSERT(channel == pdu_queue::DCH);
+    TESTASSERT(ul_nof_prbs >= 0 and ul_nof_prbs < (int)next_seq.size());
+    uint32_t seq;
+    memcpy(&seq, buff, sizeof(seq));
+    TESTASSERT(seq == next_seq[ul_nof_prbs]);
+    TESTASSERT(len == pdu_len(seq));
+    for (uint32_t i = sizeof(seq); i < len; ++i) {
+      TESTASSERT(buff[i] == (uint8_t)(seq + i));
+    }
+    next_seq[ul_nof_prbs]++;
+    nof_pdus++;
+    queue.deallocate(buff);
+  }
+
+  static uint32_t pdu_len(uint32_t seq) { return sizeof(seq) + seq % 100; }
+
+  static void fill_pdu(uint8_t* buff, uint32_t seq)
+  {
+    memcpy(buff, &seq, sizeof(seq));
+    for (uint32_t i = sizeof(seq); i < pdu_len(seq); ++i) {
+      buff[i] = seq + i;
+    }
+  }
+
+  pdu_queue&            queue;
+  std::vector<uint32_t> next_seq;
+  std::atomic<uint32_t> nof_pdus{0};
+};
+
+int test_pdu_queue_single_thread()
+{
+  pdu_queue   queue(srslog::fetch_basic_logger("MAC", false));
+  pdu_checker checker(queue, 1);
+  queue.init(&checker);
+
+  TESTASSERT(not queue.process_pdus());
+  TESTASSERT(queue.request(150 * 1024) == nullptr);
+
+  for (uint32_t seq = 0; seq < 10; ++seq) {
+    uint8_t* buff = queue.request(pdu_checker::pdu_len(seq));
+    TESTASSERT(buff != nullptr);
+    pdu_checker::fill_pdu(buff, seq);
+    queue.push(buff, pdu_checker::pdu_len(seq), pdu_queue::DCH, 0);
+  }
+  TESTASSERT(queue.process_pdus());
+  TESTASSERT(checker.nof_pdus == 10);
+  TESTASSERT(not queue.process_pdus());
+
+  // All the buffers were returned to the pool
+  std::vector<uint8_t*> buffs;
+  for (uint8_t* buff = queue.request(1); buff != nullptr; buff = queue.request(1)) {
+    buffs.push_back(buff);
+  }
+  TESTASSERT(buffs.size() >= 10);
+  for (uint8_t* buff : buffs) {
+    queue.deallocate(buff);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Several PHY workers push PDUs concurrently while the stack thread processes them
+int test_pdu_queue_multi_thread()
+{
+  const uint32_t nof_producers = 4;
+  const uint32_t nof_pdus      = 5000;
+  const uint32_t max_in_flight = 16; // below the number of buffers of the pool
+
+  pdu_queue   queue(srslog::fetch_basic_logger("MAC", false));
+  pdu_checker checker(queue, nof_producers);
+  queue.init(&checker);
+
+  std::atomic<uint32_t>    nof_pushed{0};
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < nof_producers; ++producer) {
+    producers.emplace_back([&queue, &checker, &nof_pushed, producer, nof_pdus, max_in_flight]() {
+      for (uint32_t seq = 0; seq < nof_pdus; ++seq) {
+        // Wait for the stack thread to catch up, so that the pool does not run out of buffers
+        while (nof_pushed.load() - checker.nof_pdus.load() >= max_in_flight) {
+          std::this_thread::yield();
+        }
+        nof_pushed++;
+        uint8_t* buff = queue.request(pdu_checker::pdu_len(seq));
+        TESTASSERT(buff != nullptr);
+        pdu_checker::fill_pdu(buff, seq);
+        queue.push(buff, pdu_checker::pdu_len(seq), pdu_queue::DCH, producer);
+      }
+    });
+  }
+
+  while (checker.nof_pdus < nof_producers * nof_pdus) {
+    if (not queue.process_pdus()) {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  TESTASSERT(not queue.process_pdus());
+  for (uint32_t seq : checker.next_seq) {
+    TESTASSERT(seq == nof_pdus);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("MAC", false).set_level(srslog::basic_levels::info);
+
+  srslog::init();
+
+  TESTASSERT(test_pdu_queue_single_thread() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdu_queue_multi_thread() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -118,7 +118,9 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
 
   // For now we create an pdcp entity lte for nr due to it's maturity
   if (cfg.rat == srsran::srsran_rat_t::lte) {
-    entity.reset(new pdcp_entity_lte{rlc, rrc, gw, task_sched, logger, lcid});
+    std::unique_ptr<pdcp_entity_lte> lte_entity{new pdcp_entity_lte{rlc, rrc, gw, task_sched, logger, lcid}};
+    lte_entity->set_security_pool(security_pool);
+    entity = std::move(lte_entity);
   } else if (cfg.rat == srsran::srsran_rat_t::nr) {
     entity.reset(new pdcp_entity_nr{rlc, rrc, gw, task_sched, logger, lcid});
   }
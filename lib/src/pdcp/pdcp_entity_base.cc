@@ -26,6 +26,73 @@
 
 namespace srsran {
 
+/****************************************************************************
+ * Ciphering keys
+ ***************************************************************************/
+pdcp_cipher::pdcp_cipher(CIPHERING_ALGORITHM_ID_ENUM algo_, const uint8_t* k_enc) : algo(algo_)
+{
+  // Expand the key once, rather than for every PDU
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      s3g.set_key(k_enc);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      aes.set_key(k_enc);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      zuc.set_key(k_enc);
+      break;
+    default:
+      break;
+  }
+}
+
+void pdcp_cipher::cipher(uint32_t       count,
+                         uint8_t        bearer,
+                         uint8_t        direction,
+                         const uint8_t* msg,
+                         uint32_t       msg_len,
+                         uint8_t*       out) const
+{
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_EEA0:
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      s3g.eea1(count, bearer, direction, msg, msg_len, out);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      aes.eea2(count, bearer, direction, msg, msg_len, out);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      zuc.eea3(count, bearer, direction, msg, msg_len, out);
+      break;
+    default:
+      break;
+  }
+}
+
+void pdcp_cipher::cipher_batch(uint8_t bearer, uint8_t direction, const security_pdu_t* pdus, uint32_t nof_pdus) const
+{
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_EEA0:
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      s3g.eea1_batch(bearer, direction, pdus, nof_pdus);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      aes.eea2_batch(bearer, direction, pdus, nof_pdus);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      zuc.eea3_batch(bearer, direction, pdus, nof_pdus);
+      break;
+    default:
+      break;
+  }
+}
+
+/****************************************************************************
+ * PDCP entity base
+ ***************************************************************************/
 pdcp_entity_base::pdcp_entity_base(task_sched_handle task_sched_, srslog::basic_logger& logger) :
   logger(logger), task_sched(task_sched_)
 {}
@@ -40,6 +107,24 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
               integrity_algorithm_id_text[sec_cfg.integ_algo],
               ciphering_algorithm_id_text[sec_cfg.cipher_algo]);
 
+  // Load the keys once, rather than for every PDU
+  const uint8_t* k_enc = is_srb() ? &sec_cfg.k_rrc_enc[16] : &sec_cfg.k_up_enc[16];
+  const uint8_t* k_int = is_srb() ? &sec_cfg.k_rrc_int[16] : &sec_cfg.k_up_int[16];
+  cipher_keys = std::make_shared<const pdcp_cipher>(sec_cfg.cipher_algo, k_enc);
+  switch (sec_cfg.integ_algo) {
+    case INTEGRITY_ALGORITHM_ID_128_EIA1:
+      s3g_int.set_key(k_int);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA2:
+      aes_int.set_key(k_int);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA3:
+      zuc_int.set_key(k_int);
+      break;
+    default:
+      break;
+  }
+
   logger.debug(sec_cfg.k_rrc_enc.data(), 32, "K_rrc_enc");
   logger.debug(sec_cfg.k_up_enc.data(), 32, "K_up_enc");
   logger.debug(sec_cfg.k_rrc_int.data(), 32, "K_rrc_int");
@@ -64,13 +149,13 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
     case INTEGRITY_ALGORITHM_ID_EIA0:
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA1:
-      security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      s3g_int.eia1(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      aes_int.eia2(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
-      security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      zuc_int.eia3(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     default:
       break;
@@ -102,13 +187,13 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
     case INTEGRITY_ALGORITHM_ID_EIA0:
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA1:
-      security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      s3g_int.eia1(count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      aes_int.eia2(count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
-      security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      zuc_int.eia3(count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     default:
       break;
@@ -138,7 +223,6 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
 void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct)
 {
   uint8_t* k_enc;
-  uint8_t  ct_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -154,23 +238,8 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
   logger.debug(k_enc, 32, "Cipher encrypt key:");
   logger.debug(msg, msg_len, "Cipher encrypt input msg");
 
-  switch (sec_cfg.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    default:
-      break;
+  if (cipher_keys != nullptr) {
+    cipher_keys->cipher(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
   }
   logger.debug(ct, msg_len, "Cipher encrypt output msg");
 }
@@ -178,7 +247,6 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
 void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg)
 {
   uint8_t* k_enc;
-  uint8_t  msg_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -194,23 +262,8 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(k_enc, 32, "Cipher decrypt key:");
   logger.debug(ct, ct_len, "Cipher decrypt input msg");
 
-  switch (sec_cfg.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    default:
-      break;
+  if (cipher_keys != nullptr) {
+    cipher_keys->cipher(count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
   }
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
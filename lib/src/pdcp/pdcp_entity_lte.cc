@@ -56,6 +56,9 @@ pdcp_entity_lte::pdcp_entity_lte(srsue::rlc_interface_pdcp* rlc_,
 pdcp_entity_lte::~pdcp_entity_lte()
 {
   reset();
+  if (security_bearer != nullptr) {
+    security_bearer->release();
+  }
 }
 
 bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
@@ -104,6 +107,16 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
     rx_counts_info.reserve(reordering_window);
   }
 
+  // Only DRBs are ciphered in the security workers. SRBs are few, and their integrity protection is checked in order
+  // with the security activation
+  if (is_drb() and security_pool != nullptr) {
+    // A previous binding, e.g. before a reset, still has its PDUs in flight, which are dropped
+    if (security_bearer != nullptr) {
+      security_bearer->release();
+    }
+    security_bearer = security_pool->bind_bearer(this);
+  }
+
   // Check supported config
   if (!check_valid_config()) {
     srsran::console("Warning: Invalid PDCP config.\n");
@@ -131,6 +144,10 @@ void pdcp_entity_lte::reestablish()
   } else {
     // Sending the status report will be triggered by the RRC if required
   }
+  // Drop the Tx PDUs in the security workers, which were ciphered for the RLC entity before its re-establishment. In
+  // RLC-AM, the Tx SDUs remain in the undelivered SDUs queue. The Rx PDUs are delivered, deciphered with the keys they
+  // were received with
+  tx_security_epoch++;
 }
 
 // Used to stop/pause the entity (called on RRC conn release)
@@ -202,19 +219,6 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
-  }
-
-  logger.info(sdu->msg,
-              sdu->N_bytes,
-              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
-              rb_name.c_str(),
-              used_sn,
-              srsran_direction_text[integrity_direction],
-              srsran_direction_text[encryption_direction]);
-
   // Set SDU metadata for RLC AM
   sdu->md.pdcp_sn = used_sn;
 
@@ -227,14 +231,35 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     }
   }
 
-  // Pass PDU to lower layers
   metrics.num_tx_pdus++;
   metrics.num_tx_pdu_bytes += sdu->N_bytes;
   // Count TX'd bytes as if they were ACK'd if RLC is UM
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
-  rlc->write_sdu(lcid, std::move(sdu));
+
+  // Cipher and pass PDU to lower layers. PDUs ciphered in the security workers are passed in write_secured_pdu()
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (offload_security(sdu, cfg.hdr_len_bytes, tx_count, true, do_encryption)) {
+    return;
+  }
+  if (do_encryption) {
+    cipher_encrypt(
+        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
+  }
+  pass_to_rlc(std::move(sdu));
+}
+
+void pdcp_entity_lte::pass_to_rlc(unique_byte_buffer_t pdu)
+{
+  logger.info(pdu->msg,
+              pdu->N_bytes,
+              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
+              rb_name.c_str(),
+              pdu->md.pdcp_sn,
+              srsran_direction_text[integrity_direction],
+              srsran_direction_text[encryption_direction]);
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
@@ -377,11 +402,6 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
   }
 
   uint32_t count = (st.rx_hfn << cfg.sn_len) | sn;
-  if (encryption_direction == DIRECTION_RX || encryption_direction == DIRECTION_TXRX) {
-    cipher_decrypt(pdu->msg, pdu->N_bytes, count, pdu->msg);
-  }
-
-  logger.debug(pdu->msg, pdu->N_bytes, "%s Rx PDU SN=%d", rb_name.c_str(), sn);
 
   st.next_pdcp_rx_sn = sn + 1;
   if (st.next_pdcp_rx_sn > maximum_pdcp_sn) {
@@ -389,8 +409,16 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
     st.rx_hfn++;
   }
 
+  bool do_decryption = encryption_direction == DIRECTION_RX || encryption_direction == DIRECTION_TXRX;
+  if (offload_security(pdu, 0, count, false, do_decryption)) {
+    return;
+  }
+  if (do_decryption) {
+    cipher_decrypt(pdu->msg, pdu->N_bytes, count, pdu->msg);
+  }
+
   // Pass to upper layers
-  gw->write_pdu(lcid, std::move(pdu));
+  pass_to_gw(std::move(pdu), count);
 }
 
 // DRBs mapped on RLC AM, without re-ordering (5.1.2.1.2)
@@ -443,20 +471,76 @@ void pdcp_entity_lte::handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu)
     count = (st.rx_hfn << cfg.sn_len) | sn;
   }
 
-  // Decrypt
-  cipher_decrypt(pdu->msg, pdu->N_bytes, count, pdu->msg);
-  logger.debug(pdu->msg, pdu->N_bytes, "%s Rx SDU SN=%d", rb_name.c_str(), sn);
-
   // Update info on last PDU submitted to upper layers
   st.last_submitted_pdcp_rx_sn = sn;
 
   // Store Rx SN/COUNT
   update_rx_counts_queue(count);
 
+  // Decrypt
+  if (offload_security(pdu, 0, count, false, true)) {
+    return;
+  }
+  cipher_decrypt(pdu->msg, pdu->N_bytes, count, pdu->msg);
+
   // Pass to upper layers
+  pass_to_gw(std::move(pdu), count);
+}
+
+void pdcp_entity_lte::pass_to_gw(unique_byte_buffer_t pdu, uint32_t count)
+{
+  logger.debug(pdu->msg, pdu->N_bytes, "%s Rx SDU SN=%d", rb_name.c_str(), SN(count));
   gw->write_pdu(lcid, std::move(pdu));
 }
 
+/****************************************************************************
+ * Security offloading
+ ***************************************************************************/
+bool pdcp_entity_lte::offload_security(unique_byte_buffer_t& pdu,
+                                       uint32_t              offset,
+                                       uint32_t              count,
+                                       bool                  is_tx,
+                                       bool                  do_cipher)
+{
+  // PDUs that are not ciphered are also passed through the worker while others are pending, to keep their order
+  if (security_bearer == nullptr or (not do_cipher and security_bearer->nof_pending() == 0)) {
+    return false;
+  }
+
+  pdcp_security_job_t job;
+  job.bearer    = security_bearer;
+  job.keys      = do_cipher ? cipher_keys : nullptr;
+  job.pdu       = std::move(pdu);
+  job.offset    = offset;
+  job.count     = count;
+  job.tag       = is_tx ? tx_security_epoch : 0;
+  job.bearer_id = cfg.bearer_id - 1;
+  job.direction = is_tx ? cfg.tx_direction : cfg.rx_direction;
+  job.is_tx     = is_tx;
+  if (security_bearer->push(job)) {
+    return true;
+  }
+  logger.info("%s security worker queue is full. Ciphering PDU with COUNT=%d inline", rb_name.c_str(), count);
+  pdu = std::move(job.pdu);
+  return false;
+}
+
+void pdcp_entity_lte::write_secured_pdu(unique_byte_buffer_t pdu, uint32_t count, uint32_t tag, bool is_tx)
+{
+  if (not active or (is_tx and tag != tx_security_epoch)) {
+    logger.info("Dropping %s %s PDU with COUNT=%d, the bearer was reset while it was ciphered",
+                rb_name.c_str(),
+                is_tx ? "TX" : "RX",
+                count);
+    return;
+  }
+  if (is_tx) {
+    pass_to_rlc(std::move(pdu));
+  } else {
+    pass_to_gw(std::move(pdu), count);
+  }
+}
+
 void pdcp_entity_lte::update_rx_counts_queue(uint32_t rx_count)
 {
   if (rx_count < fmc) {
@@ -903,7 +987,7 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   }
 
   // Allocate buffer and exit on error
-  srsran::unique_byte_buffer_t tmp = make_byte_buffer();
+  srsran::unique_byte_buffer_t tmp = make_byte_buffer_with_tailroom(sdu->N_bytes);
   if (tmp == nullptr) {
     return false;
   }
@@ -1003,9 +1087,8 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> undelivered_sdus_queue::get_buf
   for (auto& sdu : sdus) {
     if (sdu.sdu != nullptr) {
       // TODO: Find ways to avoid deep copy
-      srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer();
-      if (fwd_sdu != nullptr) {
-        *fwd_sdu = *sdu.sdu;
+      srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer_with_tailroom(sdu.sdu->N_bytes);
+      if (fwd_sdu != nullptr and fwd_sdu->copy_from(*sdu.sdu)) {
         fwd_sdus.emplace(sdu.sdu->md.pdcp_sn, std::move(fwd_sdu));
       } else {
         srslog::fetch_basic_logger("PDCP").warning("Can't allocate buffer to forward buffered SDUs.");
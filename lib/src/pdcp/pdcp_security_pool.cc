@@ -0,0 +1,211 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_security_pool.h"
+#include <array>
+
+namespace srsran {
+
+/****************************************************************************
+ * Bearer binding
+ ***************************************************************************/
+bool pdcp_security_bearer::push(pdcp_security_job_t& job)
+{
+  // Once a PDU is held back, the following ones are too until the PDUs in the worker are returned
+  if (deferred_jobs.empty()) {
+    srsran::error_type<pdcp_security_job_t> ret = pool->workers[worker_idx]->pending_jobs.try_push(std::move(job));
+    if (not ret.is_error()) {
+      nof_pending_jobs++;
+      return true;
+    }
+    // The job is handed back
+    job = std::move(ret.error());
+    if (nof_pending_jobs == 0) {
+      return false;
+    }
+    pool->logger.info("PDCP security worker %d queue is full. Processing PDUs from COUNT=%d inline",
+                      worker_idx,
+                      job.count);
+  }
+  pdcp_security_pool::process(&job, 1);
+  // The bearer is not kept alive by its own jobs
+  job.bearer.reset();
+  deferred_jobs.push_back(std::move(job));
+  return true;
+}
+
+void pdcp_security_bearer::release()
+{
+  if (user != nullptr) {
+    pool->workers[worker_idx]->nof_bearers--;
+    user = nullptr;
+  }
+  deferred_jobs.clear();
+}
+
+void pdcp_security_bearer::return_deferred_jobs()
+{
+  std::vector<pdcp_security_job_t> jobs;
+  jobs.swap(deferred_jobs);
+  for (pdcp_security_job_t& job : jobs) {
+    if (user != nullptr) {
+      user->write_secured_pdu(std::move(job.pdu), job.count, job.tag, job.is_tx);
+    }
+  }
+}
+
+/****************************************************************************
+ * Security workers
+ ***************************************************************************/
+pdcp_security_pool::worker_t::worker_t(pdcp_security_pool* parent_, uint32_t idx, uint32_t queue_size) :
+  thread("PDCP_SEC" + std::to_string(idx)), pending_jobs(queue_size), parent(parent_)
+{}
+
+void pdcp_security_pool::worker_t::stop()
+{
+  if (not pending_jobs.is_stopped()) {
+    pending_jobs.stop();
+    wait_thread_finish();
+  }
+}
+
+void pdcp_security_pool::worker_t::run_thread()
+{
+  std::array<pdcp_security_job_t, max_batch_size> jobs;
+  while (true) {
+    bool success;
+    jobs[0] = pending_jobs.pop_blocking(&success);
+    if (not success) {
+      break;
+    }
+    // Take the PDUs that are already waiting, to cipher them in batches
+    uint32_t nof_jobs = 1;
+    while (nof_jobs < max_batch_size and pending_jobs.try_pop(jobs[nof_jobs])) {
+      nof_jobs++;
+    }
+    process(jobs.data(), nof_jobs);
+
+    bool notify;
+    {
+      std::lock_guard<std::mutex> lock(done_mutex);
+      notify = done_jobs.empty();
+      for (uint32_t i = 0; i < nof_jobs; ++i) {
+        done_jobs.push_back(std::move(jobs[i]));
+      }
+    }
+    // Only the first jobs since the last return need a task, the stack thread takes all the jobs that are done
+    if (notify) {
+      done_queue.push([this]() { parent->return_done_jobs(*this); });
+    }
+  }
+}
+
+void pdcp_security_pool::process(pdcp_security_job_t* jobs, uint32_t nof_jobs)
+{
+  std::array<security_pdu_t, max_batch_size> pdus;
+  uint32_t                                   i = 0;
+  while (i < nof_jobs) {
+    // Consecutive jobs with the same keys and direction are ciphered together
+    const pdcp_security_job_t& first    = jobs[i];
+    uint32_t                   nof_pdus = 0;
+    for (; i < nof_jobs and jobs[i].keys == first.keys and jobs[i].bearer_id == first.bearer_id and
+           jobs[i].direction == first.direction;
+         ++i) {
+      byte_buffer_t*  pdu = jobs[i].pdu.get();
+      security_pdu_t& p   = pdus[nof_pdus++];
+      p.count             = jobs[i].count;
+      p.msg               = &pdu->msg[jobs[i].offset];
+      p.msg_len           = pdu->N_bytes - jobs[i].offset;
+      p.out               = &pdu->msg[jobs[i].offset];
+    }
+    if (first.keys != nullptr) {
+      first.keys->cipher_batch(first.bearer_id, first.direction, pdus.data(), nof_pdus);
+    }
+  }
+}
+
+/****************************************************************************
+ * Security pool
+ ***************************************************************************/
+pdcp_security_pool::pdcp_security_pool(srsran::task_sched_handle task_sched,
+                                       uint32_t                  nof_workers,
+                                       uint32_t                  queue_size,
+                                       int32_t                   prio) :
+  logger(srslog::fetch_basic_logger("PDCP"))
+{
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new worker_t(this, i, queue_size));
+    workers.back()->done_queue = task_sched.make_task_queue();
+    workers.back()->start(prio);
+  }
+  logger.info("Started %d PDCP security workers", nof_workers);
+}
+
+pdcp_security_pool::~pdcp_security_pool()
+{
+  stop();
+}
+
+void pdcp_security_pool::stop()
+{
+  for (auto& w : workers) {
+    w->stop();
+  }
+}
+
+std::shared_ptr<pdcp_security_bearer> pdcp_security_pool::bind_bearer(pdcp_security_user* user)
+{
+  uint32_t worker_idx = 0;
+  for (uint32_t i = 1; i < workers.size(); ++i) {
+    if (workers[i]->nof_bearers < workers[worker_idx]->nof_bearers) {
+      worker_idx = i;
+    }
+  }
+  workers[worker_idx]->nof_bearers++;
+  return std::make_shared<pdcp_security_bearer>(this, worker_idx, user);
+}
+
+void pdcp_security_pool::return_done_jobs(worker_t& worker)
+{
+  std::vector<pdcp_security_job_t> jobs;
+  {
+    std::lock_guard<std::mutex> lock(worker.done_mutex);
+    jobs.swap(worker.done_jobs);
+  }
+  for (pdcp_security_job_t& job : jobs) {
+    pdcp_security_bearer& bearer = *job.bearer;
+    bearer.nof_pending_jobs--;
+    if (bearer.user != nullptr) {
+      bearer.user->write_secured_pdu(std::move(job.pdu), job.count, job.tag, job.is_tx);
+    }
+    if (bearer.nof_pending_jobs == 0 and not bearer.deferred_jobs.empty()) {
+      bearer.return_deferred_jobs();
+    }
+  }
+  // Keep the allocated vector for the next jobs, unless the worker filled it in the meantime
+  jobs.clear();
+  std::lock_guard<std::mutex> lock(worker.done_mutex);
+  if (worker.done_jobs.empty()) {
+    worker.done_jobs.swap(jobs);
+  }
+}
+
+} // namespace srsran
@@ -30,6 +30,82 @@
 #define CFR_LPF_WITH_ZEROS
 
 static inline float cfr_symb_peak(float* in_abs, int len);
+static void         cfr_reset_metrics(srsran_cfr_t* q);
+
+// Computes the PAPR, in linear units, of a symbol given its absolute values
+static inline float cfr_symb_papr(float* in_abs, uint32_t len)
+{
+  const float symb_peak    = cfr_symb_peak(in_abs, (int)len);
+  const float pwr_symb_avg = srsran_vec_avg_power_ff(in_abs, len);
+  return isnormal(pwr_symb_avg) ? (symb_peak * symb_peak) / pwr_symb_avg : 0.0f;
+}
+
+// Clips the input signal with the threshold beta and filters the result. The absolute values of the input must be
+// stored in q->abs_buffer_in. The ACPR of the clipped signal is accumulated in acpr_acc if metrics are enabled
+static void cfr_clip_filter(srsran_cfr_t* q, const cf_t* in, cf_t* out, float beta, float* acpr_acc)
+{
+  const float    alpha     = q->cfg.alpha;
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+
+#ifdef CFR_PEAK_EXTRACTION
+  srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
+  cf_t clip_thr = 0;
+  for (int i = 0; i < symbol_sz; i++) {
+    if (q->abs_buffer_in[i] > beta) {
+      clip_thr          = beta * (in[i] / q->abs_buffer_in[i]);
+      q->peak_buffer[i] = in[i] - clip_thr;
+    }
+  }
+
+  // Apply FFT filter to the peak signal
+  srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
+#ifdef CFR_LPF_WITH_ZEROS
+  srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+#else  /* CFR_LPF_WITH_ZEROS */
+  srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
+#endif /* CFR_LPF_WITH_ZEROS */
+  srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
+
+  // Scale the peak signal according to alpha
+  srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
+
+  // Apply the filtered clipping
+  srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
+#else /* CFR_PEAK_EXTRACTION */
+
+  // Generate a clipping envelope and clip the signal
+  srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
+  srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
+
+  // FFT filter
+  srsran_dft_run_c(&q->fft_plan, out, out);
+  if (q->cfg.measure_metrics) {
+    // Out-of-band power generated by the clipping, which is removed by the filter
+    *acpr_acc += srsran_vec_acpr_c(out, q->lpf_bw / 2 + q->cfg.dc_sc, q->lpf_bw / 2, symbol_sz);
+  }
+#ifdef CFR_LPF_WITH_ZEROS
+  srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+#else  /* CFR_LPF_WITH_ZEROS */
+  srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
+#endif /* CFR_LPF_WITH_ZEROS */
+  srsran_dft_run_c(&q->ifft_plan, out, out);
+#endif /* CFR_PEAK_EXTRACTION */
+}
+
+// Accumulates the output PAPR and the EVM with respect to the CFR input of the given iteration
+static void cfr_iter_metrics(srsran_cfr_t* q, const cf_t* in, const cf_t* out, uint32_t iter)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+
+  srsran_vec_abs_cf(out, q->abs_buffer_out, symbol_sz);
+  q->papr_acc[iter] += cfr_symb_papr(q->abs_buffer_out, symbol_sz);
+
+  const float pwr_in = srsran_vec_avg_power_cf(in, symbol_sz);
+  if (isnormal(pwr_in)) {
+    srsran_vec_sub_ccc(out, in, q->peak_buffer, symbol_sz);
+    q->evm_acc[iter] += srsran_vec_avg_power_cf(q->peak_buffer, symbol_sz) / pwr_in;
+  }
+}
 
 void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 {
@@ -44,7 +120,6 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     return;
   }
 
-  const float    alpha     = q->cfg.alpha;
   const uint32_t symbol_sz = q->cfg.symbol_sz;
   float          beta      = 0.0f;
 
@@ -76,56 +151,44 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     beta                 = (papr_reduction > 1) ? symb_peak / sqrtf(papr_reduction) : 0;
   }
 
+  // The output may overwrite the input, keep a copy of it for the EVM
+  const cf_t* ref = in;
+  if (q->cfg.measure_metrics) {
+    q->papr_in_acc += cfr_symb_papr(q->abs_buffer_in, symbol_sz);
+    srsran_vec_cf_copy(q->ref_buffer, in, symbol_sz);
+    ref = q->ref_buffer;
+  }
+
   // Clipping algorithm
   if (isnormal(beta)) {
-#ifdef CFR_PEAK_EXTRACTION
-    srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
-    cf_t clip_thr = 0;
-    for (int i = 0; i < symbol_sz; i++) {
-      if (q->abs_buffer_in[i] > beta) {
-        clip_thr          = beta * (in[i] / q->abs_buffer_in[i]);
-        q->peak_buffer[i] = in[i] - clip_thr;
+    cf_t* iter_in = in;
+    for (uint32_t i = 0; i < q->nof_iterations; i++) {
+      if (i > 0) {
+        // The filter of the previous iteration regrows the peaks, measure them again
+        srsran_vec_abs_cf(iter_in, q->abs_buffer_in, symbol_sz);
       }
+      cfr_clip_filter(q, iter_in, out, beta, &q->acpr_acc[i]);
+      if (q->cfg.measure_metrics) {
+        cfr_iter_metrics(q, ref, out, i);
+      }
+      iter_in = out;
     }
-
-    // Apply FFT filter to the peak signal
-    srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
-#ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
-#else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
-#endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
-
-    // Scale the peak signal according to alpha
-    srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
-
-    // Apply the filtered clipping
-    srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
-#else /* CFR_PEAK_EXTRACTION */
-
-    // Generate a clipping envelope and clip the signal
-    srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
-    srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
-
-    // FFT filter
-    srsran_dft_run_c(&q->fft_plan, out, out);
-#ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
-#else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
-#endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, out, out);
-#endif /* CFR_PEAK_EXTRACTION */
-
   } else {
     // If no processing, copy the input samples into the output buffer
     if (in != out) {
       srsran_vec_cf_copy(out, in, symbol_sz);
     }
+    if (q->cfg.measure_metrics) {
+      for (uint32_t i = 0; i < q->nof_iterations; i++) {
+        cfr_iter_metrics(q, ref, out, i);
+      }
+    }
+  }
+  if (q->cfg.measure_metrics) {
+    q->metrics_n++;
   }
   if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
-    srsran_vec_abs_cf(in, q->abs_buffer_out, symbol_sz);
+    srsran_vec_abs_cf(out, q->abs_buffer_out, symbol_sz);
 
     const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
     const float pwr_symb_peak = symb_peak * symb_peak;
@@ -179,12 +242,18 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     ERROR("Error, invalid configuration for EMA averaging");
     goto clean_exit;
   }
+  if (cfg->nof_iterations > SRSRAN_CFR_MAX_ITERATIONS) {
+    ERROR("Error, invalid number of CFR iterations");
+    goto clean_exit;
+  }
 
   // Copy all the configuration parameters
-  q->cfg          = *cfg;
-  q->max_papr_lin = srsran_convert_dB_to_power(q->cfg.max_papr_db);
-  q->pwr_avg_in   = CFR_EMA_INIT_AVG_PWR;
-  q->cma_n        = 0;
+  q->cfg            = *cfg;
+  q->max_papr_lin   = srsran_convert_dB_to_power(q->cfg.max_papr_db);
+  q->pwr_avg_in     = CFR_EMA_INIT_AVG_PWR;
+  q->cma_n          = 0;
+  q->nof_iterations = SRSRAN_MAX(q->cfg.nof_iterations, 1);
+  cfr_reset_metrics(q);
 
   if (q->cfg.measure_out_papr) {
     q->pwr_avg_out = CFR_EMA_INIT_AVG_PWR;
@@ -217,6 +286,18 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     goto clean_exit;
   }
 
+  if (q->ref_buffer) {
+    free(q->ref_buffer);
+    q->ref_buffer = NULL;
+  }
+  if (q->cfg.measure_metrics) {
+    q->ref_buffer = srsran_vec_cf_malloc(q->cfg.symbol_sz);
+    if (!q->ref_buffer) {
+      ERROR("Error allocating ref_buffer");
+      goto clean_exit;
+    }
+  }
+
   // Allocate the filter
   if (q->lpf_spectrum) {
     free(q->lpf_spectrum);
@@ -315,6 +396,9 @@ void srsran_cfr_free(srsran_cfr_t* q)
     if (q->peak_buffer) {
       free(q->peak_buffer);
     }
+    if (q->ref_buffer) {
+      free(q->ref_buffer);
+    }
     if (q->lpf_spectrum) {
       free(q->lpf_spectrum);
     }
@@ -322,6 +406,39 @@ void srsran_cfr_free(srsran_cfr_t* q)
   }
 }
 
+static void cfr_reset_metrics(srsran_cfr_t* q)
+{
+  q->metrics_n   = 0;
+  q->papr_in_acc = 0.0f;
+  srsran_vec_f_zero(q->papr_acc, SRSRAN_CFR_MAX_ITERATIONS);
+  srsran_vec_f_zero(q->evm_acc, SRSRAN_CFR_MAX_ITERATIONS);
+  srsran_vec_f_zero(q->acpr_acc, SRSRAN_CFR_MAX_ITERATIONS);
+}
+
+int srsran_cfr_get_metrics(srsran_cfr_t* q, srsran_cfr_metrics_t* metrics)
+{
+  if (q == NULL || metrics == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  SRSRAN_MEM_ZERO(metrics, srsran_cfr_metrics_t, 1);
+  if (q->metrics_n == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  const float n           = (float)q->metrics_n;
+  metrics->nof_symbols    = q->metrics_n;
+  metrics->nof_iterations = q->nof_iterations;
+  metrics->papr_in_db     = srsran_convert_power_to_dB(q->papr_in_acc / n);
+  for (uint32_t i = 0; i < q->nof_iterations; i++) {
+    metrics->iter[i].papr_db = srsran_convert_power_to_dB(q->papr_acc[i] / n);
+    metrics->iter[i].evm     = 100.0f * sqrtf(q->evm_acc[i] / n);
+    metrics->iter[i].acpr_db = srsran_convert_power_to_dB(q->acpr_acc[i] / n);
+  }
+  cfr_reset_metrics(q);
+
+  return SRSRAN_SUCCESS;
+}
+
 // Find the peak absolute value of an OFDM symbol
 static inline float cfr_symb_peak(float* in_abs, int len)
 {
@@ -350,6 +467,9 @@ bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
       (cfr_conf->max_papr_db <= 0 || (cfr_conf->ema_alpha < 0 || cfr_conf->ema_alpha > 1))) {
     return false;
   }
+  if (cfr_conf->nof_iterations > SRSRAN_CFR_MAX_ITERATIONS) {
+    return false;
+  }
   return true;
 }
 
@@ -29,6 +29,7 @@
 #include "srsran/srsran.h"
 
 #define MAX_ACPR_DB -100
+#define MAX_METRIC_ERR 0.01f
 
 
 // Default CFR type
@@ -44,6 +45,7 @@ static bool              dc_empty        = true;
 static float             thr_manual      = 1.5f;
 static float             max_papr_db     = 8.0f;
 static float             ema_alpha       = (float)1 / (float)SRSRAN_CP_NORM_NSYMB;
+static uint32_t          nof_iterations  = 1;
 
 static uint32_t force_symbol_sz = 0;
 static double   elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
@@ -71,12 +73,13 @@ static void usage(char* prog)
   printf("\t-t CFR manual threshold: [Default %.2f]\n", thr_manual);
   printf("\t-p CFR Max PAPR in dB (auto modes): [Default %.2f]\n", max_papr_db);
   printf("\t-E Power avg EMA alpha (EMA mode): [Default %.2f]\n", ema_alpha);
+  printf("\t-i Number of clipping and filtering iterations: [Default %d]\n", nof_iterations);
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NnerfmatdpE")) != -1) {
+  while ((opt = getopt(argc, argv, "NnerfmatdpEi")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -111,6 +114,9 @@ static int parse_args(int argc, char** argv)
       case 'E':
         ema_alpha = strtof(argv[optind], NULL);
         break;
+      case 'i':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         return SRSRAN_ERROR;
@@ -192,6 +198,8 @@ int main(int argc, char** argv)
     cfr_tx_cfg.manual_thr       = thr_manual;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
+    cfr_tx_cfg.nof_iterations   = nof_iterations;
+    cfr_tx_cfg.measure_metrics  = true;
 
     if (!srsran_cfr_params_valid(&cfr_tx_cfg)) {
       ERROR("Invalid CFR configuration");
@@ -233,9 +241,10 @@ int main(int argc, char** argv)
     for (uint32_t i = 0; i < nof_repetitions; i++) {
       for (uint32_t j = 0; j < nof_frames; j++) {
         for (uint32_t k = 0; k < nof_symb_frame; k++) {
-          srsran_cfr_process(&cfr,
-                             input + (size_t)((k * symbol_sz) + (j * frame_sz)),
-                             output + (size_t)((k * symbol_sz) + (j * frame_sz)));
+          // Process in place, as done by the OFDM modulator
+          cf_t* symb_out = output + (size_t)((k * symbol_sz) + (j * frame_sz));
+          srsran_vec_cf_copy(symb_out, input + (size_t)((k * symbol_sz) + (j * frame_sz)), symbol_sz);
+          srsran_cfr_process(&cfr, symb_out, symb_out);
         }
       }
     }
@@ -257,6 +266,20 @@ int main(int argc, char** argv)
     float papr_in  = srsran_convert_power_to_dB(srsran_vec_papr_c(input, total_nof_re));
     float papr_out = srsran_convert_power_to_dB(srsran_vec_papr_c(output, total_nof_re));
 
+    // Per-symbol averages, as measured by the CFR
+    float symb_papr_in  = 0.0f;
+    float symb_papr_out = 0.0f;
+    float symb_evm      = 0.0f;
+    for (int i = 0; i < total_nof_symb; i++) {
+      symb_papr_in += srsran_vec_papr_c(input + i * symbol_sz, symbol_sz);
+      symb_papr_out += srsran_vec_papr_c(output + i * symbol_sz, symbol_sz);
+      symb_evm += srsran_vec_avg_power_cf(error + i * symbol_sz, symbol_sz) /
+                  srsran_vec_avg_power_cf(input + i * symbol_sz, symbol_sz);
+    }
+    symb_papr_in  = srsran_convert_power_to_dB(symb_papr_in / (float)total_nof_symb);
+    symb_papr_out = srsran_convert_power_to_dB(symb_papr_out / (float)total_nof_symb);
+    symb_evm      = 100.0f * sqrtf(symb_evm / (float)total_nof_symb);
+
     ofdm_symb = NULL;
     for (int i = 0; i < total_nof_symb; i++) {
       ofdm_symb = output + i * symbol_sz;
@@ -272,6 +295,52 @@ int main(int argc, char** argv)
     printf("  In-PAPR=%.3fdB  Out-PAPR=%.3fdB", papr_in, papr_out);
     printf("  In-ACPR=%.3fdB  Out-ACPR=%.3fdB\n", acpr_in_dB, acpr_out_dB);
 
+    // Per-iteration metrics reported by the CFR
+    srsran_cfr_metrics_t cfr_metrics = {};
+    if (srsran_cfr_get_metrics(&cfr, &cfr_metrics) < SRSRAN_SUCCESS) {
+      ERROR("Error getting CFR metrics");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < cfr_metrics.nof_iterations; i++) {
+      printf("  Iteration %d: PAPR=%.3fdB  EVM=%.3f%%  Clipping-ACPR=%.3fdB\n",
+             i,
+             cfr_metrics.iter[i].papr_db,
+             cfr_metrics.iter[i].evm,
+             cfr_metrics.iter[i].acpr_db);
+    }
+
+    // The metrics shall cover all the processed symbols and iterations
+    if (cfr_metrics.nof_symbols != total_nof_symb * nof_repetitions ||
+        cfr_metrics.nof_iterations != SRSRAN_MAX(nof_iterations, 1)) {
+      ERROR("Invalid number of CFR metric symbols (%d) or iterations (%d)",
+            cfr_metrics.nof_symbols,
+            cfr_metrics.nof_iterations);
+      goto clean_exit;
+    }
+
+    // The input PAPR, and the output PAPR and EVM of the last iteration, shall match the ones measured here
+    const srsran_cfr_iter_metrics_t* last_iter = &cfr_metrics.iter[cfr_metrics.nof_iterations - 1];
+    if (fabsf(cfr_metrics.papr_in_db - symb_papr_in) > MAX_METRIC_ERR ||
+        fabsf(last_iter->papr_db - symb_papr_out) > MAX_METRIC_ERR || fabsf(last_iter->evm - symb_evm) > MAX_METRIC_ERR) {
+      ERROR("CFR metrics do not match: In-PAPR=%.3f/%.3fdB Out-PAPR=%.3f/%.3fdB EVM=%.3f/%.3f%%",
+            cfr_metrics.papr_in_db,
+            symb_papr_in,
+            last_iter->papr_db,
+            symb_papr_out,
+            last_iter->evm,
+            symb_evm);
+      goto clean_exit;
+    }
+
+    // Every iteration shall reduce the PAPR, and the clipping shall generate the out-of-band power the filter removes
+    for (uint32_t i = 0; i < cfr_metrics.nof_iterations; i++) {
+      float prev_papr_db = (i == 0) ? cfr_metrics.papr_in_db : cfr_metrics.iter[i - 1].papr_db;
+      if (cfr_metrics.iter[i].papr_db > prev_papr_db || cfr_metrics.iter[i].acpr_db < acpr_out_dB) {
+        ERROR("Iteration %d did not reduce the PAPR or did not clip", i);
+        goto clean_exit;
+      }
+    }
+
     srsran_dft_plan_free(&ofdm_ifft);
     srsran_dft_plan_free(&ofdm_fft);
     free(input);
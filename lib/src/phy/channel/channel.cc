@@ -43,15 +43,18 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
+  // There is no point on having more worker threads than channels
+  nof_channels         = _nof_channels;
+  uint32_t nof_workers = SRSRAN_MIN(args.nof_workers, nof_channels > 0 ? nof_channels - 1 : 0);
 
-  nof_channels = _nof_channels;
   for (uint32_t i = 0; i < nof_channels; i++) {
+    // Allocate internal buffers, every channel has its own so they can be processed concurrently
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
+
     // Create fading channel
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSRAN_SUCCESS) {
@@ -73,19 +76,20 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     } else {
       delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel. Without workers, all channels draw from a single generator in order, as they always did,
+    // so that the noise of single-threaded setups is unchanged
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS && (i == 0 || nof_workers > 0)) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -96,27 +100,25 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
+    return;
+  }
+
+  // Launch workers, the caller of run() processes the first share of channels
+  for (uint32_t w = 0; w < nof_workers; w++) {
+    workers.emplace_back(new worker_t(this, w + 1));
+    workers.back()->start();
   }
 }
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  {
+    std::lock_guard<std::mutex> lock(workers_mutex);
+    workers_quit = true;
   }
-
-  if (buffer_out) {
-    free(buffer_out);
-  }
-
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
+  workers_cvar.notify_all();
+  for (std::unique_ptr<worker_t>& w : workers) {
+    w->wait_thread_finish();
   }
 
   if (rlf) {
@@ -125,6 +127,24 @@ channel::~channel()
   }
 
   for (uint32_t i = 0; i < nof_channels; i++) {
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
+
     if (fading[i]) {
       srsran_channel_fading_free(fading[i]);
       free(fading[i]);
@@ -147,66 +167,134 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
-void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
-                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
-                  uint32_t                  len,
-                  const srsran_timestamp_t& t)
+void channel::run_channel(uint32_t i)
 {
-  // Early return if pointers are not enabled
+  cf_t*    in    = run_in[i];
+  cf_t*    out   = run_out[i];
+  uint32_t len   = run_len;
+  cf_t*    b_in  = buffer_in[i];
+  cf_t*    b_out = buffer_out[i];
+
+  // Skip iteration if any buffer is null
   if (in == nullptr || out == nullptr) {
     return;
   }
 
-  // For each channel
-  for (uint32_t i = 0; i < nof_channels; i++) {
-    // Skip iteration if any buffer is null
-    if (in[i] == nullptr || out[i] == nullptr) {
-      continue;
+  // If sampling rate is not set, copy input and skip rest of channel
+  if (current_srate == 0) {
+    if (in != out) {
+      srsran_vec_cf_copy(out, in, len);
     }
+    return;
+  }
+
+  // Copy input buffer
+  srsran_vec_cf_copy(b_in, in, len);
+
+  if (hst[i]) {
+    srsran_channel_hst_execute(hst[i], b_in, b_out, len, &run_ts);
+    srsran_vec_sc_prod_ccc(b_out, run_hst_phase, b_in, len);
+  }
+
+  // Without workers, a single noise generator is shared by all channels
+  srsran_channel_awgn_t* ch_awgn = workers.empty() ? awgn[0] : awgn[i];
+  if (ch_awgn) {
+    srsran_channel_awgn_run_c(ch_awgn, b_in, b_out, len);
+    srsran_vec_cf_copy(b_in, b_out, len);
+  }
 
-    // If sampling rate is not set, copy input and skip rest of channel
-    if (current_srate == 0) {
-      if (in[i] != out[i]) {
-        srsran_vec_cf_copy(out[i], in[i], len);
+  if (fading[i]) {
+    srsran_channel_fading_execute(fading[i], b_in, b_out, len, run_ts.full_secs + run_ts.frac_secs);
+    srsran_vec_cf_copy(b_in, b_out, len);
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], b_in, b_out, len, &run_ts);
+    srsran_vec_cf_copy(b_in, b_out, len);
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, b_in, b_out, len, &run_ts);
+    srsran_vec_cf_copy(b_in, b_out, len);
+  }
+
+  // Copy output buffer
+  srsran_vec_cf_copy(out, b_in, len);
+}
+
+void channel::run_worker_channels(uint32_t worker_idx)
+{
+  uint32_t stride = (uint32_t)workers.size() + 1;
+  for (uint32_t i = worker_idx; i < nof_channels; i += stride) {
+    run_channel(i);
+  }
+}
+
+void channel::worker_loop(uint32_t worker_idx)
+{
+  uint64_t last_run = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(workers_mutex);
+      while (!workers_quit && run_count == last_run) {
+        workers_cvar.wait(lock);
       }
-      continue;
+      if (workers_quit) {
+        return;
+      }
+      last_run = run_count;
     }
 
-    // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+    run_worker_channels(worker_idx);
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+    {
+      std::lock_guard<std::mutex> lock(workers_mutex);
+      pending_count--;
+      if (pending_count == 0) {
+        done_cvar.notify_one();
+      }
     }
+  }
+}
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t)
+{
+  // Early return if pointers are not enabled
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  run_in        = in;
+  run_out       = out;
+  run_len       = len;
+  run_ts        = t;
+  run_hst_phase = local_cexpf(hst_init_phase);
+
+  if (workers.empty()) {
+    run_worker_channels(0);
+  } else {
+    // Wake up the workers, process the first share of channels and wait for the rest
+    {
+      std::lock_guard<std::mutex> lock(workers_mutex);
+      pending_count = (uint32_t)workers.size();
+      run_count++;
     }
+    workers_cvar.notify_all();
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+    run_worker_channels(0);
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    std::unique_lock<std::mutex> lock(workers_mutex);
+    while (pending_count > 0) {
+      done_cvar.wait(lock);
     }
-
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
   }
 
-  if (hst) {
+  if (hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -225,8 +313,8 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   if (delay[0]) {
     str << "delay=" << delay[0]->delay_us << "us; ";
   }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (hst[0]) {
+    str << "hst=" << hst[0]->fs_hz << "Hz; ";
   }
   logger.debug("%s", str.str().c_str());
 }
@@ -244,10 +332,10 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
-    }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
     // Update sampling rate
@@ -257,7 +345,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (awgn[i] != nullptr) {
+      srsran_channel_awgn_set_n0(awgn[i], power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
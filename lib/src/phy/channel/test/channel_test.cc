@@ -0,0 +1,165 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/vector.h"
+#include <random>
+#include <vector>
+
+static const uint32_t nof_channels = 4;
+static const uint32_t srate        = 1920000;
+static const uint32_t sf_len       = srate / 1000;
+static const uint32_t nof_sf       = 20;
+
+/// Runs nof_sf subframes of random signals through the channel emulator and returns the output of every channel
+static std::vector<std::vector<cf_t> > run_channel(const srsran::channel::args_t& args)
+{
+  srsran::channel channel(args, nof_channels, srslog::fetch_basic_logger("CHAN", false));
+  channel.set_srate(srate);
+
+  std::mt19937                          rgen(0);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<std::vector<cf_t> >       in(nof_channels, std::vector<cf_t>(sf_len * nof_sf));
+  std::vector<std::vector<cf_t> >       out(nof_channels, std::vector<cf_t>(sf_len * nof_sf));
+  for (std::vector<cf_t>& v : in) {
+    for (cf_t& x : v) {
+      x = {dist(rgen), dist(rgen)};
+    }
+  }
+
+  for (uint32_t sf = 0; sf < nof_sf; ++sf) {
+    cf_t* in_ptr[SRSRAN_MAX_CHANNELS]  = {};
+    cf_t* out_ptr[SRSRAN_MAX_CHANNELS] = {};
+    for (uint32_t i = 0; i < nof_channels; ++i) {
+      in_ptr[i]  = &in[i][sf * sf_len];
+      out_ptr[i] = &out[i][sf * sf_len];
+    }
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init(&ts, 0, sf * 1e-3);
+    channel.run(in_ptr, out_ptr, sf_len, ts);
+  }
+
+  // Return the noise/fading added to the input, for the comparisons below
+  for (uint32_t i = 0; i < nof_channels; ++i) {
+    srsran_vec_sub_ccc(out[i].data(), in[i].data(), out[i].data(), sf_len * nof_sf);
+  }
+  return out;
+}
+
+/// Generates the noise that the given AWGN generator adds to one subframe
+static void gen_awgn(srsran_channel_awgn_t* awgn, float n0_dBfs, std::vector<cf_t>& noise, uint32_t sf)
+{
+  srsran_channel_awgn_set_n0(awgn, n0_dBfs);
+  std::vector<cf_t> zeros(sf_len, 0.0f);
+  srsran_channel_awgn_run_c(awgn, zeros.data(), &noise[sf * sf_len], sf_len);
+}
+
+/// Without workers, all the channels keep drawing their noise from a single generator with the original seed
+static int test_awgn_single_worker()
+{
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 10.0f;
+
+  std::vector<std::vector<cf_t> > noise = run_channel(args);
+
+  srsran_channel_awgn_t awgn = {};
+  TESTASSERT(srsran_channel_awgn_init(&awgn, 1234) == SRSRAN_SUCCESS);
+  std::vector<std::vector<cf_t> > expected(nof_channels, std::vector<cf_t>(sf_len * nof_sf));
+  for (uint32_t sf = 0; sf < nof_sf; ++sf) {
+    for (uint32_t i = 0; i < nof_channels; ++i) {
+      gen_awgn(&awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB, expected[i], sf);
+    }
+  }
+  srsran_channel_awgn_free(&awgn);
+
+  for (uint32_t i = 0; i < nof_channels; ++i) {
+    TESTASSERT(srsran_vec_avg_power_cf(noise[i].data(), sf_len * nof_sf) > 0.0f);
+    srsran_vec_sub_ccc(noise[i].data(), expected[i].data(), noise[i].data(), sf_len * nof_sf);
+    TESTASSERT(srsran_vec_avg_power_cf(noise[i].data(), sf_len * nof_sf) < 1e-9f);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// With workers, every channel has its own generator, so the noise does not depend on the thread interleaving
+static int test_awgn_workers()
+{
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.nof_workers             = nof_channels - 1;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 10.0f;
+
+  std::vector<std::vector<cf_t> > noise = run_channel(args);
+
+  for (uint32_t i = 0; i < nof_channels; ++i) {
+    srsran_channel_awgn_t awgn = {};
+    TESTASSERT(srsran_channel_awgn_init(&awgn, 1234 + i) == SRSRAN_SUCCESS);
+    std::vector<cf_t> expected(sf_len * nof_sf);
+    for (uint32_t sf = 0; sf < nof_sf; ++sf) {
+      gen_awgn(&awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB, expected, sf);
+    }
+    srsran_channel_awgn_free(&awgn);
+
+    srsran_vec_sub_ccc(noise[i].data(), expected.data(), noise[i].data(), sf_len * nof_sf);
+    TESTASSERT(srsran_vec_avg_power_cf(noise[i].data(), sf_len * nof_sf) < 1e-9f);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The fading and delay models are per channel, so the workers shall produce the same signals as the caller alone
+static int test_fading_workers()
+{
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.fading_enable           = true;
+  args.fading_model            = "epa5";
+  args.delay_enable            = true;
+
+  std::vector<std::vector<cf_t> > ref = run_channel(args);
+  for (uint32_t nof_workers = 1; nof_workers < nof_channels + 2; ++nof_workers) {
+    args.nof_workers                    = nof_workers;
+    std::vector<std::vector<cf_t> > out = run_channel(args);
+    for (uint32_t i = 0; i < nof_channels; ++i) {
+      TESTASSERT(srsran_vec_avg_power_cf(ref[i].data(), sf_len * nof_sf) > 0.0f);
+      srsran_vec_sub_ccc(out[i].data(), ref[i].data(), out[i].data(), sf_len * nof_sf);
+      TESTASSERT(srsran_vec_avg_power_cf(out[i].data(), sf_len * nof_sf) == 0.0f);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_awgn_single_worker() == SRSRAN_SUCCESS);
+  TESTASSERT(test_awgn_workers() == SRSRAN_SUCCESS);
+  TESTASSERT(test_fading_workers() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -181,6 +181,25 @@ uint32_t srsran_tdd_nof_harq(srsran_tdd_config_t tdd_config)
   return tdd_nof_harq[tdd_config.sf_config];
 }
 
+uint32_t srsran_tdd_dl_harq_ack_delay(srsran_tdd_config_t tdd_config, uint32_t sf_idx)
+{
+  // Inverse of the downlink association set, indexed by the subframe of the PDSCH transmission
+  static const uint32_t tdd_dl_harq_ack_delay[SRSRAN_MAX_TDD_SF_CONFIGS][SRSRAN_NOF_SF_X_FRAME] = {
+      {4, 6, 0, 0, 0, 4, 6, 0, 0, 0},
+      {7, 6, 0, 0, 4, 7, 6, 0, 0, 4},
+      {7, 6, 0, 4, 8, 7, 6, 0, 4, 8},
+      {4, 11, 0, 0, 0, 7, 6, 6, 5, 5},
+      {12, 11, 0, 0, 8, 7, 7, 6, 5, 4},
+      {12, 11, 0, 9, 8, 7, 6, 5, 4, 13},
+      {7, 7, 0, 0, 0, 7, 7, 0, 0, 5}};
+
+  if (tdd_config.sf_config < SRSRAN_MAX_TDD_SF_CONFIGS && sf_idx < SRSRAN_NOF_SF_X_FRAME) {
+    return tdd_dl_harq_ack_delay[tdd_config.sf_config][sf_idx];
+  }
+
+  return 0;
+}
+
 bool srsran_sfidx_isvalid(uint32_t sf_idx)
 {
   if (sf_idx <= SRSRAN_NOF_SF_X_FRAME) {
@@ -51,9 +51,35 @@ int lte_standard_rates_test()
   return SRSRAN_SUCCESS;
 }
 
+int tdd_dl_harq_ack_delay_test()
+{
+  // The HARQ-ACK of every DL or special subframe is sent in an UL subframe, at least 4 subframes later
+  srsran_tdd_config_t tdd_config = {};
+  tdd_config.configured          = true;
+  for (tdd_config.sf_config = 0; tdd_config.sf_config < SRSRAN_MAX_TDD_SF_CONFIGS; tdd_config.sf_config++) {
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      uint32_t k = srsran_tdd_dl_harq_ack_delay(tdd_config, sf_idx);
+      if (srsran_sfidx_tdd_type(tdd_config, sf_idx) == SRSRAN_TDD_SF_U) {
+        TESTASSERT(k == 0);
+      } else {
+        TESTASSERT(k >= 4);
+        TESTASSERT(srsran_sfidx_tdd_type(tdd_config, (sf_idx + k) % SRSRAN_NOF_SF_X_FRAME) == SRSRAN_TDD_SF_U);
+      }
+    }
+  }
+
+  // Invalid arguments
+  tdd_config.sf_config = SRSRAN_MAX_TDD_SF_CONFIGS;
+  TESTASSERT(srsran_tdd_dl_harq_ack_delay(tdd_config, 0) == 0);
+  tdd_config.sf_config = 0;
+  TESTASSERT(srsran_tdd_dl_harq_ack_delay(tdd_config, SRSRAN_NOF_SF_X_FRAME) == 0);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   TESTASSERT(srsran_default_rates_test() == SRSRAN_SUCCESS);
   TESTASSERT(lte_standard_rates_test() == SRSRAN_SUCCESS);
+  TESTASSERT(tdd_dl_harq_ack_delay_test() == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/phy/utils/vector_simd.h"
+
+/**
+ * Prototype filter half length in number of samples at the lowest of the input and output rates
+ */
+#define RESAMPLER_POLY_HALF_LEN 16
+
+/**
+ * Prototype filter cut-off frequency relative to the lowest of the input and output rates. The transition band of the
+ * Blackman window spans approximately +/-0.086 of it, so an LTE signal (bandwidth below 0.6 of the sampling rate) is
+ * not attenuated and the aliases fall out of the signal band.
+ */
+#define RESAMPLER_POLY_CUTOFF 0.4
+
+static uint32_t resampler_poly_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t r = a % b;
+    a          = b;
+    b          = r;
+  }
+  return a;
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim, uint32_t max_nsamples)
+{
+  if (q == NULL || interp == 0 || decim == 0 || max_nsamples == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce ratio
+  uint32_t g = resampler_poly_gcd(interp, decim);
+  interp /= g;
+  decim /= g;
+
+  uint32_t max_ratio = SRSRAN_MAX(interp, decim);
+  uint32_t nof_taps  = SRSRAN_CEIL(2 * RESAMPLER_POLY_HALF_LEN * max_ratio, interp);
+  uint32_t buffer_sz = max_nsamples + 2 * nof_taps;
+
+  // Skip initialisation if the configuration did not change
+  if (q->interp == interp && q->decim == decim && q->buffer_sz >= buffer_sz) {
+    srsran_resampler_poly_reset_state(q);
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure the resampler is freed
+  srsran_resampler_poly_free(q);
+
+  q->filter = srsran_vec_f_malloc(interp * nof_taps);
+  if (q->filter == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->buffer = srsran_vec_cf_malloc(buffer_sz);
+  if (q->buffer == NULL) {
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  q->interp    = interp;
+  q->decim     = decim;
+  q->nof_taps  = nof_taps;
+  q->buffer_sz = buffer_sz;
+
+  // Compute Blackman windowed sinc prototype filter at the intermediate rate (L times the input rate). The window
+  // length is odd, the last coefficient is zero otherwise, so that the group delay is an integer number of samples
+  uint32_t N     = interp * nof_taps;
+  uint32_t N_win = (N % 2 == 0) ? N - 1 : N;
+  double   fc    = RESAMPLER_POLY_CUTOFF / (double)max_ratio;
+  double   sum_h = 0.0;
+  q->delay       = (N_win - 1) / 2;
+  for (uint32_t i = 0; i < N; i++) {
+    double t = (double)i - (double)q->delay;
+    double h = 2.0 * fc;
+    if (isnormal(t)) {
+      h = sin(2.0 * M_PI * fc * t) / (M_PI * t);
+    }
+    double w = 2.0 * M_PI * (double)i / (double)(N_win - 1);
+    h *= (i < N_win) ? (0.42 - 0.5 * cos(w) + 0.08 * cos(2.0 * w)) : 0.0;
+
+    // Split into branches, the coefficients are stored in reverse order so that every output sample is a dot product
+    // with contiguous input samples
+    uint32_t p                                   = i % interp;
+    uint32_t j                                   = i / interp;
+    q->filter[p * nof_taps + (nof_taps - 1 - j)] = (float)h;
+    sum_h += h;
+  }
+
+  // Normalise filter for unitary gain, each branch shall have an average gain of one
+  srsran_vec_sc_prod_fff(q->filter, (float)((double)interp / sum_h), q->filter, N);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  // Start with a history of zeros. The first output is delayed by the filter group delay, so that it is aligned with
+  // the first input sample
+  q->buffer_len = q->nof_taps - 1;
+  q->t          = (uint64_t)q->buffer_len * q->interp + q->delay;
+  srsran_vec_cf_zero(q->buffer, q->buffer_len);
+}
+
+double srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->interp == 0) {
+    return 0.0;
+  }
+
+  // Difference between the time of the next input sample and the time of the next output sample
+  return (double)q->buffer_len - ((double)q->t - (double)q->delay) / (double)q->interp;
+}
+
+double srsran_resampler_poly_get_delay_s(const srsran_resampler_poly_t* q, double output_srate)
+{
+  if (q == NULL || q->interp == 0 || !isnormal(output_srate)) {
+    return 0.0;
+  }
+
+  // The input rate is the output rate times M/L
+  return srsran_resampler_poly_get_delay(q) * (double)q->interp / ((double)q->decim * output_srate);
+}
+
+uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->interp == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  // Input index required by the last output sample
+  uint64_t last = (q->t + (uint64_t)(nof_output - 1) * q->decim) / q->interp;
+  if (last < q->buffer_len) {
+    return 0;
+  }
+
+  return (uint32_t)(last + 1 - q->buffer_len);
+}
+
+uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input)
+{
+  if (q == NULL || q->interp == 0) {
+    return 0;
+  }
+
+  uint64_t limit = (uint64_t)(q->buffer_len + nof_input) * q->interp;
+  if (q->t >= limit) {
+    return 0;
+  }
+
+  return (uint32_t)SRSRAN_CEIL(limit - q->t, q->decim);
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                   const cf_t*              input,
+                                   uint32_t                 nof_input,
+                                   cf_t*                    output,
+                                   uint32_t                 max_output)
+{
+  if (q == NULL || q->interp == 0 || output == NULL) {
+    return 0;
+  }
+
+  // Append input samples. They shall fit in the buffer together with the samples kept from the previous calls
+  uint32_t available = q->buffer_sz - q->buffer_len;
+  if (nof_input > available) {
+    ERROR("Resampler input (%d samples) exceeds the available buffer (%d samples)", nof_input, available);
+    assert(nof_input <= available);
+    nof_input = available;
+  }
+  if (input != NULL) {
+    srsran_vec_cf_copy(&q->buffer[q->buffer_len], input, nof_input);
+  } else {
+    srsran_vec_cf_zero(&q->buffer[q->buffer_len], nof_input);
+  }
+  q->buffer_len += nof_input;
+
+  // Compute output samples while the required input is available
+  uint32_t count = 0;
+  while (count < max_output) {
+    uint64_t n = q->t / q->interp;
+    if (n >= q->buffer_len) {
+      break;
+    }
+    uint32_t    p = (uint32_t)(q->t % q->interp);
+    const cf_t* x = &q->buffer[n + 1 - q->nof_taps];
+    output[count++] = srsran_vec_dot_prod_cfc_simd(x, &q->filter[p * q->nof_taps], q->nof_taps);
+    q->t += q->decim;
+  }
+
+  // Discard the samples that will not be used anymore
+  uint64_t first   = q->t / q->interp + 1 - q->nof_taps;
+  uint32_t discard = (uint32_t)SRSRAN_MIN(first, (uint64_t)q->buffer_len);
+  if (discard > 0) {
+    memmove(q->buffer, &q->buffer[discard], sizeof(cf_t) * (q->buffer_len - discard));
+    q->buffer_len -= discard;
+    q->t -= (uint64_t)discard * q->interp;
+  }
+
+  return count;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->filter) {
+    free(q->filter);
+  }
+  if (q->buffer) {
+    free(q->buffer);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_poly_t));
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t buffer_size = 23040;
+static uint32_t interp      = 2;
+static uint32_t decim       = 3;
+static uint32_t repetitions = 10;
+static float    freq_norm   = 0.05f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sLMrfv]\n", prog);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-L Interpolation factor [Default %d]\n", interp);
+  printf("\t-M Decimation factor [Default %d]\n", decim);
+  printf("\t-r Number of repetitions [Default %d]\n", repetitions);
+  printf("\t-f Tone frequency normalised to the input rate [Default %.2f]\n", freq_norm);
+  printf("\t-v Increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sLMrfv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'L':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'M':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        freq_norm = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3]      = {};
+  srsran_resampler_poly_t resampler = {};
+
+  parse_args(argc, argv);
+
+  uint32_t out_size = SRSRAN_CEIL(buffer_size * interp, decim) + 1;
+  cf_t*    src      = srsran_vec_cf_malloc(buffer_size);
+  cf_t*    dst      = srsran_vec_cf_malloc(out_size);
+  cf_t*    ref      = srsran_vec_cf_malloc(out_size);
+  if (src == NULL || dst == NULL || ref == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_resampler_poly_init(&resampler, interp, decim, buffer_size)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Check the number of input samples for an exact number of output samples
+  uint32_t nof_out = srsran_resampler_poly_nof_output(&resampler, buffer_size);
+  uint32_t nof_in  = srsran_resampler_poly_nof_input(&resampler, nof_out);
+  if (nof_out == 0 || nof_in > buffer_size || srsran_resampler_poly_nof_output(&resampler, nof_in) != nof_out) {
+    ERROR("Invalid number of input samples %d for %d output samples", nof_in, nof_out);
+    return SRSRAN_ERROR;
+  }
+
+  // The output shall be aligned with the input, the group delay is compensated
+  if (fabs(srsran_resampler_poly_get_delay(&resampler)) > 1e-9) {
+    ERROR("Invalid initial delay %f", srsran_resampler_poly_get_delay(&resampler));
+    return SRSRAN_ERROR;
+  }
+
+  // Generate continuous tone through all the repetitions and run the resampler
+  uint64_t total_out   = 0;
+  uint64_t last_start  = 0;
+  uint64_t duration_us = 0;
+  uint32_t count       = 0;
+  for (uint32_t r = 0; r < repetitions; r++) {
+    for (uint32_t i = 0; i < buffer_size; i++) {
+      double phase = fmod((double)freq_norm * (double)((uint64_t)r * buffer_size + i), 1.0);
+      src[i]       = cexpf(I * 2.0f * (float)M_PI * (float)phase);
+    }
+    last_start = total_out;
+    gettimeofday(&t[1], NULL);
+    count = srsran_resampler_poly_run(&resampler, src, buffer_size, dst, out_size);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    duration_us += (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+    total_out += count;
+  }
+
+  // The delay in seconds shall match the input time of the next output sample, given the input and output sample
+  // counts. The output rate is L MHz, so the input rate is M MHz
+  double output_srate = (double)interp * 1e6;
+  double next_in_s    = (double)((uint64_t)repetitions * buffer_size) / ((double)decim * 1e6);
+  double next_out_s   = (double)total_out / output_srate;
+  double delay_s      = srsran_resampler_poly_get_delay_s(&resampler, output_srate);
+  if (fabs(delay_s - (next_in_s - next_out_s)) > 1e-9) {
+    ERROR("Invalid delay %.3f us, expected %.3f us", delay_s * 1e6, (next_in_s - next_out_s) * 1e6);
+    return SRSRAN_ERROR;
+  }
+
+  // Compare the last output block, skipping the filter transient, with the ideal tone at the output rate. The output
+  // sample k corresponds to the input time k*M/L, so the tone phase shall match too
+  double freq_out = (double)freq_norm * (double)decim / (double)interp;
+  for (uint32_t i = 0; i < count; i++) {
+    double phase = fmod(freq_out * (double)(last_start + i), 1.0);
+    ref[i]       = cexpf(I * 2.0f * (float)M_PI * (float)phase);
+  }
+  uint32_t skip = count / 4;
+  uint32_t len  = count - skip;
+  cf_t     gain = srsran_vec_dot_prod_conj_ccc(&dst[skip], &ref[skip], len) / (float)len;
+  srsran_vec_sc_prod_ccc(&ref[skip], gain, &ref[skip], len);
+  srsran_vec_sub_ccc(&dst[skip], &ref[skip], &ref[skip], len);
+  float err = sqrtf(srsran_vec_avg_power_cf(&ref[skip], len));
+
+  if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    printf("out=");
+    srsran_vec_fprint_c(stdout, dst, count);
+  }
+
+  printf("Done %d/%d %.1f Msps (output %.1f Msps); gain: %.4f; phase: %.4f; error: %.6f\n",
+         interp,
+         decim,
+         (double)buffer_size * repetitions / (double)duration_us,
+         (double)total_out / (double)duration_us,
+         cabsf(gain),
+         cargf(gain),
+         err);
+
+  srsran_resampler_poly_free(&resampler);
+  free(src);
+  free(dst);
+  free(ref);
+
+  return (err < 0.01f && cabsf(gain - 1.0f) < 0.01f) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
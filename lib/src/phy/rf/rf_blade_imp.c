@@ -19,6 +19,7 @@
  *
  */
 
+#include <inttypes.h>
 #include <libbladeRF.h>
 #include <string.h>
 #include <unistd.h>
@@ -27,20 +28,24 @@
 #include "rf_plugin.h"
 #include "srsran/phy/common/timestamp.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/iq_converter.h"
 #include "srsran/phy/utils/vector.h"
 
 #define UNUSED __attribute__((unused))
 #define CONVERT_BUFFER_SIZE (240 * 1024)
+#define BLADE_SC16_Q11_SCALE (2048)
+#define BLADE_SC16_Q11_MAX (2047)
 
 typedef struct {
-  struct bladerf*     dev;
-  bladerf_sample_rate rx_rate;
-  bladerf_sample_rate tx_rate;
-  int16_t             rx_buffer[CONVERT_BUFFER_SIZE];
-  int16_t             tx_buffer[CONVERT_BUFFER_SIZE];
-  bool                rx_stream_enabled;
-  bool                tx_stream_enabled;
-  srsran_rf_info_t    info;
+  struct bladerf*       dev;
+  bladerf_sample_rate   rx_rate;
+  bladerf_sample_rate   tx_rate;
+  int16_t               rx_buffer[CONVERT_BUFFER_SIZE];
+  int16_t               tx_buffer[CONVERT_BUFFER_SIZE];
+  srsran_iq_converter_t converter;
+  bool                  rx_stream_enabled;
+  bool                  tx_stream_enabled;
+  srsran_rf_info_t      info;
 } rf_blade_handler_t;
 
 static srsran_rf_error_handler_t blade_error_handler     = NULL;
@@ -186,6 +191,9 @@ int rf_blade_open(char* args, void** h)
   }
   *h = handler;
 
+  // The device streams SC16 Q11 samples, only the 12 LSB of each 16-bit component are used
+  srsran_iq_converter_init(&handler->converter, SRSRAN_IQ_FORMAT_SC16, BLADE_SC16_Q11_SCALE, BLADE_SC16_Q11_MAX);
+
   printf("Opening bladeRF...\n");
   int status = bladerf_open(&handler->dev, args);
   if (status) {
@@ -242,6 +250,12 @@ clean_exit:
 int rf_blade_close(void* h)
 {
   rf_blade_handler_t* handler = (rf_blade_handler_t*)h;
+
+  uint64_t nof_saturated = srsran_iq_converter_get_saturated(&handler->converter);
+  if (nof_saturated > 0) {
+    printf("bladeRF: %" PRIu64 " I/Q components saturated\n", nof_saturated);
+  }
+
   bladerf_close(handler->dev);
   return 0;
 }
@@ -462,7 +476,7 @@ int rf_blade_recv_with_time(void*       h,
   }
 
   timestamp_to_secs(handler->rx_rate, meta.timestamp, secs, frac_secs);
-  srsran_vec_convert_if(handler->rx_buffer, 2048, data, 2 * nsamples);
+  srsran_iq_converter_from_wire(&handler->converter, handler->rx_buffer, data, nsamples);
 
   return nsamples;
 }
@@ -504,7 +518,7 @@ int rf_blade_send_timed(void*       h,
     return -1;
   }
 
-  srsran_vec_convert_fi(data, 2048, handler->tx_buffer, 2 * nsamples);
+  srsran_iq_converter_to_wire(&handler->converter, data, handler->tx_buffer, nsamples);
 
   memset(&meta, 0, sizeof(meta));
   if (is_start_of_burst) {
@@ -70,6 +70,12 @@ typedef struct {
  */
 
 static void update_rates(rf_file_handler_t* handler, double srate);
+static int  rf_file_open_file_format(void**             h,
+                                     FILE**             rx_files,
+                                     FILE**             tx_files,
+                                     uint32_t           nof_channels,
+                                     uint32_t           base_srate,
+                                     srsran_iq_format_t format);
 
 void rf_file_info(char* id, const char* format, ...)
 {
@@ -179,12 +185,23 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
   FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t           base_srate = FILE_BASERATE_DEFAULT_HZ;
+    srsran_iq_format_t format     = SRSRAN_IQ_FORMAT_FC32;
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
       parse_uint32(args, "base_srate", -1, &base_srate);
+
+      // format of the samples in the files
+      char format_str[RF_PARAM_LEN] = {};
+      if (parse_string(args, "format", -1, format_str) == SRSRAN_SUCCESS) {
+        format = srsran_iq_format_from_str(format_str);
+        if (format == SRSRAN_IQ_FORMAT_INVALID) {
+          fprintf(stderr, "[file] Error: unsupported sample format %s\n", format_str);
+          goto clean_exit;
+        }
+      }
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
@@ -219,7 +236,7 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
     }
 
     // defer further initialization to open_file method
-    ret = rf_file_open_file(h, rx_files, tx_files, nof_channels, base_srate);
+    ret = rf_file_open_file_format(h, rx_files, tx_files, nof_channels, base_srate, format);
     if (ret != SRSRAN_SUCCESS) {
       goto clean_exit;
     }
@@ -243,6 +260,16 @@ clean_exit:
 }
 
 int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_channels, uint32_t base_srate)
+{
+  return rf_file_open_file_format(h, rx_files, tx_files, nof_channels, base_srate, SRSRAN_IQ_FORMAT_FC32);
+}
+
+static int rf_file_open_file_format(void**             h,
+                                    FILE**             rx_files,
+                                    FILE**             tx_files,
+                                    uint32_t           nof_channels,
+                                    uint32_t           base_srate,
+                                    srsran_iq_format_t format)
 {
   int ret = SRSRAN_ERROR;
 
@@ -290,9 +317,8 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     // TODO: set some meaningful ID in handler->id
 
     // rx_format, tx_format
-    // TODO: add other formats
-    rx_opts.sample_format = FILERF_TYPE_FC32;
-    tx_opts.sample_format = FILERF_TYPE_FC32;
+    rx_opts.sample_format = format;
+    tx_opts.sample_format = format;
 
     update_rates(handler, 1.92e6);
 
@@ -40,7 +40,10 @@ int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
     q->file = opts.file;
 
     // Configure formats
-    q->sample_format = opts.sample_format;
+    if (srsran_iq_converter_init(&q->converter, opts.sample_format, 0.0f, 0) < SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error: invalid rx sample format\n");
+      goto clean_exit;
+    }
     q->frequency_mhz = opts.frequency_mhz;
 
     q->temp_buffer = srsran_vec_malloc(FILE_MAX_BUFFER_SIZE);
@@ -71,10 +74,18 @@ clean_exit:
 
 int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  uint32_t sample_sz = sizeof(cf_t);
+  void*    buf       = buffer;
+  uint32_t sample_sz = srsran_iq_format_sample_sz(q->converter.format);
 
-  int ret = fread(buffer, sample_sz, nsamples, q->file);
+  if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
+    buf = q->temp_buffer_convert;
+  }
+
+  int ret = fread(buf, sample_sz, nsamples, q->file);
   if (ret > 0) {
+    if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
+      srsran_iq_converter_from_wire(&q->converter, buf, buffer, ret);
+    }
     return ret;
   } else {
     return SRSRAN_ERROR_RX_EOF;
@@ -23,6 +23,7 @@
 #define SRSRAN_RF_FILE_IMP_TRX_H
 
 #include "srsran/config.h"
+#include "srsran/phy/utils/iq_converter.h"
 #include <math.h>
 #include <pthread.h>
 #include <stdbool.h>
@@ -40,39 +41,37 @@
 #define FILE_MAX_GAIN_DB (30.0f)
 #define FILE_MIN_GAIN_DB (0.0f)
 
-typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16 } rf_file_format_t;
-
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_mutex_t  mutex;
-  cf_t*            zeros;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
-  int32_t          sample_offset;
+  char                  id[FILE_ID_STRLEN];
+  srsran_iq_converter_t converter;
+  FILE*                 file;
+  uint64_t              nsamples;
+  bool                  running;
+  pthread_mutex_t       mutex;
+  cf_t*                 zeros;
+  void*                 temp_buffer_convert;
+  uint32_t              frequency_mhz;
+  int32_t               sample_offset;
 } rf_file_tx_t;
 
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_t        thread;
-  pthread_mutex_t  mutex;
-  cf_t*            temp_buffer;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
+  char                  id[FILE_ID_STRLEN];
+  srsran_iq_converter_t converter;
+  FILE*                 file;
+  uint64_t              nsamples;
+  bool                  running;
+  pthread_t             thread;
+  pthread_mutex_t       mutex;
+  cf_t*                 temp_buffer;
+  void*                 temp_buffer_convert;
+  uint32_t              frequency_mhz;
 } rf_file_rx_t;
 
 typedef struct {
-  const char*      id;
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint32_t         frequency_mhz;
+  const char*        id;
+  srsran_iq_format_t sample_format;
+  FILE*              file;
+  uint32_t           frequency_mhz;
 } rf_file_opts_t;
 
 /*
@@ -43,7 +43,10 @@ int rf_file_tx_open(rf_file_tx_t* q, rf_file_opts_t opts)
     q->file = opts.file;
 
     // Configure formats
-    q->sample_format = opts.sample_format;
+    if (srsran_iq_converter_init(&q->converter, opts.sample_format, 0.0f, 0) < SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error: invalid tx sample format\n");
+      goto clean_exit;
+    }
     q->frequency_mhz = opts.frequency_mhz;
 
     q->temp_buffer_convert = srsran_vec_malloc(FILE_MAX_BUFFER_SIZE);
@@ -79,12 +82,11 @@ static int _rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples
 
   // convert samples if necessary
   void*    buf       = (buffer) ? buffer : q->zeros;
-  uint32_t sample_sz = sizeof(cf_t);
+  uint32_t sample_sz = srsran_iq_format_sample_sz(q->converter.format);
 
-  if (q->sample_format == FILERF_TYPE_SC16) {
-    buf       = q->temp_buffer_convert;
-    sample_sz = 2 * sizeof(short);
-    srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+  if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
+    srsran_iq_converter_to_wire(&q->converter, buf, q->temp_buffer_convert, nsamples);
+    buf = q->temp_buffer_convert;
   }
 
   size_t ret = fwrite(buf, (size_t)sample_sz, (size_t)nsamples, q->file);
@@ -184,6 +186,15 @@ void rf_file_tx_close(rf_file_tx_t* q)
   q->running = false;
   pthread_mutex_unlock(&q->mutex);
 
+  uint64_t nof_saturated = srsran_iq_converter_get_saturated(&q->converter);
+  if (nof_saturated > 0) {
+    fprintf(stderr,
+            "[file] %s: %" PRIu64 " I/Q components saturated in %s format\n",
+            q->id,
+            nof_saturated,
+            srsran_iq_format_to_str(q->converter.format));
+  }
+
   pthread_mutex_destroy(&q->mutex);
 
   if (q->zeros) {
@@ -47,6 +47,7 @@ typedef struct {
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
   uint32_t rx_freq_mhz[SRSRAN_MAX_CHANNELS];
   bool     tx_off;
+  bool     virtual_clock; // do not pace reception to wall-clock, advance time as soon as peers exchange samples
   char     id[RF_PARAM_LEN];
 
   // Server
@@ -61,6 +62,7 @@ typedef struct {
   // Rx timestamp
   uint64_t next_rx_ts;
 
+  pthread_mutex_t rx_ts_mutex;
   pthread_mutex_t tx_config_mutex;
   pthread_mutex_t rx_config_mutex;
   pthread_mutex_t decim_mutex;
@@ -123,6 +125,22 @@ static inline int update_ts(void* h, uint64_t* ts, int nsamples, const char* dir
   return ret;
 }
 
+// The Rx timestamp is written by the receiving thread and read by rf_zmq_get_time from any other thread
+static uint64_t get_rx_ts(rf_zmq_handler_t* handler)
+{
+  pthread_mutex_lock(&handler->rx_ts_mutex);
+  uint64_t ts = handler->next_rx_ts;
+  pthread_mutex_unlock(&handler->rx_ts_mutex);
+  return ts;
+}
+
+static void update_rx_ts(rf_zmq_handler_t* handler, uint32_t nsamples)
+{
+  pthread_mutex_lock(&handler->rx_ts_mutex);
+  update_ts(handler, &handler->next_rx_ts, nsamples, "rx");
+  pthread_mutex_unlock(&handler->rx_ts_mutex);
+}
+
 int rf_zmq_handle_error(char* id, const char* text)
 {
   int ret = SRSRAN_SUCCESS;
@@ -225,6 +243,9 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
     tx_opts.id            = handler->id;
     rx_opts.id            = handler->id;
 
+    if (pthread_mutex_init(&handler->rx_ts_mutex, NULL)) {
+      perror("Mutex init");
+    }
     if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
       perror("Mutex init");
     }
@@ -246,8 +267,19 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       // id
       parse_string(args, "id", -1, handler->id);
 
-      // rx_type
       char tmp[RF_PARAM_LEN] = {0};
+
+      // clock
+      if (parse_string(args, "clock", -1, tmp) == SRSRAN_SUCCESS) {
+        if (!strcmp(tmp, "virtual")) {
+          handler->virtual_clock = true;
+        } else if (strcmp(tmp, "realtime") != 0) {
+          printf("Unsupported clock type %s\n", tmp);
+          goto clean_exit;
+        }
+      }
+
+      // rx_type
       if (parse_string(args, "rx_type", -1, tmp) == SRSRAN_SUCCESS) {
         if (!strcmp(tmp, "sub")) {
           rx_opts.socket_type = ZMQ_SUB;
@@ -258,11 +290,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       }
 
       // rx_format
-      rx_opts.sample_format = ZMQ_TYPE_FC32;
+      rx_opts.sample_format = SRSRAN_IQ_FORMAT_FC32;
       if (parse_string(args, "rx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          rx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
+        rx_opts.sample_format = srsran_iq_format_from_str(tmp);
+        if (rx_opts.sample_format == SRSRAN_IQ_FORMAT_INVALID) {
           printf("Unsupported sample format %s\n", tmp);
           goto clean_exit;
         }
@@ -279,11 +310,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       }
 
       // tx_format
-      tx_opts.sample_format = ZMQ_TYPE_FC32;
+      tx_opts.sample_format = SRSRAN_IQ_FORMAT_FC32;
       if (parse_string(args, "tx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          tx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
+        tx_opts.sample_format = srsran_iq_format_from_str(tmp);
+        if (tx_opts.sample_format == SRSRAN_IQ_FORMAT_INVALID) {
           printf("Unsupported sample format %s\n", tmp);
           goto clean_exit;
         }
@@ -424,6 +454,7 @@ int rf_zmq_close(void* h)
     free(handler->buffer_tx);
   }
 
+  pthread_mutex_destroy(&handler->rx_ts_mutex);
   pthread_mutex_destroy(&handler->tx_config_mutex);
   pthread_mutex_destroy(&handler->rx_config_mutex);
   pthread_mutex_destroy(&handler->decim_mutex);
@@ -578,12 +609,20 @@ double rf_zmq_set_tx_freq(void* h, uint32_t ch, double freq)
 void rf_zmq_get_time(void* h, time_t* secs, double* frac_secs)
 {
   if (h) {
+    rf_zmq_handler_t* handler = (rf_zmq_handler_t*)h;
+
+    // In virtual clock mode the device time is given by the number of received samples
+    srsran_timestamp_t ts = {};
+    if (handler->virtual_clock) {
+      srsran_timestamp_init_uint64(&ts, get_rx_ts(handler), handler->base_srate);
+    }
+
     if (secs) {
-      *secs = 0;
+      *secs = ts.full_secs;
     }
 
     if (frac_secs) {
-      *frac_secs = 0;
+      *frac_secs = ts.frac_secs;
     }
   }
 }
@@ -680,16 +719,17 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id, "Rx %d samples (%d B)\n", nsamples, nbytes);
 
     // set timestamp for this reception
+    uint64_t rx_ts = get_rx_ts(handler);
     if (secs != NULL && frac_secs != NULL) {
       srsran_timestamp_t ts = {};
-      srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+      srsran_timestamp_init_uint64(&ts, rx_ts, handler->base_srate);
       *secs      = ts.full_secs;
       *frac_secs = ts.frac_secs;
     }
 
     // return if receiver is turned off
     if (!rf_zmq_rx_is_running(&handler->receiver[0])) {
-      update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
+      update_rx_ts(handler, nsamples_baserate);
       return nsamples;
     }
 
@@ -706,17 +746,31 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     // receive samples
     srsran_timestamp_t ts_tx = {}, ts_rx = {};
     srsran_timestamp_init_uint64(&ts_tx, rf_zmq_tx_get_nsamples(&handler->transmitter[0]), handler->base_srate);
-    srsran_timestamp_init_uint64(&ts_rx, handler->next_rx_ts, handler->base_srate);
+    srsran_timestamp_init_uint64(&ts_rx, rx_ts, handler->base_srate);
     rf_zmq_info(handler->id, " - next rx time: %d + %.3f\n", ts_rx.full_secs, ts_rx.frac_secs);
     rf_zmq_info(handler->id, " - next tx time: %d + %.3f\n", ts_tx.full_secs, ts_tx.frac_secs);
 
-    // Leave time for the Tx to transmit
-    usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    // Leave time for the Tx to transmit, then fill the tx gap, if any, with zeros. With a virtual clock, the REQ/REP
+    // exchange with the peers is the only pacing and time advances as fast as all of them produce and consume samples.
+    // The gap is then only filled when the received samples are not already buffered, as the peers may be waiting for
+    // this radio to transmit. Otherwise, the padding could run ahead of the PHY, which has no sleep to transmit in
+    bool fill_tx_gap = true;
+    if (!handler->virtual_clock) {
+      usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    } else {
+      fill_tx_gap = false;
+      for (uint32_t i = 0; i < handler->nof_channels; i++) {
+        if (rf_zmq_rx_is_running(&handler->receiver[i]) &&
+            rf_zmq_rx_get_nsamples_available(&handler->receiver[i]) < nsamples_baserate) {
+          fill_tx_gap = true;
+        }
+      }
+    }
 
     // check for tx gap if we're also transmitting on this radio
-    for (int i = 0; i < handler->nof_channels; i++) {
+    for (int i = 0; i < handler->nof_channels && fill_tx_gap; i++) {
       if (rf_zmq_tx_is_running(&handler->transmitter[i])) {
-        rf_zmq_tx_align(&handler->transmitter[i], handler->next_rx_ts + nsamples_baserate);
+        rf_zmq_tx_align(&handler->transmitter[i], rx_ts + nsamples_baserate);
       }
     }
 
@@ -822,7 +876,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     }
 
     // update rx time
-    update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
+    update_rx_ts(handler, nsamples_baserate);
   }
 
   ret = nsamples;
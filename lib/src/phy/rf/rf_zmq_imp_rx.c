@@ -117,13 +117,17 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
     q->socket_type        = opts.socket_type;
-    q->sample_format      = opts.sample_format;
     q->frequency_mhz      = opts.frequency_mhz;
     q->fail_on_disconnect = opts.fail_on_disconnect;
     q->sample_offset      = opts.sample_offset;
     q->trx_timeout_ms     = opts.trx_timeout_ms;
     q->log_trx_timeout    = opts.log_trx_timeout;
 
+    if (srsran_iq_converter_init(&q->converter, opts.sample_format, 0.0f, 0) < SRSRAN_SUCCESS) {
+      fprintf(stderr, "[zmq] Error: invalid receiver sample format\n");
+      goto clean_exit;
+    }
+
     if (opts.socket_type == ZMQ_SUB) {
       zmq_setsockopt(q->sock, ZMQ_SUBSCRIBE, "", 0);
     }
@@ -210,10 +214,9 @@ clean_exit:
 int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
   void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
-  if (q->sample_format != ZMQ_TYPE_FC32) {
+  uint32_t sample_sz  = srsran_iq_format_sample_sz(q->converter.format);
+  if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
     dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
   }
 
   // If the read needs to be delayed
@@ -243,13 +246,18 @@ int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
     return n;
   }
 
-  if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+  if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
+    srsran_iq_converter_from_wire(&q->converter, dst_buffer, buffer, nsamples);
   }
 
   return n;
 }
 
+uint32_t rf_zmq_rx_get_nsamples_available(rf_zmq_rx_t* q)
+{
+  return srsran_ringbuffer_status(&q->ringbuffer) / srsran_iq_format_sample_sz(q->converter.format);
+}
+
 bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz)
 {
   bool ret = false;
@@ -23,6 +23,7 @@
 #define SRSRAN_RF_ZMQ_IMP_TRX_H
 
 #include <pthread.h>
+#include <srsran/phy/utils/iq_converter.h>
 #include <srsran/phy/utils/ringbuffer.h>
 #include <stdbool.h>
 
@@ -38,54 +39,52 @@
 #define ZMQ_MAX_GAIN_DB (30.0f)
 #define ZMQ_MIN_GAIN_DB (0.0f)
 
-typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
-
 typedef struct {
-  char            id[ZMQ_ID_STRLEN];
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  void*           sock;
-  uint64_t        nsamples;
-  bool            running;
-  pthread_mutex_t mutex;
-  cf_t*           zeros;
-  void*           temp_buffer_convert;
-  uint32_t        frequency_mhz;
-  int32_t         sample_offset;
+  char                  id[ZMQ_ID_STRLEN];
+  uint32_t              socket_type;
+  srsran_iq_converter_t converter;
+  void*                 sock;
+  uint64_t              nsamples;
+  bool                  running;
+  pthread_mutex_t       mutex;
+  cf_t*                 zeros;
+  void*                 temp_buffer_convert;
+  uint32_t              frequency_mhz;
+  int32_t               sample_offset;
 } rf_zmq_tx_t;
 
 typedef struct {
-  char            id[ZMQ_ID_STRLEN];
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  void*           sock;
+  char                  id[ZMQ_ID_STRLEN];
+  uint32_t              socket_type;
+  srsran_iq_converter_t converter;
+  void*                 sock;
 #if ZMQ_MONITOR
   void* socket_monitor;
   bool  tx_connected;
 #endif
-  uint64_t            nsamples;
-  bool                running;
-  pthread_t           thread;
-  pthread_mutex_t     mutex;
-  srsran_ringbuffer_t ringbuffer;
-  cf_t*               temp_buffer;
-  void*               temp_buffer_convert;
-  uint32_t            frequency_mhz;
-  bool                fail_on_disconnect;
-  uint32_t            trx_timeout_ms;
-  bool                log_trx_timeout;
-  int32_t             sample_offset;
+  uint64_t              nsamples;
+  bool                  running;
+  pthread_t             thread;
+  pthread_mutex_t       mutex;
+  srsran_ringbuffer_t   ringbuffer;
+  cf_t*                 temp_buffer;
+  void*                 temp_buffer_convert;
+  uint32_t              frequency_mhz;
+  bool                  fail_on_disconnect;
+  uint32_t              trx_timeout_ms;
+  bool                  log_trx_timeout;
+  int32_t               sample_offset;
 } rf_zmq_rx_t;
 
 typedef struct {
-  const char*     id;
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  uint32_t        frequency_mhz;
-  bool            fail_on_disconnect;
-  uint32_t        trx_timeout_ms;
-  bool            log_trx_timeout;
-  int32_t         sample_offset; ///< offset in samples
+  const char*        id;
+  uint32_t           socket_type;
+  srsran_iq_format_t sample_format;
+  uint32_t           frequency_mhz;
+  bool               fail_on_disconnect;
+  uint32_t           trx_timeout_ms;
+  bool               log_trx_timeout;
+  int32_t            sample_offset; ///< offset in samples
 } rf_zmq_opts_t;
 
 /*
@@ -123,6 +122,8 @@ SRSRAN_API int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples);
 
+SRSRAN_API uint32_t rf_zmq_rx_get_nsamples_available(rf_zmq_rx_t* q);
+
 SRSRAN_API bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz);
 
 SRSRAN_API void rf_zmq_rx_close(rf_zmq_rx_t* q);
@@ -46,10 +46,14 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
     q->socket_type   = opts.socket_type;
-    q->sample_format = opts.sample_format;
     q->frequency_mhz = opts.frequency_mhz;
     q->sample_offset = opts.sample_offset;
 
+    if (srsran_iq_converter_init(&q->converter, opts.sample_format, 0.0f, 0) < SRSRAN_SUCCESS) {
+      fprintf(stderr, "[zmq] Error: invalid transmitter sample format\n");
+      goto clean_exit;
+    }
+
     rf_zmq_info(q->id, "Binding transmitter: %s\n", sock_args);
 
     ret = zmq_bind(q->sock, sock_args);
@@ -129,12 +133,11 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
 
     // convert samples if necessary
     void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
+    uint32_t sample_sz = srsran_iq_format_sample_sz(q->converter.format);
 
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+    if (q->converter.format != SRSRAN_IQ_FORMAT_FC32) {
+      srsran_iq_converter_to_wire(&q->converter, buf, q->temp_buffer_convert, nsamples);
+      buf = q->temp_buffer_convert;
     }
 
     // Send base-band if request was received
@@ -145,10 +148,10 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != sample_sz * nsamples) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     sample_sz * nsamples,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -244,6 +247,15 @@ void rf_zmq_tx_close(rf_zmq_tx_t* q)
   q->running = false;
   pthread_mutex_unlock(&q->mutex);
 
+  uint64_t nof_saturated = srsran_iq_converter_get_saturated(&q->converter);
+  if (nof_saturated > 0) {
+    fprintf(stderr,
+            "[zmq] %s: %" PRIu64 " I/Q components saturated in %s format\n",
+            q->id,
+            nof_saturated,
+            srsran_iq_format_to_str(q->converter.format));
+  }
+
   pthread_mutex_destroy(&q->mutex);
 
   if (q->zeros) {
@@ -24,6 +24,7 @@
 #include "srsran/phy/common/timestamp.h"
 #include "srsran/phy/utils/debug.h"
 #include <complex.h>
+#include <math.h>
 #include <pthread.h>
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
@@ -45,6 +46,7 @@ static cf_t enb_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
 
 static srsran_rf_t ue_radio, enb_radio;
 pthread_t          rx_thread;
+static int         ue_rx_ret = SRSRAN_ERROR;
 
 void* ue_rx_thread_function(void* args)
 {
@@ -61,18 +63,48 @@ void* ue_rx_thread_function(void* args)
   }
 
   // receive 5 subframes at once (i.e. mimic initial rx that receives one slot)
-  uint32_t num_slots          = NUM_SF / 5;
-  uint32_t num_samps_per_slot = SF_LEN * 5;
-  uint32_t num_rxed_samps     = 0;
+  uint32_t           num_slots          = NUM_SF / 5;
+  uint32_t           num_samps_per_slot = SF_LEN * 5;
+  uint32_t           num_rxed_samps     = 0;
+  srsran_timestamp_t rx_time = {}, slot_duration = {};
+
+  ue_rx_ret = SRSRAN_SUCCESS;
   for (uint32_t i = 0; i < num_slots; ++i) {
     void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
     for (uint32_t c = 0; c < NOF_RX_ANT; c++) {
       data_ptr[c] = &ue_rx_buffer[c][i * num_samps_per_slot];
     }
-    num_rxed_samps += srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, num_samps_per_slot, true, NULL, NULL);
+    num_rxed_samps += srsran_rf_recv_with_time_multi(
+        &ue_radio, data_ptr, num_samps_per_slot, true, &rx_time.full_secs, &rx_time.frac_secs);
+
+    // The Rx time is given by the number of samples received so far, so it advances one slot per reception
+    if (i == 1) {
+      srsran_timestamp_copy(&slot_duration, &rx_time);
+    }
+    double expected_s = i * srsran_timestamp_real(&slot_duration);
+    if ((i == 0 && srsran_timestamp_real(&rx_time) != 0.0) ||
+        (i > 0 && fabs(srsran_timestamp_real(&rx_time) - expected_s) > 1e-9)) {
+      fprintf(stderr, "Rx time of slot %d is %.9f s, expected %.9f s\n", i, srsran_timestamp_real(&rx_time), expected_s);
+      ue_rx_ret = SRSRAN_ERROR;
+    }
   }
 
   printf("received %d samples.\n", num_rxed_samps);
+  if (num_rxed_samps != num_slots * num_samps_per_slot) {
+    fprintf(stderr, "Received %d samples, expected %d\n", num_rxed_samps, num_slots * num_samps_per_slot);
+    ue_rx_ret = SRSRAN_ERROR;
+  }
+
+  // With a virtual clock, the device time is the time of the samples received so far
+  if (strstr(rf_args, "clock=virtual") != NULL) {
+    srsran_timestamp_t now = {};
+    srsran_rf_get_time(&ue_radio, &now.full_secs, &now.frac_secs);
+    double expected_s = num_slots * srsran_timestamp_real(&slot_duration);
+    if (fabs(srsran_timestamp_real(&now) - expected_s) > 1e-9) {
+      fprintf(stderr, "Device time is %.9f s, expected %.9f s\n", srsran_timestamp_real(&now), expected_s);
+      ue_rx_ret = SRSRAN_ERROR;
+    }
+  }
 
   printf("closing ue zmq device\n");
   srsran_rf_close(&ue_radio);
@@ -173,6 +205,9 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
 
   // wait for rx thread
   pthread_join(rx_thread, NULL);
+  if (ue_rx_ret != SRSRAN_SUCCESS) {
+    goto exit;
+  }
 
   // channel-wise comparison
   for (int c = 0; c < NOF_RX_ANT; c++) {
@@ -315,5 +350,16 @@ int main()
     return -1;
   }
 
+  // up to 4 trx radios with continous tx (timed tx) and virtual clock, the device time follows the received samples
+  if (run_test("tx_port=tcp://*:5554,tx_port=tcp://*:5556,tx_port=tcp://*:5558,tx_port=tcp://*:5560,rx_port=ipc://"
+               "dl0,rx_port=ipc://dl1,rx_port=ipc://dl2,rx_port=ipc://dl3,id=ue,base_srate=1.92e6,clock=virtual",
+               "rx_port=tcp://localhost:5554,rx_port=tcp://localhost:5556,rx_port=tcp://localhost:5558,rx_port=tcp://"
+               "localhost:5560,tx_port=ipc://dl0,tx_port=ipc://dl1,tx_port=ipc://dl2,tx_port=ipc://"
+               "dl3,id=enb,base_srate=1.92e6,clock=virtual",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx and virtual clock failed!\n");
+    return -1;
+  }
+
   return SRSRAN_SUCCESS;
 }
@@ -193,6 +193,15 @@ int srsran_ue_ul_set_cfr(srsran_ue_ul_t* q, const srsran_cfr_cfg_t* cfr)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ue_ul_get_cfr_metrics(srsran_ue_ul_t* q, srsran_cfr_metrics_t* metrics)
+{
+  if (q == NULL || metrics == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  return srsran_cfr_get_metrics(&q->fft.tx_cfr, metrics);
+}
+
 int srsran_ue_ul_pregen_signals(srsran_ue_ul_t* q, srsran_ue_ul_cfg_t* cfg)
 {
   if (q->signals_pregenerated) {
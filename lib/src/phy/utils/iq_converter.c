@@ -0,0 +1,261 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "srsran/phy/utils/iq_converter.h"
+#include "srsran/phy/utils/vector.h"
+
+// Largest integer of each wire format
+#define IQ_SC16_MAX INT16_MAX
+#define IQ_SC12_MAX 2047
+#define IQ_SC8_MAX INT8_MAX
+
+// Counts the components whose scaled magnitude exceeds the integer range. Written as a branchless reduction so the
+// compiler vectorises it
+static uint32_t iq_count_saturated(const float* x, float scale, float max_value, uint32_t len)
+{
+  const float thr   = max_value / scale;
+  uint32_t    count = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    count += (fabsf(x[i]) > thr);
+  }
+  return count;
+}
+
+// The narrow formats are converted to 16-bit first with the SIMD kernel, then saturated and packed per block
+#define IQ_BLOCK_LEN 512
+
+static inline int16_t iq_clamp(int16_t x, int16_t max_value)
+{
+  x = (x > max_value) ? max_value : x;
+  x = (x < -max_value) ? -max_value : x;
+  return x;
+}
+
+static void iq_clamp_sc16(int16_t* x, int16_t max_value, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    x[i] = iq_clamp(x[i], max_value);
+  }
+}
+
+static void iq_to_sc12(const float* x, float scale, int16_t max_value, uint8_t* z, uint32_t nsamples)
+{
+  int16_t tmp[IQ_BLOCK_LEN];
+  for (uint32_t i = 0; i < nsamples; i += IQ_BLOCK_LEN / 2) {
+    uint32_t n = SRSRAN_MIN(IQ_BLOCK_LEN / 2, nsamples - i);
+    srsran_vec_convert_fi(&x[2 * i], scale, tmp, 2 * n);
+
+    // I in the 12 LSB, Q in the 12 MSB of a little-endian 24-bit word
+    uint8_t* restrict out = &z[3 * i];
+    for (uint32_t j = 0; j < n; j++) {
+      int16_t re     = iq_clamp(tmp[2 * j], max_value);
+      int16_t im     = iq_clamp(tmp[2 * j + 1], max_value);
+      out[3 * j]     = (uint8_t)(re & 0xff);
+      out[3 * j + 1] = (uint8_t)(((re >> 8) & 0x0f) | ((im & 0x0f) << 4));
+      out[3 * j + 2] = (uint8_t)((im >> 4) & 0xff);
+    }
+  }
+}
+
+static void iq_from_sc12(const uint8_t* x, float scale, float* z, uint32_t nsamples)
+{
+  const float gain = 1.0f / scale;
+  for (uint32_t i = 0; i < nsamples; i++) {
+    // Sign-extend the 12-bit components through the 16-bit shift
+    int16_t re = (int16_t)((uint16_t)(x[3 * i] | ((x[3 * i + 1] & 0x0f) << 8)) << 4) >> 4;
+    int16_t im = (int16_t)((uint16_t)((x[3 * i + 1] >> 4) | (x[3 * i + 2] << 4)) << 4) >> 4;
+
+    z[2 * i]     = (float)re * gain;
+    z[2 * i + 1] = (float)im * gain;
+  }
+}
+
+static void iq_to_sc8(const float* x, float scale, int16_t max_value, int8_t* z, uint32_t len)
+{
+  int16_t tmp[IQ_BLOCK_LEN];
+  for (uint32_t i = 0; i < len; i += IQ_BLOCK_LEN) {
+    uint32_t n = SRSRAN_MIN(IQ_BLOCK_LEN, len - i);
+    srsran_vec_convert_fi(&x[i], scale, tmp, n);
+
+    int8_t* restrict out = &z[i];
+    for (uint32_t j = 0; j < n; j++) {
+      out[j] = (int8_t)iq_clamp(tmp[j], max_value);
+    }
+  }
+}
+
+static void iq_from_sc8(const int8_t* x, float scale, float* z, uint32_t len)
+{
+  const float gain = 1.0f / scale;
+  for (uint32_t i = 0; i < len; i++) {
+    z[i] = (float)x[i] * gain;
+  }
+}
+
+int srsran_iq_converter_init(srsran_iq_converter_t* q, srsran_iq_format_t format, float scale, int32_t max_value)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  switch (format) {
+    case SRSRAN_IQ_FORMAT_FC32:
+      q->max_value = 0;
+      break;
+    case SRSRAN_IQ_FORMAT_SC16:
+      q->max_value = IQ_SC16_MAX;
+      break;
+    case SRSRAN_IQ_FORMAT_SC12:
+      q->max_value = IQ_SC12_MAX;
+      break;
+    case SRSRAN_IQ_FORMAT_SC8:
+      q->max_value = IQ_SC8_MAX;
+      break;
+    default:
+      return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The device may accept a narrower range than the format, e.g. 12-bit samples in 16-bit words
+  if (max_value > 0 && max_value < q->max_value) {
+    q->max_value = max_value;
+  }
+
+  q->format        = format;
+  q->scale         = isnormal(scale) ? scale : (float)q->max_value;
+  q->nof_saturated = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_iq_converter_to_wire(srsran_iq_converter_t* q, const cf_t* in, void* out, uint32_t nsamples)
+{
+  const float* x             = (const float*)in;
+  uint32_t     len           = 2 * nsamples;
+  uint32_t     nof_saturated = 0;
+
+  if (q->format != SRSRAN_IQ_FORMAT_FC32) {
+    nof_saturated = iq_count_saturated(x, q->scale, (float)q->max_value, len);
+    q->nof_saturated += nof_saturated;
+  }
+
+  switch (q->format) {
+    case SRSRAN_IQ_FORMAT_FC32:
+      if (out != in) {
+        memcpy(out, in, sizeof(cf_t) * nsamples);
+      }
+      break;
+    case SRSRAN_IQ_FORMAT_SC16:
+      srsran_vec_convert_fi(x, q->scale, (int16_t*)out, len);
+      // The conversion saturates to the 16-bit range, clip to a narrower device range only if needed
+      if (nof_saturated > 0 && q->max_value < IQ_SC16_MAX) {
+        iq_clamp_sc16((int16_t*)out, (int16_t)q->max_value, len);
+      }
+      break;
+    case SRSRAN_IQ_FORMAT_SC12:
+      iq_to_sc12(x, q->scale, (int16_t)q->max_value, (uint8_t*)out, nsamples);
+      break;
+    case SRSRAN_IQ_FORMAT_SC8:
+      iq_to_sc8(x, q->scale, (int16_t)q->max_value, (int8_t*)out, len);
+      break;
+    default:
+      break;
+  }
+}
+
+void srsran_iq_converter_from_wire(srsran_iq_converter_t* q, const void* in, cf_t* out, uint32_t nsamples)
+{
+  float*   z   = (float*)out;
+  uint32_t len = 2 * nsamples;
+
+  switch (q->format) {
+    case SRSRAN_IQ_FORMAT_FC32:
+      if (out != in) {
+        memcpy(out, in, sizeof(cf_t) * nsamples);
+      }
+      break;
+    case SRSRAN_IQ_FORMAT_SC16:
+      srsran_vec_convert_if((const int16_t*)in, q->scale, z, len);
+      break;
+    case SRSRAN_IQ_FORMAT_SC12:
+      iq_from_sc12((const uint8_t*)in, q->scale, z, nsamples);
+      break;
+    case SRSRAN_IQ_FORMAT_SC8:
+      iq_from_sc8((const int8_t*)in, q->scale, z, len);
+      break;
+    default:
+      break;
+  }
+}
+
+uint64_t srsran_iq_converter_get_saturated(srsran_iq_converter_t* q)
+{
+  uint64_t ret     = q->nof_saturated;
+  q->nof_saturated = 0;
+  return ret;
+}
+
+uint32_t srsran_iq_format_sample_sz(srsran_iq_format_t format)
+{
+  switch (format) {
+    case SRSRAN_IQ_FORMAT_FC32:
+      return sizeof(cf_t);
+    case SRSRAN_IQ_FORMAT_SC16:
+      return 2 * sizeof(int16_t);
+    case SRSRAN_IQ_FORMAT_SC12:
+      return 3;
+    case SRSRAN_IQ_FORMAT_SC8:
+      return 2 * sizeof(int8_t);
+    default:
+      return 0;
+  }
+}
+
+srsran_iq_format_t srsran_iq_format_from_str(const char* str)
+{
+  if (str == NULL) {
+    return SRSRAN_IQ_FORMAT_INVALID;
+  }
+  for (uint32_t i = 0; i < SRSRAN_IQ_FORMAT_INVALID; i++) {
+    if (strcmp(str, srsran_iq_format_to_str((srsran_iq_format_t)i)) == 0) {
+      return (srsran_iq_format_t)i;
+    }
+  }
+  return SRSRAN_IQ_FORMAT_INVALID;
+}
+
+const char* srsran_iq_format_to_str(srsran_iq_format_t format)
+{
+  switch (format) {
+    case SRSRAN_IQ_FORMAT_FC32:
+      return "fc32";
+    case SRSRAN_IQ_FORMAT_SC16:
+      return "sc16";
+    case SRSRAN_IQ_FORMAT_SC12:
+      return "sc12";
+    case SRSRAN_IQ_FORMAT_SC8:
+      return "sc8";
+    default:
+      return "invalid";
+  }
+}
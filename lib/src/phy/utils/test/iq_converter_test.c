@@ -0,0 +1,177 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/iq_converter.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static uint32_t nof_samples     = 23040;
+static uint32_t nof_repetitions = 100;
+static uint32_t nof_saturated   = 16;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-N Number of samples [Default %d]\n", nof_samples);
+  printf("\t-r Number of benchmark repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s Number of saturated samples [Default %d]\n", nof_saturated);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "Nrs")) != -1) {
+    switch (opt) {
+      case 'N':
+        nof_samples = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        nof_saturated = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval* t)
+{
+  return (double)t[0].tv_sec * 1e6 + (double)t[0].tv_usec;
+}
+
+static int
+test_format(srsran_iq_format_t format, float scale, int32_t max_value, const cf_t* input, cf_t* output, void* wire)
+{
+  srsran_iq_converter_t q = {};
+  TESTASSERT(srsran_iq_converter_init(&q, format, scale, max_value) == SRSRAN_SUCCESS);
+  TESTASSERT(max_value == 0 || format == SRSRAN_IQ_FORMAT_FC32 || q.max_value == max_value);
+  TESTASSERT(srsran_iq_format_from_str(srsran_iq_format_to_str(format)) == format);
+
+  // Round trip, saturated samples are at the end of the input
+  srsran_iq_converter_to_wire(&q, input, wire, nof_samples);
+  srsran_iq_converter_from_wire(&q, wire, output, nof_samples);
+
+  uint32_t expected_saturated = (format == SRSRAN_IQ_FORMAT_FC32) ? 0 : 2 * nof_saturated;
+  TESTASSERT(srsran_iq_converter_get_saturated(&q) == expected_saturated);
+  TESTASSERT(srsran_iq_converter_get_saturated(&q) == 0);
+
+  // The error of the non-saturated samples is bounded by the quantization step
+  float max_err = 0.0f;
+  for (uint32_t i = 0; i < nof_samples - nof_saturated; i++) {
+    max_err = SRSRAN_MAX(max_err, fabsf(crealf(input[i]) - crealf(output[i])));
+    max_err = SRSRAN_MAX(max_err, fabsf(cimagf(input[i]) - cimagf(output[i])));
+  }
+  TESTASSERT(max_err <= 1.0f / q.scale);
+
+  // Saturated samples are clipped to full scale, the negative range may hold one more integer
+  for (uint32_t i = nof_samples - nof_saturated; i < nof_samples && q.max_value; i++) {
+    float out_abs = fabsf(crealf(output[i]));
+    TESTASSERT(out_abs >= (float)q.max_value / q.scale && out_abs <= (float)(q.max_value + 1) / q.scale);
+  }
+
+  // Benchmark
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_iq_converter_to_wire(&q, input, wire, nof_samples);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double to_wire_us = elapsed_us(t);
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_iq_converter_from_wire(&q, wire, output, nof_samples);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double from_wire_us = elapsed_us(t);
+
+  double total = (double)nof_samples * nof_repetitions;
+  printf("%s: %d bytes/sample; max_err=%.2e; to_wire=%.1f Msps; from_wire=%.1f Msps\n",
+         srsran_iq_format_to_str(format),
+         srsran_iq_format_sample_sz(format),
+         max_err,
+         total / to_wire_us,
+         total / from_wire_us);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+  if (nof_saturated > nof_samples) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0x1234);
+  cf_t*           input      = srsran_vec_cf_malloc(nof_samples);
+  cf_t*           output     = srsran_vec_cf_malloc(nof_samples);
+  void*           wire       = srsran_vec_malloc(nof_samples * sizeof(cf_t));
+  if (!random_gen || !input || !output || !wire) {
+    goto clean_exit;
+  }
+
+  srsran_random_uniform_complex_dist_vector(random_gen, input, nof_samples, -0.99f, +0.99f);
+  for (uint32_t i = nof_samples - nof_saturated; i < nof_samples; i++) {
+    input[i] = ((i % 2) ? 1.5f : -1.5f) * (1.0f + 1.0f * I);
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_IQ_FORMAT_INVALID; i++) {
+    if (test_format((srsran_iq_format_t)i, 0.0f, 0, input, output, wire) != SRSRAN_SUCCESS) {
+      printf("Failed format %s\n", srsran_iq_format_to_str((srsran_iq_format_t)i));
+      goto clean_exit;
+    }
+  }
+
+  // SC16 Q11, as streamed by bladeRF: saturation is counted and clipped against the 12-bit range
+  if (test_format(SRSRAN_IQ_FORMAT_SC16, 2048.0f, 2047, input, output, wire) != SRSRAN_SUCCESS) {
+    printf("Failed format %s Q11\n", srsran_iq_format_to_str(SRSRAN_IQ_FORMAT_SC16));
+    goto clean_exit;
+  }
+  TESTASSERT(srsran_iq_format_from_str("sc4") == SRSRAN_IQ_FORMAT_INVALID);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  free(input);
+  free(output);
+  free(wire);
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : tx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : rx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -295,25 +303,31 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio       = 1;     // No decimation by default
+  bool     rx_resample = false; // No rational resampling by default
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (rx_resamplers[0].interp > 0) {
+    rx_resample = true;
   }
 
-  // Calculate number of samples, considering the decimation ratio
+  // Calculate number of samples, considering the decimation ratio or the samples the resampler needs
   uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  if (rx_resample) {
+    nof_samples = srsran_resampler_poly_nof_input(&rx_resamplers[0], buffer.get_nof_samples());
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if ((ratio > 1 || rx_resample) && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +341,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, (ratio > 1 || rx_resample) ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -357,6 +371,28 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     }
   }
 
+  // Perform rational resampling, all channels shall be fed to keep their states aligned
+  if (rx_resample) {
+    // The first output sample precedes the first received sample by the resampler delay
+    double delay_s = srsran_resampler_poly_get_delay(&rx_resamplers[0]) / cur_rx_srate;
+    if (delay_s > 0) {
+      rxd_time.sub(delay_s);
+    } else {
+      rxd_time.add(-delay_s);
+    }
+
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (buffer.get(ch) and buffer_rx.get(ch)) {
+        uint32_t nof_out = buffer.get_nof_samples();
+        uint32_t n       = srsran_resampler_poly_run(
+            &rx_resamplers[ch], buffer_rx.get(ch), buffer_rx.get_nof_samples(), buffer.get(ch), nof_out);
+
+        // Fill with zeros if the resampler could not produce all the samples
+        srsran_vec_cf_zero(&buffer.get(ch)[n], nof_out - n);
+      }
+    }
+  }
+
   return ret;
 }
 
@@ -442,6 +478,35 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
     nof_samples = tx_buffer[0].size() / ratio;
   }
 
+  // Rational resampling output size shall not exceed the buffer size either
+  const srsran_resampler_poly_t* resampler = &tx_resamplers[0];
+  if (resampler->interp > 0 && srsran_resampler_poly_nof_output(resampler, nof_samples) > tx_buffer[0].size()) {
+    logger.info("Tx number of samples (%d/%d) exceeds buffer size (%zd)",
+                nof_samples,
+                srsran_resampler_poly_nof_output(resampler, nof_samples),
+                tx_buffer[0].size());
+
+    // Limit number of samples to transmit
+    nof_samples = (uint32_t)(((tx_buffer[0].size() - 1) * resampler->decim) / resampler->interp);
+  }
+
+  // If the resampler has been set, resample. The first output sample precedes the first input sample by the resampler
+  // delay
+  double resampler_delay_s = 0.0;
+  if (resampler->interp > 0) {
+    resampler_delay_s = srsran_resampler_poly_get_delay_s(resampler, cur_tx_srate);
+
+    uint32_t nof_resampled = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      nof_resampled = srsran_resampler_poly_run(
+          &tx_resamplers[ch], buffer.get(ch), nof_samples, tx_buffer[ch].data(), (uint32_t)tx_buffer[ch].size());
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the resampling
+    buffer.set_nof_samples(nof_resampled);
+  }
+
   // If the interpolator have been set, interpolate
   if (interpolators[0].ratio > 1) {
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
@@ -457,7 +522,13 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
-    ret &= tx_dev(device_idx, buffer, tx_time.get(device_idx));
+    srsran_timestamp_t ts = tx_time.get(device_idx);
+    if (resampler_delay_s > 0) {
+      srsran_timestamp_sub(&ts, 0, resampler_delay_s);
+    } else {
+      srsran_timestamp_add(&ts, 0, -resampler_delay_s);
+    }
+    ret &= tx_dev(device_idx, buffer, ts);
   }
 
   is_start_of_burst = false;
@@ -641,6 +712,10 @@ void radio::tx_end_nolock()
       srsran_rf_send_timed2(
           &rf_devices[i], zeros.data(), 0, end_of_burst_time[i].full_secs, end_of_burst_time[i].frac_secs, false, true);
     }
+    // The next burst shall not start with the filter history of this one
+    for (srsran_resampler_poly_t& q : tx_resamplers) {
+      srsran_resampler_poly_reset_state(&q);
+    }
     is_start_of_burst = true;
   }
 }
@@ -746,17 +821,24 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    if (((uint32_t)cur_rx_srate % (uint32_t)srate) == 0) {
+      // Update decimators
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&rx_resamplers[ch]);
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
+    } else {
+      // Non-integer ratio, use polyphase resamplers from the device rate to the baseband rate
+      uint32_t max_nsamples = (uint32_t)rx_buffer[0].size();
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&decimators[ch]);
+        srsran_assert(srsran_resampler_poly_init(
+                          &rx_resamplers[ch], (uint32_t)srate, (uint32_t)cur_rx_srate, max_nsamples) == SRSRAN_SUCCESS,
+                      "Error initialising Rx resampler (%.2f MHz / %.2f MHz)",
+                      cur_rx_srate / 1e6,
+                      srate / 1e6);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1084,24 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    if (((uint32_t)cur_tx_srate % (uint32_t)srate) == 0) {
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&tx_resamplers[ch]);
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
+    } else {
+      // Non-integer ratio, use polyphase resamplers from the baseband rate to the device rate
+      uint32_t max_nsamples = (uint32_t)(max_resamp_buf_sz_ms * srate) / 1000;
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&interpolators[ch]);
+        srsran_assert(srsran_resampler_poly_init(
+                          &tx_resamplers[ch], (uint32_t)cur_tx_srate, (uint32_t)srate, max_nsamples) == SRSRAN_SUCCESS,
+                      "Error initialising Tx resampler (%.2f MHz / %.2f MHz)",
+                      cur_tx_srate / 1e6,
+                      srate / 1e6);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include "srsran/radio/radio.h"
+
+/*
+ * Runs a radio in loopback over ZMQ with clock=virtual, and ticks a timer_handler once per received subframe, as the
+ * PHY does with the stack. The radio time shall advance by the number of received samples and the timers shall follow
+ * it, whatever the wall-clock time it takes to exchange them. The same holds with the real-time clock.
+ */
+
+static const double   srate_hz      = 1.92e6;
+static const uint32_t sf_sz         = (uint32_t)(1e-3 * srate_hz);
+static const uint32_t tx_delay_ms   = 4;
+static const uint32_t timer_dur_ms  = 1000;
+static const uint32_t nof_sf        = timer_dur_ms + 100;
+static const char*    virtual_args  = "tx_port=ipc:///tmp/test_radio_virtual_clock,rx_port=ipc:///tmp/"
+                                      "test_radio_virtual_clock,base_srate=1.92e6,clock=virtual";
+static const char*    realtime_args = "tx_port=ipc:///tmp/test_radio_realtime_clock,rx_port=ipc:///tmp/"
+                                      "test_radio_realtime_clock,base_srate=1.92e6";
+
+class phy_radio_listener : public srsran::phy_interface_radio
+{
+public:
+  void radio_overflow() override { srslog::fetch_basic_logger("TEST", false).error("Overflow"); }
+  void radio_failure() override { srslog::fetch_basic_logger("TEST", false).error("Failure"); }
+};
+
+/// Receives nof_sf subframes through the radio and checks the radio time and the timers against the sample count
+static int run_radio(const char* device_args)
+{
+  srsran::radio      radio;
+  phy_radio_listener radio_listener;
+
+  srsran::rf_args_t rf_args = {};
+  rf_args.log_level         = "info";
+  rf_args.srate_hz          = srate_hz;
+  rf_args.dl_freq           = 2.4e9;
+  rf_args.ul_freq           = 2.4e9;
+  rf_args.nof_carriers      = 1;
+  rf_args.nof_antennas      = 1;
+  rf_args.device_name       = "zmq";
+  rf_args.device_args       = device_args;
+  TESTASSERT(radio.init(rf_args, &radio_listener) == SRSRAN_SUCCESS);
+  radio.set_tx_freq(0, rf_args.ul_freq);
+  radio.set_rx_freq(0, rf_args.dl_freq);
+  radio.set_tx_srate(srate_hz);
+  radio.set_rx_srate(srate_hz);
+
+  srsran::timer_handler timers;
+  srsran::unique_timer  timer      = timers.get_unique_timer();
+  uint64_t              start_ts   = 0;
+  uint64_t              rx_ts      = 0;
+  uint64_t              expired_ts = 0;
+  timer.set(timer_dur_ms, [&rx_ts, &expired_ts](uint32_t tid) { expired_ts = rx_ts; });
+
+  std::vector<cf_t> buffer(sf_sz);
+  for (uint32_t sf = 0; sf < nof_sf; ++sf) {
+    srsran::rf_buffer_t rf_buffer = {};
+    rf_buffer.set(0, buffer.data());
+    rf_buffer.set_nof_samples(sf_sz);
+
+    srsran::rf_timestamp_t ts = {};
+    TESTASSERT(radio.rx_now(rf_buffer, ts));
+    srsran_timestamp_t rx_time = ts.get(0);
+    rx_ts                      = srsran_timestamp_uint64(&rx_time, srate_hz);
+    if (sf == 0) {
+      start_ts = rx_ts;
+    }
+    // The radio time advances one subframe per reception
+    TESTASSERT(rx_ts == start_ts + sf * sf_sz);
+
+    // Tick the timers once per TTI, as the stack does. The timer starts in the first TTI
+    timers.step_all();
+    if (sf == 0) {
+      timer.run();
+    }
+
+    // Keep the loopback fed, as the PHY does
+    srsran_vec_cf_zero(buffer.data(), sf_sz);
+    ts.add(1e-3 * tx_delay_ms);
+    radio.tx(rf_buffer, ts);
+  }
+  radio.stop();
+
+  // The timer expired when the radio time reached its duration
+  TESTASSERT(timer.is_expired());
+  TESTASSERT(expired_ts == start_ts + timer_dur_ms * sf_sz);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(run_radio(realtime_args) == SRSRAN_SUCCESS);
+  TESTASSERT(run_radio(virtual_args) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -25,6 +25,7 @@
 #include "srsran/rlc/rlc_tm.h"
 #include "srsran/rlc/rlc_um_lte.h"
 #include "srsran/rlc/rlc_um_nr.h"
+#include <bitset>
 
 namespace srsran {
 
@@ -325,6 +326,27 @@ void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   }
 }
 
+// The PDUs are written in the order given. The buffer state is reported once per LCID after all PDUs are written.
+// In the eNB the PDUs may be written by a RLC worker instead of the stack thread, so the lock is taken
+void rlc::write_pdus(span<const rlc_pdu_ref_t> pdus)
+{
+  rwlock_read_guard                   lock(rwlock);
+  std::bitset<SRSRAN_N_RADIO_BEARERS> written_lcids;
+  for (const rlc_pdu_ref_t& pdu : pdus) {
+    if (not valid_lcid(pdu.lcid)) {
+      logger.warning("LCID %d doesn't exist. Dropping PDU.", pdu.lcid);
+      continue;
+    }
+    rlc_array.at(pdu.lcid)->write_pdu_s(pdu.payload, pdu.nof_bytes);
+    written_lcids.set(pdu.lcid);
+  }
+  for (uint32_t lcid = 0; lcid < written_lcids.size(); ++lcid) {
+    if (written_lcids.test(lcid)) {
+      update_bsr(lcid);
+    }
+  }
+}
+
 // Pass directly to PDCP, no DL througput counting done
 void rlc::write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu)
 {
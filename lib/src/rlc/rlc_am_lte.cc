@@ -30,6 +30,8 @@
 #define TX_MOD_BASE(x) (((x)-vt_a) % 1024)
 #define LCID (parent->lcid)
 #define MAX_SDUS_PER_PDU (128)
+#define MAX_DATA_PDU_PAYLOAD_SIZE (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET)
+#define MAX_RX_SDU_SIZE (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET)
 
 namespace srsran {
 
@@ -143,8 +145,8 @@ void rlc_am_lte_tx::empty_queue_nolock()
   }
 
   // deallocate SDU that is currently processed
-  if (tx_sdu != nullptr) {
-    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu->md.pdcp_sn);
+  if (not tx_sdu.empty()) {
+    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu.metadata().pdcp_sn);
   }
   tx_sdu.reset();
 }
@@ -166,7 +168,7 @@ bool rlc_am_lte_tx::has_data()
 {
   return (((do_status() && not status_prohibit_timer.is_running())) || // if we have a status PDU to transmit
           (not retx_queue.empty()) ||                                  // if we have a retransmission
-          (tx_sdu != nullptr) ||                                       // if we are currently transmitting a SDU
+          (not tx_sdu.empty()) ||                                      // if we are currently transmitting a SDU
           (tx_sdu_queue.get_n_sdus() != 0)); // or if there is a SDU queued up for transmission
 }
 
@@ -254,9 +256,9 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
   if (not window_full()) {
     n_sdus = tx_sdu_queue.get_n_sdus();
     n_bytes_newtx += tx_sdu_queue.size_bytes();
-    if (tx_sdu != NULL) {
+    if (not tx_sdu.empty()) {
       n_sdus++;
-      n_bytes_newtx += tx_sdu->N_bytes;
+      n_bytes_newtx += tx_sdu.size();
     }
   }
 
@@ -360,7 +362,7 @@ void rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   rlc_amd_retx_lte_t& retx = retx_queue.push();
   retx.is_segment          = false;
   retx.so_start            = 0;
-  retx.so_end              = pdu.buf->N_bytes;
+  retx.so_end              = pdu.buf.size();
   retx.sn                  = pdu.rlc_sn;
 }
 
@@ -491,7 +493,7 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set poll bit
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.size() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d", pdu_without_poll);
   RlcInfo("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -508,32 +510,32 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  memcpy(ptr, tx_window[retx.sn].buf->msg, tx_window[retx.sn].buf->N_bytes);
+  tx_window[retx.sn].buf.copy_to(ptr);
 
   retx_queue.pop();
 
   RlcHexInfo(payload,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.size(),
              "Tx PDU SN=%d (%d B) (attempt %d/%d)",
              retx.sn,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.size(),
              tx_window[retx.sn].retx_count + 1,
              cfg.max_retx_thresh);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "Tx PDU - %s", new_header);
 
   debug_state();
-  return (ptr - payload) + tx_window[retx.sn].buf->N_bytes;
+  return (ptr - payload) + tx_window[retx.sn].buf.size();
 }
 
 int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx)
 {
-  if (tx_window[retx.sn].buf == NULL) {
-    RlcError("In build_segment: retx.sn=%d has null buffer", retx.sn);
+  if (tx_window[retx.sn].buf.empty()) {
+    RlcError("In build_segment: retx.sn=%d has empty buffer", retx.sn);
     return 0;
   }
   if (!retx.is_segment) {
     retx.so_start = 0;
-    retx.so_end   = tx_window[retx.sn].buf->N_bytes;
+    retx.so_end   = tx_window[retx.sn].buf.size();
   }
 
   // Construct new header
@@ -541,7 +543,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   rlc_amd_pdu_header_t old_header = tx_window[retx.sn].header;
 
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.size() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d, byte_without_poll: %d", pdu_without_poll, byte_without_poll);
 
   new_header.dc   = RLC_DC_FIELD_DATA_PDU;
@@ -641,7 +643,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   srsran_expect(head_len + (retx.so_end - retx.so_start) <= nof_bytes, "The provided buffer was overflown.");
 
   // Update retx_queue
-  if (tx_window[retx.sn].buf->N_bytes == retx.so_end) {
+  if (tx_window[retx.sn].buf.size() == retx.so_end) {
     retx_queue.pop();
     new_header.lsf = 1;
     if (rlc_am_end_aligned(old_header.fi)) {
@@ -669,9 +671,8 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   // Write header and pdu
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  uint8_t* data = &tx_window[retx.sn].buf->msg[retx.so_start];
-  uint32_t len  = retx.so_end - retx.so_start;
-  memcpy(ptr, data, len);
+  uint32_t len = retx.so_end - retx.so_start;
+  tx_window[retx.sn].buf.copy_to(ptr, retx.so_start, len);
 
   debug_state();
   int pdu_len = (ptr - payload) + len;
@@ -698,7 +699,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
 
 int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (tx_sdu == NULL && tx_sdu_queue.is_empty()) {
+  if (tx_sdu.empty() && tx_sdu_queue.is_empty()) {
     RlcInfo("No data available to be sent");
     return 0;
   }
@@ -716,23 +717,6 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Could not allocate PDU in build_data_pdu()\n");
-    srsran::console("tx_window size: %zd PDUs\n", tx_window.size());
-    srsran::console("vt_a = %d, vt_ms = %d, vt_s = %d, poll_sn = %d\n", vt_a, vt_ms, vt_s, poll_sn);
-    srsran::console("retx_queue size: %zd PDUs\n", retx_queue.size());
-    std::map<uint32_t, rlc_amd_tx_pdu>::iterator txit;
-    for (txit = tx_window.begin(); txit != tx_window.end(); txit++) {
-      srsran::console("tx_window - SN=%d\n", txit->first);
-    }
-    exit(-1);
-#else
-    RlcError("Fatal Error: Couldn't allocate PDU in build_data_pdu().");
-    return 0;
-#endif
-  }
   rlc_amd_pdu_header_t header = {};
   header.dc                   = RLC_DC_FIELD_DATA_PDU;
   header.fi                   = RLC_FI_FIELD_START_AND_END_ALIGNED;
@@ -745,42 +729,39 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // insert newly assigned SN into window and use reference for in-place operations
   // NOTE: from now on, we can't return from this function anymore before increasing vt_s
+  // The PDU payload references the SDU segments, which are only copied into the MAC PDU
   rlc_amd_tx_pdu_lte& tx_pdu = tx_window.add_pdu(header.sn);
 
   uint32_t head_len  = rlc_am_packed_length(&header);
   uint32_t to_move   = 0;
   uint32_t last_li   = 0;
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
-  uint8_t* pdu_ptr   = pdu->msg;
+  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, MAX_DATA_PDU_PAYLOAD_SIZE);
 
   RlcDebug("Building PDU - pdu_space: %d, head_len: %d ", pdu_space, head_len);
 
   // Check for SDU segment
-  if (tx_sdu != nullptr) {
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
-    last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+  if (not tx_sdu.empty()) {
+    uint32_t pdcp_sn = tx_sdu.metadata().pdcp_sn;
+    to_move          = ((pdu_space - head_len) >= tx_sdu.size()) ? tx_sdu.size() : pdu_space - head_len;
+    last_li          = to_move;
+    tx_pdu.buf.append(tx_sdu.take_front(to_move));
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
       segment_pool.make_segment(tx_pdu, pdcp_pdu);
-      if (tx_sdu->N_bytes == 0) {
+      if (tx_sdu.empty()) {
         pdcp_pdu.fully_txed = true;
       }
     } else {
       // PDCP SNs for the RLC SDU has been removed from the queue
-      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", tx_sdu->md.pdcp_sn);
+      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", pdcp_sn);
     }
 
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu.empty()) {
       RlcDebug("Complete SDU scheduled for tx.");
       tx_sdu.reset();
     }
     if (pdu_space > to_move) {
-      pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+      pdu_space -= to_move;
     } else {
       pdu_space = 0;
     }
@@ -797,7 +778,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   while (pdu_space > head_len && tx_sdu_queue.get_n_sdus() > 0 && header.N_li < MAX_SDUS_PER_PDU) {
     if (not segment_pool.has_segments()) {
       RlcInfo("Can't build a PDU segment - No segment resources available");
-      if (pdu_ptr != pdu->msg) {
+      if (not tx_pdu.buf.empty()) {
         break; // continue with the segments created up to this point
       }
       tx_window.remove_pdu(tx_pdu.rlc_sn);
@@ -815,41 +796,38 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       break;
     }
 
+    unique_byte_buffer_t sdu;
     do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
-    if (tx_sdu == nullptr) {
+      sdu = tx_sdu_queue.read();
+    } while (sdu == nullptr && tx_sdu_queue.size() != 0);
+    if (sdu == nullptr) {
       if (header.N_li > 0) {
         header.N_li--;
       }
       break;
     }
+    uint32_t pdcp_sn = sdu->md.pdcp_sn;
+    tx_sdu           = byte_buffer_slice(std::move(sdu));
 
     // store sdu info
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      RlcWarning("PDCP_SN=%d already marked as undelivered", tx_sdu->md.pdcp_sn);
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      RlcWarning("PDCP_SN=%d already marked as undelivered", pdcp_sn);
     } else {
-      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)",
-               tx_sdu->md.pdcp_sn,
-               undelivered_sdu_info_queue.nof_sdus());
-      undelivered_sdu_info_queue.add_pdcp_sdu(tx_sdu->md.pdcp_sn);
+      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)", pdcp_sn, undelivered_sdu_info_queue.nof_sdus());
+      undelivered_sdu_info_queue.add_pdcp_sdu(pdcp_sn);
     }
-    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
 
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    to_move = ((pdu_space - head_len) >= tx_sdu.size()) ? tx_sdu.size() : pdu_space - head_len;
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
+    tx_pdu.buf.append(tx_sdu.take_front(to_move));
     segment_pool.make_segment(tx_pdu, pdcp_pdu);
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu.empty()) {
       pdcp_pdu.fully_txed = true;
     }
 
-    if (tx_sdu->N_bytes == 0) {
-      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", tx_sdu->md.pdcp_sn);
+    if (tx_sdu.empty()) {
+      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", pdcp_sn);
       tx_sdu.reset();
     }
     if (pdu_space > to_move) {
@@ -862,17 +840,17 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   }
 
   // Make sure, at least one SDU (segment) has been added until this point
-  if (pdu->N_bytes == 0) {
+  if (tx_pdu.buf.empty()) {
     RlcError("Generated empty RLC PDU.");
   }
 
-  if (tx_sdu != NULL) {
+  if (not tx_sdu.empty()) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
   // Set Poll bit
   pdu_without_poll++;
-  byte_without_poll += (pdu->N_bytes + head_len);
+  byte_without_poll += (tx_pdu.buf.size() + head_len);
   RlcDebug("pdu_without_poll: %d", pdu_without_poll);
   RlcDebug("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -889,15 +867,13 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Update Tx window
   vt_s = (vt_s + 1) % MOD;
 
-  // Write final header and TX
-  tx_pdu.buf                      = std::move(pdu);
-  tx_pdu.header                   = header;
-  const byte_buffer_t* buffer_ptr = tx_pdu.buf.get();
+  // Write final header and gather the SDU segments into the MAC PDU
+  tx_pdu.header = header;
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&header, &ptr);
-  memcpy(ptr, buffer_ptr->msg, buffer_ptr->N_bytes);
-  int total_len = (ptr - payload) + buffer_ptr->N_bytes;
+  tx_pdu.buf.copy_to(ptr);
+  int total_len = (ptr - payload) + tx_pdu.buf.size();
   RlcHexInfo(payload, total_len, "Tx PDU SN=%d (%d B)", header.sn, total_len);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
   debug_state();
@@ -970,24 +946,24 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
             retx.sn         = i;
             retx.is_segment = false;
             retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
+            retx.so_end     = pdu.buf.size();
 
             if (status.nacks[j].has_so) {
               // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start >= pdu.buf.size()) {
                 // print error but try to send original PDU again
-                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf.size());
                 status.nacks[j].so_start = 0;
               }
 
               // check for special SO_end value
               if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
+                status.nacks[j].so_end = pdu.buf.size();
               } else {
                 retx.so_end = status.nacks[j].so_end + 1;
               }
 
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start < pdu.buf.size() && status.nacks[j].so_end <= pdu.buf.size()) {
                 retx.is_segment = true;
                 retx.so_start   = status.nacks[j].so_start;
               } else {
@@ -995,7 +971,7 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
                            i,
                            status.nacks[j].so_start,
                            status.nacks[j].so_end,
-                           pdu.buf->N_bytes);
+                           pdu.buf.size());
               }
             }
           } else {
@@ -1093,10 +1069,10 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
     if (tx_window.has_sn(retx.sn)) {
-      if (tx_window[retx.sn].buf) {
-        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf->N_bytes;
+      if (not tx_window[retx.sn].buf.empty()) {
+        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf.size();
       } else {
-        RlcWarning("retx.sn=%d has null ptr in required_buffer_size()", retx.sn);
+        RlcWarning("retx.sn=%d has empty buffer in required_buffer_size()", retx.sn);
         return -1;
       }
     } else {
@@ -1207,7 +1183,7 @@ void rlc_am_lte_rx::stop()
     reordering_timer.stop();
   }
 
-  rx_sdu.reset();
+  rx_sdu.clear();
 
   vr_r  = 0;
   vr_mr = RLC_AM_WINDOW_SIZE;
@@ -1256,8 +1232,6 @@ void rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
  */
 void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu>::iterator it;
-
   RlcHexInfo(payload, nof_bytes, "Rx data PDU SN=%d (%d B)", header.sn, nof_bytes);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
 
@@ -1293,7 +1267,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
   // Write to rx window
   rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
-  pdu.buf             = srsran::make_byte_buffer();
+  pdu.buf             = srsran::make_byte_buffer_with_tailroom(nof_bytes);
   if (pdu.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
@@ -1369,8 +1343,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1391,7 +1363,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   }
 
   rlc_amd_rx_pdu segment;
-  segment.buf = srsran::make_byte_buffer();
+  segment.buf = srsran::make_byte_buffer_with_tailroom(nof_bytes);
   if (segment.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu_segment().\n");
@@ -1412,7 +1384,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
+  auto it = rx_segments.find(header.sn);
   if (rx_segments.end() != it) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
@@ -1421,15 +1393,16 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
     // Add segment to PDU list and check for complete
     // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
+    // The complete PDU may have been reassembled already, and its segments erased with it
     if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+      rx_segments.erase(header.sn);
     }
 
   } else {
     // Create new PDU segment list and write to rx_segments
     rlc_amd_rx_pdu_segments_t pdu;
     pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    rx_segments.insert(header.sn, std::move(pdu));
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1456,28 +1429,19 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
 void rlc_am_lte_rx::reassemble_rx_sdus()
 {
-  uint32_t len = 0;
-  if (rx_sdu == NULL) {
-    rx_sdu = srsran::make_byte_buffer();
-    if (rx_sdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-      srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)\n");
-      exit(-1);
-#else
-      RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)");
-      return;
-#endif
-    }
-  }
+  uint32_t          len = 0;
+  byte_buffer_slice payload;
 
-  // Iterate through rx_window, assembling and delivering SDUs
+  // Iterate through rx_window, linking the SDU segments of the PDUs and delivering the complete SDUs
   while (rx_window.has_sn(vr_r)) {
+    payload = byte_buffer_slice(std::move(rx_window[vr_r].buf));
+
     // Handle any SDU segments
     for (uint32_t i = 0; i < rx_window[vr_r].header.N_li; i++) {
       len = rx_window[vr_r].header.li[i];
 
-      RlcHexDebug(rx_window[vr_r].buf->msg,
-                  len,
+      RlcHexDebug(payload.data(),
+                  SRSRAN_MIN(len, payload.size()),
                   "Handling segment %d/%d of length %d B of SN=%d",
                   i + 1,
                   rx_window[vr_r].header.N_li,
@@ -1489,104 +1453,44 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
         break;
       }
 
-      if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
-          if (rx_window[vr_r].buf->N_bytes < len) {
-            RlcError("Dropping corrupted SN=%d", vr_r);
-            rx_sdu.reset();
-            goto exit;
-          }
-          // store timestamp of the first segment when starting to assemble SDUs
-          if (rx_sdu->N_bytes == 0) {
-            rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
-          }
-          memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-          rx_sdu->N_bytes += len;
-
-          rx_window[vr_r].buf->msg += len;
-          rx_window[vr_r].buf->N_bytes -= len;
-
-          RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-          sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                     .count());
-          parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
-          {
-            std::lock_guard<std::mutex> lock(parent->metrics_mutex);
-            parent->metrics.num_rx_sdus++;
-          }
-
-          rx_sdu = srsran::make_byte_buffer();
-          if (rx_sdu == nullptr) {
-#ifdef RLC_AM_BUFFER_DEBUG
-            srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
-            exit(-1);
-#else
-            RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
-            return;
-#endif
-          }
-        } else {
-          int buf_len = rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer;
-          RlcError("Cannot read %d bytes from rx_window. vr_r=%d, msg-buffer=%d B", len, vr_r, buf_len);
-          rx_sdu.reset();
+      if (rx_sdu.size() + len <= MAX_RX_SDU_SIZE) {
+        if (payload.size() < len) {
+          RlcError("Dropping corrupted SN=%d", vr_r);
+          rx_sdu.clear();
           goto exit;
         }
+        rx_sdu.append(payload.take_front(len));
+        deliver_rx_sdu();
       } else {
         RlcError("Cannot fit RLC PDU in SDU buffer, dropping both.");
-        rx_sdu.reset();
+        rx_sdu.clear();
         goto exit;
       }
     }
 
     // Handle last segment
-    len = rx_window[vr_r].buf->N_bytes;
-    RlcHexDebug(rx_window[vr_r].buf->msg, len, "Handling last segment of length %d B of SN=%d", len, vr_r);
-    if (rx_sdu->get_tailroom() >= len) {
-      // store timestamp of the first segment when starting to assemble SDUs
-      if (rx_sdu->N_bytes == 0) {
-        rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
-      }
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-      rx_sdu->N_bytes += rx_window[vr_r].buf->N_bytes;
+    len = payload.size();
+    RlcHexDebug(payload.data(), len, "Handling last segment of length %d B of SN=%d", len, vr_r);
+    if (rx_sdu.size() + len <= MAX_RX_SDU_SIZE) {
+      rx_sdu.append(std::move(payload));
     } else {
       printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
-             rx_sdu->get_tailroom(),
+             MAX_RX_SDU_SIZE - rx_sdu.size(),
              len,
              vr_r);
-      rx_sdu.reset();
+      rx_sdu.clear();
       goto exit;
     }
 
     if (rlc_am_end_aligned(rx_window[vr_r].header.fi)) {
-      RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-      sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                 std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                 .count());
-      parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
-      {
-        std::lock_guard<std::mutex> lock(parent->metrics_mutex);
-        parent->metrics.num_rx_sdus++;
-      }
-
-      rx_sdu = srsran::make_byte_buffer();
-      if (rx_sdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-        srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)\n");
-        exit(-1);
-#else
-        RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)");
-        return;
-#endif
-      }
+      deliver_rx_sdu();
     }
 
   exit:
     // Move the rx_window
     RlcDebug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
+    auto it = rx_segments.find(vr_r);
     if (rx_segments.end() != it) {
       RlcDebug("Erasing segments of SN=%d", vr_r);
       std::list<rlc_amd_rx_pdu>::iterator segit;
@@ -1597,7 +1501,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
                  segit->buf->N_bytes,
                  segit->header.N_li);
       }
-      it->second.segments.clear();
+      rx_segments.erase(it);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -1605,6 +1509,26 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
   }
 }
 
+void rlc_am_lte_rx::deliver_rx_sdu()
+{
+  // The SDU of a single PDU is handed over without copy, otherwise its segments are gathered here
+  unique_byte_buffer_t sdu = rx_sdu.gather();
+  if (sdu == nullptr) {
+    RlcError("Fatal Error: Couldn't allocate SDU in deliver_rx_sdu()");
+    return;
+  }
+  RlcHexInfo(sdu->msg, sdu->N_bytes, "Rx SDU (%d B)", sdu->N_bytes);
+  sdu_rx_latency_ms.push(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -
+                                                            sdu->get_timestamp())
+          .count());
+  parent->pdcp->write_pdu(parent->lcid, std::move(sdu));
+  {
+    std::lock_guard<std::mutex> lock(parent->metrics_mutex);
+    parent->metrics.num_rx_sdus++;
+  }
+}
+
 void rlc_am_lte_rx::reset_status()
 {
   do_status     = false;
@@ -1733,10 +1657,9 @@ int rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
+  for (auto it = rx_segments.begin(); it != rx_segments.end(); ++it) {
     std::list<rlc_amd_rx_pdu>::iterator segit;
     for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
       ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
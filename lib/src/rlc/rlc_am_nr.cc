@@ -1636,7 +1636,7 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   uint32_t hdr_len = rlc_am_nr_packed_length(header);
   // Full SDU received. Add SDU to Rx Window and copy full PDU into SDU buffer.
   rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->add_pdu(header.sn);
-  rx_sdu.buf                  = srsran::make_byte_buffer();
+  rx_sdu.buf                  = srsran::make_byte_buffer_with_tailroom(nof_bytes);
   if (rx_sdu.buf == nullptr) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
     rx_window->remove_pdu(header.sn);
@@ -1683,7 +1683,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   // Create PDU segment info, to be stored later
   rlc_amd_rx_pdu_nr pdu_segment = {};
   pdu_segment.header            = header;
-  pdu_segment.buf               = srsran::make_byte_buffer();
+  pdu_segment.buf               = srsran::make_byte_buffer_with_tailroom(nof_bytes - hdr_len);
   if (pdu_segment.buf == nullptr) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
     return SRSRAN_ERROR;
@@ -326,25 +326,4 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
-uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
-{
-  unique_byte_buffer_t pdu;
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    RlcDebug("MAC opportunity - %d bytes", nof_bytes);
-
-    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
-      RlcInfo("No data available to be sent");
-      return 0;
-    }
-
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
-  }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
-}
-
 } // namespace srsran
@@ -121,36 +121,43 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  rlc_umd_pdu_header_t        header = {};
-  header.fi      = RLC_FI_FIELD_START_AND_END_ALIGNED;
-  header.sn      = vt_us;
-  header.N_li    = 0;
-  header.sn_size = cfg.um.tx_sn_field_length;
+  RlcDebug("MAC opportunity - %d bytes", nof_bytes);
+
+  if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
+    RlcInfo("No data available to be sent");
+    return 0;
+  }
+
+  rlc_umd_pdu_header_t header = {};
+  header.fi                   = RLC_FI_FIELD_START_AND_END_ALIGNED;
+  header.sn                   = vt_us;
+  header.N_li                 = 0;
+  header.sn_size              = cfg.um.tx_sn_field_length;
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = nof_bytes;
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
     return 0;
   }
 
+  // SDU segments are only referenced here. Their bytes are gathered into the payload once the header is written
+  tx_segments.clear();
+
   // Check for SDU segment
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
     to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
     RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    tx_segments.push_back({tx_sdu->msg, to_move});
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
     tx_sdu->N_bytes -= to_move;
     tx_sdu->msg += to_move;
     if (tx_sdu->N_bytes == 0) {
@@ -163,9 +170,9 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 #else
       RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
 #endif
-      tx_sdu.reset();
+      tx_sdus_done.push_back(std::move(tx_sdu));
     }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
@@ -185,10 +192,8 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
     tx_sdu  = tx_sdu_queue.read();
     to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
     RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    tx_segments.push_back({tx_sdu->msg, to_move});
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
     tx_sdu->N_bytes -= to_move;
     tx_sdu->msg += to_move;
     if (tx_sdu->N_bytes == 0) {
@@ -201,7 +206,7 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 #else
       RlcDebug("Complete SDU scheduled for tx.");
 #endif
-      tx_sdu.reset();
+      tx_sdus_done.push_back(std::move(tx_sdu));
     }
     pdu_space -= to_move;
   }
@@ -214,15 +219,20 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  // Write header in place and gather the SDU segments right behind it
+  uint8_t* pdu_ptr = payload + rlc_um_write_data_pdu_header(&header, payload);
+  for (const tx_segment_t& segment : tx_segments) {
+    memcpy(pdu_ptr, segment.ptr, segment.len);
+    pdu_ptr += segment.len;
+  }
+  tx_sdus_done.clear();
+  uint32_t pdu_len = pdu_ptr - payload;
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -313,15 +323,14 @@ void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
     return;
   }
 
-  std::map<uint32_t, rlc_umd_pdu_t>::iterator it = rx_window.find(header.sn);
-  if (rx_window.end() != it) {
+  if (rx_window.contains(header.sn)) {
     RlcInfo("Discarding duplicate SN=%d", header.sn);
     return;
   }
 
   // Write to rx window
   rlc_umd_pdu_t pdu = {};
-  pdu.buf           = make_byte_buffer();
+  pdu.buf           = make_byte_buffer_with_tailroom(nof_bytes);
   if (!pdu.buf) {
     RlcError("Discarding packet: no space in buffer pool");
     return;
@@ -332,8 +341,8 @@ void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
   int header_len = rlc_um_packed_length(&header);
   pdu.buf->msg += header_len;
   pdu.buf->N_bytes -= header_len;
-  pdu.header           = header;
-  rx_window[header.sn] = std::move(pdu);
+  pdu.header = header;
+  rx_window.insert(header.sn, std::move(pdu));
 
   // Update vr_uh
   if (!inside_reordering_window(header.sn)) {
@@ -376,7 +385,7 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
   while (!inside_reordering_window(vr_ur)) {
     RlcDebug("SN=%d is not inside reordering windows", vr_ur);
 
-    if (rx_window.end() == rx_window.find(vr_ur)) {
+    if (not rx_window.contains(vr_ur)) {
       RlcDebug("SN=%d not in rx_window. Reset received SDU", vr_ur);
       rx_sdu->clear();
     } else {
@@ -474,7 +483,7 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
   }
 
   // Now update vr_ur until we reach an SN we haven't yet received
-  while (rx_window.end() != rx_window.find(vr_ur)) {
+  while (rx_window.contains(vr_ur)) {
     RlcDebug("Reassemble loop for vr_ur=%d", vr_ur);
 
     if (not pdu_belongs_to_rx_sdu()) {
@@ -761,12 +770,17 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  pdu->N_bytes += rlc_um_write_data_pdu_header(header, pdu->msg);
+}
+
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
+  uint8_t* ptr = payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -806,7 +820,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  return ptr - payload;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
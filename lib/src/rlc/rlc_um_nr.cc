@@ -136,6 +136,27 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   return true;
 }
 
+uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
+{
+  unique_byte_buffer_t pdu;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    RlcDebug("MAC opportunity - %d bytes", nof_bytes);
+
+    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
+      RlcInfo("No data available to be sent");
+      return 0;
+    }
+
+    pdu = make_byte_buffer();
+    if (!pdu || pdu->N_bytes != 0) {
+      RlcError("Failed to allocate PDU buffer");
+      return 0;
+    }
+  }
+  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+}
+
 uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
 {
   // Sanity check (we need at least 2B for a SDU)
@@ -330,12 +351,10 @@ void rlc_um_nr::rlc_um_nr_rx::timer_expired(uint32_t timeout_id)
     }
 
     // discard all segments with SN < updated RX_Next_Reassembly
-    for (auto it = rx_window.begin(); it != rx_window.end();) {
-      if (RX_MOD_NR_BASE(it->first) < RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-        it = rx_window.erase(it);
-      } else {
-        ++it;
-      }
+    for (uint32_t old_sn = (RX_Next_Highest + mod - UM_Window_Size) % mod;
+         RX_MOD_NR_BASE(old_sn) < RX_MOD_NR_BASE(RX_Next_Reassembly);
+         old_sn = (old_sn + 1) % mod) {
+      rx_window.erase(old_sn);
     }
 
     // check start of t_reassembly
@@ -388,17 +407,17 @@ bool rlc_um_nr::rlc_um_nr_rx::has_missing_byte_segment(const uint32_t sn)
 {
   // is at least one missing byte segment of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of
   // all received segments of this RLC SDU
-  return (rx_window.find(sn) != rx_window.end());
+  return rx_window.contains(sn);
 }
 
 // Sect 5.2.2.2.3
 void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
 {
-  if (rx_window.find(sn) != rx_window.end()) {
+  if (rx_window.contains(sn)) {
     bool sdu_complete = false;
 
     // iterate over received segments and try to assemble full SDU
-    auto& pdu = rx_window.at(sn);
+    auto& pdu = rx_window[sn];
     for (auto it = pdu.segments.begin(); it != pdu.segments.end();) {
       RlcDebug("Have %s segment with SO=%d for SN=%d",
                to_string_short(it->second.header.si).c_str(),
@@ -464,10 +483,12 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
           // no further segments received
           RX_Next_Reassembly = RX_Next_Highest;
         } else {
-          for (auto it = rx_window.begin(); it != rx_window.end(); ++it) {
-            RlcDebug("SN=%d has %zd segments", it->first, it->second.segments.size());
-            if (RX_MOD_NR_BASE(it->first) > RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-              RX_Next_Reassembly = it->first;
+          for (uint32_t next_sn = (RX_Next_Reassembly + 1) % mod;
+               RX_MOD_NR_BASE(next_sn) < RX_MOD_NR_BASE(RX_Next_Highest);
+               next_sn = (next_sn + 1) % mod) {
+            if (rx_window.contains(next_sn)) {
+              RlcDebug("SN=%d has %zd segments", next_sn, rx_window[next_sn].segments.size());
+              RX_Next_Reassembly = next_sn;
               break;
             }
           }
@@ -476,29 +497,28 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
       }
     } else if (not sn_in_reassembly_window(sn)) {
       // SN outside of rx window
+      uint32_t old_window_start = (RX_Next_Highest + mod - UM_Window_Size) % mod;
 
       RX_Next_Highest = (sn + 1) % mod; // update RX_Next_highest
       RlcDebug("Updating RX_Next_Highest=%d", RX_Next_Highest);
 
-      // drop all SNs outside of new rx window
-      for (auto it = rx_window.begin(); it != rx_window.end();) {
-        if (not sn_in_reassembly_window(it->first)) {
+      // drop all SNs outside of new rx window, i.e. the SNs the lower edge of the window moved past
+      for (uint32_t old_sn = old_window_start; not sn_in_reassembly_window(old_sn); old_sn = (old_sn + 1) % mod) {
+        if (rx_window.erase(old_sn)) {
           RlcInfo("SN=%d outside rx window [%d:%d] - discarding",
-                  it->first,
+                  old_sn,
                   RX_Next_Highest - UM_Window_Size,
                   RX_Next_Highest);
-          it = rx_window.erase(it);
           metrics.num_lost_pdus++;
-        } else {
-          ++it;
         }
       }
 
       if (not sn_in_reassembly_window(RX_Next_Reassembly)) {
         // update RX_Next_Reassembly to first SN that has not been reassembled and delivered
-        for (const auto& rx_pdu : rx_window) {
-          if (rx_pdu.first >= RX_MOD_NR_BASE(RX_Next_Highest - UM_Window_Size)) {
-            RX_Next_Reassembly = rx_pdu.first;
+        for (uint32_t next_sn = (RX_Next_Highest + mod - UM_Window_Size) % mod; next_sn != RX_Next_Highest;
+             next_sn = (next_sn + 1) % mod) {
+          if (rx_window.contains(next_sn)) {
+            RX_Next_Reassembly = next_sn;
             RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
             break;
           }
@@ -565,7 +585,7 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
     rx_pdu.buf              = rlc_um_nr_strip_pdu_header(header, payload, nof_bytes);
 
     // check if this SN is already present in rx buffer
-    if (rx_window.find(header.sn) == rx_window.end()) {
+    if (not rx_window.contains(header.sn)) {
       // first received segment of this SN, add to rx buffer
       RlcHexDebug(rx_pdu.buf->msg,
                   rx_pdu.buf->N_bytes,
@@ -576,7 +596,7 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
       rlc_umd_pdu_segments_nr_t pdu_segments = {};
       update_total_sdu_length(pdu_segments, rx_pdu);
       pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
-      rx_window[header.sn] = std::move(pdu_segments);
+      rx_window.insert(header.sn, std::move(pdu_segments));
     } else {
       // other segment for this SN already present, update received data
       RlcHexDebug(rx_pdu.buf->msg,
@@ -586,7 +606,7 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
                   rx_pdu.header.so,
                   rx_pdu.buf->N_bytes);
 
-      auto& pdu_segments = rx_window.at(header.sn);
+      auto& pdu_segments = rx_window[header.sn];
 
       // calculate total SDU length
       update_total_sdu_length(pdu_segments, rx_pdu);
@@ -278,6 +278,39 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_range_oper()
+{
+  srsran::bounded_bitset<150, reversed> bitset(130);
+
+  // Ranges crossing the 64-bit word boundaries
+  bitset.fill(60, 70);
+  TESTASSERT(bitset.count() == 10);
+  TESTASSERT(bitset.count(0, bitset.size()) == 10);
+  TESTASSERT(bitset.count(65, 130) == 5);
+  TESTASSERT(bitset.count(60, 60) == 0);
+  for (size_t i = 0; i < bitset.size(); ++i) {
+    TESTASSERT(bitset.test(i) == (i >= 60 and i < 70));
+  }
+  TESTASSERT(bitset.any(69, 70));
+  TESTASSERT(not bitset.any(70, 130));
+  TESTASSERT(not bitset.any(0, 60));
+  TESTASSERT(not bitset.any(60, 60));
+
+  bitset.fill(0, bitset.size());
+  bitset.fill(1, 129, false);
+  TESTASSERT(bitset.count() == 2 and bitset.test(0) and bitset.test(129));
+  TESTASSERT(not bitset.any(1, 129));
+  TESTASSERT(bitset.count(1, 130) == 1);
+
+  // Per RBG count of a PRB mask
+  srsran::bounded_bitset<100, reversed> prbs(100);
+  prbs.fill(10, 30);
+  for (uint32_t rbg = 0; rbg < 25; ++rbg) {
+    TESTASSERT(prbs.count(rbg * 4, rbg * 4 + 4) == ((rbg >= 3 and rbg < 7) ? 4 : (rbg == 2 or rbg == 7) ? 2 : 0));
+  }
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +322,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_range_oper<false>();
+  test_bitset_range_oper<true>();
   printf("Success\n");
   return 0;
 }
@@ -21,6 +21,7 @@
 
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/test_common.h"
+#include <memory>
 
 namespace srsran {
 
@@ -140,6 +141,42 @@ void test_correct_destruction()
   TESTASSERT(C::count == 0);
 }
 
+void test_pooled_circular_map()
+{
+  pooled_circular_map<uint32_t, std::unique_ptr<int>, 4> mymap;
+  TESTASSERT(mymap.empty() and mymap.capacity() == 4);
+
+  TESTASSERT(mymap.insert(0, std::unique_ptr<int>(new int(0))));
+  TESTASSERT(mymap.insert(5, std::unique_ptr<int>(new int(5))));
+  TESTASSERT(not mymap.insert(4, std::unique_ptr<int>(new int(4))));
+  TESTASSERT(mymap.size() == 2);
+  TESTASSERT(mymap.contains(0) and mymap.contains(5));
+  TESTASSERT(not mymap.contains(1) and not mymap.contains(4));
+  TESTASSERT(*mymap[0] == 0 and *mymap[5] == 5);
+
+  // The erased objects are reset, and their storage is reused by the next insertions
+  std::unique_ptr<int>& obj0 = mymap[0];
+  TESTASSERT(mymap.erase(0));
+  TESTASSERT(obj0 == nullptr);
+  TESTASSERT(not mymap.erase(0) and not mymap.contains(0));
+  TESTASSERT(mymap.insert(4, std::unique_ptr<int>(new int(4))));
+  TESTASSERT(&mymap[4] == &obj0 and *mymap[4] == 4);
+  TESTASSERT(mymap.size() == 2);
+
+  TESTASSERT(mymap.insert(2, std::unique_ptr<int>(new int(2))));
+  TESTASSERT(mymap.insert(3, std::unique_ptr<int>(new int(3))));
+  TESTASSERT(not mymap.insert(7, nullptr));
+  TESTASSERT(mymap.full());
+
+  mymap.clear();
+  TESTASSERT(mymap.empty());
+  for (uint32_t id = 0; id < 8; ++id) {
+    TESTASSERT(not mymap.contains(id));
+  }
+  TESTASSERT(mymap.insert(7, std::unique_ptr<int>(new int(7))));
+  TESTASSERT(mymap.contains(7) and *mymap[7] == 7);
+}
+
 } // namespace srsran
 
 int main(int argc, char** argv)
@@ -152,6 +189,7 @@ int main(int argc, char** argv)
   srsran::test_id_map();
   srsran::test_id_map_wraparound();
   srsran::test_correct_destruction();
+  srsran::test_pooled_circular_map();
 
   printf("Success\n");
   return SRSRAN_SUCCESS;
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/circular_map.h"
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cinttypes>
+#include <getopt.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t nof_tunnels = 10000;
+static uint32_t nof_lookups = 1000000;
+
+// Tunnel pool with room for the default number of tunnels
+static const size_t max_tunnels = 16384;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nl]\n", prog);
+  printf("\t-n Number of tunnels [Default %d, Max %zd]\n", nof_tunnels, max_tunnels);
+  printf("\t-l Number of lookups [Default %d]\n", nof_lookups);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:l:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_tunnels = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        nof_lookups = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (nof_tunnels == 0 or nof_tunnels > max_tunnels) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+/// Context of a GTP-U tunnel, as looked up for each packet
+struct tunnel_t {
+  uint16_t rnti          = 0;
+  uint32_t eps_bearer_id = 0;
+  uint32_t teid_out      = 0;
+  uint32_t addr_out      = 0;
+};
+
+/// Runs the lookups of the given keys, and prints the average time of one lookup
+template <typename Key, typename LookupFunc>
+static void run_lookups(const char* name, const std::vector<Key>& keys, const LookupFunc& lookup)
+{
+  uint64_t checksum = 0;
+  auto     tp_start = std::chrono::steady_clock::now();
+  for (const Key& key : keys) {
+    const tunnel_t* tun = lookup(key);
+    checksum += tun->teid_out;
+  }
+  double time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp_start).count();
+  printf("%-32s %10.1f %20" PRIu64 "\n", name, time_ns / keys.size(), checksum);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> tunnel_dist(0, nof_tunnels - 1);
+
+  // TEIDs are allocated by the tunnel pool, and UE addresses from a contiguous range, as done by the SPGW
+  using tunnel_pool_t = static_id_obj_pool<uint32_t, tunnel_t, max_tunnels>;
+  std::unique_ptr<tunnel_pool_t>          teid_pool(new tunnel_pool_t(1));
+  std::unordered_map<uint32_t, tunnel_t>  teid_hash;
+  std::map<in_addr_t, tunnel_t>           ip_tree;
+  std::unordered_map<in_addr_t, tunnel_t> ip_hash;
+  flat_hash_map<in_addr_t, tunnel_t>      ip_flat_hash;
+  std::vector<uint32_t>                   teids;
+  std::vector<in_addr_t>                  ue_ips;
+  for (uint32_t i = 0; i < nof_tunnels; ++i) {
+    tunnel_t tun;
+    tun.rnti                   = 0x46 + i;
+    tun.eps_bearer_id          = 5;
+    tun.teid_out               = rgen();
+    tun.addr_out               = htonl(0xc0a80001);
+    srsran::expected<uint32_t> teid = teid_pool->insert(tun);
+    TESTASSERT(teid.has_value());
+    teid_hash.insert(std::make_pair(teid.value(), tun));
+    teids.push_back(teid.value());
+
+    in_addr_t ue_ip = htonl(0xac100002 + i);
+    ip_tree.insert(std::make_pair(ue_ip, tun));
+    ip_hash.insert(std::make_pair(ue_ip, tun));
+    TESTASSERT(ip_flat_hash.insert(ue_ip, tun));
+    ue_ips.push_back(ue_ip);
+  }
+
+  // Packets of random tunnels
+  std::vector<uint32_t>  teid_keys(nof_lookups);
+  std::vector<in_addr_t> ip_keys(nof_lookups);
+  for (uint32_t i = 0; i < nof_lookups; ++i) {
+    uint32_t idx = tunnel_dist(rgen);
+    teid_keys[i] = teids[idx];
+    ip_keys[i]   = ue_ips[idx];
+  }
+
+  printf("Tunnels: %d, lookups: %d\n", nof_tunnels, nof_lookups);
+  printf("%-32s %10s %20s\n", "lookup", "ns/packet", "checksum");
+  run_lookups("UL TEID, std::unordered_map", teid_keys, [&teid_hash](uint32_t teid) {
+    return &teid_hash.find(teid)->second;
+  });
+  run_lookups("UL TEID, static_id_obj_pool", teid_keys, [&teid_pool](uint32_t teid) {
+    return &teid_pool->find(teid)->second;
+  });
+  run_lookups("DL UE IP, std::map", ip_keys, [&ip_tree](in_addr_t ip) { return &ip_tree.find(ip)->second; });
+  run_lookups("DL UE IP, std::unordered_map", ip_keys, [&ip_hash](in_addr_t ip) {
+    return &ip_hash.find(ip)->second;
+  });
+  run_lookups("DL UE IP, flat_hash_map", ip_keys, [&ip_flat_hash](in_addr_t ip) { return ip_flat_hash.find(ip); });
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace srsran {
+
+void test_flat_hash_map()
+{
+  flat_hash_map<uint32_t, std::string> mymap;
+  TESTASSERT(mymap.size() == 0 and mymap.empty());
+  TESTASSERT(not mymap.contains(0) and mymap.find(0) == nullptr);
+
+  TESTASSERT(mymap.insert(0, "obj0"));
+  TESTASSERT(mymap.contains(0) and *mymap.find(0) == "obj0");
+  TESTASSERT(not mymap.insert(0, "other"));
+  TESTASSERT(mymap[0] == "obj0");
+  TESTASSERT(mymap.size() == 1 and not mymap.empty());
+
+  // operator[] inserts the missing keys
+  TESTASSERT(mymap[5].empty());
+  mymap[5] = "obj5";
+  TESTASSERT(mymap.size() == 2 and *mymap.find(5) == "obj5");
+
+  uint32_t count = 0;
+  mymap.for_each([&count](uint32_t key, std::string& obj) {
+    TESTASSERT(obj == "obj" + std::to_string(key));
+    count++;
+  });
+  TESTASSERT(count == 2);
+
+  TESTASSERT(mymap.erase(0));
+  TESTASSERT(not mymap.erase(0));
+  TESTASSERT(not mymap.contains(0) and mymap.contains(5));
+  TESTASSERT(mymap.size() == 1);
+
+  mymap.clear();
+  TESTASSERT(mymap.size() == 0 and mymap.empty() and not mymap.contains(5));
+}
+
+void test_flat_hash_map_growth()
+{
+  flat_hash_map<uint32_t, uint32_t> mymap(4);
+  size_t                            init_capacity = mymap.capacity();
+  for (uint32_t i = 0; i < 1000; ++i) {
+    TESTASSERT(mymap.insert(i * 7919, i));
+  }
+  TESTASSERT(mymap.size() == 1000);
+  TESTASSERT(mymap.capacity() > init_capacity and mymap.capacity() >= 2 * mymap.size());
+  for (uint32_t i = 0; i < 1000; ++i) {
+    TESTASSERT(mymap.find(i * 7919) != nullptr and *mymap.find(i * 7919) == i);
+  }
+}
+
+/// Compares against std::unordered_map for random insertions and erasures, with keys that collide in the same slots
+void test_flat_hash_map_random()
+{
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> key_dist(0, 255);
+  flat_hash_map<uint32_t, uint32_t>       mymap;
+  std::unordered_map<uint32_t, uint32_t>  ref;
+
+  for (uint32_t i = 0; i < 20000; ++i) {
+    // Addresses in network byte order, that only differ in the most significant byte
+    uint32_t key = key_dist(rgen) << 24u | 0x10acu;
+    if (rgen() % 2 == 0) {
+      TESTASSERT(mymap.insert(key, i) == ref.insert(std::make_pair(key, i)).second);
+    } else {
+      TESTASSERT(mymap.erase(key) == (ref.erase(key) > 0));
+    }
+    TESTASSERT(mymap.size() == ref.size());
+  }
+  for (uint32_t key = 0; key < 256; ++key) {
+    auto      it  = ref.find(key << 24u | 0x10acu);
+    uint32_t* obj = mymap.find(key << 24u | 0x10acu);
+    TESTASSERT((it == ref.end()) == (obj == nullptr));
+    TESTASSERT(obj == nullptr or *obj == it->second);
+  }
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_flat_hash_map();
+  srsran::test_flat_hash_map_growth();
+  srsran::test_flat_hash_map_random();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
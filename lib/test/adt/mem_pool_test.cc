@@ -117,6 +117,10 @@ void test_fixedsize_pool()
     }
     std::unique_ptr<BigObj> obj(new (std::nothrow) BigObj());
     TESTASSERT(obj == nullptr);
+    BigObj::pool_t::occupancy_t occupancy = fixed_pool->read_occupancy();
+    TESTASSERT(occupancy.nof_used_blocks == pool_size);
+    TESTASSERT(occupancy.max_used_blocks == pool_size);
+    TESTASSERT(occupancy.nof_failures == 1);
     vec.clear();
     obj = std::unique_ptr<BigObj>(new (std::nothrow) BigObj());
     TESTASSERT(obj != nullptr);
@@ -149,6 +153,8 @@ void test_fixedsize_pool()
   }
   fixed_pool->print_all_buffers();
   TESTASSERT(C::default_ctor_counter == C::dtor_counter);
+  // The blocks freed by another thread than the one that allocated them are accounted for
+  TESTASSERT(fixed_pool->read_occupancy().nof_used_blocks == 0);
 }
 
 struct D : public C {
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_mpmc_queue_single_thread()
+{
+  mpmc_bounded_queue<std::unique_ptr<int> > queue(10);
+  TESTASSERT(queue.capacity() == 16);
+  TESTASSERT(queue.empty());
+
+  // push until full
+  for (size_t i = 0; i < queue.capacity(); ++i) {
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(i))));
+    TESTASSERT(queue.size() == i + 1);
+  }
+  TESTASSERT(not queue.try_push(std::unique_ptr<int>(new int(-1))));
+
+  // pop until empty
+  std::unique_ptr<int> val;
+  for (size_t i = 0; i < queue.capacity(); ++i) {
+    TESTASSERT(queue.try_pop(val));
+    TESTASSERT(val != nullptr and *val == (int)i);
+  }
+  TESTASSERT(not queue.try_pop(val));
+  TESTASSERT(queue.empty());
+
+  // wrap-around
+  for (int i = 0; i < 100; ++i) {
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(i))));
+    TESTASSERT(queue.try_pop(val) and *val == i);
+  }
+}
+
+void test_mpmc_queue_multi_thread()
+{
+  const int nof_producers = 4, nof_consumers = 2, nof_values = 100000;
+
+  mpmc_bounded_queue<int>  queue(64);
+  std::atomic<int>         nof_popped{0};
+  std::atomic<long>        sum{0};
+  std::vector<std::thread> workers;
+
+  for (int p = 0; p < nof_producers; ++p) {
+    workers.emplace_back([&queue, p]() {
+      for (int i = 0; i < nof_values; ++i) {
+        // values of each producer are tagged, so that per-producer ordering can be checked
+        while (not queue.try_push(p * nof_values + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<std::vector<int> > last_seen(nof_consumers, std::vector<int>(nof_producers, -1));
+  for (int c = 0; c < nof_consumers; ++c) {
+    workers.emplace_back([&, c]() {
+      int val;
+      while (nof_popped < nof_producers * nof_values) {
+        if (not queue.try_pop(val)) {
+          std::this_thread::yield();
+          continue;
+        }
+        int p = val / nof_values, i = val % nof_values;
+        TESTASSERT(i > last_seen[c][p]);
+        last_seen[c][p] = i;
+        sum += val;
+        nof_popped++;
+      }
+    });
+  }
+  for (auto& t : workers) {
+    t.join();
+  }
+
+  long n        = (long)nof_producers * nof_values;
+  long expected = n * (n - 1) / 2;
+  TESTASSERT(nof_popped == nof_producers * nof_values);
+  TESTASSERT(sum == expected);
+  TESTASSERT(queue.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpmc_queue_single_thread();
+  srsran::test_mpmc_queue_multi_thread();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/asn1/liblte_byte_msg.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srslog/srslog.h"
@@ -52,11 +53,11 @@ int nas_dedicated_eps_bearer_context_setup_request_test()
 
   // Test message type and protocol discriminator
   uint8_t pd, msg_type;
-  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)tst_msg.get(), &pd, &msg_type);
+  liblte_mme_parse_msg_header(srsran::liblte_rx_byte_msg(*tst_msg).get(), &pd, &msg_type);
   TESTASSERT(msg_type == LIBLTE_MME_MSG_TYPE_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST);
 
   // Unpack message
-  err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_request_msg((LIBLTE_BYTE_MSG_STRUCT*)tst_msg.get(),
+  err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_request_msg(srsran::liblte_rx_byte_msg(*tst_msg).get(),
                                                                             &ded_bearer_req);
   TESTASSERT(err == LIBLTE_SUCCESS);
 
@@ -117,7 +118,7 @@ int downlink_generic_nas_transport_unpacking_test()
   LIBLTE_ERROR_ENUM                                    err;
 
   copy_msg_to_buffer(buf, nas_message);
-  err = liblte_mme_unpack_downlink_generic_nas_transport_msg((LIBLTE_BYTE_MSG_STRUCT*)buf.get(),
+  err = liblte_mme_unpack_downlink_generic_nas_transport_msg(srsran::liblte_rx_byte_msg(*buf).get(),
                                                              &dl_generic_nas_transport);
   TESTASSERT(err == LIBLTE_SUCCESS);
   TESTASSERT(dl_generic_nas_transport.generic_msg_cont_type == 1);
@@ -159,7 +160,7 @@ int downlink_generic_nas_transport_with_add_info_unpacking_test()
   LIBLTE_ERROR_ENUM                                    err;
 
   copy_msg_to_buffer(buf, nas_message);
-  err = liblte_mme_unpack_downlink_generic_nas_transport_msg((LIBLTE_BYTE_MSG_STRUCT*)buf.get(),
+  err = liblte_mme_unpack_downlink_generic_nas_transport_msg(srsran::liblte_rx_byte_msg(*buf).get(),
                                                              &dl_generic_nas_transport);
   TESTASSERT(err == LIBLTE_SUCCESS);
   TESTASSERT(dl_generic_nas_transport.generic_msg_cont_type == 1);
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+unique_byte_buffer_t make_test_buffer(uint32_t len, uint8_t first)
+{
+  unique_byte_buffer_t buf = make_byte_buffer_with_tailroom(len);
+  for (uint32_t i = 0; i < len; ++i) {
+    buf->msg[i] = first + i;
+  }
+  buf->N_bytes = len;
+  return buf;
+}
+
+uint32_t nof_used_buffers()
+{
+  byte_buffer_pools_metrics_t metrics;
+  get_byte_buffer_pools_metrics(metrics);
+  return metrics.small.nof_used_buffers + metrics.medium.nof_used_buffers + metrics.large.nof_used_buffers;
+}
+
+int test_slices()
+{
+  {
+    byte_buffer_slice sdu(make_test_buffer(100, 0));
+    TESTASSERT(sdu.size() == 100);
+    TESTASSERT(nof_used_buffers() == 1);
+
+    // The slices share the byte buffer
+    byte_buffer_slice first = sdu.take_front(30);
+    TESTASSERT(first.size() == 30 and sdu.size() == 70);
+    TESTASSERT(first.data()[29] == 29 and sdu.data()[0] == 30);
+    byte_buffer_slice copy = sdu;
+    TESTASSERT(copy.data() == sdu.data());
+    TESTASSERT(copy.try_release() == nullptr);
+    TESTASSERT(nof_used_buffers() == 1);
+
+    // The last slice takes the byte buffer
+    sdu.reset();
+    copy.reset();
+    TESTASSERT(nof_used_buffers() == 1);
+    unique_byte_buffer_t buf = first.try_release();
+    TESTASSERT(buf != nullptr and first.empty());
+    TESTASSERT(buf->N_bytes == 30 and buf->msg[0] == 0);
+  }
+  TESTASSERT(nof_used_buffers() == 0);
+
+  // Taking the whole slice moves it
+  byte_buffer_slice sdu(make_test_buffer(10, 0));
+  byte_buffer_slice all = sdu.take_front(10);
+  TESTASSERT(sdu.empty() and all.size() == 10);
+  all.reset();
+  TESTASSERT(nof_used_buffers() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_chain()
+{
+  byte_buffer_slice sdu1(make_test_buffer(50, 0));
+  byte_buffer_slice sdu2(make_test_buffer(50, 50));
+  sdu2.take_front(20);
+
+  // PDU made of sdu1, in two slices, and of the start of what is left of sdu2
+  byte_buffer_chain pdu;
+  pdu.append(sdu1.take_front(10));
+  pdu.append(std::move(sdu1));
+  pdu.append(sdu2.take_front(15));
+  pdu.append(byte_buffer_slice());
+  TESTASSERT(pdu.size() == 65 and pdu.get_nof_slices() == 3);
+
+  uint8_t out[80] = {};
+  TESTASSERT(pdu.copy_to(out) == 65);
+  for (uint32_t i = 0; i < 50; ++i) {
+    TESTASSERT(out[i] == i);
+  }
+  for (uint32_t i = 50; i < 65; ++i) {
+    TESTASSERT(out[i] == 70 + (i - 50));
+  }
+
+  // Copy of a part of the PDU, across slices
+  TESTASSERT(pdu.copy_to(out, 45, 8) == 8);
+  TESTASSERT(out[0] == 45 and out[4] == 49 and out[5] == 70 and out[7] == 72);
+  TESTASSERT(pdu.copy_to(out, 60, 10) == 5);
+
+  // More slices than stored in place
+  byte_buffer_slice sdu3(make_test_buffer(byte_buffer_chain::nof_inline_slices * 4, 0));
+  byte_buffer_chain sdu;
+  while (not sdu3.empty()) {
+    sdu.append(sdu3.take_front(2));
+  }
+  TESTASSERT(sdu.get_nof_slices() == byte_buffer_chain::nof_inline_slices * 2);
+  byte_buffer_chain moved(std::move(sdu));
+  TESTASSERT(sdu.empty() and moved.size() == byte_buffer_chain::nof_inline_slices * 4);
+  unique_byte_buffer_t gathered = moved.gather();
+  TESTASSERT(gathered != nullptr and moved.empty());
+  TESTASSERT(gathered->N_bytes == byte_buffer_chain::nof_inline_slices * 4);
+  for (uint32_t i = 0; i < gathered->N_bytes; ++i) {
+    TESTASSERT(gathered->msg[i] == i);
+  }
+
+  pdu.clear();
+  sdu2.reset();
+  gathered.reset();
+  TESTASSERT(nof_used_buffers() == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_gather_without_copy()
+{
+  unique_byte_buffer_t buf = make_test_buffer(100, 0);
+  buf->md.pdcp_sn          = 7;
+  const uint8_t* data      = buf->msg;
+
+  byte_buffer_slice pdu(std::move(buf));
+  byte_buffer_chain sdu;
+  pdu.take_front(10);
+  sdu.append(std::move(pdu));
+  unique_byte_buffer_t out = sdu.gather();
+  TESTASSERT(out != nullptr);
+  TESTASSERT(out->msg == data + 10 and out->N_bytes == 90);
+  TESTASSERT(out->md.pdcp_sn == 7);
+
+  // Shared byte buffers are copied
+  byte_buffer_slice shared(std::move(out));
+  sdu.append(shared);
+  out = sdu.gather();
+  TESTASSERT(out != nullptr and out->msg != shared.data());
+  TESTASSERT(out->N_bytes == 90 and out->md.pdcp_sn == 7);
+  TESTASSERT(std::equal(out->begin(), out->end(), shared.begin()));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_slices() == SRSRAN_SUCCESS);
+  TESTASSERT(test_chain() == SRSRAN_SUCCESS);
+  TESTASSERT(test_gather_without_copy() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
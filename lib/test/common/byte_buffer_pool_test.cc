@@ -0,0 +1,217 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <vector>
+
+using namespace srsran;
+
+int test_size_classes()
+{
+  byte_buffer_pools_metrics_t metrics;
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.nof_used_buffers == 0);
+  TESTASSERT(metrics.medium.nof_used_buffers == 0);
+  TESTASSERT(metrics.large.nof_used_buffers == 0);
+
+  unique_byte_buffer_t small = make_byte_buffer_with_tailroom(40);
+  TESTASSERT(small != nullptr);
+  TESTASSERT(small->buffer_size == byte_buffer_t::small_buffer_size);
+  TESTASSERT(small->get_headroom() == SRSRAN_BUFFER_HEADER_OFFSET);
+  TESTASSERT(small->get_tailroom() == byte_buffer_t::small_buffer_size - SRSRAN_BUFFER_HEADER_OFFSET);
+
+  unique_byte_buffer_t medium = make_byte_buffer_with_tailroom(1500);
+  TESTASSERT(medium != nullptr);
+  TESTASSERT(medium->buffer_size == byte_buffer_t::medium_buffer_size);
+
+  unique_byte_buffer_t large = make_byte_buffer_with_tailroom(byte_buffer_t::medium_buffer_size);
+  TESTASSERT(large != nullptr);
+  TESTASSERT(large->buffer_size == SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  TESTASSERT(make_byte_buffer()->buffer_size == SRSRAN_MAX_BUFFER_SIZE_BYTES);
+
+  // The whole buffer of each size class is usable
+  std::fill(small->msg, small->msg + small->get_tailroom(), 0xab);
+  small->N_bytes = small->get_tailroom();
+  std::fill(medium->msg, medium->msg + medium->get_tailroom(), 0xcd);
+  medium->N_bytes = medium->get_tailroom();
+  TESTASSERT(small->get_tailroom() == 0);
+  TESTASSERT(std::all_of(small->begin(), small->end(), [](uint8_t b) { return b == 0xab; }));
+
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.buffer_size == byte_buffer_t::small_buffer_size);
+  TESTASSERT(metrics.small.nof_used_buffers == 1);
+  TESTASSERT(metrics.medium.nof_used_buffers == 1);
+  TESTASSERT(metrics.large.nof_used_buffers == 1);
+  TESTASSERT(metrics.large.max_used_buffers >= 1);
+
+  small.reset();
+  medium.reset();
+  large.reset();
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.nof_used_buffers == 0);
+  TESTASSERT(metrics.medium.nof_used_buffers == 0);
+  TESTASSERT(metrics.large.nof_used_buffers == 0);
+  TESTASSERT(metrics.small.max_used_buffers == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_rx_byte_buffer()
+{
+  std::vector<uint8_t> overflow(rx_byte_buffer_overflow_size);
+
+  // Packets that fit in the receive buffer stay in it
+  unique_byte_buffer_t buf = make_rx_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  TESTASSERT(buf->buffer_size == byte_buffer_t::medium_buffer_size);
+  uint32_t capacity = get_rx_byte_buffer_capacity(*buf);
+  TESTASSERT(capacity + rx_byte_buffer_spare_tailroom == buf->get_tailroom());
+  TESTASSERT(capacity + rx_byte_buffer_overflow_size == SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+  buf->N_bytes    = 1500;
+  buf->md.pdcp_sn = 5;
+  TESTASSERT(merge_rx_byte_buffer_overflow(buf, overflow.data()));
+  TESTASSERT(buf->buffer_size == byte_buffer_t::medium_buffer_size);
+  TESTASSERT(buf->N_bytes == 1500);
+
+  // Larger packets are moved to a large buffer, with the bytes of the overflow area
+  std::fill(buf->msg, buf->msg + capacity, 0x11);
+  std::fill(overflow.begin(), overflow.end(), 0x22);
+  buf->N_bytes = capacity + 100;
+  TESTASSERT(merge_rx_byte_buffer_overflow(buf, overflow.data()));
+  TESTASSERT(buf->buffer_size == SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  TESTASSERT(buf->N_bytes == capacity + 100);
+  TESTASSERT(buf->md.pdcp_sn == 5);
+  TESTASSERT(std::all_of(buf->begin(), buf->begin() + capacity, [](uint8_t b) { return b == 0x11; }));
+  TESTASSERT(std::all_of(buf->begin() + capacity, buf->end(), [](uint8_t b) { return b == 0x22; }));
+
+  // Large buffers receive packets up to their whole room
+  TESTASSERT(get_rx_byte_buffer_capacity(*buf) == SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_copy_to_smaller_class()
+{
+  // Copies into a smaller buffer give up headroom to fit the content
+  unique_byte_buffer_t src = make_byte_buffer();
+  TESTASSERT(src != nullptr);
+  src->msg += 1500;
+  src->N_bytes = 1000;
+  std::fill(src->begin(), src->end(), 0x22);
+  unique_byte_buffer_t dst = make_byte_buffer_with_tailroom(src->N_bytes);
+  TESTASSERT(dst->buffer_size == byte_buffer_t::small_buffer_size);
+  TESTASSERT(dst->copy_from(*src));
+  TESTASSERT(dst->N_bytes == src->N_bytes);
+  TESTASSERT(dst->get_tailroom() == 0);
+  TESTASSERT(std::equal(dst->begin(), dst->end(), src->begin()));
+
+  // Content that does not fit is not copied
+  src->N_bytes = byte_buffer_t::small_buffer_size + 1;
+  dst->N_bytes = 10;
+  TESTASSERT(not dst->copy_from(*src));
+  TESTASSERT(dst->N_bytes == 10);
+
+  // Copies to byte buffers outside of the pools get a payload of the size of the source
+  src->N_bytes = byte_buffer_t::medium_buffer_size;
+  byte_buffer_t copy(*src);
+  TESTASSERT(copy.buffer_size == SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  TESTASSERT(copy.N_bytes == src->N_bytes);
+  TESTASSERT(std::equal(copy.begin(), copy.end(), src->begin()));
+  byte_buffer_t small_copy(*dst);
+  TESTASSERT(small_copy.buffer_size == byte_buffer_t::small_buffer_size);
+  TESTASSERT(small_copy.N_bytes == dst->N_bytes);
+  TESTASSERT(std::equal(small_copy.begin(), small_copy.end(), dst->begin()));
+
+  // Byte buffers outside of the pools with a given content only have room for it and the header
+  byte_buffer_t sized(10, 0x44);
+  TESTASSERT(sized.buffer_size == SRSRAN_BUFFER_HEADER_OFFSET + 10);
+  TESTASSERT(sized.N_bytes == 10 and sized.get_tailroom() == 0);
+  byte_buffer_t unsized;
+  TESTASSERT(unsized.buffer_size == SRSRAN_MAX_BUFFER_SIZE_BYTES and unsized.N_bytes == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_append_bytes()
+{
+  std::vector<uint8_t> data(byte_buffer_t::small_buffer_size, 0x33);
+
+  unique_byte_buffer_t buf = make_byte_buffer_with_tailroom(10);
+  TESTASSERT(buf->buffer_size == byte_buffer_t::small_buffer_size);
+  uint32_t tailroom = buf->get_tailroom();
+  TESTASSERT(buf->append_bytes(data.data(), tailroom - 1));
+  TESTASSERT(not buf->append_bytes(data.data(), 2));
+  TESTASSERT(buf->N_bytes == tailroom - 1);
+  TESTASSERT(buf->append_bytes(data.data(), 1));
+  TESTASSERT(buf->get_tailroom() == 0);
+  TESTASSERT(std::all_of(buf->begin(), buf->end(), [](uint8_t b) { return b == 0x33; }));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_fallback_to_larger_class()
+{
+  std::vector<unique_byte_buffer_t> bufs;
+  size_t                            nof_small = byte_buffer_class_pool_size;
+  byte_buffer_pools_metrics_t       metrics;
+
+  // Deplete the small buffers
+  for (size_t i = 0; i < nof_small; ++i) {
+    bufs.push_back(make_byte_buffer_with_tailroom(10));
+  }
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.nof_used_buffers == nof_small);
+  TESTASSERT(metrics.medium.nof_used_buffers == 0);
+
+  unique_byte_buffer_t buf = make_byte_buffer_with_tailroom(10);
+  TESTASSERT(buf != nullptr);
+  TESTASSERT(buf->buffer_size == byte_buffer_t::medium_buffer_size);
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.nof_failures > 0);
+
+  bufs.clear();
+  buf.reset();
+  get_byte_buffer_pools_metrics(metrics);
+  TESTASSERT(metrics.small.nof_used_buffers == 0);
+  TESTASSERT(metrics.medium.nof_used_buffers == 0);
+  TESTASSERT(metrics.small.max_used_buffers == nof_small);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  auto& logger = srslog::fetch_basic_logger("POOL", false);
+  logger.set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  // The small and medium size classes are disabled with a BYTE_BUFFER_CLASS_POOL_SIZE of 0
+  if (byte_buffer_class_pool_size > 0) {
+    TESTASSERT(test_size_classes() == SRSRAN_SUCCESS);
+    TESTASSERT(test_rx_byte_buffer() == SRSRAN_SUCCESS);
+    TESTASSERT(test_copy_to_smaller_class() == SRSRAN_SUCCESS);
+    TESTASSERT(test_append_bytes() == SRSRAN_SUCCESS);
+    TESTASSERT(test_fallback_to_larger_class() == SRSRAN_SUCCESS);
+  }
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
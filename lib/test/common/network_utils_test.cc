@@ -23,7 +23,9 @@
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/test_common.h"
 #include <atomic>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 struct rx_thread_tester {
   srsran::task_scheduler    task_sched;
@@ -148,6 +150,210 @@ int test_sctp_bind_error()
   return SRSRAN_SUCCESS;
 }
 
+/// Opens a UDP socket bound to the loopback interface, with a port chosen by the kernel
+void open_udp_socket(srsran::unique_socket& sock, sockaddr_in& addr)
+{
+  using namespace srsran::net_utils;
+  TESTASSERT(sock.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(sock.bind_addr("127.0.0.1", 0));
+  socklen_t addrlen = sizeof(addr);
+  TESTASSERT(getsockname(sock.fd(), (struct sockaddr*)&addr, &addrlen) == 0);
+}
+
+srsran::unique_byte_buffer_t make_test_pdu(uint32_t sn, uint32_t nof_bytes = sizeof(uint32_t))
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  TESTASSERT(pdu != nullptr and nof_bytes >= sizeof(sn) and pdu->get_tailroom() >= nof_bytes);
+  for (uint32_t i = 0; i < nof_bytes; ++i) {
+    pdu->msg[i] = static_cast<uint8_t>(sn + i);
+  }
+  memcpy(pdu->msg, &sn, sizeof(sn));
+  pdu->N_bytes = nof_bytes;
+  return pdu;
+}
+
+/// Receives the datagrams waiting in the socket, and returns their sequence numbers
+std::vector<uint32_t> recv_test_pdus(int fd)
+{
+  std::vector<uint32_t> sns;
+  uint32_t              sn;
+  while (recv(fd, &sn, sizeof(sn), MSG_DONTWAIT) == (ssize_t)sizeof(sn)) {
+    sns.push_back(sn);
+  }
+  return sns;
+}
+
+int test_socket_batch_counter()
+{
+  srsran::socket_batch_counter   counter;
+  srsran::socket_batch_metrics_t metrics;
+
+  counter.get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 0 and metrics.nof_packets == 0 and metrics.max_batch == 0);
+
+  counter.add_batch(3);
+  counter.add_batch(7);
+  counter.add_batch(2);
+  counter.get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 3);
+  TESTASSERT(metrics.nof_packets == 12);
+  TESTASSERT(metrics.max_batch == 7);
+
+  // The largest batch restarts with each read, while the totals keep counting
+  counter.add_batch(1);
+  counter.get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 4);
+  TESTASSERT(metrics.nof_packets == 13);
+  TESTASSERT(metrics.max_batch == 1);
+  counter.get_metrics(metrics);
+  TESTASSERT(metrics.max_batch == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_udp_batch_sender()
+{
+  auto&                          logger = srslog::fetch_basic_logger("S1AP", false);
+  srsran::unique_socket          tx_socket, rx_socket;
+  sockaddr_in                    tx_addr = {}, rx_addr = {};
+  srsran::socket_batch_metrics_t metrics;
+  open_udp_socket(tx_socket, tx_addr);
+  open_udp_socket(rx_socket, rx_addr);
+
+  srsran::udp_batch_sender sender(logger);
+  sender.set_fd(tx_socket.fd());
+  TESTASSERT(sender.empty());
+
+  // The datagrams are queued until the batch is full, and then sent with one call
+  const uint32_t batch_size = srsran::udp_batch_sender::max_batch_size;
+  for (uint32_t sn = 0; sn < batch_size - 1; ++sn) {
+    sender.push(make_test_pdu(sn), rx_addr);
+  }
+  TESTASSERT(not sender.empty());
+  TESTASSERT(recv_test_pdus(rx_socket.fd()).empty());
+  sender.push(make_test_pdu(batch_size - 1), rx_addr);
+  TESTASSERT(sender.empty());
+  std::vector<uint32_t> sns = recv_test_pdus(rx_socket.fd());
+  TESTASSERT(sns.size() == batch_size);
+  for (uint32_t sn = 0; sn < batch_size; ++sn) {
+    TESTASSERT(sns[sn] == sn);
+  }
+  sender.get_counter().get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 1 and metrics.nof_packets == batch_size and metrics.max_batch == batch_size);
+
+  // An incomplete batch is sent by flush()
+  for (uint32_t sn = 0; sn < 3; ++sn) {
+    sender.push(make_test_pdu(sn), rx_addr);
+  }
+  sender.flush();
+  TESTASSERT(sender.empty());
+  TESTASSERT(recv_test_pdus(rx_socket.fd()).size() == 3);
+  sender.get_counter().get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 2 and metrics.nof_packets == batch_size + 3 and metrics.max_batch == 3);
+
+  // A datagram that cannot be sent (UDP port 0) stops sendmmsg(...) with a partial result. It is dropped, and the
+  // datagrams after it are still sent, in order
+  sockaddr_in bad_addr = rx_addr;
+  bad_addr.sin_port    = 0;
+  for (uint32_t sn = 0; sn < 5; ++sn) {
+    sender.push(make_test_pdu(sn), sn == 2 ? bad_addr : rx_addr);
+  }
+  sender.flush();
+  TESTASSERT(sender.empty());
+  sns = recv_test_pdus(rx_socket.fd());
+  TESTASSERT(sns == std::vector<uint32_t>({0, 1, 3, 4}));
+  sender.get_counter().get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 4 and metrics.nof_packets == batch_size + 7 and metrics.max_batch == 2);
+
+  // When the socket fails, every datagram is dropped and the queue is emptied
+  sender.set_fd(-1);
+  for (uint32_t sn = 0; sn < 4; ++sn) {
+    sender.push(make_test_pdu(sn), rx_addr);
+  }
+  sender.flush();
+  TESTASSERT(sender.empty());
+  sender.get_counter().get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 4 and metrics.nof_packets == batch_size + 7);
+  TESTASSERT(recv_test_pdus(rx_socket.fd()).empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_batch_sdu_handler()
+{
+  auto&                          logger = srslog::fetch_basic_logger("S1AP", false);
+  srsran::unique_socket          tx_socket, rx_socket;
+  sockaddr_in                    tx_addr = {}, rx_addr = {};
+  srsran::socket_batch_metrics_t metrics;
+  open_udp_socket(tx_socket, tx_addr);
+  open_udp_socket(rx_socket, rx_addr);
+
+  srsran::task_scheduler       task_sched;
+  srsran::task_queue_handle    task_queue = task_sched.make_task_queue();
+  srsran::socket_batch_counter rx_batches;
+  std::vector<uint32_t>        rx_sns;
+  std::vector<uint32_t>        rx_sizes;
+
+  auto rx_callback = [&rx_sns, &rx_sizes, &tx_addr](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    TESTASSERT(from.sin_addr.s_addr == tx_addr.sin_addr.s_addr and from.sin_port == tx_addr.sin_port);
+    uint32_t sn;
+    memcpy(&sn, pdu->msg, sizeof(sn));
+    for (uint32_t i = sizeof(sn); i < pdu->N_bytes; ++i) {
+      TESTASSERT(pdu->msg[i] == static_cast<uint8_t>(sn + i));
+    }
+    rx_sns.push_back(sn);
+    rx_sizes.push_back(pdu->N_bytes);
+  };
+  srsran::socket_manager_itf::recv_callback_t handler =
+      srsran::make_sdu_handler(logger, task_queue, rx_callback, &rx_batches);
+
+  // Nothing is waiting in the socket
+  TESTASSERT(handler(rx_socket.fd()));
+  rx_batches.get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 0);
+
+  // One call receives at most a batch. The last datagram is larger than the medium byte buffers
+  const uint32_t nof_pdus     = 40;
+  const uint32_t max_pdu_size = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    srsran::unique_byte_buffer_t pdu = make_test_pdu(sn, sn == nof_pdus - 1 ? max_pdu_size : 16);
+    TESTASSERT(sendto(tx_socket.fd(), pdu->msg, pdu->N_bytes, 0, (struct sockaddr*)&rx_addr, sizeof(rx_addr)) ==
+               (ssize_t)pdu->N_bytes);
+  }
+  TESTASSERT(handler(rx_socket.fd()));
+  task_sched.run_pending_tasks();
+  TESTASSERT(rx_sns.size() == 32);
+  TESTASSERT(handler(rx_socket.fd()));
+  task_sched.run_pending_tasks();
+  TESTASSERT(rx_sns.size() == nof_pdus);
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    TESTASSERT(rx_sns[sn] == sn);
+    TESTASSERT(rx_sizes[sn] == (sn == nof_pdus - 1 ? max_pdu_size : 16));
+  }
+  rx_batches.get_metrics(metrics);
+  TESTASSERT(metrics.nof_calls == 2 and metrics.nof_packets == nof_pdus and metrics.max_batch == 32);
+
+  // The handlers of all the sockets read by a thread share the overflow areas, which each call merges before returning
+  srsran::unique_socket rx_socket2;
+  sockaddr_in           rx_addr2 = {};
+  open_udp_socket(rx_socket2, rx_addr2);
+  srsran::socket_manager_itf::recv_callback_t handler2 = srsran::make_sdu_handler(logger, task_queue, rx_callback);
+  srsran::unique_byte_buffer_t                pdu      = make_test_pdu(nof_pdus, max_pdu_size);
+  TESTASSERT(sendto(tx_socket.fd(), pdu->msg, pdu->N_bytes, 0, (struct sockaddr*)&rx_addr, sizeof(rx_addr)) ==
+             (ssize_t)pdu->N_bytes);
+  pdu = make_test_pdu(nof_pdus + 1, max_pdu_size);
+  TESTASSERT(sendto(tx_socket.fd(), pdu->msg, pdu->N_bytes, 0, (struct sockaddr*)&rx_addr2, sizeof(rx_addr2)) ==
+             (ssize_t)pdu->N_bytes);
+  TESTASSERT(handler(rx_socket.fd()));
+  TESTASSERT(handler2(rx_socket2.fd()));
+  task_sched.run_pending_tasks();
+  TESTASSERT(rx_sns.size() == nof_pdus + 2);
+  TESTASSERT(rx_sns[nof_pdus] == nof_pdus and rx_sns[nof_pdus + 1] == nof_pdus + 1);
+  TESTASSERT(rx_sizes[nof_pdus] == max_pdu_size and rx_sizes[nof_pdus + 1] == max_pdu_size);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   auto& logger = srslog::fetch_basic_logger("S1AP", false);
@@ -158,6 +364,9 @@ int main()
 
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
+  TESTASSERT(test_socket_batch_counter() == SRSRAN_SUCCESS);
+  TESTASSERT(test_udp_batch_sender() == SRSRAN_SUCCESS);
+  TESTASSERT(test_batch_sdu_handler() == SRSRAN_SUCCESS);
 
   return 0;
 }
@@ -0,0 +1,349 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/aes128.h"
+#include "srsran/common/s3g_zuc_engine.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t pdu_len     = 1500;
+static uint32_t nof_pdus    = 32;
+static uint32_t nof_repeats = 1000;
+
+static const uint8_t bearer    = 3;
+static const uint8_t direction = SECURITY_DIRECTION_DOWNLINK;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [lbr]\n", prog);
+  printf("\t-l PDU length in bytes [Default %d]\n", pdu_len);
+  printf("\t-b Number of PDUs per batch [Default %d]\n", nof_pdus);
+  printf("\t-r Number of repetitions [Default %d]\n", nof_repeats);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "lbr")) != -1) {
+    switch (opt) {
+      case 'l':
+        pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repeats = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+struct pdu_batch_t {
+  std::vector<std::vector<uint8_t> > msgs;
+  std::vector<std::vector<uint8_t> > outs;
+  std::vector<security_pdu_t>        pdus;
+
+  pdu_batch_t(std::mt19937& rgen, const std::vector<uint32_t>& lens)
+  {
+    std::uniform_int_distribution<uint32_t> byte_dist(0, 255);
+    for (uint32_t len : lens) {
+      msgs.emplace_back(len);
+      outs.emplace_back(std::max(len, 4U));
+      for (uint8_t& b : msgs.back()) {
+        b = (uint8_t)byte_dist(rgen);
+      }
+      pdus.push_back({(uint32_t)rgen(), msgs.back().data(), len, outs.back().data()});
+    }
+  }
+};
+
+static std::vector<aes128_engine::impl_t> supported_impls()
+{
+  std::vector<aes128_engine::impl_t> impls = {aes128_engine::impl_t::generic};
+  if (aes128_engine::get_hw_impl() >= aes128_engine::impl_t::aesni) {
+    impls.push_back(aes128_engine::impl_t::aesni);
+  }
+  if (aes128_engine::get_hw_impl() >= aes128_engine::impl_t::vaes) {
+    impls.push_back(aes128_engine::impl_t::vaes);
+  }
+  return impls;
+}
+
+/// Checks the engine against the 128-EEA2/128-EIA2 implementation of liblte, for PDU lengths around the AES block
+/// and batch boundaries.
+static int test_engine_output(aes128_engine::impl_t impl)
+{
+  std::mt19937 rgen(1234);
+  uint8_t      key[32];
+  for (uint8_t& b : key) {
+    b = (uint8_t)rgen();
+  }
+  std::vector<uint32_t> lens;
+  for (uint32_t len = 1; len < 70; ++len) {
+    lens.push_back(len);
+  }
+  lens.push_back(1500);
+  lens.push_back(9000);
+
+  aes128_engine engine(impl);
+  TESTASSERT(engine.get_impl() == impl);
+  engine.set_key(&key[16]);
+
+  pdu_batch_t          batch(rgen, lens);
+  std::vector<uint8_t> expected(9000);
+
+  // Batch ciphering
+  engine.eea2_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  for (const security_pdu_t& pdu : batch.pdus) {
+    security_128_eea2(&key[16], pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, expected.data());
+    TESTASSERT(memcmp(expected.data(), pdu.out, pdu.msg_len) == 0);
+  }
+
+  // Single PDU deciphering, in place
+  for (const security_pdu_t& pdu : batch.pdus) {
+    engine.eea2(pdu.count, bearer, direction, pdu.out, pdu.msg_len, pdu.out);
+    TESTASSERT(memcmp(pdu.msg, pdu.out, pdu.msg_len) == 0);
+  }
+
+  // Batch integrity
+  engine.eia2_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  for (const security_pdu_t& pdu : batch.pdus) {
+    security_128_eia2(&key[16], pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, expected.data());
+    TESTASSERT(memcmp(expected.data(), pdu.out, 4) == 0);
+
+    uint8_t mac[4];
+    engine.eia2(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, mac);
+    TESTASSERT(memcmp(expected.data(), mac, 4) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Checks the SNOW 3G and ZUC engines against the 128-EEA1/EIA1 and 128-EEA3/EIA3 implementations of liblte, with
+/// batches that mix PDU lengths across the lanes.
+static int test_s3g_zuc_output()
+{
+  using security_func_t  = uint8_t (*)(uint8_t*, uint32_t, uint8_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+  using integrity_func_t = uint8_t (*)(const uint8_t*, uint32_t, uint32_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+
+  std::mt19937 rgen(4321);
+  uint8_t      key[16];
+  for (uint8_t& b : key) {
+    b = (uint8_t)rgen();
+  }
+  std::vector<uint32_t> lens;
+  for (uint32_t len = 0; len < 70; ++len) {
+    lens.push_back(len);
+  }
+  lens.push_back(1500);
+  lens.push_back(9000);
+
+  s3g_engine s3g;
+  zuc_engine zuc;
+  s3g.set_key(key);
+  zuc.set_key(key);
+
+  pdu_batch_t          batch(rgen, lens);
+  std::vector<uint8_t> expected(9000);
+  std::vector<uint8_t> single(9000);
+
+  security_func_t  cipher_funcs[] = {security_128_eea1, security_128_eea3};
+  integrity_func_t integ_funcs[]  = {security_128_eia1, security_128_eia3};
+  for (uint32_t i = 0; i < 2; ++i) {
+    // Batch and single PDU ciphering
+    if (i == 0) {
+      s3g.eea1_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    } else {
+      zuc.eea3_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    }
+    for (const security_pdu_t& pdu : batch.pdus) {
+      if (pdu.msg_len == 0) {
+        continue;
+      }
+      cipher_funcs[i](key, pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, expected.data());
+      TESTASSERT(memcmp(expected.data(), pdu.out, pdu.msg_len) == 0);
+      if (i == 0) {
+        s3g.eea1(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, single.data());
+      } else {
+        zuc.eea3(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, single.data());
+      }
+      TESTASSERT(memcmp(expected.data(), single.data(), pdu.msg_len) == 0);
+    }
+
+    // Batch and single PDU integrity
+    if (i == 0) {
+      s3g.eia1_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    } else {
+      zuc.eia3_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    }
+    for (const security_pdu_t& pdu : batch.pdus) {
+      if (pdu.msg_len == 0) {
+        continue;
+      }
+      integ_funcs[i](key, pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, expected.data());
+      TESTASSERT(memcmp(expected.data(), pdu.out, 4) == 0);
+      if (i == 0) {
+        s3g.eia1(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, single.data());
+      } else {
+        zuc.eia3(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, single.data());
+      }
+      TESTASSERT(memcmp(expected.data(), single.data(), 4) == 0);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+template <typename Func>
+static void print_throughput(const char* algo, const char* impl, const char* mode, const Func& func)
+{
+  auto tp_start = std::chrono::high_resolution_clock::now();
+  for (uint32_t r = 0; r < nof_repeats; ++r) {
+    func();
+  }
+  auto     tp_end   = std::chrono::high_resolution_clock::now();
+  uint64_t nof_bits = (uint64_t)nof_repeats * nof_pdus * pdu_len * 8;
+  double   elapsed_us =
+      std::max<double>(std::chrono::duration_cast<std::chrono::microseconds>(tp_end - tp_start).count(), 1.0);
+  printf("%-9s %-8s %-7s %10.1f\n", algo, impl, mode, nof_bits / elapsed_us);
+}
+
+/// Throughput of each algorithm when called once per PDU through the security_* API, which expands the key for
+/// every PDU, and of the AES, SNOW 3G and ZUC engines when called once per PDU or once per batch.
+static void run_benchmark()
+{
+  using security_func_t  = uint8_t (*)(uint8_t*, uint32_t, uint8_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+  using integrity_func_t = uint8_t (*)(const uint8_t*, uint32_t, uint32_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+
+  std::mt19937 rgen(0);
+  uint8_t      key[16];
+  for (uint8_t& b : key) {
+    b = (uint8_t)rgen();
+  }
+  pdu_batch_t batch(rgen, std::vector<uint32_t>(nof_pdus, pdu_len));
+
+  printf("PDU length: %d bytes, batch: %d PDUs\n", pdu_len, nof_pdus);
+  printf("%-9s %-8s %-7s %10s\n", "algorithm", "impl", "mode", "Mbps");
+
+  const char*      cipher_names[] = {"128-EEA1", "128-EEA2", "128-EEA3"};
+  security_func_t  cipher_funcs[] = {security_128_eea1, security_128_eea2, security_128_eea3};
+  const char*      integ_names[]  = {"128-EIA1", "128-EIA2", "128-EIA3"};
+  integrity_func_t integ_funcs[]  = {security_128_eia1, security_128_eia2, security_128_eia3};
+  for (uint32_t i = 0; i < 3; ++i) {
+    print_throughput(cipher_names[i], "", "per-PDU", [&]() {
+      for (security_pdu_t& pdu : batch.pdus) {
+        cipher_funcs[i](key, pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, pdu.out);
+      }
+    });
+    print_throughput(integ_names[i], "", "per-PDU", [&]() {
+      for (security_pdu_t& pdu : batch.pdus) {
+        integ_funcs[i](key, pdu.count, bearer, direction, (uint8_t*)pdu.msg, pdu.msg_len, pdu.out);
+      }
+    });
+  }
+
+  for (aes128_engine::impl_t impl : supported_impls()) {
+    aes128_engine engine(impl);
+    engine.set_key(key);
+    const char* impl_name = aes128_engine::get_impl_name(impl);
+
+    print_throughput("128-EEA2", impl_name, "per-PDU", [&]() {
+      for (security_pdu_t& pdu : batch.pdus) {
+        engine.eea2(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+      }
+    });
+    print_throughput("128-EEA2", impl_name, "batch", [&]() {
+      engine.eea2_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    });
+    print_throughput("128-EIA2", impl_name, "per-PDU", [&]() {
+      for (security_pdu_t& pdu : batch.pdus) {
+        engine.eia2(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+      }
+    });
+    print_throughput("128-EIA2", impl_name, "batch", [&]() {
+      engine.eia2_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+    });
+  }
+
+  s3g_engine s3g;
+  zuc_engine zuc;
+  s3g.set_key(key);
+  zuc.set_key(key);
+  char lanes_name[16];
+  snprintf(lanes_name, sizeof(lanes_name), "%uxlane", s3g_engine::get_nof_lanes());
+
+  print_throughput("128-EEA1", "1xlane", "per-PDU", [&]() {
+    for (security_pdu_t& pdu : batch.pdus) {
+      s3g.eea1(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+    }
+  });
+  print_throughput("128-EEA1", lanes_name, "batch", [&]() {
+    s3g.eea1_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  });
+  print_throughput("128-EIA1", "1xlane", "per-PDU", [&]() {
+    for (security_pdu_t& pdu : batch.pdus) {
+      s3g.eia1(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+    }
+  });
+  print_throughput("128-EIA1", lanes_name, "batch", [&]() {
+    s3g.eia1_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  });
+  print_throughput("128-EEA3", "1xlane", "per-PDU", [&]() {
+    for (security_pdu_t& pdu : batch.pdus) {
+      zuc.eea3(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+    }
+  });
+  print_throughput("128-EEA3", lanes_name, "batch", [&]() {
+    zuc.eea3_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  });
+  print_throughput("128-EIA3", "1xlane", "per-PDU", [&]() {
+    for (security_pdu_t& pdu : batch.pdus) {
+      zuc.eia3(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.out);
+    }
+  });
+  print_throughput("128-EIA3", lanes_name, "batch", [&]() {
+    zuc.eia3_batch(bearer, direction, batch.pdus.data(), batch.pdus.size());
+  });
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  for (aes128_engine::impl_t impl : supported_impls()) {
+    TESTASSERT(test_engine_output(impl) == SRSRAN_SUCCESS);
+  }
+  TESTASSERT(test_s3g_zuc_output() == SRSRAN_SUCCESS);
+
+  run_benchmark();
+
+  return SRSRAN_SUCCESS;
+}
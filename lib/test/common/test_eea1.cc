@@ -25,6 +25,7 @@
 
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/test_common.h"
+#include "srsran/common/test_security_engine.h"
 #include "srsran/srsran.h"
 
 /*
@@ -84,6 +85,17 @@ int test_set_1()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -129,6 +141,17 @@ int test_set_2()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -168,6 +191,17 @@ int test_set_3()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -217,6 +251,17 @@ int test_set_4()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -270,6 +315,17 @@ int test_set_5()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -369,6 +425,17 @@ int test_set_6()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::s3g_engine::eea1,
+                                           &srsran::s3g_engine::eea1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
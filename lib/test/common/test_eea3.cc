@@ -24,6 +24,7 @@
 
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/test_common.h"
+#include "srsran/common/test_security_engine.h"
 #include "srsran/srsran.h"
 
 int32 arrcmp(uint8_t const* const a, uint8_t const* const b, uint32 len)
@@ -95,6 +96,17 @@ int test_set_1()
     printf("Test Set 1 Decryption: Failed\n");
   }
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::zuc_engine::eea3,
+                                           &srsran::zuc_engine::eea3_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -155,6 +167,17 @@ int test_set_2()
     printf("Test Set 2 Decryption: Failed\n");
   }
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::zuc_engine::eea3,
+                                           &srsran::zuc_engine::eea3_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -228,6 +251,17 @@ int test_set_3()
     printf("Test Set 3 Decryption: Failed\n");
   }
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::zuc_engine::eea3,
+                                           &srsran::zuc_engine::eea3_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -317,6 +351,17 @@ int test_set_4()
     printf("Test Set 4 Decryption: Failed\n");
   }
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::zuc_engine::eea3,
+                                           &srsran::zuc_engine::eea3_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -422,6 +467,17 @@ int test_set_5()
     printf("Test Set 5 Decryption: Failed\n");
   }
 
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_ciphering(&srsran::zuc_engine::eea3,
+                                           &srsran::zuc_engine::eea3_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           ct,
+                                           len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -26,6 +26,7 @@
 
 #include "srsran/common/security.h"
 #include "srsran/common/test_common.h"
+#include "srsran/common/test_security_engine.h"
 #include "srsran/srsran.h"
 
 /*
@@ -53,6 +54,17 @@ int test_set_1()
   for (int i = 0; i < 4; i++) {
     TESTASSERT(mac[i] == mt[i]);
   }
+
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_integrity(&srsran::s3g_engine::eia1,
+                                           &srsran::s3g_engine::eia1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           len_bytes,
+                                           mt) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
 
@@ -79,6 +91,17 @@ int test_set_4()
   for (int i = 0; i < 4; i++) {
     TESTASSERT(mac[i] == mt[i]);
   }
+
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_integrity(&srsran::s3g_engine::eia1,
+                                           &srsran::s3g_engine::eia1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           len_bytes,
+                                           mt) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
 
@@ -211,6 +234,17 @@ int test_set_7()
   for (int i = 0; i < 4; i++) {
     TESTASSERT(mac[i] == mt[i]);
   }
+
+  // multi-buffer engine
+  TESTASSERT(srsran::test_engine_integrity(&srsran::s3g_engine::eia1,
+                                           &srsran::s3g_engine::eia1_batch,
+                                           key,
+                                           count,
+                                           bearer,
+                                           direction,
+                                           msg,
+                                           len_bytes,
+                                           mt) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
 /*
@@ -0,0 +1,348 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "pdcp_lte_test.h"
+#include "srsran/upper/pdcp_security_pool.h"
+#include <chrono>
+#include <thread>
+
+/*
+ * Dummy RLC and GW that keep all the packets they receive
+ */
+class rlc_recorder : public rlc_dummy
+{
+public:
+  explicit rlc_recorder(srslog::basic_logger& logger) : rlc_dummy(logger) {}
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override { pdus.push_back(std::move(sdu)); }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+class gw_recorder : public gw_dummy
+{
+public:
+  explicit gw_recorder(srslog::basic_logger& logger) : gw_dummy(logger) {}
+  void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override { sdus.push_back(std::move(pdu)); }
+
+  std::vector<srsran::unique_byte_buffer_t> sdus;
+};
+
+const uint32_t nof_sdus = 300;
+
+srsran::pdcp_config_t make_drb_cfg(srsran::security_direction_t tx_dir, srsran::security_direction_t rx_dir)
+{
+  return {1,
+          srsran::PDCP_RB_IS_DRB,
+          tx_dir,
+          rx_dir,
+          srsran::PDCP_SN_LEN_12,
+          srsran::pdcp_t_reordering_t::ms500,
+          srsran::pdcp_discard_timer_t::infinity,
+          false,
+          srsran::srsran_rat_t::lte};
+}
+
+srsran::unique_byte_buffer_t make_test_sdu(uint32_t i)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes                     = 1 + (i * 37) % 1500;
+  for (uint32_t j = 0; j < sdu->N_bytes; ++j) {
+    sdu->msg[j] = i + j;
+  }
+  return sdu;
+}
+
+srsran::as_security_config_t make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo, uint8_t key_seed)
+{
+  srsran::as_security_config_t cfg = sec_cfg;
+  cfg.cipher_algo                  = cipher_algo;
+  for (uint32_t i = 0; i < cfg.k_up_enc.size(); ++i) {
+    cfg.k_up_enc[i] = key_seed + i;
+  }
+  return cfg;
+}
+
+// Runs the stack tasks until the number of packets reaches nof_pkts
+template <typename Vector>
+int wait_for_packets(srsue::stack_test_dummy& stack, const Vector& pkts, uint32_t nof_pkts)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (pkts.size() < nof_pkts) {
+    TESTASSERT(std::chrono::steady_clock::now() < deadline);
+    stack.run_pending_tasks();
+    std::this_thread::yield();
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Runs the stack tasks until the PDUs in the single worker of the pool are returned. A PDU of a new entity, bound to that
+// worker, is returned after them
+int drain_security_pool(srsue::stack_test_dummy&    stack,
+                        srsran::pdcp_security_pool& pool,
+                        srslog::basic_logger&       logger)
+{
+  TESTASSERT(pool.get_nof_workers() == 1);
+  rlc_recorder rlc(logger);
+  rrc_dummy    rrc(logger);
+  gw_recorder  gw(logger);
+
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+  pdcp.set_security_pool(&pool);
+  TESTASSERT(pdcp.configure(make_drb_cfg(srsran::SECURITY_DIRECTION_UPLINK, srsran::SECURITY_DIRECTION_DOWNLINK)));
+  pdcp.config_security(make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, 0x40));
+  pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+  pdcp.write_sdu(make_test_sdu(0));
+  return wait_for_packets(stack, rlc.pdus, 1);
+}
+
+/*
+ * Writes nof_sdus SDUs into an entity ciphering inline and into an entity with security workers. The keys change
+ * halfway, while PDUs are still in the workers. The PDUs of both entities must be equal and in the same order, and
+ * deciphered in order by a receiving entity with security workers.
+ */
+int test_tx_rx(srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo,
+               srsran::CIPHERING_ALGORITHM_ID_ENUM new_cipher_algo,
+               uint32_t                            nof_workers,
+               srslog::basic_logger&               logger)
+{
+  srsue::stack_test_dummy    stack;
+  srsran::pdcp_security_pool pool(&stack.task_sched, nof_workers);
+  rlc_recorder               rlc_ref(logger), rlc(logger), rlc_rx(logger);
+  rrc_dummy                  rrc(logger);
+  gw_recorder                gw(logger), gw_rx(logger);
+
+  srsran::pdcp_config_t cfg_tx = make_drb_cfg(srsran::SECURITY_DIRECTION_UPLINK, srsran::SECURITY_DIRECTION_DOWNLINK);
+  srsran::pdcp_config_t cfg_rx = make_drb_cfg(srsran::SECURITY_DIRECTION_DOWNLINK, srsran::SECURITY_DIRECTION_UPLINK);
+
+  srsran::pdcp_entity_lte pdcp_ref(&rlc_ref, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_tx(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_rx(&rlc_rx, &rrc, &gw_rx, &stack.task_sched, logger, 3);
+  pdcp_tx.set_security_pool(&pool);
+  pdcp_rx.set_security_pool(&pool);
+  TESTASSERT(pdcp_ref.configure(cfg_tx));
+  TESTASSERT(pdcp_tx.configure(cfg_tx));
+  TESTASSERT(pdcp_rx.configure(cfg_rx));
+  for (srsran::pdcp_entity_lte* pdcp : {&pdcp_ref, &pdcp_tx, &pdcp_rx}) {
+    pdcp->config_security(make_sec_cfg(cipher_algo, 0x40));
+    pdcp->enable_encryption(srsran::DIRECTION_TXRX);
+  }
+
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    if (i == nof_sdus / 2) {
+      pdcp_ref.config_security(make_sec_cfg(new_cipher_algo, 0x80));
+      pdcp_tx.config_security(make_sec_cfg(new_cipher_algo, 0x80));
+    }
+    pdcp_ref.write_sdu(make_test_sdu(i));
+    pdcp_tx.write_sdu(make_test_sdu(i));
+  }
+  TESTASSERT(rlc_ref.pdus.size() == nof_sdus);
+  TESTASSERT(wait_for_packets(stack, rlc.pdus, nof_sdus) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    TESTASSERT(compare_two_packets(rlc_ref.pdus[i], rlc.pdus[i]) == 0);
+    TESTASSERT(rlc.pdus[i]->md.pdcp_sn == i);
+  }
+
+  // Deciphering, with the keys changing at the same PDU
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    if (i == nof_sdus / 2) {
+      pdcp_rx.config_security(make_sec_cfg(new_cipher_algo, 0x80));
+    }
+    pdcp_rx.write_pdu(std::move(rlc.pdus[i]));
+  }
+  TESTASSERT(wait_for_packets(stack, gw_rx.sdus, nof_sdus) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    TESTASSERT(compare_two_packets(make_test_sdu(i), gw_rx.sdus[i]) == 0);
+  }
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Destroys an entity while its PDUs are in the security workers. Its PDUs must be dropped.
+ */
+int test_release_with_pending_pdus(srslog::basic_logger& logger)
+{
+  srsue::stack_test_dummy    stack;
+  srsran::pdcp_security_pool pool(&stack.task_sched, 1);
+  rlc_recorder               rlc(logger);
+  rrc_dummy                  rrc(logger);
+  gw_recorder                gw(logger);
+
+  {
+    srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+    pdcp.set_security_pool(&pool);
+    TESTASSERT(pdcp.configure(make_drb_cfg(srsran::SECURITY_DIRECTION_UPLINK, srsran::SECURITY_DIRECTION_DOWNLINK)));
+    pdcp.config_security(make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, 0x40));
+    pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+    for (uint32_t i = 0; i < nof_sdus; ++i) {
+      pdcp.write_sdu(make_test_sdu(i));
+    }
+  }
+
+  // Let the worker return the PDUs of the destroyed entity
+  TESTASSERT(drain_security_pool(stack, pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(rlc.pdus.empty());
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Two entities share a worker with a small queue. When the queue is full, the PDUs are ciphered inline, and held back
+ * until the PDUs of the entity in the worker are returned. No PDU is lost or reordered.
+ */
+int test_full_queue(srslog::basic_logger& logger)
+{
+  srsue::stack_test_dummy    stack;
+  srsran::pdcp_security_pool pool(&stack.task_sched, 1, 4);
+  rlc_recorder               rlc_ref(logger), rlc_a(logger), rlc_b(logger);
+  rrc_dummy                  rrc(logger);
+  gw_recorder                gw(logger);
+
+  srsran::pdcp_config_t   cfg = make_drb_cfg(srsran::SECURITY_DIRECTION_UPLINK, srsran::SECURITY_DIRECTION_DOWNLINK);
+  srsran::pdcp_entity_lte pdcp_ref(&rlc_ref, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_a(&rlc_a, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_b(&rlc_b, &rrc, &gw, &stack.task_sched, logger, 3);
+  pdcp_a.set_security_pool(&pool);
+  pdcp_b.set_security_pool(&pool);
+  for (srsran::pdcp_entity_lte* pdcp : {&pdcp_ref, &pdcp_a, &pdcp_b}) {
+    TESTASSERT(pdcp->configure(cfg));
+    pdcp->config_security(make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_128_EEA1, 0x40));
+    pdcp->enable_encryption(srsran::DIRECTION_TXRX);
+  }
+
+  // Bursts of one entity fill the queue while the other entity has no PDUs in the worker
+  const uint32_t burst_size = 10;
+  for (uint32_t i = 0; i < nof_sdus; i += burst_size) {
+    for (uint32_t j = i; j < i + burst_size; ++j) {
+      pdcp_ref.write_sdu(make_test_sdu(j));
+      pdcp_b.write_sdu(make_test_sdu(j));
+    }
+    // The SDUs are made beforehand, so that they are written faster than the worker ciphers them
+    std::vector<srsran::unique_byte_buffer_t> burst;
+    for (uint32_t j = i; j < i + burst_size; ++j) {
+      burst.push_back(make_test_sdu(j));
+    }
+    for (srsran::unique_byte_buffer_t& sdu : burst) {
+      pdcp_a.write_sdu(std::move(sdu));
+    }
+    TESTASSERT(wait_for_packets(stack, rlc_a.pdus, i + burst_size) == SRSRAN_SUCCESS);
+    TESTASSERT(wait_for_packets(stack, rlc_b.pdus, i + burst_size) == SRSRAN_SUCCESS);
+  }
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    TESTASSERT(compare_two_packets(rlc_ref.pdus[i], rlc_a.pdus[i]) == 0);
+    TESTASSERT(compare_two_packets(rlc_ref.pdus[i], rlc_b.pdus[i]) == 0);
+  }
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Re-establishes an RLC-AM entity, and resets and configures it again, while its PDUs are in the security workers.
+ * The Tx PDUs must be dropped, and the PDUs written afterwards delivered. The Rx PDUs deciphered across the
+ * re-establishment must be delivered.
+ */
+int test_reestablish_with_pending_pdus(srslog::basic_logger& logger)
+{
+  srsue::stack_test_dummy    stack;
+  srsran::pdcp_security_pool pool(&stack.task_sched, 1);
+  rlc_recorder               rlc(logger), rlc_ref(logger), rlc_rx(logger);
+  rrc_dummy                  rrc(logger);
+  gw_recorder                gw(logger), gw_rx(logger);
+
+  srsran::pdcp_config_t   cfg    = make_drb_cfg(srsran::SECURITY_DIRECTION_UPLINK, srsran::SECURITY_DIRECTION_DOWNLINK);
+  srsran::pdcp_config_t   cfg_rx = make_drb_cfg(srsran::SECURITY_DIRECTION_DOWNLINK, srsran::SECURITY_DIRECTION_UPLINK);
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_ref(&rlc_ref, &rrc, &gw, &stack.task_sched, logger, 3);
+  srsran::pdcp_entity_lte pdcp_rx(&rlc_rx, &rrc, &gw_rx, &stack.task_sched, logger, 3);
+  pdcp.set_security_pool(&pool);
+  pdcp_rx.set_security_pool(&pool);
+  TESTASSERT(pdcp.configure(cfg));
+  TESTASSERT(pdcp_ref.configure(cfg));
+  TESTASSERT(pdcp_rx.configure(cfg_rx));
+  for (srsran::pdcp_entity_lte* entity : {&pdcp, &pdcp_ref, &pdcp_rx}) {
+    entity->config_security(make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, 0x40));
+    entity->enable_encryption(srsran::DIRECTION_TXRX);
+  }
+
+  // Re-establishment
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    pdcp.write_sdu(make_test_sdu(i));
+    pdcp_ref.write_sdu(make_test_sdu(i));
+    pdcp_rx.write_pdu(std::move(rlc_ref.pdus[i]));
+  }
+  pdcp.reestablish();
+  pdcp_rx.reestablish();
+  TESTASSERT(drain_security_pool(stack, pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(rlc.pdus.empty());
+  TESTASSERT(gw_rx.sdus.size() == nof_sdus);
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    TESTASSERT(compare_two_packets(make_test_sdu(i), gw_rx.sdus[i]) == 0);
+  }
+
+  // Reset followed by a new configuration
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    pdcp.write_sdu(make_test_sdu(i));
+  }
+  pdcp.reset();
+  TESTASSERT(pdcp.configure(cfg));
+  TESTASSERT(drain_security_pool(stack, pool, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(rlc.pdus.empty());
+
+  pdcp.write_sdu(make_test_sdu(0));
+  TESTASSERT(wait_for_packets(stack, rlc.pdus, 1) == SRSRAN_SUCCESS);
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int run_all_tests()
+{
+  // Setup log
+  auto& logger = srslog::fetch_basic_logger("PDCP LTE Test Security Pool", false);
+  logger.set_level(srslog::basic_levels::info);
+  logger.set_hex_dump_max_size(128);
+
+  TESTASSERT(test_tx_rx(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, srsran::CIPHERING_ALGORITHM_ID_128_EEA2, 1, logger) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_rx(srsran::CIPHERING_ALGORITHM_ID_128_EEA1, srsran::CIPHERING_ALGORITHM_ID_128_EEA3, 2, logger) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_rx(srsran::CIPHERING_ALGORITHM_ID_EEA0, srsran::CIPHERING_ALGORITHM_ID_128_EEA2, 4, logger) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(test_release_with_pending_pdus(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_full_queue(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_reestablish_with_pending_pdus(logger) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  if (run_all_tests() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "pdcp_lte_test_security_pool() failed\n");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -52,7 +52,8 @@ public:
       printf("Received PDU with size %d, expected %d. Exiting.\n", sdu->N_bytes, expected_sdu_len);
       exit(-1);
     }
-    sdus[n_sdus++] = std::move(sdu);
+    sdu_lcids[n_sdus] = lcid;
+    sdus[n_sdus++]    = std::move(sdu);
   }
   void notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) {}
   void notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) {}
@@ -68,6 +69,7 @@ public:
   void        set_expected_sdu_len(uint32_t len) { expected_sdu_len = len; }
 
   unique_byte_buffer_t sdus[MAX_NBUFS];
+  uint32_t             sdu_lcids[MAX_NBUFS];
   int                  n_sdus;
   uint32_t             expected_sdu_len;
 };
@@ -204,6 +206,67 @@ int meas_obj_test()
   return 0;
 }
 
+// PDUs of several bearers handed over in one call, as the MAC does after demultiplexing a PDU
+int write_pdus_test()
+{
+  auto& logger_rlc1 = srslog::fetch_basic_logger("RLC_1", false);
+  auto& logger_rlc2 = srslog::fetch_basic_logger("RLC_2", false);
+
+  rlc_tester            tester;
+  srsran::timer_handler timers(1);
+
+  rlc rlc1(logger_rlc1.id().c_str());
+  rlc rlc2(logger_rlc2.id().c_str());
+
+  rlc1.init(&tester, &tester, &timers, 0);
+  rlc2.init(&tester, &tester, &timers, 0);
+
+  rlc_config_t cnfg = rlc_config_t::default_rlc_um_config(10);
+  for (uint32_t lcid = 1; lcid <= 2; lcid++) {
+    rlc1.add_bearer(lcid, cnfg);
+    rlc2.add_bearer(lcid, cnfg);
+  }
+
+  tester.set_expected_sdu_len(1);
+
+  // NBUFS PDUs of one byte per bearer. The payload tells the bearer and the position
+  byte_buffer_t pdu_bufs[2][NBUFS];
+  for (uint32_t lcid = 1; lcid <= 2; lcid++) {
+    for (int i = 0; i < NBUFS; i++) {
+      unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      *sdu->msg                = lcid * NBUFS + i;
+      sdu->N_bytes             = 1;
+      rlc1.write_sdu(lcid, std::move(sdu));
+      byte_buffer_t& pdu = pdu_bufs[lcid - 1][i];
+      pdu.N_bytes        = rlc1.read_pdu(lcid, pdu.msg, 4);
+      TESTASSERT(pdu.N_bytes > 0);
+    }
+  }
+
+  // The PDUs of both bearers are interleaved, as they may come in a MAC PDU
+  std::vector<rlc_pdu_ref_t> pdus;
+  for (int i = 0; i < NBUFS; i++) {
+    for (uint32_t lcid = 1; lcid <= 2; lcid++) {
+      pdus.push_back({lcid, pdu_bufs[lcid - 1][i].msg, pdu_bufs[lcid - 1][i].N_bytes});
+    }
+    // PDUs of bearers that do not exist are dropped without affecting the rest
+    pdus.push_back({7, pdu_bufs[0][i].msg, pdu_bufs[0][i].N_bytes});
+  }
+
+  rlc2.write_pdus(pdus);
+
+  // The SDUs are delivered in the order of the PDUs, as with one write_pdu() call per PDU
+  TESTASSERT(2 * NBUFS == tester.n_sdus);
+  for (int i = 0; i < 2 * NBUFS; i++) {
+    uint32_t lcid = 1 + i % 2;
+    TESTASSERT(tester.sdu_lcids[i] == lcid);
+    TESTASSERT(tester.sdus[i]->N_bytes == 1);
+    TESTASSERT(*(tester.sdus[i]->msg) == lcid * NBUFS + i / 2);
+  }
+
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
@@ -211,4 +274,8 @@ int main(int argc, char** argv)
   if (meas_obj_test()) {
     return -1;
   }
+
+  if (write_pdus_test()) {
+    return -1;
+  }
 }
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_base.h"
+#include "srsran/rlc/rlc_um_lte.h"
+#include "srsran/rlc/rlc_um_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t sdu_len          = 1500;
+static uint32_t grant_len        = 100;
+static uint32_t nof_sdus         = 20000;
+static float    pdu_loss_rate    = 0.05;
+static uint32_t nof_pdus_per_tti = 32;
+
+// TTIs run after the last SDU is written, for the retransmissions and the reordering timers
+static const uint32_t nof_drain_ttis = 1000;
+static const uint32_t lcid           = 1;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [lgnp]\n", prog);
+  printf("\t-l SDU length in bytes [Default %d]\n", sdu_len);
+  printf("\t-g MAC grant per PDU in bytes [Default %d]\n", grant_len);
+  printf("\t-n Number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-p PDU loss rate [Default %.2f]\n", pdu_loss_rate);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "l:g:n:p:")) != -1) {
+    switch (opt) {
+      case 'l':
+        sdu_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'g':
+        grant_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        pdu_loss_rate = strtof(optarg, NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static srslog::basic_logger& fetch_logger(const char* name)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger(name, false);
+  logger.set_level(srslog::basic_levels::error);
+  return logger;
+}
+
+/// Dummy PDCP and RRC that count the SDUs delivered by the receiving entity
+class sdu_counter : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  void write_pdu(uint32_t lcid_, unique_byte_buffer_t sdu) override
+  {
+    if (sdu->N_bytes != sdu_len or sdu->msg[0] != sdu->msg[sdu->N_bytes - 1]) {
+      nof_corrupted_sdus++;
+    }
+    nof_sdus++;
+  }
+  void        write_pdu_bcch_bch(unique_byte_buffer_t sdu) override {}
+  void        write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) override {}
+  void        write_pdu_pcch(unique_byte_buffer_t sdu) override {}
+  void        write_pdu_mch(uint32_t lcid_, unique_byte_buffer_t sdu) override {}
+  void        notify_delivery(uint32_t lcid_, const pdcp_sn_vector_t& pdcp_sns) override {}
+  void        notify_failure(uint32_t lcid_, const pdcp_sn_vector_t& pdcp_sns) override {}
+  void        max_retx_attempted() override {}
+  void        protocol_failure() override {}
+  const char* get_rb_name(uint32_t lcid_) override { return "DRB1"; }
+
+  uint32_t nof_sdus           = 0;
+  uint32_t nof_corrupted_sdus = 0;
+};
+
+/**
+ * Writes the SDUs in the transmitting entity, and passes its PDUs, made for small grants, to the receiving entity
+ * while dropping some of them at random. The status PDUs of AM are never dropped. Only the time spent by the
+ * receiving entity in reordering and reassembling the PDUs is measured.
+ */
+static int run_bearer(const char* name, rlc_common& tx, rlc_common& rx, timer_handler& timers, sdu_counter& counter)
+{
+  std::mt19937                          rgen(0);
+  std::uniform_real_distribution<float> loss_dist(0.0, 1.0);
+  std::vector<uint8_t>                  pdu(grant_len);
+  std::vector<uint8_t>                  status_pdu(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+
+  uint32_t                 nof_written_sdus = 0;
+  uint32_t                 nof_rx_pdus      = 0;
+  uint32_t                 nof_lost_pdus    = 0;
+  uint32_t                 nof_drained_ttis = 0;
+  std::chrono::nanoseconds rx_time(0);
+  while (nof_drained_ttis < nof_drain_ttis) {
+    while (nof_written_sdus < nof_sdus and not tx.sdu_queue_is_full()) {
+      unique_byte_buffer_t sdu = make_byte_buffer(sdu_len, (uint8_t)nof_written_sdus);
+      TESTASSERT(sdu != nullptr);
+      tx.write_sdu(std::move(sdu));
+      nof_written_sdus++;
+    }
+
+    for (uint32_t i = 0; i < nof_pdus_per_tti; ++i) {
+      uint32_t len = tx.read_pdu(pdu.data(), grant_len);
+      if (len == 0) {
+        break;
+      }
+      if (loss_dist(rgen) < pdu_loss_rate) {
+        nof_lost_pdus++;
+        continue;
+      }
+      auto tp_start = std::chrono::steady_clock::now();
+      rx.write_pdu(pdu.data(), len);
+      rx_time += std::chrono::steady_clock::now() - tp_start;
+      nof_rx_pdus++;
+    }
+
+    uint32_t len = rx.read_pdu(status_pdu.data(), status_pdu.size());
+    if (len > 0) {
+      tx.write_pdu(status_pdu.data(), len);
+    }
+
+    timers.step_all();
+    if (nof_written_sdus == nof_sdus) {
+      nof_drained_ttis++;
+    }
+  }
+
+  double rx_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(rx_time).count();
+  printf("%-8s %9d %9d %9d %9d %10.1f\n",
+         name,
+         nof_rx_pdus,
+         nof_lost_pdus,
+         counter.nof_sdus,
+         counter.nof_corrupted_sdus,
+         rx_time_ns / std::max(nof_rx_pdus, 1U));
+  TESTASSERT(counter.nof_corrupted_sdus == 0);
+  return SRSRAN_SUCCESS;
+}
+
+static int run_am_lte()
+{
+  timer_handler timers(16);
+  sdu_counter   tx_counter, rx_counter;
+  rlc_am        tx(srsran_rat_t::lte, fetch_logger("RLC_AM_1"), lcid, &tx_counter, &tx_counter, &timers);
+  rlc_am        rx(srsran_rat_t::lte, fetch_logger("RLC_AM_2"), lcid, &rx_counter, &rx_counter, &timers);
+
+  // Enough retransmissions for all SDUs to be delivered
+  rlc_config_t cfg       = rlc_config_t::default_rlc_am_config();
+  cfg.am.max_retx_thresh = 32;
+  TESTASSERT(tx.configure(cfg));
+  TESTASSERT(rx.configure(cfg));
+
+  TESTASSERT(run_bearer("LTE AM", tx, rx, timers, rx_counter) == SRSRAN_SUCCESS);
+  TESTASSERT(rx_counter.nof_sdus == nof_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+static int run_um_lte()
+{
+  timer_handler timers(16);
+  sdu_counter   tx_counter, rx_counter;
+  rlc_um_lte    tx(fetch_logger("RLC_UM_1"), lcid, &tx_counter, &tx_counter, &timers);
+  rlc_um_lte    rx(fetch_logger("RLC_UM_2"), lcid, &rx_counter, &rx_counter, &timers);
+
+  rlc_config_t cfg = rlc_config_t::default_rlc_um_config(10);
+  TESTASSERT(tx.configure(cfg));
+  TESTASSERT(rx.configure(cfg));
+
+  return run_bearer("LTE UM", tx, rx, timers, rx_counter);
+}
+
+static int run_um_nr()
+{
+  timer_handler timers(16);
+  sdu_counter   tx_counter, rx_counter;
+  rlc_um_nr     tx(fetch_logger("RLC_UM_1"), lcid, &tx_counter, &tx_counter, &timers);
+  rlc_um_nr     rx(fetch_logger("RLC_UM_2"), lcid, &rx_counter, &rx_counter, &timers);
+
+  rlc_config_t cfg = rlc_config_t::default_rlc_um_nr_config(12);
+  TESTASSERT(tx.configure(cfg));
+  TESTASSERT(rx.configure(cfg));
+
+  return run_bearer("NR UM", tx, rx, timers, rx_counter);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  printf("SDU length: %d bytes, grant: %d bytes, PDU loss rate: %.2f\n", sdu_len, grant_len, pdu_loss_rate);
+  printf("%-8s %9s %9s %9s %9s %10s\n", "bearer", "rx PDUs", "lost PDUs", "rx SDUs", "corrupted", "ns/rx PDU");
+
+  TESTASSERT(run_am_lte() == SRSRAN_SUCCESS);
+  TESTASSERT(run_um_lte() == SRSRAN_SUCCESS);
+  TESTASSERT(run_um_nr() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
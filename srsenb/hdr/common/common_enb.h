@@ -35,7 +35,10 @@ namespace srsenb {
 #define SRSENB_RRC_MAX_N_PLMN_IDENTITIES 6
 
 #define SRSENB_N_SRB 3
+// Can be overridden at build time, e.g. to benchmark the schedulers with a large number of UEs
+#ifndef SRSENB_MAX_UES
 #define SRSENB_MAX_UES 64
+#endif
 const uint32_t MAX_ERAB_ID   = 15;
 const uint32_t MAX_NOF_ERABS = 16;
 
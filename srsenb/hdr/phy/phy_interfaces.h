@@ -53,6 +53,7 @@ struct cfr_args_t {
   float             strength         = 1.0f;
   float             auto_target_papr = 8.0f;
   float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  uint32_t          iterations       = 1;
 };
 
 struct phy_args_t {
@@ -66,12 +66,56 @@ struct mac_cc_info_t {
   uint32_t cc_rach_counter;
 };
 
+/// Scheduler feedback event queue metrics, accumulated since the previous read.
+struct mac_sched_event_metrics_t {
+  /// Number of feedback events applied by the scheduler.
+  uint32_t nof_events;
+  /// Number of events applied synchronously because the event queue was full.
+  uint32_t nof_overflows;
+  /// Maximum number of pending events found in a single drain of the event queues.
+  uint32_t max_queue_depth;
+  /// Average and maximum delay between the event push and its application, in microseconds.
+  float avg_latency_us;
+  float max_latency_us;
+};
+
+/// NR scheduler pipeline metrics, accumulated since the previous read.
+struct mac_sched_pipeline_metrics_t {
+  /// Number of {slot, cc} results requested by the PHY.
+  uint32_t nof_slots;
+  /// Number of {slot, cc} results that the scheduler thread had not finished when requested by the PHY.
+  uint32_t nof_late_slots;
+  /// Maximum time that the PHY waited for a late result, in microseconds.
+  float max_wait_us;
+};
+
+/// Occupancy of a shared HARQ softbuffer code block pool.
+struct mac_softbuffer_pool_metrics_t {
+  /// Number of code block buffers allocated by the pool.
+  uint32_t nof_cbs;
+  /// Number of code block buffers currently bound to HARQ processes.
+  uint32_t nof_used_cbs;
+  /// Maximum number of code block buffers bound at the same time since the previous read.
+  uint32_t max_used_cbs;
+  /// Memory allocated by the pool, in bytes.
+  uint64_t nof_bytes;
+  /// Number of softbuffers that could not be bound since the previous read.
+  uint32_t nof_failures;
+};
+
 /// Main MAC metrics.
 struct mac_metrics_t {
   /// Per CC info.
   std::vector<mac_cc_info_t> cc_info;
   /// Per UE MAC metrics.
   std::vector<mac_ue_metrics_t> ues;
+  /// Scheduler event queue metrics.
+  mac_sched_event_metrics_t sched_events;
+  /// NR scheduler pipeline metrics.
+  mac_sched_pipeline_metrics_t sched_pipeline;
+  /// DL (Tx) and UL (Rx) HARQ softbuffer pool metrics.
+  mac_softbuffer_pool_metrics_t dl_softbuffers;
+  mac_softbuffer_pool_metrics_t ul_softbuffers;
 };
 
 } // namespace srsenb
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SOFTBUFFER_POOL_H
+#define SRSENB_SOFTBUFFER_POOL_H
+
+#include "mac_metrics.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+extern "C" {
+#include "srsran/phy/fec/softbuffer.h"
+}
+
+namespace srsenb {
+
+/**
+ * Pool of code block (CB) buffers shared by the HARQ softbuffers of all UEs.
+ * The memory of the CB buffers is reserved when the cells are configured and kept until the pool is destroyed. CB
+ * buffers are handed out individually, so that a HARQ process only holds the CBs of the TB that it has in flight.
+ * The pool never allocates memory when CB buffers are taken, as this happens in the PHY and MAC workers. When there
+ * are not enough free CB buffers left, the allocation fails.
+ */
+class softbuffer_cb_pool
+{
+public:
+  explicit softbuffer_cb_pool(uint32_t block_size_);
+  softbuffer_cb_pool(const softbuffer_cb_pool&) = delete;
+  softbuffer_cb_pool& operator=(const softbuffer_cb_pool&) = delete;
+  ~softbuffer_cb_pool();
+
+  /// Allocates memory until the pool holds at least nof_blocks CB buffers. Returns false if the memory could not be
+  /// allocated. Only meant to be called at configuration.
+  bool reserve(uint32_t nof_blocks);
+
+  /// Takes nof_blocks CB buffers from the pool and writes their addresses to blocks. Returns false if there are not
+  /// enough free CB buffers, in which case no CB buffer is taken.
+  bool allocate(uint8_t** blocks, uint32_t nof_blocks);
+
+  /// Returns CB buffers previously taken with allocate().
+  void deallocate(uint8_t* const* blocks, uint32_t nof_blocks);
+
+  uint32_t block_size() const { return block_sz; }
+
+  /// Reads the pool occupancy and resets the metrics accumulated since the previous read.
+  void get_metrics(mac_softbuffer_pool_metrics_t& metrics);
+
+  /// Size of the memory block of a Rx CB buffer, which holds the soft bits followed by the decoded bits.
+  static uint32_t rx_block_size(uint32_t cb_size);
+  static uint32_t rx_data_offset(uint32_t cb_size);
+
+private:
+  const uint32_t block_sz;
+  const uint32_t block_stride;
+
+  std::mutex            mutex;
+  std::vector<uint8_t*> slabs;
+  std::vector<uint8_t*> free_blocks;
+  uint32_t              capacity     = 0;
+  uint32_t              nof_used     = 0;
+  uint32_t              max_used     = 0;
+  uint32_t              nof_failures = 0;
+};
+
+/**
+ * HARQ Tx softbuffer that only holds memory from a softbuffer_cb_pool while a TB is in flight.
+ * The number of CBs bound is given by the TBS of the new transmission, and the CBs are returned to the pool
+ * with release(). While unbound, the softbuffer reports max_cb=0, which the PHY rejects as too small for any TB.
+ */
+class pooled_softbuffer_tx
+{
+public:
+  pooled_softbuffer_tx(softbuffer_cb_pool& pool_, uint32_t cb_size, uint32_t max_cb);
+  pooled_softbuffer_tx(const pooled_softbuffer_tx&) = delete;
+  pooled_softbuffer_tx(pooled_softbuffer_tx&& other) noexcept;
+  pooled_softbuffer_tx& operator=(const pooled_softbuffer_tx&) = delete;
+  pooled_softbuffer_tx& operator=(pooled_softbuffer_tx&&) = delete;
+  ~pooled_softbuffer_tx() { release(); }
+
+  /// Returns the current CBs to the pool and binds nof_cb new ones.
+  bool bind(uint32_t nof_cb);
+  void release();
+
+  bool     is_bound() const { return buffer.max_cb > 0; }
+  uint32_t nof_cb() const { return buffer.max_cb; }
+
+  srsran_softbuffer_tx_t*       get() { return &buffer; }
+  const srsran_softbuffer_tx_t* get() const { return &buffer; }
+
+private:
+  softbuffer_cb_pool*    pool;
+  std::vector<uint8_t*>  cb_list;
+  srsran_softbuffer_tx_t buffer;
+};
+
+/**
+ * HARQ Rx softbuffer that only holds memory from a softbuffer_cb_pool while a TB is in flight. The CBs are reset
+ * when bound.
+ */
+class pooled_softbuffer_rx
+{
+public:
+  pooled_softbuffer_rx(softbuffer_cb_pool& pool_, uint32_t cb_size, uint32_t max_cb);
+  pooled_softbuffer_rx(const pooled_softbuffer_rx&) = delete;
+  pooled_softbuffer_rx(pooled_softbuffer_rx&& other) noexcept;
+  pooled_softbuffer_rx& operator=(const pooled_softbuffer_rx&) = delete;
+  pooled_softbuffer_rx& operator=(pooled_softbuffer_rx&&) = delete;
+  ~pooled_softbuffer_rx() { release(); }
+
+  /// Returns the current CBs to the pool and binds nof_cb new ones.
+  bool bind(uint32_t nof_cb);
+  void release();
+
+  bool     is_bound() const { return buffer.max_cb > 0; }
+  uint32_t nof_cb() const { return buffer.max_cb; }
+
+  srsran_softbuffer_rx_t*       get() { return &buffer; }
+  const srsran_softbuffer_rx_t* get() const { return &buffer; }
+
+private:
+  softbuffer_cb_pool*     pool;
+  std::vector<uint8_t*>   cb_list;
+  std::vector<int16_t*>   softbit_list;
+  std::vector<uint8_t*>   data_list;
+  std::unique_ptr<bool[]> cb_crc;
+  srsran_softbuffer_rx_t  buffer;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_SOFTBUFFER_POOL_H
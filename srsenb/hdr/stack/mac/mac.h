@@ -203,6 +203,10 @@ private:
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
+  // Code block pools shared by the DL and UL HARQ softbuffers of all UEs
+  std::unique_ptr<softbuffer_cb_pool> tx_cb_pool;
+  std::unique_ptr<softbuffer_cb_pool> rx_cb_pool;
+
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
 };
@@ -26,7 +26,13 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/thread_pool.h"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -89,15 +95,33 @@ public:
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) final;
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
   int                                  metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics);
+  void                                 event_metrics_read(mac_sched_event_metrics_t& metrics);
 
   class carrier_sched;
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int ue_db_read_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int  ue_db_push_event(uint16_t rnti, Func&& f, const char* func_name = nullptr);
+  void process_ue_events();
+  void notify_ue_event(uint16_t rnti);
+
+  /// UE feedback event, applied by the scheduler at the start of the next TTI (or next locked access to ue_db)
+  struct ue_event_t {
+    uint64_t                               seq       = 0;
+    uint16_t                               rnti      = SRSRAN_INVALID_RNTI;
+    const char*                            func_name = nullptr;
+    std::chrono::steady_clock::time_point  tp;
+    srsran::move_callback<void(sched_ue&)> callback;
+  };
+  using ue_event_queue_t = srsran::mpmc_bounded_queue<ue_event_t>;
 
   // args
   rrc_interface_mac*               rrc       = nullptr;
@@ -112,9 +136,32 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Feedback events pushed by PHY/stack workers. Each producer thread is assigned one queue, so that workers don't
+  // contend with each other or with the scheduler
+  static const uint32_t                          nof_event_queues     = 4;
+  static const uint32_t                          event_queue_capacity = 2048;
+  std::vector<std::unique_ptr<ue_event_queue_t> > event_queues;
+  // Events popped from the queues and not yet applied, sorted by push order
+  std::vector<ue_event_t>                         pending_events;
+  mac_sched_event_metrics_t                       event_metrics        = {};
+  float                                           event_latency_sum_us = 0;
+  std::atomic<uint32_t>                           nof_event_overflows{0};
+  // Global order of the pushed events, so that the events of different queues are applied in the order they were pushed
+  std::atomic<uint64_t> event_seq{0};
+  // Sequence number of the next event to apply. Events are only applied once all the preceding ones were pushed
+  uint64_t next_event_seq = 0;
+  // RNTIs present in ue_db, indexed as in ue_db, so that events of unknown RNTIs are rejected without locking
+  std::array<std::atomic<uint16_t>, SRSENB_MAX_UES> active_rntis{};
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
+
+  // Workers allocating the resources of different carriers in parallel
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_cc_allocs = 0;
 };
 
 } // namespace srsenb
@@ -46,6 +46,15 @@ public:
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
+  void                   ue_event(uint16_t rnti);
+
+  /* Phases of generate_tti_result(). Used to schedule the different carriers in parallel */
+  //! Set up the TTI and refresh the UE subframe state. Not thread-safe with respect to other carriers
+  void new_tti(srsran::tti_point tti_rx);
+  //! Allocate the carrier resources. UE state shared across carriers is only read, so carriers can run it in parallel
+  void alloc_tti(srsran::tti_point tti_rx);
+  //! Generate DCIs and assign UE buffers and HARQs. Carriers must run it sequentially, in enb_cc_idx order
+  const cc_sched_result& finish_tti(srsran::tti_point tti_rx);
 
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
@@ -61,6 +70,8 @@ private:
   sf_sched* get_sf_sched(srsran::tti_point tti_rx);
   //! Schedule PDCCH orders
   void pdcch_order_sched(sf_sched* tti_sched);
+  //! Checks whether DL is allowed in the given subframe (e.g. not MBSFN)
+  bool is_dl_active(const sf_sched* tti_sched) const;
 
   // args
   const sched_cell_params_t* cc_cfg = nullptr;
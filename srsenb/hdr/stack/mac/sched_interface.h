@@ -80,11 +80,14 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_workers            = 0;
   };
 
   struct cell_cfg_t {
     // Main cell configuration (used to calculate DCI locations in scheduler)
     srsran_cell_t cell;
+    // TDD UL/DL configuration, only used if cell.frame_type is SRSRAN_TDD
+    srsran_tdd_config_t tdd_config;
 
     /* SIB configuration */
     cell_cfg_sib_t sibs[MAX_SIBS];
@@ -199,6 +202,7 @@ public:
 
   typedef struct {
     bool            needs_pdcch;
+    bool            is_msg3;
     uint32_t        current_tx_nb;
     uint32_t        tbs;
     srsran_dci_ul_t dci;
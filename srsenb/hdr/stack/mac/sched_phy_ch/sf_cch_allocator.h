@@ -29,7 +29,12 @@ namespace srsenb {
 
 class sched_ue;
 
-/// Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+/**
+ * Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+ * Each new DCI is placed in the first position of its search space that does not collide in PDCCH or PUCCH with
+ * previous DCIs. If none is free, a bounded repair is attempted, where one previous DCI is moved to another position
+ * of its search space. If the repair also fails, the CFI is increased and all DCIs are placed again.
+ */
 class sf_cch_allocator
 {
 public:
@@ -40,11 +45,11 @@ public:
     uint32_t              record_idx  = 0;
     uint32_t              dci_pos_idx = 0;
     srsran_dci_location_t dci_pos     = {0, 0};
-    /// Accumulation of all PDCCH masks for the current solution (DFS path)
+    /// Accumulation of the PDCCH masks of this and the previously allocated DCIs
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  using alloc_result_t = srsran::bounded_vector<const tree_node*, MAX_NOF_CCES>;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
@@ -70,18 +75,42 @@ public:
   std::string result_to_string(bool verbose = false) const;
 
 private:
+  /// DCI position of the search space that does not collide with the UE SR and falls inside the PUCCH HARQ region
+  struct cce_candidate {
+    uint32_t dci_pos_idx;
+    uint32_t ncce;
+    int8_t   pucch_n_prb;
+  };
+  using cce_candidate_list = srsran::bounded_vector<cce_candidate, 6>; ///< same capacity as cce_position_list
   /// DCI allocation parameters
   struct alloc_record {
     bool         pusch_uci;
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+    /// candidate positions for each CFI, derived the first time the CFI is tried in the TTI
+    std::array<cce_candidate_list, MAX_CFI> candidates;
+    std::array<bool, MAX_CFI>               candidates_set;
   };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
 
   // PDCCH allocation algorithm
-  bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
-  bool get_next_dfs();
+  bool                      alloc_dci_node(uint32_t record_idx, uint32_t cfix, std::vector<tree_node>& allocs);
+  const cce_candidate_list& get_cce_candidates(alloc_record& record, uint32_t cfix);
+  bool                      is_cce_candidate_free(const cce_candidate& cand,
+                                                  uint32_t             aggr_idx,
+                                                  const pdcch_mask_t&  cce_mask,
+                                                  const prbmask_t&     pucch_mask) const;
+  void                      set_node(tree_node&           node,
+                                     uint32_t             record_idx,
+                                     const cce_candidate& cand,
+                                     uint32_t             cfix) const;
+  void                      get_used_resources(const std::vector<tree_node>& allocs,
+                                               int                           skip_idx,
+                                               uint32_t                      cfix,
+                                               pdcch_mask_t&                 cce_mask,
+                                               prbmask_t&                    pucch_mask) const;
+  void                      update_total_masks(std::vector<tree_node>& allocs, size_t start_idx) const;
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -92,8 +121,9 @@ private:
   tti_point                 tti_rx;
   uint32_t                  current_cfix     = 0;
   uint32_t                  current_max_cfix = 0;
-  std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  std::vector<tree_node>    dci_alloc_list;  ///< DCI positions of the records in dci_record_list
+  std::vector<tree_node>    temp_alloc_list;
 };
 
 // Helper methods
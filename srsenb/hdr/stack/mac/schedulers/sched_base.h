@@ -38,6 +38,10 @@ public:
   virtual void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) = 0;
   virtual void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) = 0;
 
+  /// Called when the state of a UE is updated outside of the TTI scheduling (buffer status, CQI, HARQ feedback,
+  /// reconfiguration, removal, etc.)
+  virtual void ue_event(uint16_t rnti) {}
+
 protected:
   srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
 };
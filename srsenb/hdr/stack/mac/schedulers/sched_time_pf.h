@@ -25,7 +25,7 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include <vector>
 
 namespace srsenb {
 
@@ -37,44 +37,71 @@ public:
   sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args);
   void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
   void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
+  void ue_event(uint16_t rnti) override;
 
-private:
-  void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
+  // Building blocks of the scheduler. They are public for testing
 
-  const sched_cell_params_t* cc_cfg         = nullptr;
-  float                      fairness_coeff = 1;
+  /// Exponential moving average of the bytes allocated per TTI, with a fast start phase. TTIs without allocation
+  /// count as zero samples, which are only applied when the average is read or updated
+  struct ue_rate {
+    float    avg_rate    = 0;
+    uint32_t nof_samples = 0;
+    uint64_t last_tti    = 0; ///< TTI of the last applied sample
 
-  srsran::tti_point current_tti_rx;
+    void apply_idle_ttis(uint64_t tti, float alpha);
+    void save_alloc(uint64_t tti, uint32_t alloc_bytes, float alpha);
+    bool is_fast_start(float alpha) const { return nof_samples < 1 / alpha; }
+  };
 
   struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    ue_ctxt(uint16_t rnti_, float fairness_coeff_, uint64_t tti_count) : rnti(rnti_), fairness_coeff(fairness_coeff_)
+    {
+      dl_rate.last_tti = tti_count;
+      ul_rate.last_tti = tti_count;
+    }
+    bool   new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched, uint64_t tti, float alpha);
+    double get_prio(float r, ue_rate& rate, uint64_t tti, float alpha) const;
 
     const uint16_t rnti;
     const float    fairness_coeff;
 
-    int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
-    const dl_harq_proc* dl_retx_h  = nullptr;
-    const dl_harq_proc* dl_newtx_h = nullptr;
-    const ul_harq_proc* ul_h       = nullptr;
+    int     ue_cc_idx    = 0;
+    bool    dl_active    = false; ///< user has DL data or DL HARQs in flight
+    bool    ul_active    = false; ///< user has UL data or UL HARQs in flight
+    bool    dl_retx      = false;
+    bool    ul_retx      = false;
+    double  dl_prio      = 0;
+    double  ul_prio      = 0;
+    int     dl_heap_pos  = -1;
+    int     ul_heap_pos  = -1;
+    bool    pending_eval = false;
+    ue_rate dl_rate, ul_rate;
+  };
+
+  /// Binary max-heap of UE contexts. Each UE context stores its own position in the heap, so that its priority can be
+  /// updated, or the UE removed, in O(log N) without rebuilding the heap
+  template <int ue_ctxt::*HeapPos, typename Compare>
+  class ue_heap
+  {
+  public:
+    bool     empty() const { return heap.empty(); }
+    ue_ctxt* top() const { return heap.front(); }
+    void     reserve(size_t n) { heap.reserve(n); }
+    void     pop() { erase(*heap.front()); }
+    void     push_or_update(ue_ctxt& u);
+    void     erase(ue_ctxt& u);
 
   private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+    void place(size_t pos);
+    void set(size_t pos, ue_ctxt* u)
+    {
+      heap[pos]   = u;
+      u->*HeapPos = pos;
+    }
+
+    std::vector<ue_ctxt*> heap;
   };
 
-  rnti_map_t<ue_ctxt> ue_history_db;
-
   struct ue_dl_prio_compare {
     bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
   };
@@ -82,12 +109,33 @@ private:
     bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
   };
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  using ue_dl_queue_t = ue_heap<&ue_ctxt::dl_heap_pos, ue_dl_prio_compare>;
+  using ue_ul_queue_t = ue_heap<&ue_ctxt::ul_heap_pos, ue_ul_prio_compare>;
 
+private:
+  void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
+
+  const sched_cell_params_t* cc_cfg         = nullptr;
+  float                      fairness_coeff = 1;
+  const float                exp_avg_alpha  = 0.01;
+
+  srsran::tti_point current_tti_rx;
+  uint64_t          tti_count          = 0; ///< monotonic TTI counter, used to decay the average rates lazily
+  bool              full_sweep_pending = true;
+
+  rnti_map_t<ue_ctxt> ue_history_db;
+
+  /// Active UEs, i.e. with pending data or HARQs in flight, ordered by priority. Idle UEs are not kept in the queues
   ue_dl_queue_t dl_queue;
   ue_ul_queue_t ul_queue;
 
+  /// UEs whose state has to be refreshed in the next TTI, and RNTIs of UEs that may have been created
+  std::vector<ue_ctxt*> pending_eval_ues, eval_ues;
+  std::vector<uint16_t> new_rntis;
+
+  void     set_pending_eval(ue_ctxt& ue);
+  void     update_queues(ue_ctxt& ue, sched_ue& user, sf_sched* tti_sched);
+  void     rem_user(ue_ctxt& ue);
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
 };
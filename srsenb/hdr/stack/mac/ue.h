@@ -23,6 +23,7 @@
 #define SRSENB_UE_H
 
 #include "common/mac_metrics.h"
+#include "common/softbuffer_pool.h"
 #include "sched_interface.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
@@ -31,6 +32,7 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/tti_point.h"
+#include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/mac/pdu_queue.h"
 #include "srsran/srslog/srslog.h"
@@ -45,28 +47,60 @@ class rrc_interface_mac;
 class rlc_interface_mac;
 class phy_interface_stack_lte;
 
-/// Class to manage the allocation, deallocation & access to UE carrier DL + UL softbuffers
+/// Class to manage the binding & access to UE carrier DL + UL softbuffers. The softbuffers only hold code block
+/// buffers from the MAC shared pools while their HARQ process has a TB in flight.
 struct ue_cc_softbuffers {
-  // List of Tx softbuffers for all HARQ processes of one carrier
-  using cc_softbuffer_tx_list_t = std::vector<srsran_softbuffer_tx_t>;
-  // List of Rx softbuffers for all HARQ processes of one carrier
-  using cc_softbuffer_rx_list_t = std::vector<srsran_softbuffer_rx_t>;
-
-  const uint32_t          nof_tx_harq_proc;
-  const uint32_t          nof_rx_harq_proc;
-  cc_softbuffer_tx_list_t softbuffer_tx_list;
-  cc_softbuffer_rx_list_t softbuffer_rx_list;
-
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
-  ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
-  ~ue_cc_softbuffers();
+  struct tx_softbuffer_t {
+    pooled_softbuffer_tx buffer;
+    tti_point            tti_tx;
+    tti_point            tti_ack; ///< TTI when the HARQ-ACK of the last transmission is received
+    bool                 ack_pending = false;
+    uint32_t             nof_tx      = 0;
+
+    tx_softbuffer_t(softbuffer_cb_pool& pool, uint32_t max_cb) : buffer(pool, SOFTBUFFER_SIZE, max_cb) {}
+  };
+  struct rx_softbuffer_t {
+    pooled_softbuffer_rx buffer;
+    uint32_t             nof_tx     = 0;
+    uint32_t             max_nof_tx = 0;
+
+    rx_softbuffer_t(softbuffer_cb_pool& pool, uint32_t max_cb) : buffer(pool, SOFTBUFFER_SIZE, max_cb) {}
+  };
+
+  const uint32_t               nof_tx_harq_proc;
+  const uint32_t               nof_rx_harq_proc;
+  std::vector<tx_softbuffer_t> softbuffer_tx_list;
+  std::vector<rx_softbuffer_t> softbuffer_rx_list;
+
+  ue_cc_softbuffers(softbuffer_cb_pool& tx_pool,
+                    softbuffer_cb_pool& rx_pool,
+                    uint32_t            nof_prb,
+                    uint32_t            nof_tx_harq_proc_,
+                    uint32_t            nof_rx_harq_proc_);
   void clear();
 
-  srsran_softbuffer_tx_t& get_tx(uint32_t pid, uint32_t tb_idx)
-  {
-    return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
-  }
-  srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
+  /// Maximum number of code blocks of a TB in a cell with nof_prb PRBs.
+  static uint32_t max_nof_cb(uint32_t nof_prb);
+
+  /// Gets the Tx softbuffer of a HARQ process. New transmissions bind code blocks for a TB of tbs bytes. The HARQ-ACK
+  /// of the transmission is expected ack_delay TTIs after tti_tx_dl.
+  srsran_softbuffer_tx_t*
+  get_tx(uint32_t pid, uint32_t tb_idx, tti_point tti_tx_dl, uint32_t ack_delay, uint32_t tbs, bool new_tx);
+  /// Gets the Rx softbuffer of the HARQ process received in tti_rx. New transmissions bind code blocks for a TB
+  /// of tbs bytes, which is transmitted up to max_nof_tx times.
+  srsran_softbuffer_rx_t* get_rx(tti_point tti_rx, uint32_t tbs, bool new_tx, uint32_t max_nof_tx);
+  /// Returns the code blocks of a DL TB that was not transmitted to the pool.
+  void release_tx(uint32_t pid, uint32_t tb_idx);
+
+  /// Returns the code blocks of a DL TB to the pool when it is ACKed or it has reached max_nof_tx transmissions.
+  void tx_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack, uint32_t max_nof_tx);
+  /// Returns the code blocks of an UL TB to the pool when it is decoded or it has reached its maximum number of
+  /// transmissions.
+  void rx_crc_info(tti_point tti_rx, bool crc);
+
+private:
+  // Protects the HARQ bindings, which are accessed by the PHY workers processing different TTIs
+  std::mutex mutex;
 };
 
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
@@ -105,13 +139,9 @@ public:
   void allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_);
   void deallocate_cc();
 
-  bool                    empty() const { return cc_softbuffers == nullptr; }
-  srsran_softbuffer_tx_t& get_tx_softbuffer(uint32_t pid, uint32_t tb_idx)
-  {
-    return cc_softbuffers->get_tx(pid, tb_idx);
-  }
-  srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
-  srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
+  bool                   empty() const { return cc_softbuffers == nullptr; }
+  ue_cc_softbuffers&     get_softbuffers() { return *cc_softbuffers; }
+  srsran::byte_buffer_t* get_tx_payload_buffer(size_t harq_pid, size_t tb)
   {
     return tx_payload_buffer[harq_pid][tb].get();
   }
@@ -133,6 +163,7 @@ class ue : public srsran::read_pdu_interface, public mac_ta_ue_interface
 public:
   ue(uint16_t                                 rnti,
      uint32_t                                 enb_cc_idx,
+     uint32_t                                 max_msg3_tx,
      sched_interface*                         sched,
      rrc_interface_mac*                       rrc_,
      rlc_interface_mac*                       rlc,
@@ -168,8 +199,17 @@ public:
                             uint32_t                             nof_pdu_elems,
                             uint32_t                             grant_size);
 
-  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
-  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
+  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx,
+                                            uint32_t harq_process,
+                                            uint32_t tb_idx,
+                                            uint32_t tti_tx_dl,
+                                            uint32_t ack_delay,
+                                            uint32_t tbs,
+                                            bool     new_tx);
+  void                    release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
+  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, bool new_tx, bool is_msg3);
+  void                    tx_softbuffer_ack_info(uint32_t enb_cc_idx, uint32_t tti_rx, uint32_t tb_idx, bool ack);
+  void                    rx_softbuffer_crc_info(uint32_t enb_cc_idx, uint32_t tti_rx, bool crc);
 
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
@@ -215,13 +255,19 @@ private:
   mac_ue_metrics_t ue_metrics     = {};
 
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
+  std::atomic<uint32_t>                    max_harq_tx{sched_interface::ue_cfg_t{}.maxharq_tx};
+  const uint32_t                           max_msg3_tx; // maxharq_msg3tx of the cell of the random access
 
   srsran::block_queue<uint32_t> pending_ta_commands;
   ta                            ta_fsm;
 
   // For UL there are multiple buffers per PID and are managed by pdu_queue
-  srsran::sch_pdu mac_msg_dl, mac_msg_ul;
-  srsran::mch_pdu mch_mac_msg_dl;
+  static const uint32_t MAX_UL_SUBHEADERS = 20;
+  srsran::sch_pdu       mac_msg_dl, mac_msg_ul;
+  srsran::mch_pdu       mch_mac_msg_dl;
+
+  // RLC PDUs of the UL MAC PDU being processed, in order of arrival
+  srsran::bounded_vector<srsran::rlc_pdu_ref_t, MAX_UL_SUBHEADERS> ul_rlc_pdus;
 
   srsran::bounded_vector<cc_buffer_handler, SRSRAN_MAX_CARRIERS> cc_buffers;
 
@@ -20,12 +20,13 @@
  */
 
 #include <map>
-#include <unordered_map>
 #include <string.h>
 
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
 #include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
@@ -132,8 +133,8 @@ private:
   pdcp_interface_gtpu*      pdcp      = nullptr;
   srslog::basic_logger&     logger;
 
-  std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                     tunnels;
+  srsran::flat_hash_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
+  tunnel_list_t                                           tunnels;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
@@ -149,6 +150,7 @@ public:
 
   int  init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_);
   void stop();
+  void get_metrics(gtpu_metrics_t& m);
 
   // gtpu_interface_rrc
   srsran::expected<uint32_t> add_bearer(uint16_t            rnti,
@@ -219,7 +221,12 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // Data PDUs are sent in batches, when the stack task that produced them ends
+  srsran::udp_batch_sender     tx_batch;
+  srsran::socket_batch_counter rx_batches;
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
+  void flush_tx_batch();
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_GTPU_METRICS_H
+#define SRSENB_GTPU_METRICS_H
+
+#include "srsran/common/network_utils.h"
+
+namespace srsenb {
+
+struct gtpu_metrics_t {
+  srsran::socket_batch_metrics_t rx; ///< Batches received from the S1-U/NG-U socket
+  srsran::socket_batch_metrics_t tx; ///< Batches sent to the S1-U/NG-U socket
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_GTPU_METRICS_H
@@ -27,6 +27,7 @@
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/upper/pdcp.h"
+#include "srsran/upper/pdcp_security_pool.h"
 #include <map>
 
 #ifndef SRSENB_PDCP_H
@@ -43,7 +44,10 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
   virtual ~pdcp() {}
-  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  void init(rlc_interface_pdcp*  rlc_,
+            rrc_interface_pdcp*  rrc_,
+            gtpu_interface_pdcp* gtpu_,
+            uint32_t             nof_security_workers = 0);
   void stop();
 
   // pdcp_interface_rlc
@@ -132,6 +136,9 @@ private:
   gtpu_interface_pdcp*      gtpu = nullptr;
   srsran::task_sched_handle task_sched;
   srslog::basic_logger&     logger;
+
+  // Workers ciphering the DRBs of all the users, if enabled
+  std::unique_ptr<srsran::pdcp_security_pool> security_pool;
 };
 
 } // namespace srsenb
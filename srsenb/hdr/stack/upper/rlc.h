@@ -20,12 +20,20 @@
  */
 
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -43,12 +51,22 @@ class rrc_interface_rlc;
 class pdcp_interface_rlc;
 class mac_interface_rlc;
 
+/**
+ * RLC of all the UEs of the eNB or gNB.
+ * With RLC workers, the RLC PDUs received by the MAC are copied and written by one of the workers, chosen by RNTI, so
+ * that the reordering and reassembly of different UEs runs in parallel. The SDUs, and the other notifications of the
+ * RLC entities to PDCP and RRC, are returned to the stack thread in the order they are produced by each worker.
+ */
 class rlc : public rlc_interface_mac, public rlc_interface_rrc, public rlc_interface_pdcp
 {
 public:
   explicit rlc(srslog::basic_logger& logger) : logger(logger) {}
-  void
-  init(pdcp_interface_rlc* pdcp_, rrc_interface_rlc* rrc_, mac_interface_rlc* mac_, srsran::timer_handler* timers_);
+  void init(pdcp_interface_rlc*       pdcp_,
+            rrc_interface_rlc*        rrc_,
+            mac_interface_rlc*        mac_,
+            srsran::timer_handler*    timers_,
+            srsran::task_sched_handle task_sched_,
+            uint32_t                  nof_workers = 0);
   void stop();
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
@@ -75,8 +93,46 @@ public:
   // rlc_interface_mac
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  void write_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus);
 
 private:
+  /// Maximum number of RLC PDUs written by a RLC worker in one job
+  static const uint32_t max_pdus_per_job  = 32;
+  static const uint32_t worker_queue_size = 4096;
+  /// Number of upcalls deferred by a RLC worker to the stack thread above which the worker stops taking new jobs
+  static const uint32_t max_deferred_tasks = 512;
+
+  /// RLC PDUs of a MAC PDU, copied into one buffer, waiting to be written by a RLC worker
+  struct rx_pdus_job_t {
+    uint16_t                                                        rnti = SRSRAN_INVALID_RNTI;
+    srsran::unique_byte_buffer_t                                    buf;
+    srsran::bounded_vector<srsran::rlc_pdu_ref_t, max_pdus_per_job> pdus;
+  };
+
+  class worker_t : public srsran::thread
+  {
+  public:
+    worker_t(rlc* parent_, uint32_t idx);
+
+    void stop();
+    /// Runs the task in the stack thread, after the tasks deferred before it by the RLC entities of the worker.
+    void defer_to_stack(srsran::move_task_t task);
+
+    srsran::dyn_blocking_queue<rx_pdus_job_t> pending_jobs;
+    srsran::task_queue_handle                 stack_queue;
+
+  private:
+    void run_thread() override;
+    void run_deferred_tasks();
+
+    rlc* parent;
+
+    std::mutex                       deferred_mutex;
+    std::condition_variable          deferred_cvar;
+    std::vector<srsran::move_task_t> deferred_tasks;
+    bool                             stopping = false;
+  };
+
   class user_interface : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
   {
   public:
@@ -96,9 +152,12 @@ private:
     srsenb::rrc_interface_rlc*   rrc;
     unique_rnti_ptr<srsran::rlc> rlc;
     srsenb::rlc*                 parent;
+    worker_t*                    worker = nullptr; ///< RLC worker of the UE, if any
   };
 
   void update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue);
+  void push_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus);
+  void write_user_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus);
 
   pthread_rwlock_t rwlock;
 
@@ -110,6 +169,8 @@ private:
   rrc_interface_rlc*     rrc  = nullptr;
   srslog::basic_logger&  logger;
   srsran::timer_handler* timers = nullptr;
+
+  std::vector<std::unique_ptr<worker_t> > workers;
 };
 
 } // namespace srsenb
@@ -180,11 +180,13 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(0), "Number of threads scheduling carriers in parallel (0 schedules carriers sequentially)")
 
 
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_workers",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_workers)->default_value(0),          "Number of extra threads processing channels in parallel")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -204,6 +206,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_workers",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_workers)->default_value(0),             "Number of extra threads processing channels in parallel")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -229,6 +232,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
     ("cfr.ema_alpha", bpo::value<float>(&args->phy.cfr_args.ema_alpha)->default_value(args->phy.cfr_args.ema_alpha), "Alpha coefficient for the power average in auto_ema mode (0 to 1)")
+    ("cfr.iterations", bpo::value<uint32_t>(&args->phy.cfr_args.iterations)->default_value(args->phy.cfr_args.iterations), "Number of CFR clipping and filtering iterations (1 to 4)")
 
       /* Expert section */
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
@@ -258,10 +262,13 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.nof_softbuffer_ues", bpo::value<uint32_t>(&args->stack.mac.nof_softbuffer_ues)->default_value(8), "Number of UEs per cell whose HARQ softbuffers for maximum size TBs are reserved during eNB initialization.")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.pdcp_security_workers", bpo::value<uint32_t>(&args->stack.pdcp_nof_security_workers)->default_value(0), "Number of threads ciphering the PDCP PDUs of DRBs (0 ciphers them in the stack thread).")
+    ("expert.rlc_workers", bpo::value<uint32_t>(&args->stack.rlc_nof_workers)->default_value(0), "Number of threads writing the received RLC PDUs, with the UEs bound to them by RNTI (0 writes them in the stack thread).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -286,6 +293,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_pipeline_depth", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.pipeline_depth)->default_value(0), "Number of slots the NR scheduler thread runs ahead of the PHY (0 schedules within the PHY slot worker).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
@@ -363,6 +371,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   if (!srsran::string_to_mnc(mnc, &args->nr_stack.ngap.mnc)) {
     cout << "Error parsing enb.mnc:" << mnc << " - must be a 2 or 3-digit string." << endl;
   }
+  args->nr_stack.rlc_nof_workers = args->stack.rlc_nof_workers;
 
   if (args->stack.embms.enable) {
     if (args->stack.mac.sched.max_nof_ctrl_symbols == 3) {
@@ -61,7 +61,13 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
   if (file.is_open() && enb != NULL) {
     if (n_reports == 0) {
       file << "time;nof_ue;dl_brate;ul_brate;"
-              "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;system_load;thread_count";
+              "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;system_load;thread_count;"
+              "sched_events;sched_overflows;sched_max_queue;sched_avg_latency_us;sched_max_latency_us;"
+              "dl_sb_used;dl_sb_max;dl_sb_fail;ul_sb_used;ul_sb_max;ul_sb_fail;"
+              "nr_dl_sb_used;nr_dl_sb_max;nr_dl_sb_fail;nr_ul_sb_used;nr_ul_sb_max;nr_ul_sb_fail;"
+              "pool_small_used;pool_small_max;pool_small_fail;pool_medium_used;pool_medium_max;pool_medium_fail;"
+              "pool_large_used;pool_large_max;pool_large_fail;"
+              "gtpu_rx_pkts;gtpu_rx_max_batch;gtpu_tx_pkts;gtpu_tx_max_batch";
 
       // Add the cpus
       for (uint32_t i = 0, e = metrics.sys.cpu_count; i != e; ++i) {
@@ -108,6 +114,38 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
     file << float_to_string(m.process_cpu_usage, 2);
     file << std::to_string(m.thread_count) << ";";
 
+    // Write the scheduler event queue metrics.
+    const mac_sched_event_metrics_t& sched_events = metrics.stack.mac.sched_events;
+    file << std::to_string(sched_events.nof_events) << ";";
+    file << std::to_string(sched_events.nof_overflows) << ";";
+    file << std::to_string(sched_events.max_queue_depth) << ";";
+    file << float_to_string(sched_events.avg_latency_us, 2);
+    file << float_to_string(sched_events.max_latency_us, 2);
+
+    // Write the HARQ softbuffer pool metrics.
+    for (const mac_softbuffer_pool_metrics_t* sb : {&metrics.stack.mac.dl_softbuffers,
+                                                    &metrics.stack.mac.ul_softbuffers,
+                                                    &metrics.nr_stack.mac.dl_softbuffers,
+                                                    &metrics.nr_stack.mac.ul_softbuffers}) {
+      file << std::to_string(sb->nof_used_cbs) << ";";
+      file << std::to_string(sb->max_used_cbs) << ";";
+      file << std::to_string(sb->nof_failures) << ";";
+    }
+
+    // Write the byte buffer pool metrics.
+    const srsran::byte_buffer_pools_metrics_t& pools = metrics.stack.buffer_pools;
+    for (const srsran::byte_buffer_pool_metrics_t* pool : {&pools.small, &pools.medium, &pools.large}) {
+      file << std::to_string(pool->nof_used_buffers) << ";";
+      file << std::to_string(pool->max_used_buffers) << ";";
+      file << std::to_string(pool->nof_failures) << ";";
+    }
+
+    // Write the GTPU socket metrics.
+    file << std::to_string(metrics.stack.gtpu.rx.nof_packets) << ";";
+    file << std::to_string(metrics.stack.gtpu.rx.max_batch) << ";";
+    file << std::to_string(metrics.stack.gtpu.tx.nof_packets) << ";";
+    file << std::to_string(metrics.stack.gtpu.tx.max_batch) << (m.cpu_count > 0 ? ";" : "");
+
     // Write the cpu metrics.
     for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
       file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
@@ -95,13 +95,107 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Scheduler event queue metrics.
+DECLARE_METRIC("nof_events", metric_sched_nof_events, uint32_t, "");
+DECLARE_METRIC("nof_overflows", metric_sched_nof_overflows, uint32_t, "");
+DECLARE_METRIC("max_queue_depth", metric_sched_max_queue_depth, uint32_t, "");
+DECLARE_METRIC("avg_latency_us", metric_sched_avg_latency, float, "");
+DECLARE_METRIC("max_latency_us", metric_sched_max_latency, float, "");
+DECLARE_METRIC_SET("sched_events",
+                   mset_sched_events,
+                   metric_sched_nof_events,
+                   metric_sched_nof_overflows,
+                   metric_sched_max_queue_depth,
+                   metric_sched_avg_latency,
+                   metric_sched_max_latency);
+
+/// HARQ softbuffer pool metrics.
+DECLARE_METRIC("nof_cbs", metric_sb_nof_cbs, uint32_t, "");
+DECLARE_METRIC("nof_used_cbs", metric_sb_nof_used_cbs, uint32_t, "");
+DECLARE_METRIC("max_used_cbs", metric_sb_max_used_cbs, uint32_t, "");
+DECLARE_METRIC("nof_bytes", metric_sb_nof_bytes, uint64_t, "");
+DECLARE_METRIC("nof_failures", metric_nof_failures, uint32_t, "");
+DECLARE_METRIC_SET("dl_softbuffers",
+                   mset_dl_softbuffers,
+                   metric_sb_nof_cbs,
+                   metric_sb_nof_used_cbs,
+                   metric_sb_max_used_cbs,
+                   metric_sb_nof_bytes,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("ul_softbuffers",
+                   mset_ul_softbuffers,
+                   metric_sb_nof_cbs,
+                   metric_sb_nof_used_cbs,
+                   metric_sb_max_used_cbs,
+                   metric_sb_nof_bytes,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("nr_dl_softbuffers",
+                   mset_nr_dl_softbuffers,
+                   metric_sb_nof_cbs,
+                   metric_sb_nof_used_cbs,
+                   metric_sb_max_used_cbs,
+                   metric_sb_nof_bytes,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("nr_ul_softbuffers",
+                   mset_nr_ul_softbuffers,
+                   metric_sb_nof_cbs,
+                   metric_sb_nof_used_cbs,
+                   metric_sb_max_used_cbs,
+                   metric_sb_nof_bytes,
+                   metric_nof_failures);
+
+/// Byte buffer pool metrics.
+DECLARE_METRIC("buffer_size", metric_pool_buffer_size, uint32_t, "");
+DECLARE_METRIC("nof_buffers", metric_pool_nof_buffers, uint32_t, "");
+DECLARE_METRIC("nof_used_buffers", metric_pool_nof_used_buffers, uint32_t, "");
+DECLARE_METRIC("max_used_buffers", metric_pool_max_used_buffers, uint32_t, "");
+DECLARE_METRIC_SET("small",
+                   mset_small_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("medium",
+                   mset_medium_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("large",
+                   mset_large_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_nof_failures);
+DECLARE_METRIC_SET("buffer_pools", mset_buffer_pools, mset_small_pool, mset_medium_pool, mset_large_pool);
+
+/// GTPU socket metrics.
+DECLARE_METRIC("nof_calls", metric_socket_nof_calls, uint64_t, "");
+DECLARE_METRIC("nof_packets", metric_socket_nof_packets, uint64_t, "");
+DECLARE_METRIC("max_batch", metric_socket_max_batch, uint32_t, "");
+DECLARE_METRIC_SET("rx", mset_gtpu_rx, metric_socket_nof_calls, metric_socket_nof_packets, metric_socket_max_batch);
+DECLARE_METRIC_SET("tx", mset_gtpu_tx, metric_socket_nof_calls, metric_socket_nof_packets, metric_socket_max_batch);
+DECLARE_METRIC_SET("gtpu", mset_gtpu, mset_gtpu_rx, mset_gtpu_tx);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mset_sched_events,
+                                                    mset_dl_softbuffers,
+                                                    mset_ul_softbuffers,
+                                                    mset_nr_dl_softbuffers,
+                                                    mset_nr_ul_softbuffers,
+                                                    mset_buffer_pools,
+                                                    mset_gtpu>;
 
 } // namespace
 
@@ -174,6 +268,37 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
   }
 }
 
+/// Fill the metrics of a HARQ softbuffer pool.
+template <typename Set>
+static void fill_softbuffer_pool_metrics(Set& set, const mac_softbuffer_pool_metrics_t& m)
+{
+  set.template write<metric_sb_nof_cbs>(m.nof_cbs);
+  set.template write<metric_sb_nof_used_cbs>(m.nof_used_cbs);
+  set.template write<metric_sb_max_used_cbs>(m.max_used_cbs);
+  set.template write<metric_sb_nof_bytes>(m.nof_bytes);
+  set.template write<metric_nof_failures>(m.nof_failures);
+}
+
+/// Fill the metrics of a byte buffer pool.
+template <typename Set>
+static void fill_buffer_pool_metrics(Set& set, const srsran::byte_buffer_pool_metrics_t& m)
+{
+  set.template write<metric_pool_buffer_size>(m.buffer_size);
+  set.template write<metric_pool_nof_buffers>(m.nof_buffers);
+  set.template write<metric_pool_nof_used_buffers>(m.nof_used_buffers);
+  set.template write<metric_pool_max_used_buffers>(m.max_used_buffers);
+  set.template write<metric_nof_failures>(m.nof_failures);
+}
+
+/// Fill the metrics of a socket.
+template <typename Set>
+static void fill_socket_metrics(Set& set, const srsran::socket_batch_metrics_t& m)
+{
+  set.template write<metric_socket_nof_calls>(m.nof_calls);
+  set.template write<metric_socket_nof_packets>(m.nof_packets);
+  set.template write<metric_socket_max_batch>(m.max_batch);
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -238,6 +363,30 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // Scheduler event queue metrics.
+  auto& sched_events = ctx.get<mset_sched_events>();
+  sched_events.write<metric_sched_nof_events>(m.stack.mac.sched_events.nof_events);
+  sched_events.write<metric_sched_nof_overflows>(m.stack.mac.sched_events.nof_overflows);
+  sched_events.write<metric_sched_max_queue_depth>(m.stack.mac.sched_events.max_queue_depth);
+  sched_events.write<metric_sched_avg_latency>(m.stack.mac.sched_events.avg_latency_us);
+  sched_events.write<metric_sched_max_latency>(m.stack.mac.sched_events.max_latency_us);
+
+  // HARQ softbuffer pool metrics.
+  fill_softbuffer_pool_metrics(ctx.get<mset_dl_softbuffers>(), m.stack.mac.dl_softbuffers);
+  fill_softbuffer_pool_metrics(ctx.get<mset_ul_softbuffers>(), m.stack.mac.ul_softbuffers);
+  fill_softbuffer_pool_metrics(ctx.get<mset_nr_dl_softbuffers>(), m.nr_stack.mac.dl_softbuffers);
+  fill_softbuffer_pool_metrics(ctx.get<mset_nr_ul_softbuffers>(), m.nr_stack.mac.ul_softbuffers);
+
+  // Byte buffer pool metrics.
+  auto& buffer_pools = ctx.get<mset_buffer_pools>();
+  fill_buffer_pool_metrics(buffer_pools.get<mset_small_pool>(), m.stack.buffer_pools.small);
+  fill_buffer_pool_metrics(buffer_pools.get<mset_medium_pool>(), m.stack.buffer_pools.medium);
+  fill_buffer_pool_metrics(buffer_pools.get<mset_large_pool>(), m.stack.buffer_pools.large);
+
+  // GTPU socket metrics.
+  fill_socket_metrics(ctx.get<mset_gtpu>().get<mset_gtpu_rx>(), m.stack.gtpu.rx);
+  fill_socket_metrics(ctx.get<mset_gtpu>().get<mset_gtpu_tx>(), m.stack.gtpu.tx);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -188,6 +188,40 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  const mac_sched_event_metrics_t& sched_events = metrics.stack.mac.sched_events;
+  if (sched_events.nof_overflows > 0) {
+    fmt::print("SCHED events: overflows={}, max queue={}, latency avg={:.1f}us max={:.1f}us\n",
+               sched_events.nof_overflows,
+               sched_events.max_queue_depth,
+               sched_events.avg_latency_us,
+               sched_events.max_latency_us);
+  }
+  if (metrics.stack.mac.dl_softbuffers.nof_failures > 0 or metrics.stack.mac.ul_softbuffers.nof_failures > 0 or
+      metrics.nr_stack.mac.dl_softbuffers.nof_failures > 0 or metrics.nr_stack.mac.ul_softbuffers.nof_failures > 0) {
+    fmt::print("HARQ softbuffers: lte dl={}/{} ul={}/{}, nr dl={}/{} ul={}/{} CBs, failures={}\n",
+               metrics.stack.mac.dl_softbuffers.max_used_cbs,
+               metrics.stack.mac.dl_softbuffers.nof_cbs,
+               metrics.stack.mac.ul_softbuffers.max_used_cbs,
+               metrics.stack.mac.ul_softbuffers.nof_cbs,
+               metrics.nr_stack.mac.dl_softbuffers.max_used_cbs,
+               metrics.nr_stack.mac.dl_softbuffers.nof_cbs,
+               metrics.nr_stack.mac.ul_softbuffers.max_used_cbs,
+               metrics.nr_stack.mac.ul_softbuffers.nof_cbs,
+               metrics.stack.mac.dl_softbuffers.nof_failures + metrics.stack.mac.ul_softbuffers.nof_failures +
+                   metrics.nr_stack.mac.dl_softbuffers.nof_failures + metrics.nr_stack.mac.ul_softbuffers.nof_failures);
+  }
+  const srsran::byte_buffer_pools_metrics_t& pools = metrics.stack.buffer_pools;
+  if (pools.small.nof_failures > 0 or pools.medium.nof_failures > 0 or pools.large.nof_failures > 0) {
+    fmt::print("Buffer pools: small={}/{} medium={}/{} large={}/{}, failures={}\n",
+               pools.small.max_used_buffers,
+               pools.small.nof_buffers,
+               pools.medium.max_used_buffers,
+               pools.medium.nof_buffers,
+               pools.large.max_used_buffers,
+               pools.large.nof_buffers,
+               pools.small.nof_failures + pools.medium.nof_failures + pools.large.nof_failures);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
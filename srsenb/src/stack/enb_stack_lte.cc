@@ -133,8 +133,8 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     stack_logger.error("Couldn't initialize MAC");
     return SRSRAN_ERROR;
   }
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler(), &task_sched, args.rlc_nof_workers);
+  pdcp.init(&rlc, &rrc, gtpu_adapter.get(), args.pdcp_nof_security_workers);
   if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
@@ -224,6 +224,8 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    gtpu.get_metrics(metrics.gtpu);
+    srsran::get_byte_buffer_pools_metrics(metrics.buffer_pools);
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/common/softbuffer_pool.h"
+#include <algorithm>
+extern "C" {
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+}
+
+namespace srsenb {
+
+// CB buffers keep the alignment of buffers allocated with srsran_vec_malloc()
+static uint32_t align_block(uint32_t nof_bytes)
+{
+  return SRSRAN_CEIL(nof_bytes, SRSRAN_SIMD_BIT_ALIGN) * SRSRAN_SIMD_BIT_ALIGN;
+}
+
+softbuffer_cb_pool::softbuffer_cb_pool(uint32_t block_size_) :
+  block_sz(block_size_), block_stride(align_block(block_size_))
+{}
+
+softbuffer_cb_pool::~softbuffer_cb_pool()
+{
+  for (uint8_t* slab : slabs) {
+    free(slab);
+  }
+}
+
+uint32_t softbuffer_cb_pool::rx_data_offset(uint32_t cb_size)
+{
+  return align_block(cb_size * sizeof(int16_t));
+}
+
+uint32_t softbuffer_cb_pool::rx_block_size(uint32_t cb_size)
+{
+  return rx_data_offset(cb_size) + cb_size / 8;
+}
+
+bool softbuffer_cb_pool::reserve(uint32_t nof_blocks)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (nof_blocks <= capacity) {
+    return true;
+  }
+  uint32_t nof_new_blocks = nof_blocks - capacity;
+  uint8_t* slab           = srsran_vec_u8_malloc(block_stride * nof_new_blocks);
+  if (slab == nullptr) {
+    return false;
+  }
+  slabs.push_back(slab);
+  free_blocks.reserve(nof_blocks);
+  for (uint32_t i = nof_new_blocks; i > 0; --i) {
+    free_blocks.push_back(slab + (i - 1) * block_stride);
+  }
+  capacity = nof_blocks;
+  return true;
+}
+
+bool softbuffer_cb_pool::allocate(uint8_t** blocks, uint32_t nof_blocks)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (free_blocks.size() < nof_blocks) {
+    nof_failures++;
+    return false;
+  }
+  for (uint32_t i = 0; i < nof_blocks; ++i) {
+    blocks[i] = free_blocks.back();
+    free_blocks.pop_back();
+  }
+  nof_used += nof_blocks;
+  max_used = std::max(max_used, nof_used);
+  return true;
+}
+
+void softbuffer_cb_pool::deallocate(uint8_t* const* blocks, uint32_t nof_blocks)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (uint32_t i = 0; i < nof_blocks; ++i) {
+    free_blocks.push_back(blocks[i]);
+  }
+  nof_used -= nof_blocks;
+}
+
+void softbuffer_cb_pool::get_metrics(mac_softbuffer_pool_metrics_t& metrics)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  metrics.nof_cbs      = capacity;
+  metrics.nof_used_cbs = nof_used;
+  metrics.max_used_cbs = max_used;
+  metrics.nof_bytes    = (uint64_t)capacity * block_stride;
+  metrics.nof_failures = nof_failures;
+  max_used             = nof_used;
+  nof_failures         = 0;
+}
+
+/////////////////////////////////////////////////////////////////
+
+pooled_softbuffer_tx::pooled_softbuffer_tx(softbuffer_cb_pool& pool_, uint32_t cb_size, uint32_t max_cb) :
+  pool(&pool_), cb_list(max_cb, nullptr)
+{
+  buffer             = {};
+  buffer.max_cb_size = cb_size;
+  buffer.buffer_b    = cb_list.data();
+}
+
+pooled_softbuffer_tx::pooled_softbuffer_tx(pooled_softbuffer_tx&& other) noexcept :
+  pool(other.pool), cb_list(std::move(other.cb_list)), buffer(other.buffer)
+{
+  other.buffer = {};
+}
+
+bool pooled_softbuffer_tx::bind(uint32_t nof_cb)
+{
+  release();
+  if (nof_cb > cb_list.size() or not pool->allocate(cb_list.data(), nof_cb)) {
+    return false;
+  }
+  buffer.max_cb = nof_cb;
+  return true;
+}
+
+void pooled_softbuffer_tx::release()
+{
+  if (is_bound()) {
+    pool->deallocate(cb_list.data(), buffer.max_cb);
+    buffer.max_cb = 0;
+  }
+}
+
+/////////////////////////////////////////////////////////////////
+
+pooled_softbuffer_rx::pooled_softbuffer_rx(softbuffer_cb_pool& pool_, uint32_t cb_size, uint32_t max_cb) :
+  pool(&pool_),
+  cb_list(max_cb, nullptr),
+  softbit_list(max_cb, nullptr),
+  data_list(max_cb, nullptr),
+  cb_crc(new bool[max_cb]())
+{
+  buffer             = {};
+  buffer.max_cb_size = cb_size;
+  buffer.buffer_f    = softbit_list.data();
+  buffer.data        = data_list.data();
+  buffer.cb_crc      = cb_crc.get();
+}
+
+pooled_softbuffer_rx::pooled_softbuffer_rx(pooled_softbuffer_rx&& other) noexcept :
+  pool(other.pool),
+  cb_list(std::move(other.cb_list)),
+  softbit_list(std::move(other.softbit_list)),
+  data_list(std::move(other.data_list)),
+  cb_crc(std::move(other.cb_crc)),
+  buffer(other.buffer)
+{
+  other.buffer = {};
+}
+
+bool pooled_softbuffer_rx::bind(uint32_t nof_cb)
+{
+  release();
+  if (nof_cb > cb_list.size() or not pool->allocate(cb_list.data(), nof_cb)) {
+    return false;
+  }
+  uint32_t data_offset = softbuffer_cb_pool::rx_data_offset(buffer.max_cb_size);
+  for (uint32_t i = 0; i < nof_cb; ++i) {
+    softbit_list[i] = reinterpret_cast<int16_t*>(cb_list[i]);
+    data_list[i]    = cb_list[i] + data_offset;
+  }
+  buffer.max_cb = nof_cb;
+  srsran_softbuffer_rx_reset(&buffer);
+  return true;
+}
+
+void pooled_softbuffer_rx::release()
+{
+  if (is_bound()) {
+    pool->deallocate(cb_list.data(), buffer.max_cb);
+    buffer.max_cb = 0;
+  }
+}
+
+} // namespace srsenb
@@ -79,10 +79,23 @@ bool mac::init(const mac_args_t&        args_,
     srsran_softbuffer_tx_init(&cc.rar_softbuffer_tx, args.nof_prb);
   }
 
+  // Initiate common pools of code blocks, with the code blocks of maximum size TBs in all HARQ processes of
+  // nof_softbuffer_ues UEs per cell. The pools do not grow afterwards, so that no memory is allocated in the workers
+  uint32_t nof_prb    = args.nof_prb;
+  uint32_t nof_ue_cbs = ue_cc_softbuffers::max_nof_cb(nof_prb) * SRSRAN_FDD_NOF_HARQ * args.nof_softbuffer_ues;
+  tx_cb_pool.reset(new softbuffer_cb_pool(SOFTBUFFER_SIZE));
+  rx_cb_pool.reset(new softbuffer_cb_pool(softbuffer_cb_pool::rx_block_size(SOFTBUFFER_SIZE)));
+  if (not tx_cb_pool->reserve(nof_ue_cbs * SRSRAN_MAX_TB * cells.size()) or
+      not rx_cb_pool->reserve(nof_ue_cbs * cells.size())) {
+    logger.error("Failed to allocate the HARQ softbuffers of %d UEs", args.nof_softbuffer_ues);
+    return false;
+  }
+
   // Initiate common pool of softbuffers
-  uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  softbuffer_cb_pool* tx_pool          = tx_cb_pool.get();
+  softbuffer_cb_pool* rx_pool          = rx_cb_pool.get();
+  auto                init_softbuffers = [tx_pool, rx_pool, nof_prb](void* ptr) {
+    new (ptr) ue_cc_softbuffers(*tx_pool, *rx_pool, nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
   };
   auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
   softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
@@ -261,6 +274,11 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+  scheduler.event_metrics_read(metrics.sched_events);
+  if (tx_cb_pool != nullptr) {
+    tx_cb_pool->get_metrics(metrics.dl_softbuffers);
+    rx_cb_pool->get_metrics(metrics.ul_softbuffers);
+  }
 }
 
 void mac::toggle_padding()
@@ -296,6 +314,7 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 
   int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
   ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  ue_db[rnti]->tx_softbuffer_ack_info(enb_cc_idx, tti_rx, tb_idx, ack);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -313,6 +332,7 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 
   ue_db[rnti]->set_tti(tti_rx);
   ue_db[rnti]->metrics_rx(crc, nof_bytes);
+  ue_db[rnti]->rx_softbuffer_crc_info(enb_cc_idx, tti_rx, crc);
 
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
@@ -485,6 +505,7 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     rnti = FIRST_RNTI + (ue_counter.fetch_add(1, std::memory_order_relaxed) % 60000);
 
     // Pre-check if rnti is valid
+    uint32_t max_msg3_tx = 0;
     {
       srsran::rwlock_read_guard read_lock(rwlock);
       if (ue_db.full()) {
@@ -494,11 +515,21 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
       if (not is_valid_rnti_unprotected(rnti)) {
         continue;
       }
+      max_msg3_tx = cell_config[enb_cc_idx].maxharq_msg3tx;
     }
 
     // Allocate and initialize UE object
-    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(rnti,
+                                                   rnti,
+                                                   enb_cc_idx,
+                                                   max_msg3_tx,
+                                                   &scheduler,
+                                                   rrc_h,
+                                                   rlc_h,
+                                                   phy_h,
+                                                   logger,
+                                                   cells.size(),
+                                                   softbuffer_pool.get());
 
     // Add UE to rnti map
     srsran::rwlock_write_guard rw_lock(rwlock);
@@ -630,6 +661,15 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
   });
 }
 
+/// Number of TTIs between a PDSCH transmission and its HARQ-ACK
+static uint32_t dl_harq_ack_delay(const sched_interface::cell_cfg_t& cell_cfg, uint32_t tti_tx_dl)
+{
+  if (cell_cfg.cell.frame_type == SRSRAN_TDD) {
+    return srsran_tdd_dl_harq_ack_delay(cell_cfg.tdd_config, tti_tx_dl % SRSRAN_NOF_SF_X_FRAME);
+  }
+  return FDD_HARQ_DELAY_DL_MS;
+}
+
 int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 {
   if (!started) {
@@ -657,8 +697,6 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
     // Copy data grants
     for (uint32_t i = 0; i < sched_result.data.size(); i++) {
-      uint32_t tb_count = 0;
-
       // Get UE
       uint16_t rnti = sched_result.data[i].dci.rnti;
 
@@ -666,15 +704,38 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
         // Copy dci info
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
-        for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
-          dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
-
-          // If the Rx soft-buffer is not given, abort transmission
+        // Code blocks are bound to the HARQ process softbuffers for new transmissions. If the softbuffer of any TB
+        // is not given, the whole grant is dropped before generating its PDUs
+        uint32_t ack_delay   = dl_harq_ack_delay(cell_config[enb_cc_idx], tti_tx_dl);
+        bool     valid_grant = true;
+        for (uint32_t tb = 0; tb < SRSRAN_MAX_TB and valid_grant; tb++) {
+          bool new_tx = sched_result.data[i].nof_pdu_elems[tb] > 0;
+          dl_sched_res->pdsch[n].softbuffer_tx[tb] = ue_db[rnti]->get_tx_softbuffer(enb_cc_idx,
+                                                                                    sched_result.data[i].dci.pid,
+                                                                                    tb,
+                                                                                    tti_tx_dl,
+                                                                                    ack_delay,
+                                                                                    sched_result.data[i].tbs[tb],
+                                                                                    new_tx);
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
-            continue;
+            logger.warning("Failed to retrieve DL softbuffer for rnti=0x%x, pid=%d, tb=%d. Dropping grant",
+                           rnti,
+                           sched_result.data[i].dci.pid,
+                           tb);
+            valid_grant = false;
           }
+        }
+        if (not valid_grant) {
+          // The code blocks bound to the other TBs of the grant are not used
+          for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+            if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
+              ue_db[rnti]->release_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+            }
+          }
+          continue;
+        }
 
+        for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
             /* Get PDU if it's a new transmission */
             dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
@@ -700,14 +761,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
             /* TB not enabled OR no data to send: set pointers to NULL  */
             dl_sched_res->pdsch[n].data[tb] = nullptr;
           }
-
-          tb_count++;
-        }
-
-        // Count transmission if at least one TB has successfully added
-        if (tb_count > 0) {
-          n++;
         }
+        n++;
       } else {
         logger.warning("Invalid DL scheduling result. User 0x%x does not exist", rnti);
       }
@@ -997,17 +1052,19 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          // Code blocks are bound (and reset) for new transmissions
+          phy_ul_sched_res->pusch[n].softbuffer_rx =
+              ue_db[rnti]->get_rx_softbuffer(enb_cc_idx,
+                                             tti_tx_ul,
+                                             sched_result.pusch[i].tbs,
+                                             sched_result.pusch[i].current_tx_nb == 0,
+                                             sched_result.pusch[i].is_msg3);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
             logger.warning("Failed to retrieve UL softbuffer for tti=%d, cc=%d", tti_tx_ul, enb_cc_idx);
             continue;
           }
-
-          if (sched_result.pusch[n].current_tx_nb == 0) {
-            srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
-          }
           phy_ul_sched_res->pusch[n].data =
               ue_db[rnti]->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
           if (phy_ul_sched_res->pusch[n].data) {
@@ -1055,8 +1112,9 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
   current_mcch_length = mcch_payload_length;
 
+  // The MBMS user has no UL transmissions, hence no Msg3
   unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
   auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
   if (!ret) {
@@ -20,6 +20,7 @@
  */
 
 #include <srsenb/hdr/stack/mac/sched_ue.h>
+#include <algorithm>
 #include <string.h>
 
 #include "srsenb/hdr/stack/mac/sched.h"
@@ -34,13 +35,26 @@ using srsran::tti_point;
 
 namespace srsenb {
 
+/// Index of the event queue assigned to the calling thread
+static uint32_t get_thread_event_queue_idx(uint32_t nof_queues)
+{
+  static std::atomic<uint32_t> thread_count{0};
+  thread_local uint32_t        thread_idx = thread_count.fetch_add(1, std::memory_order_relaxed);
+  return thread_idx % nof_queues;
+}
+
 /*******************************************************
  *
  * Initialization and sched configuration functions
  *
  *******************************************************/
 
-sched::sched() {}
+sched::sched()
+{
+  for (uint32_t i = 0; i < nof_event_queues; ++i) {
+    event_queues.emplace_back(new ue_event_queue_t(event_queue_capacity));
+  }
+}
 
 sched::~sched() {}
 
@@ -52,16 +66,24 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  if (sched_cfg.nof_cc_workers > 0) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+  }
+
   reset();
 }
 
 int sched::reset()
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  process_ue_events();
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
   ue_db.clear();
+  for (std::atomic<uint16_t>& r : active_rntis) {
+    r.store(SRSRAN_INVALID_RNTI, std::memory_order_relaxed);
+  }
   return 0;
 }
 
@@ -106,9 +128,11 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
-    auto                        it = ue_db.find(rnti);
+    process_ue_events();
+    auto it = ue_db.find(rnti);
     if (it != ue_db.end()) {
       it->second->set_cfg(ue_cfg);
+      notify_ue_event(rnti);
       return SRSRAN_SUCCESS;
     }
   }
@@ -116,15 +140,23 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
-  ue_db.insert(rnti, std::move(ue));
+  if (not ue_db.insert(rnti, std::move(ue)).has_value()) {
+    Error("SCHED: Failed to add rnti=0x%x. The maximum number of UEs (%d) was reached", rnti, SRSENB_MAX_UES);
+    return SRSRAN_ERROR;
+  }
+  active_rntis[rnti % SRSENB_MAX_UES].store(rnti, std::memory_order_release);
+  notify_ue_event(rnti);
   return SRSRAN_SUCCESS;
 }
 
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  process_ue_events();
   if (ue_db.contains(rnti)) {
     ue_db.erase(rnti);
+    active_rntis[rnti % SRSENB_MAX_UES].store(SRSRAN_INVALID_RNTI, std::memory_order_release);
+    notify_ue_event(rnti);
   } else {
     Error("User rnti=0x%x not found", rnti);
     return SRSRAN_ERROR;
@@ -134,7 +166,7 @@ int sched::ue_rem(uint16_t rnti)
 
 bool sched::ue_exists(uint16_t rnti)
 {
-  return ue_db_access_locked(
+  return ue_db_read_locked(
              rnti, [](sched_ue& ue) {}, nullptr, false) >= 0;
 }
 
@@ -158,7 +190,7 @@ int sched::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 uint32_t sched::get_dl_buffer(uint16_t rnti)
 {
   uint32_t ret = SRSRAN_ERROR;
-  ue_db_access_locked(
+  ue_db_read_locked(
       rnti, [&ret](sched_ue& ue) { ret = ue.get_pending_dl_rlc_data(); }, __PRETTY_FUNCTION__);
   return ret;
 }
@@ -167,7 +199,7 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 {
   // TODO: Check if correct use of last_tti
   uint32_t ret = SRSRAN_ERROR;
-  ue_db_access_locked(
+  ue_db_read_locked(
       rnti,
       [this, &ret](sched_ue& ue) { ret = ue.get_pending_ul_new_data(to_tx_ul(last_tti), -1); },
       __PRETTY_FUNCTION__);
@@ -176,12 +208,13 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  return ue_db_push_event(
+      rnti, [lc_id, tx_queue, prio_tx_queue](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  return ue_db_push_event(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
@@ -196,31 +229,31 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+  return ue_db_push_event(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
 }
@@ -233,29 +266,30 @@ int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  return ue_db_push_event(rnti, [tti_rx, enb_cc_idx, snr, ul_ch_code](sched_ue& ue) {
+    ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code);
+  });
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return ue_db_push_event(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return ue_db_push_event(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
+  return ue_db_push_event(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
 
@@ -269,7 +303,7 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_cc_map(uint16_t rnti)
 {
   std::array<int, SRSRAN_MAX_CARRIERS> ret{};
   ret.fill(-1); // -1 for inactive & non-existent carriers
-  ue_db_access_locked(
+  ue_db_read_locked(
       rnti,
       [this, &ret](sched_ue& ue) {
         for (size_t enb_cc_idx = 0; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
@@ -287,7 +321,7 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
 {
   std::array<int, SRSRAN_MAX_CARRIERS> ret{};
   ret.fill(-1); // -1 for inactive & non-existent carriers
-  ue_db_access_locked(
+  ue_db_read_locked(
       rnti,
       [this, &ret](sched_ue& ue) {
         for (size_t enb_cc_idx = 0; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
@@ -361,6 +395,14 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  // Apply the feedback received since the last TTI
+  process_ue_events();
+
+  if (cc_workers != nullptr and carrier_schedulers.size() > 1) {
+    new_tti_parallel(tti_rx);
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,6 +412,54 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate scheduling decision for tti_rx, allocating the resources of the different CCs in parallel.
+/// The UE state shared across CCs (e.g. buffers, HARQ entities, UCI multiplexing) is only read during the allocation
+/// phase. It is then updated in a sequential post-phase, which generates the DCIs of each CC in order and drops
+/// allocations that were left without data by the CCs that came before
+void sched::new_tti_parallel(tti_point tti_rx)
+{
+  srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS> pending_ccs;
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    if (not is_generated(tti_rx, cc_idx)) {
+      pending_ccs.push_back(cc_idx);
+    }
+  }
+  if (pending_ccs.empty()) {
+    return;
+  }
+
+  // Set up TTI. Touches state shared across CCs, so it runs sequentially
+  for (uint32_t cc_idx : pending_ccs) {
+    carrier_schedulers[cc_idx]->new_tti(tti_rx);
+  }
+
+  // Allocate CC resources in parallel. The caller thread allocates the first CC
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_allocs = pending_ccs.size() - 1;
+  }
+  for (uint32_t i = 1; i < pending_ccs.size(); ++i) {
+    uint32_t cc_idx = pending_ccs[i];
+    cc_workers->push_task([this, cc_idx, tti_rx]() {
+      carrier_schedulers[cc_idx]->alloc_tti(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_allocs == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  carrier_schedulers[pending_ccs[0]]->alloc_tti(tti_rx);
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    cc_workers_cvar.wait(lock, [this]() { return nof_pending_cc_allocs == 0; });
+  }
+
+  // Reconcile the UE state shared across CCs
+  for (uint32_t cc_idx : pending_ccs) {
+    carrier_schedulers[cc_idx]->finish_tti(tti_rx);
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
@@ -378,16 +468,131 @@ bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 
 int sched::metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics)
 {
-  return ue_db_access_locked(
+  return ue_db_read_locked(
       rnti, [&metrics](sched_ue& ue) { ue.metrics_read(metrics); }, "metrics_read");
 }
 
-// Common way to access ue_db elements in a read locking way
+void sched::event_metrics_read(mac_sched_event_metrics_t& metrics)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  metrics                = event_metrics;
+  metrics.nof_overflows  = nof_event_overflows.exchange(0, std::memory_order_relaxed);
+  metrics.avg_latency_us = event_metrics.nof_events > 0 ? event_latency_sum_us / event_metrics.nof_events : 0;
+  event_metrics          = {};
+  event_latency_sum_us   = 0;
+}
+
+/// Pushes a UE feedback event to the event queue of the calling thread, without locking the scheduler. The event is
+/// applied at the start of the next TTI, or before any other locked access to ue_db, whichever comes first, once the
+/// events pushed before it were applied.
+/// If the queue is full, the event is handed over to the scheduler under the lock, after the events already queued
+template <typename Func>
+int sched::ue_db_push_event(uint16_t rnti, Func&& f, const char* func_name)
+{
+  if (active_rntis[rnti % SRSENB_MAX_UES].load(std::memory_order_acquire) != rnti) {
+    if (func_name != nullptr) {
+      Error("SCHED: User rnti=0x%x not found. Failed to call %s.", rnti, func_name);
+    } else {
+      Error("SCHED: User rnti=0x%x not found.", rnti);
+    }
+    return SRSRAN_ERROR;
+  }
+
+  ue_event_t ev;
+  ev.seq       = event_seq.fetch_add(1, std::memory_order_relaxed);
+  ev.rnti      = rnti;
+  ev.func_name = func_name;
+  ev.tp        = std::chrono::steady_clock::now();
+  ev.callback  = std::forward<Func>(f);
+  if (event_queues[get_thread_event_queue_idx(nof_event_queues)]->try_push(std::move(ev))) {
+    return SRSRAN_SUCCESS;
+  }
+  nof_event_overflows.fetch_add(1, std::memory_order_relaxed);
+  // The event keeps its sequence number, so that it is applied after the events that this and other threads queued
+  // before it
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  pending_events.push_back(std::move(ev));
+  process_ue_events();
+  return SRSRAN_SUCCESS;
+}
+
+/// Applies the pending UE feedback events, in the order they were pushed across all threads. Called with sched_mutex
+/// locked
+void sched::process_ue_events()
+{
+  auto       now = std::chrono::steady_clock::now();
+  ue_event_t ev;
+  for (std::unique_ptr<ue_event_queue_t>& q : event_queues) {
+    // Only the events present at the start of the drain are applied, so that busy producers can't stall the TTI
+    for (size_t n = q->size(); n > 0 and q->try_pop(ev); --n) {
+      pending_events.push_back(std::move(ev));
+    }
+  }
+
+  // Each queue is ordered, merge them by push order
+  std::sort(pending_events.begin(), pending_events.end(), [](const ue_event_t& lhs, const ue_event_t& rhs) {
+    return lhs.seq < rhs.seq;
+  });
+  // A sequence number may be taken by a thread that has not pushed its event yet. The events that follow it are left
+  // pending until it arrives
+  auto events_end = pending_events.begin();
+  while (events_end != pending_events.end() and events_end->seq == next_event_seq) {
+    ++events_end;
+    ++next_event_seq;
+  }
+
+  for (auto pending = pending_events.begin(); pending != events_end; ++pending) {
+    // Events pushed concurrently with the drain may have a timestamp later than "now"
+    float latency_us = std::max(0.0f, std::chrono::duration<float, std::micro>(now - pending->tp).count());
+    event_latency_sum_us += latency_us;
+    event_metrics.max_latency_us = std::max(event_metrics.max_latency_us, latency_us);
+
+    auto it = ue_db.find(pending->rnti);
+    if (it != ue_db.end()) {
+      pending->callback(*it->second);
+      notify_ue_event(pending->rnti);
+    } else if (pending->func_name != nullptr) {
+      Error("SCHED: User rnti=0x%x not found. Failed to call %s.", pending->rnti, pending->func_name);
+    } else {
+      Error("SCHED: User rnti=0x%x not found.", pending->rnti);
+    }
+  }
+  uint32_t depth = events_end - pending_events.begin();
+  pending_events.erase(pending_events.begin(), events_end);
+  event_metrics.nof_events += depth;
+  event_metrics.max_queue_depth = std::max(event_metrics.max_queue_depth, depth);
+}
+
+/// Lets the carrier schedulers know that the state of a UE was changed outside of the TTI scheduling
+void sched::notify_ue_event(uint16_t rnti)
+{
+  for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+    c->ue_event(rnti);
+  }
+}
+
+// Common way to access ue_db elements in a read locking way. The schedulers are notified of the UE change
 template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
+{
+  return ue_db_read_locked(
+      rnti,
+      [this, &f](sched_ue& ue) {
+        f(ue);
+        notify_ue_event(ue.get_rnti());
+      },
+      func_name,
+      log_fail);
+}
+
+// Same as ue_db_access_locked, for accesses that do not change the UE state
+template <typename Func>
+int sched::ue_db_read_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  // Feedback events that were pushed before this call must be applied first
+  process_ue_events();
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
   } else {
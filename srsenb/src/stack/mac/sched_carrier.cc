@@ -352,6 +352,13 @@ void sched::carrier_sched::reset()
   pending_pdcch_orders.clear();
 }
 
+void sched::carrier_sched::ue_event(uint16_t rnti)
+{
+  if (sched_algo != nullptr) {
+    sched_algo->ue_event(rnti);
+  }
+}
+
 void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
 {
   // carrier_sched is now fully set
@@ -383,16 +390,29 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+  new_tti(tti_rx);
+  alloc_tti(tti_rx);
+  return finish_tti(tti_rx);
+}
+
+void sched::carrier_sched::new_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
-  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+  /* Set up Msg3 subframe, as the sched results ringbuffer is shared by all carriers */
+  if (is_dl_active(tti_sched)) {
+    get_sf_sched(tti_rx + MSG3_DELAY_MS);
+  }
 
   /* Refresh UE internal buffers and subframe vars */
   for (auto& user : *ue_db) {
     user.second->new_subframe(tti_rx, enb_cc_idx);
   }
+}
+
+void sched::carrier_sched::alloc_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
   /* Schedule PHICH */
   for (auto& ue_pair : *ue_db) {
@@ -402,7 +422,7 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   }
 
   /* Schedule DL control data */
-  if (dl_active) {
+  if (is_dl_active(tti_sched)) {
     /* Schedule Broadcast data (SIB and paging) */
     bc_sched_ptr->dl_sched(tti_sched);
 
@@ -428,6 +448,13 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   if ((tti_rx.to_uint() % 2) == 1) {
     alloc_ul_users(tti_sched);
   }
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti(tti_point tti_rx)
+{
+  sf_sched*        tti_sched = get_sf_sched(tti_rx);
+  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
+  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
@@ -443,6 +470,11 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   return *cc_result;
 }
 
+bool sched::carrier_sched::is_dl_active(const sf_sched* tti_sched) const
+{
+  return sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+}
+
 void sched::carrier_sched::alloc_dl_users(sf_sched* tti_result)
 {
   if (sf_dl_mask[tti_result->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] != 0) {
@@ -281,20 +281,20 @@ alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
 bool sf_grid_t::find_ul_alloc(uint32_t L, prb_interval* alloc) const
 {
   *alloc = {};
-  for (uint32_t n = 0; n < ul_mask.size() && alloc->length() < L; n++) {
-    if (not ul_mask.test(n) && alloc->length() == 0) {
-      alloc->displace_to(n);
+  for (size_t n = 0; n < ul_mask.size() and L > 0;) {
+    int start = ul_mask.find_lowest(n, ul_mask.size(), false);
+    if (start < 0) {
+      break;
     }
-    if (not ul_mask.test(n)) {
-      alloc->resize_by(1);
-    } else if (alloc->length() > 0) {
-      // avoid edges
-      if (n < 3) {
-        *alloc = {};
-      } else {
-        break;
-      }
+    size_t stop_max = std::min(ul_mask.size(), (size_t)start + L);
+    int    stop     = ul_mask.find_lowest(start + 1, stop_max, true);
+    *alloc          = prb_interval(start, stop < 0 ? stop_max : stop);
+    if (stop < 0 or stop >= 3) {
+      break;
     }
+    // avoid edges
+    *alloc = {};
+    n      = stop;
   }
   if (alloc->length() == 0) {
     return false;
@@ -538,7 +538,11 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  // When the CCs are allocated in parallel, the results of the other CCs may still be in the making, so only this CC's
+  // allocations are checked. The CC carrying UCI on PUSCH is selected later, in generate_sched_results()
+  bool parallel_cc_alloc = cc_cfg->sched_cfg->nof_cc_workers > 0 and cc_results->enb_cc_list.size() > 1;
+  bool has_pusch_grant   = is_ul_alloc(user->get_rnti()) or
+                         (not parallel_cc_alloc and cc_results->is_ul_alloc(user->get_rnti()));
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -893,6 +897,7 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
       ul_result->pusch.pop_back();
       continue;
     }
+    pusch.is_msg3 = ul_alloc.is_msg3;
 
     // Print Resulting UL Allocation
     uint32_t old_pending_bytes = user->get_pending_ul_old_data();
@@ -37,9 +37,9 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
 {
   cc_cfg           = &cell_params_;
   pucch_cfg_common = cc_cfg->pucch_cfg_common;
-  dci_record_list.reserve(16);
-  last_dci_dfs.reserve(16);
-  temp_dci_dfs.reserve(16);
+  dci_record_list.reserve(MAX_NOF_CCES);
+  dci_alloc_list.reserve(MAX_NOF_CCES);
+  temp_alloc_list.reserve(MAX_NOF_CCES);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -47,7 +47,7 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
   tti_rx = tti_rx_;
 
   dci_record_list.clear();
-  last_dci_dfs.clear();
+  dci_alloc_list.clear();
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
 }
@@ -74,7 +74,6 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
 
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
-  temp_dci_dfs.clear();
   uint32_t start_cfix = current_cfix;
 
   alloc_record record;
@@ -82,6 +81,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   record.aggr_idx   = aggr_idx;
   record.alloc_type = alloc_type;
   record.pusch_uci  = has_pusch_grant;
+  record.candidates_set.fill(false);
 
   if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
@@ -98,128 +98,211 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
       }
     }
   }
+  dci_record_list.push_back(record);
+  uint32_t record_idx = dci_record_list.size() - 1;
 
-  // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
-  do {
-    bool success = alloc_dfs_node(record, 0);
-    if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
+  // Try to allocate grant in the current CFI, moving at most one of the past DCIs to another position
+  bool success = alloc_dci_node(record_idx, current_cfix, dci_alloc_list);
 
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
-      }
-      return true;
+  // If it fails, increase the CFI and place again all the DCIs
+  for (uint32_t cfix = current_cfix + 1; not success and cfix <= current_max_cfix; ++cfix) {
+    temp_alloc_list.clear();
+    success = true;
+    for (uint32_t i = 0; i <= record_idx and success; ++i) {
+      success = alloc_dci_node(i, cfix, temp_alloc_list);
     }
-    if (temp_dci_dfs.empty()) {
-      temp_dci_dfs = last_dci_dfs;
+    if (success) {
+      dci_alloc_list.swap(temp_alloc_list);
+      current_cfix = cfix;
     }
-  } while (get_next_dfs());
-
-  // Revert steps to initial state, before dci record allocation was attempted
-  last_dci_dfs.swap(temp_dci_dfs);
-  current_cfix = start_cfix;
-  return false;
-}
+  }
 
-bool sf_cch_allocator::get_next_dfs()
-{
-  do {
-    uint32_t start_child_idx = 0;
-    if (last_dci_dfs.empty()) {
-      // If we reach root, increase CFI
-      current_cfix++;
-      if (current_cfix > current_max_cfix) {
-        return false;
-      }
-    } else {
-      // Attempt to re-add last tree node, but with a higher node child index
-      start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
-      last_dci_dfs.pop_back();
-    }
-    while (last_dci_dfs.size() < dci_record_list.size() and
-           alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
-      start_child_idx = 0;
-    }
-  } while (last_dci_dfs.size() < dci_record_list.size());
+  if (not success) {
+    // Revert steps to initial state, before dci record allocation was attempted
+    dci_record_list.pop_back();
+    current_cfix = start_cfix;
+    return false;
+  }
 
-  // Finished computation of next DFS node
+  if (is_dl_ctrl_alloc(alloc_type)) {
+    // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+    current_max_cfix = current_cfix;
+  }
   return true;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+const sf_cch_allocator::cce_candidate_list& sf_cch_allocator::get_cce_candidates(alloc_record& record, uint32_t cfix)
 {
-  // Get DCI Location Table
-  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
+  cce_candidate_list& candidates = record.candidates[cfix];
+  if (record.candidates_set[cfix]) {
+    return candidates;
   }
+  record.candidates_set[cfix] = true;
+  candidates.clear();
 
-  tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
-  // get cumulative pdcch & pucch masks
-  if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
-  } else {
-    node.total_mask.resize(nof_cces());
-    node.total_pucch_mask.resize(cc_cfg->nof_prb());
+  // Get DCI Location Table
+  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, cfix);
+  if (dci_locs == nullptr) {
+    return candidates;
   }
+  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+  for (uint32_t i = 0; i < dci_pos_list.size(); ++i) {
+    cce_candidate cand;
+    cand.dci_pos_idx = i;
+    cand.ncce        = dci_pos_list[i];
+    cand.pucch_n_prb = -1;
 
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
       // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
+      pucch_cfg_common.n_pucch = cand.ncce + pucch_cfg_common.N_pucch_1;
 
       if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
         // avoid collision of HARQ-ACK with own SR n(1)_pucch
         continue;
       }
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
-        // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
-        continue;
-      }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
+      cand.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+      int low_rb       = cand.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
+                             ? cand.pucch_n_prb
+                             : cc_cfg->cfg.cell.nof_prb - cand.pucch_n_prb - 1;
       if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
         // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
-        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
-                    node.dci_pos.ncce);
+        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n", cand.ncce);
         continue;
       }
     }
+    candidates.push_back(cand);
+  }
+  return candidates;
+}
+
+bool sf_cch_allocator::is_cce_candidate_free(const cce_candidate& cand,
+                                             uint32_t             aggr_idx,
+                                             const pdcch_mask_t&  cce_mask,
+                                             const prbmask_t&     pucch_mask) const
+{
+  if (cand.pucch_n_prb >= 0 and not cc_cfg->sched_cfg->pucch_mux_enabled and pucch_mask.test(cand.pucch_n_prb)) {
+    // PUCCH allocation would collide with other PUCCH/PUSCH grants
+    return false;
+  }
+  // check PDCCH collision
+  return not cce_mask.any(cand.ncce, cand.ncce + (1U << aggr_idx));
+}
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
+bool sf_cch_allocator::alloc_dci_node(uint32_t record_idx, uint32_t cfix, std::vector<tree_node>& allocs)
+{
+  alloc_record&             record     = dci_record_list[record_idx];
+  const cce_candidate_list& candidates = get_cce_candidates(record, cfix);
+  if (candidates.empty()) {
+    return false;
+  }
+
+  // Greedy placement in the first free position
+  pdcch_mask_t cce_mask;
+  prbmask_t    pucch_mask;
+  get_used_resources(allocs, -1, cfix, cce_mask, pucch_mask);
+  for (const cce_candidate& cand : candidates) {
+    if (is_cce_candidate_free(cand, record.aggr_idx, cce_mask, pucch_mask)) {
+      allocs.emplace_back();
+      set_node(allocs.back(), record_idx, cand, cfix);
+      update_total_masks(allocs, allocs.size() - 1);
+      return true;
+    }
+  }
+
+  // Bounded repair. Move one of the previously allocated DCIs to another position of its search space, to make room
+  for (int j = (int)allocs.size() - 1; j >= 0; --j) {
+    tree_node&                node             = allocs[j];
+    alloc_record&             other            = dci_record_list[node.record_idx];
+    const cce_candidate_list& other_candidates = get_cce_candidates(other, cfix);
+    if (other_candidates.size() < 2) {
       continue;
     }
+    get_used_resources(allocs, j, cfix, cce_mask, pucch_mask);
+    for (const cce_candidate& cand : candidates) {
+      if (not is_cce_candidate_free(cand, record.aggr_idx, cce_mask, pucch_mask)) {
+        continue;
+      }
+      pdcch_mask_t cce_mask2   = cce_mask;
+      prbmask_t    pucch_mask2 = pucch_mask;
+      cce_mask2.fill(cand.ncce, cand.ncce + (1U << record.aggr_idx));
+      if (cand.pucch_n_prb >= 0) {
+        pucch_mask2.set(cand.pucch_n_prb);
+      }
+      for (const cce_candidate& other_cand : other_candidates) {
+        if (other_cand.ncce != node.dci_pos.ncce and
+            is_cce_candidate_free(other_cand, other.aggr_idx, cce_mask2, pucch_mask2)) {
+          set_node(node, node.record_idx, other_cand, cfix);
+          allocs.emplace_back();
+          set_node(allocs.back(), record_idx, cand, cfix);
+          update_total_masks(allocs, j);
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+void sf_cch_allocator::set_node(tree_node& node, uint32_t record_idx, const cce_candidate& cand, uint32_t cfix) const
+{
+  const alloc_record& record = dci_record_list[record_idx];
+  node.record_idx            = record_idx;
+  node.dci_pos_idx           = cand.dci_pos_idx;
+  node.dci_pos.L             = record.aggr_idx;
+  node.dci_pos.ncce          = cand.ncce;
+  node.rnti                  = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+  node.pucch_n_prb           = cand.pucch_n_prb;
+  node.current_mask.resize(cc_cfg->nof_cce_table[cfix]);
+  node.current_mask.reset();
+  node.current_mask.fill(cand.ncce, cand.ncce + (1U << record.aggr_idx));
+}
+
+void sf_cch_allocator::get_used_resources(const std::vector<tree_node>& allocs,
+                                          int                           skip_idx,
+                                          uint32_t                      cfix,
+                                          pdcch_mask_t&                 cce_mask,
+                                          prbmask_t&                    pucch_mask) const
+{
+  if (skip_idx < 0 and not allocs.empty()) {
+    cce_mask   = allocs.back().total_mask;
+    pucch_mask = allocs.back().total_pucch_mask;
+    return;
+  }
+  cce_mask.resize(cc_cfg->nof_cce_table[cfix]);
+  cce_mask.reset();
+  pucch_mask.resize(cc_cfg->nof_prb());
+  pucch_mask.reset();
+  for (int i = 0; i < (int)allocs.size(); ++i) {
+    if (i != skip_idx) {
+      cce_mask |= allocs[i].current_mask;
+      if (allocs[i].pucch_n_prb >= 0) {
+        pucch_mask.set(allocs[i].pucch_n_prb);
+      }
+    }
+  }
+}
 
-    // Allocation successful
+void sf_cch_allocator::update_total_masks(std::vector<tree_node>& allocs, size_t start_idx) const
+{
+  for (size_t i = start_idx; i < allocs.size(); ++i) {
+    tree_node& node = allocs[i];
+    if (i > 0) {
+      node.total_mask       = allocs[i - 1].total_mask;
+      node.total_pucch_mask = allocs[i - 1].total_pucch_mask;
+    } else {
+      node.total_mask.resize(node.current_mask.size());
+      node.total_mask.reset();
+      node.total_pucch_mask.resize(cc_cfg->nof_prb());
+      node.total_pucch_mask.reset();
+    }
     node.total_mask |= node.current_mask;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
     }
-    last_dci_dfs.push_back(node);
-    return true;
   }
-
-  return false;
 }
 
 void sf_cch_allocator::rem_last_dci()
@@ -227,7 +310,7 @@ void sf_cch_allocator::rem_last_dci()
   assert(not dci_record_list.empty());
 
   // Remove DCI record
-  last_dci_dfs.pop_back();
+  dci_alloc_list.pop_back();
   dci_record_list.pop_back();
 }
 
@@ -236,18 +319,18 @@ void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, s
   if (vec != nullptr) {
     vec->clear();
 
-    vec->resize(last_dci_dfs.size());
-    for (uint32_t i = 0; i < last_dci_dfs.size(); ++i) {
-      (*vec)[i] = &last_dci_dfs[i];
+    vec->resize(dci_alloc_list.size());
+    for (uint32_t i = 0; i < dci_alloc_list.size(); ++i) {
+      (*vec)[i] = &dci_alloc_list[i];
     }
   }
 
   if (tot_mask != nullptr) {
-    if (last_dci_dfs.empty()) {
+    if (dci_alloc_list.empty()) {
       tot_mask->resize(nof_cces());
       tot_mask->reset();
     } else {
-      *tot_mask = last_dci_dfs.back().total_mask;
+      *tot_mask = dci_alloc_list.back().total_mask;
     }
   }
 }
@@ -263,7 +346,7 @@ std::string sf_cch_allocator::result_to_string(bool verbose) const
                    get_cfi(),
                    nof_cces(),
                    nof_allocs(),
-                   last_dci_dfs.back().total_mask);
+                   dci_alloc_list.back().total_mask);
     alloc_result_t vec;
     get_allocs(&vec);
     if (verbose) {
@@ -19,8 +19,10 @@
  *
  */
 
+
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
-#include <vector>
+#include <algorithm>
+#include <cmath>
 
 namespace srsenb {
 
@@ -33,46 +35,96 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  dl_queue.reserve(SRSENB_MAX_UES);
+  ul_queue.reserve(SRSENB_MAX_UES);
+  pending_eval_ues.reserve(SRSENB_MAX_UES);
+  eval_ues.reserve(SRSENB_MAX_UES);
 }
 
-void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
+void sched_time_pf::ue_event(uint16_t rnti)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
+  auto it = ue_history_db.find(rnti);
+  if (it != ue_history_db.end()) {
+    set_pending_eval(it->second);
+  } else {
+    new_rntis.push_back(rnti);
   }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
+}
+
+void sched_time_pf::set_pending_eval(ue_ctxt& ue)
+{
+  if (not ue.pending_eval) {
+    ue.pending_eval = true;
+    pending_eval_ues.push_back(&ue);
   }
+}
+
+void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
+{
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
-  // remove deleted users from history
-  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
-    if (not ue_db.contains(it->first)) {
-      it = ue_history_db.erase(it);
-    } else {
-      ++it;
+  tti_count++;
+
+  if (full_sweep_pending) {
+    // users created before this scheduler
+    full_sweep_pending = false;
+    for (auto& u : ue_db) {
+      ue_event(u.first);
     }
   }
-  // add new users to history db, and update priority queues
-  for (auto& u : ue_db) {
-    auto it = ue_history_db.find(u.first);
-    if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
-    }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+
+  // remove the deleted users first, as a new user may take the same slot of the history db in the same TTI
+  for (ue_ctxt*& ue : pending_eval_ues) {
+    if (not ue_db.contains(ue->rnti)) {
+      rem_user(*ue);
+      ue = nullptr;
     }
-    if (it->second.ul_h != nullptr) {
-      ul_queue.push(&it->second);
+  }
+  pending_eval_ues.erase(std::remove(pending_eval_ues.begin(), pending_eval_ues.end(), nullptr),
+                         pending_eval_ues.end());
+
+  // add new users to history db
+  for (uint16_t rnti : new_rntis) {
+    if (ue_db.contains(rnti) and not ue_history_db.contains(rnti)) {
+      auto ret = ue_history_db.insert(rnti, ue_ctxt{rnti, fairness_coeff, tti_count});
+      if (ret.has_value()) {
+        set_pending_eval(ret.value()->second);
+      }
     }
   }
+  new_rntis.clear();
+
+  // Refresh the state of the users that received events or were allocated since the last TTI. The remaining users
+  // keep their position in the priority queues
+  std::swap(eval_ues, pending_eval_ues);
+  for (ue_ctxt* ue : eval_ues) {
+    ue->pending_eval = false;
+    update_queues(*ue, *ue_db[ue->rnti], tti_sched);
+  }
+  eval_ues.clear();
+}
+
+void sched_time_pf::update_queues(ue_ctxt& ue, sched_ue& user, sf_sched* tti_sched)
+{
+  if (ue.new_tti(*cc_cfg, user, tti_sched, tti_count, exp_avg_alpha)) {
+    set_pending_eval(ue);
+  }
+  if (ue.dl_active) {
+    dl_queue.push_or_update(ue);
+  } else {
+    dl_queue.erase(ue);
+  }
+  if (ue.ul_active) {
+    ul_queue.push_or_update(ue);
+  } else {
+    ul_queue.erase(ue);
+  }
+}
+
+void sched_time_pf::rem_user(ue_ctxt& ue)
+{
+  dl_queue.erase(ue);
+  ul_queue.erase(ue);
+  ue_history_db.erase(ue.rnti);
 }
 
 /*****************************************************************
@@ -88,25 +140,37 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
 
   while (not dl_queue.empty()) {
     ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
+    if (not ue.dl_retx and tti_sched->get_dl_mask().all()) {
+      // No PDSCH space left. The users that were not visited keep their priority order
+      break;
+    }
     dl_queue.pop();
+    // The user is added back to the queue in the next TTI, with its updated buffers and rate
+    set_pending_eval(ue);
+    auto it = ue_db.find(ue.rnti);
+    if (it != ue_db.end()) {
+      ue.dl_rate.save_alloc(tti_count, try_dl_alloc(ue, *it->second, tti_sched), exp_avg_alpha);
+    }
   }
 }
 
 uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
 {
+  const dl_harq_proc* dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
+  const dl_harq_proc* dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
+
   alloc_result code = alloc_result::other_cause;
-  if (ue_ctxt.dl_retx_h != nullptr) {
-    code = try_dl_retx_alloc(*tti_sched, ue, *ue_ctxt.dl_retx_h);
+  if (dl_retx_h != nullptr) {
+    code = try_dl_retx_alloc(*tti_sched, ue, *dl_retx_h);
     if (code == alloc_result::success) {
-      return ue_ctxt.dl_retx_h->get_tbs(0) + ue_ctxt.dl_retx_h->get_tbs(1);
+      return dl_retx_h->get_tbs(0) + dl_retx_h->get_tbs(1);
     }
   }
 
   // There is space in PDCCH and an available DL HARQ
-  if (code != alloc_result::no_cch_space and ue_ctxt.dl_newtx_h != nullptr) {
+  if (code != alloc_result::no_cch_space and dl_newtx_h != nullptr) {
     rbgmask_t alloc_mask;
-    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *ue_ctxt.dl_newtx_h, &alloc_mask);
+    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *dl_newtx_h, &alloc_mask);
     if (code == alloc_result::success) {
       return ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
     }
@@ -127,27 +191,40 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
 
   while (not ul_queue.empty()) {
     ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
+    if (not ue.ul_retx and tti_sched->get_ul_mask().all()) {
+      // No PUSCH space left. The users that were not visited keep their priority order
+      break;
+    }
     ul_queue.pop();
+    // The user is added back to the queue in the next TTI, with its updated buffers and rate
+    set_pending_eval(ue);
+    auto it = ue_db.find(ue.rnti);
+    if (it != ue_db.end()) {
+      ue.ul_rate.save_alloc(tti_count, try_ul_alloc(ue, *it->second, tti_sched), exp_avg_alpha);
+    }
   }
 }
 
 uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
 {
-  if (ue_ctxt.ul_h == nullptr) {
+  const ul_harq_proc* ul_h = get_ul_retx_harq(ue, tti_sched);
+  if (ul_h == nullptr) {
+    ul_h = get_ul_newtx_harq(ue, tti_sched);
+  }
+  if (ul_h == nullptr) {
     // In case the UL HARQ could not be allocated (e.g. meas gap occurrence)
     return 0;
   }
   if (tti_sched->is_ul_alloc(ue_ctxt.rnti)) {
     // NOTE: An UL grant could have been previously allocated for UCI
-    return ue_ctxt.ul_h->get_pending_data();
+    return ul_h->get_pending_data();
   }
 
   alloc_result code;
   uint32_t     estim_tbs_bytes = 0;
-  if (ue_ctxt.ul_h->has_pending_retx()) {
-    code            = try_ul_retx_alloc(*tti_sched, ue, *ue_ctxt.ul_h);
-    estim_tbs_bytes = code == alloc_result::success ? ue_ctxt.ul_h->get_pending_data() : 0;
+  if (ul_h->has_pending_retx()) {
+    code            = try_ul_retx_alloc(*tti_sched, ue, *ul_h);
+    estim_tbs_bytes = code == alloc_result::success ? ul_h->get_pending_data() : 0;
   } else {
     // Note: h->is_empty check is required, in case CA allocated a small UL grant for UCI
     uint32_t pending_data = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -172,74 +249,164 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
  *                          UE history
  *****************************************************************/
 
-void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched)
+/// Refreshes the user state and priorities. Returns true if the state has to be refreshed again in the next TTI,
+/// because it changes without external events (HARQs in flight) or its priority order does (rate fast start)
+bool sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell,
+                                     sched_ue&                  ue,
+                                     sf_sched*                  tti_sched,
+                                     uint64_t                   tti,
+                                     float                      alpha)
 {
-  dl_retx_h  = nullptr;
-  dl_newtx_h = nullptr;
-  ul_h       = nullptr;
-  dl_prio    = 0;
-  ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
+  dl_active = false;
+  ul_active = false;
+  dl_retx   = false;
+  ul_retx   = false;
+  ue_cc_idx = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
-    return;
+    return false;
   }
 
+  harq_entity& harq_ent = ue.find_ue_carrier(cell.enb_cc_idx)->harq_ent;
+  bool         dl_harqs_busy =
+      std::any_of(harq_ent.dl_harq_procs().begin(), harq_ent.dl_harq_procs().end(), [](const dl_harq_proc& h) {
+        return not h.is_empty();
+      });
+  bool ul_harqs_busy =
+      std::any_of(harq_ent.ul_harq_procs().begin(), harq_ent.ul_harq_procs().end(), [](const ul_harq_proc& h) {
+        return not h.is_empty();
+      });
+
   // Calculate DL priority
-  dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
-  dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
-  if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  dl_active = dl_harqs_busy or ue.get_pending_dl_bytes(cell.enb_cc_idx) > 0;
+  if (dl_active) {
+    dl_retx = get_dl_retx_harq(ue, tti_sched) != nullptr;
+    dl_prio = get_prio(ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8, dl_rate, tti, alpha);
   }
 
   // Calculate UL priority
-  ul_h = get_ul_retx_harq(ue, tti_sched);
-  if (ul_h == nullptr) {
-    ul_h = get_ul_newtx_harq(ue, tti_sched);
+  ul_active = ul_harqs_busy or ue.get_pending_ul_data_total(tti_sched->get_tti_tx_ul(), cell.enb_cc_idx) > 0;
+  if (ul_active) {
+    ul_retx = get_ul_retx_harq(ue, tti_sched) != nullptr;
+    ul_prio = get_prio(ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8, ul_rate, tti, alpha);
   }
-  if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+
+  return dl_harqs_busy or ul_harqs_busy or (dl_active and dl_rate.is_fast_start(alpha)) or
+         (ul_active and ul_rate.is_fast_start(alpha));
+}
+
+/// Logarithm of the PF metric r / R^fairness_coeff. In TTIs without allocations, R decays by the same factor for all
+/// users. This decay is taken out of the metric, so that the priority order of the users whose rate was not updated
+/// stays valid
+double sched_time_pf::ue_ctxt::get_prio(float r, ue_rate& rate, uint64_t tti, float alpha) const
+{
+  rate.apply_idle_ttis(tti, alpha);
+  if (r == 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  if (rate.avg_rate == 0) {
+    return std::numeric_limits<double>::infinity();
   }
+  return std::log(r) - fairness_coeff * (std::log(rate.avg_rate) - tti * std::log(1.0 - alpha));
 }
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+/// Applies the zero samples of the TTIs between the last sample and "tti"
+void sched_time_pf::ue_rate::apply_idle_ttis(uint64_t tti, float alpha)
 {
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+  if (tti <= last_tti + 1) {
+    return;
   }
-  dl_nof_samples++;
+  uint64_t nof_idle = tti - last_tti - 1;
+
+  // In the fast start phase, each zero sample scales the average by n / (n + 1)
+  uint64_t fast_start_len = std::ceil(1 / alpha);
+  uint64_t nof_fast_start = nof_samples < fast_start_len ? std::min(nof_idle, fast_start_len - nof_samples) : 0;
+  if (nof_fast_start > 0) {
+    avg_rate *= nof_samples / static_cast<float>(nof_samples + nof_fast_start);
+  }
+  avg_rate *= std::pow(1 - alpha, nof_idle - nof_fast_start);
+  nof_samples += nof_idle;
+  last_tti = tti - 1;
 }
 
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void sched_time_pf::ue_rate::save_alloc(uint64_t tti, uint32_t alloc_bytes, float alpha)
 {
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
+  apply_idle_ttis(tti, alpha);
+  if (is_fast_start(alpha)) {
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
   } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    avg_rate = (1 - alpha) * avg_rate + (alpha)*alloc_bytes;
   }
-  ul_nof_samples++;
+  nof_samples++;
+  last_tti = tti;
 }
 
 bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
                                                    const sched_time_pf::ue_ctxt* rhs) const
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  return (not lhs->dl_retx and rhs->dl_retx) or (lhs->dl_retx == rhs->dl_retx and lhs->dl_prio < rhs->dl_prio);
 }
 
 bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
                                                    const sched_time_pf::ue_ctxt* rhs) const
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  return (not lhs->ul_retx and rhs->ul_retx) or (lhs->ul_retx == rhs->ul_retx and lhs->ul_prio < rhs->ul_prio);
+}
+
+/*****************************************************************
+ *                       UE priority queue
+ *****************************************************************/
+
+template <int sched_time_pf::ue_ctxt::*HeapPos, typename Compare>
+void sched_time_pf::ue_heap<HeapPos, Compare>::push_or_update(ue_ctxt& u)
+{
+  if (u.*HeapPos < 0) {
+    heap.push_back(&u);
+    u.*HeapPos = heap.size() - 1;
+  }
+  place(u.*HeapPos);
 }
 
+template <int sched_time_pf::ue_ctxt::*HeapPos, typename Compare>
+void sched_time_pf::ue_heap<HeapPos, Compare>::erase(ue_ctxt& u)
+{
+  if (u.*HeapPos < 0) {
+    return;
+  }
+  size_t pos = u.*HeapPos;
+  u.*HeapPos = -1;
+  ue_ctxt* last = heap.back();
+  heap.pop_back();
+  if (pos < heap.size()) {
+    set(pos, last);
+    place(pos);
+  }
+}
+
+/// Moves the user at position "pos" up or down the heap, until the heap property is restored
+template <int sched_time_pf::ue_ctxt::*HeapPos, typename Compare>
+void sched_time_pf::ue_heap<HeapPos, Compare>::place(size_t pos)
+{
+  Compare  comp;
+  ue_ctxt* u = heap[pos];
+  while (pos > 0 and comp(heap[(pos - 1) / 2], u)) {
+    set(pos, heap[(pos - 1) / 2]);
+    pos = (pos - 1) / 2;
+  }
+  for (size_t child = 2 * pos + 1; child < heap.size(); child = 2 * pos + 1) {
+    if (child + 1 < heap.size() and comp(heap[child], heap[child + 1])) {
+      child++;
+    }
+    if (not comp(u, heap[child])) {
+      break;
+    }
+    set(pos, heap[child]);
+    pos = child;
+  }
+  set(pos, u);
+}
+
+template class sched_time_pf::ue_heap<&sched_time_pf::ue_ctxt::dl_heap_pos, sched_time_pf::ue_dl_prio_compare>;
+template class sched_time_pf::ue_heap<&sched_time_pf::ue_ctxt::ul_heap_pos, sched_time_pf::ue_ul_prio_compare>;
+
 } // namespace srsenb
@@ -32,42 +32,139 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(softbuffer_cb_pool& tx_pool,
+                                     softbuffer_cb_pool& rx_pool,
+                                     uint32_t            nof_prb,
+                                     uint32_t            nof_tx_harq_proc_,
+                                     uint32_t            nof_rx_harq_proc_) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
-  // Create and init Rx buffers
-  softbuffer_rx_list.resize(nof_rx_harq_proc);
-  for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+  uint32_t max_cb = max_nof_cb(nof_prb);
+
+  // Create Rx buffers
+  softbuffer_rx_list.reserve(nof_rx_harq_proc);
+  for (uint32_t i = 0; i < nof_rx_harq_proc; ++i) {
+    softbuffer_rx_list.emplace_back(rx_pool, max_cb);
   }
 
-  // Create and init Tx buffers
-  softbuffer_tx_list.resize(nof_tx_harq_proc * SRSRAN_MAX_TB);
-  for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_init(&buffer, nof_prb);
+  // Create Tx buffers
+  softbuffer_tx_list.reserve(nof_tx_harq_proc * SRSRAN_MAX_TB);
+  for (uint32_t i = 0; i < nof_tx_harq_proc * SRSRAN_MAX_TB; ++i) {
+    softbuffer_tx_list.emplace_back(tx_pool, max_cb);
   }
 }
 
-ue_cc_softbuffers::~ue_cc_softbuffers()
+void ue_cc_softbuffers::clear()
 {
+  std::lock_guard<std::mutex> lock(mutex);
   for (auto& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_free(&buffer);
+    buffer.buffer.release();
   }
-  softbuffer_rx_list.clear();
-
   for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_free(&buffer);
+    buffer.buffer.release();
   }
-  softbuffer_tx_list.clear();
 }
 
-void ue_cc_softbuffers::clear()
+uint32_t ue_cc_softbuffers::max_nof_cb(uint32_t nof_prb)
 {
-  for (auto& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_reset(&buffer);
+  int max_tbs = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  return max_tbs < 0 ? 0 : (uint32_t)max_tbs / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+}
+
+static uint32_t nof_codeblocks(uint32_t tbs)
+{
+  srsran_cbsegm_t cbsegm = {};
+  if (srsran_cbsegm(&cbsegm, tbs * 8) != SRSRAN_SUCCESS) {
+    return 0;
   }
-  for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_reset(&buffer);
+  return cbsegm.C;
+}
+
+srsran_softbuffer_tx_t* ue_cc_softbuffers::get_tx(uint32_t  pid,
+                                                  uint32_t  tb_idx,
+                                                  tti_point tti_tx_dl,
+                                                  uint32_t  ack_delay,
+                                                  uint32_t  tbs,
+                                                  bool      new_tx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  tx_softbuffer_t&            softbuffer = softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
+
+  // Disabled TBs are not encoded by the PHY
+  if (tbs == 0) {
+    return softbuffer.buffer.get();
+  }
+  if (new_tx) {
+    uint32_t nof_cb = nof_codeblocks(tbs);
+    if (nof_cb == 0 or not softbuffer.buffer.bind(nof_cb)) {
+      return nullptr;
+    }
+    softbuffer.nof_tx = 0;
+  } else if (not softbuffer.buffer.is_bound()) {
+    // The TB content was lost together with its code blocks
+    return nullptr;
+  }
+  softbuffer.tti_tx      = tti_tx_dl;
+  softbuffer.tti_ack     = tti_tx_dl + ack_delay;
+  softbuffer.ack_pending = true;
+  softbuffer.nof_tx++;
+  return softbuffer.buffer.get();
+}
+
+srsran_softbuffer_rx_t* ue_cc_softbuffers::get_rx(tti_point tti_rx, uint32_t tbs, bool new_tx, uint32_t max_nof_tx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  rx_softbuffer_t&            softbuffer = softbuffer_rx_list.at(tti_rx.to_uint() % nof_rx_harq_proc);
+
+  // Retransmissions of TBs whose code blocks were returned are decoded without soft combining
+  if (new_tx or not softbuffer.buffer.is_bound()) {
+    uint32_t nof_cb = nof_codeblocks(tbs);
+    if (nof_cb == 0 or not softbuffer.buffer.bind(nof_cb)) {
+      return nullptr;
+    }
+    softbuffer.nof_tx     = 0;
+    softbuffer.max_nof_tx = max_nof_tx;
+  }
+  softbuffer.nof_tx++;
+  return softbuffer.buffer.get();
+}
+
+void ue_cc_softbuffers::release_tx(uint32_t pid, uint32_t tb_idx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  tx_softbuffer_t&            softbuffer = softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
+  softbuffer.buffer.release();
+  softbuffer.ack_pending = false;
+}
+
+void ue_cc_softbuffers::tx_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack, uint32_t max_nof_tx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  // In TDD, the HARQ-ACKs of several transmissions may be received in the same TTI. They are matched to the
+  // transmissions in the order these were sent
+  tx_softbuffer_t* acked = nullptr;
+  for (uint32_t pid = 0; pid < nof_tx_harq_proc; ++pid) {
+    tx_softbuffer_t& softbuffer = softbuffer_tx_list[pid * SRSRAN_MAX_TB + tb_idx];
+    if (softbuffer.buffer.is_bound() and softbuffer.ack_pending and softbuffer.tti_ack == tti_rx and
+        (acked == nullptr or softbuffer.tti_tx < acked->tti_tx)) {
+      acked = &softbuffer;
+    }
+  }
+  if (acked == nullptr) {
+    return;
+  }
+  acked->ack_pending = false;
+  if (ack or acked->nof_tx >= max_nof_tx) {
+    acked->buffer.release();
+  }
+}
+
+void ue_cc_softbuffers::rx_crc_info(tti_point tti_rx, bool crc)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  rx_softbuffer_t&            softbuffer = softbuffer_rx_list.at(tti_rx.to_uint() % nof_rx_harq_proc);
+  if (crc or softbuffer.nof_tx >= softbuffer.max_nof_tx) {
+    softbuffer.buffer.release();
   }
 }
 
@@ -186,6 +283,7 @@ void cc_buffer_handler::reset()
 
 ue::ue(uint16_t                                 rnti_,
        uint32_t                                 enb_cc_idx,
+       uint32_t                                 max_msg3_tx_,
        sched_interface*                         sched_,
        rrc_interface_mac*                       rrc_,
        rlc_interface_mac*                       rlc_,
@@ -201,9 +299,10 @@ ue::ue(uint16_t                                 rnti_,
   logger(logger_),
   mac_msg_dl(20, logger_),
   mch_mac_msg_dl(10, logger_),
-  mac_msg_ul(20, logger_),
+  mac_msg_ul(MAX_UL_SUBHEADERS, logger_),
   ta_fsm(this),
   softbuffer_pool(softbuffer_pool_),
+  max_msg3_tx(max_msg3_tx_),
   cc_buffers(nof_cells_)
 {
   // Allocate buffer for PCell
@@ -237,6 +336,7 @@ void ue::start_pcap(srsran::mac_pcap* pcap_)
 
 void ue::ue_cfg(const sched_interface::ue_cfg_t& ue_cfg)
 {
+  max_harq_tx = ue_cfg.maxharq_tx;
   for (const auto& ue_cc : ue_cfg.supported_cc_list) {
     // Allocate and initialize Rx/Tx softbuffers for new carriers (exclude PCell)
     if (ue_cc.active and cc_buffers[ue_cc.enb_cc_idx].empty()) {
@@ -245,24 +345,55 @@ void ue::ue_cfg(const sched_interface::ue_cfg_t& ue_cfg)
   }
 }
 
-srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti)
+srsran_softbuffer_rx_t*
+ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, bool new_tx, bool is_msg3)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
 
-  return &cc_buffers[enb_cc_idx].get_rx_softbuffer(tti);
+  // Msg3 is retransmitted up to maxharq_msg3tx times, before the UE is configured with maxharq_tx
+  uint32_t max_nof_tx = is_msg3 ? max_msg3_tx : max_harq_tx.load();
+  return cc_buffers[enb_cc_idx].get_softbuffers().get_rx(tti_point{tti}, tbs, new_tx, max_nof_tx);
 }
 
-srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
+srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx,
+                                              uint32_t harq_process,
+                                              uint32_t tb_idx,
+                                              uint32_t tti_tx_dl,
+                                              uint32_t ack_delay,
+                                              uint32_t tbs,
+                                              bool     new_tx)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
 
-  return &cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
+  return cc_buffers[enb_cc_idx].get_softbuffers().get_tx(
+      harq_process, tb_idx, tti_point{tti_tx_dl}, ack_delay, tbs, new_tx);
+}
+
+void ue::release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].get_softbuffers().release_tx(harq_process, tb_idx);
+  }
+}
+
+void ue::tx_softbuffer_ack_info(uint32_t enb_cc_idx, uint32_t tti_rx, uint32_t tb_idx, bool ack)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].get_softbuffers().tx_ack_info(tti_point{tti_rx}, tb_idx, ack, max_harq_tx);
+  }
+}
+
+void ue::rx_softbuffer_crc_info(uint32_t enb_cc_idx, uint32_t tti_rx, bool crc)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].get_softbuffers().rx_crc_info(tti_point{tti_rx}, crc);
+  }
 }
 
 uint8_t* ue::request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len)
@@ -323,6 +454,7 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
   uint32_t lcid_most_data = 0;
   int      most_data      = -99;
 
+  ul_rlc_pdus.clear();
   while (mac_msg_ul.next()) {
     assert(mac_msg_ul.get());
     if (mac_msg_ul.get()->is_sdu()) {
@@ -343,10 +475,8 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
       }
 
       if (route_pdu) {
-        rlc->write_pdu(rnti,
-                       mac_msg_ul.get()->get_sdu_lcid(),
-                       mac_msg_ul.get()->get_sdu_ptr(),
-                       mac_msg_ul.get()->get_payload_size());
+        ul_rlc_pdus.push_back(
+            {mac_msg_ul.get()->get_sdu_lcid(), mac_msg_ul.get()->get_sdu_ptr(), mac_msg_ul.get()->get_payload_size()});
       }
 
       // Indicate scheduler to update BSR counters
@@ -380,6 +510,11 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
   }
   mac_msg_ul.reset();
 
+  // Deliver all SDUs to RLC in a single call
+  if (not ul_rlc_pdus.empty()) {
+    rlc->write_pdus(rnti, ul_rlc_pdus);
+  }
+
   /* Process CE after all SDUs because we need to update BSR after */
   bool bsr_received = false;
   while (mac_msg_ul.next()) {
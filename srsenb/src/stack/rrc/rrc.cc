@@ -768,6 +768,11 @@ void rrc::config_mac()
     // Copy base cell configuration
     item.cell    = cfg.cell;
     item.cell.id = cfg.cell_list[ccidx].pci;
+    if (cfg.sib1.tdd_cfg_present) {
+      item.tdd_config.configured = true;
+      item.tdd_config.sf_config  = cfg.sib1.tdd_cfg.sf_assign.to_number();
+      item.tdd_config.ss_config  = cfg.sib1.tdd_cfg.special_sf_patterns.to_number();
+    }
 
     // copy secondary cell list info
     sched_cfg[ccidx].scell_list.reserve(cfg.cell_list[ccidx].scell_list.size());
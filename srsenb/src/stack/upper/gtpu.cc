@@ -59,8 +59,7 @@ const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t tei
 
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
-  auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return ue_teidin_db.find(rnti);
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -99,22 +98,19 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
   tun->teid_out      = teidout;
   tun->spgw_addr     = spgw_addr;
 
-  if (ue_teidin_db.find(rnti) == ue_teidin_db.end()) {
-    auto ret = ue_teidin_db.emplace(rnti, ue_bearer_tunnel_list());
-    if (!ret.second) {
-      logger.error("Failed to allocate rnti=0x%x", rnti);
-      return nullptr;
-    }
+  ue_bearer_tunnel_list* ue_tunnels = find_rnti_tunnels(rnti);
+  if (ue_tunnels == nullptr) {
+    ue_teidin_db.insert(rnti, ue_bearer_tunnel_list{});
+    ue_tunnels = find_rnti_tunnels(rnti);
   }
-  auto& ue_tunnels = ue_teidin_db[rnti];
 
-  if (ue_tunnels.full()) {
+  if (ue_tunnels->full()) {
     logger.error("The number of TEIDs per UE exceeded for rnti=0x%x", rnti);
     tunnels.erase(tun->teid_in);
     return nullptr;
   }
-  ue_tunnels.push_back(bearer_teid_pair{eps_bearer_id, tun->teid_in});
-  std::sort(ue_tunnels.begin(), ue_tunnels.end());
+  ue_tunnels->push_back(bearer_teid_pair{eps_bearer_id, tun->teid_in});
+  std::sort(ue_tunnels->begin(), ue_tunnels->end());
 
   fmt::memory_buffer str_buffer;
   srsran::gtpu_ntoa(str_buffer, htonl(spgw_addr));
@@ -139,13 +135,15 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
   }
   logger.info("Modifying bearer rnti. Old rnti: 0x%x, new rnti: 0x%x", old_rnti, new_rnti);
 
-  // create new RNTI and update TEIDs of old rnti to reflect new rnti
-  if (new_rnti_ptr == nullptr and not ue_teidin_db.insert({new_rnti, ue_bearer_tunnel_list()}).second) {
-    logger.error("Failure to create new rnti=0x%x", new_rnti);
-    return false;
+  // create new RNTI and update TEIDs of old rnti to reflect new rnti. The insertion may move the old rnti entry
+  if (new_rnti_ptr == nullptr) {
+    ue_teidin_db.insert(new_rnti, ue_bearer_tunnel_list{});
+    new_rnti_ptr = find_rnti_tunnels(new_rnti);
+    old_rnti_ptr = find_rnti_tunnels(old_rnti);
   }
-  std::swap(ue_teidin_db[new_rnti], *old_rnti_ptr);
-  ue_bearer_tunnel_list&                               new_rnti_obj = ue_teidin_db[new_rnti];
+  srsran_assert(new_rnti_ptr != nullptr and old_rnti_ptr != nullptr, "rnti=0x%x not found after insertion", new_rnti);
+  ue_bearer_tunnel_list& new_rnti_obj = *new_rnti_ptr;
+  std::swap(new_rnti_obj, *old_rnti_ptr);
   srsran::bounded_vector<uint32_t, MAX_TUNNELS_PER_UE> to_remove;
   for (bearer_teid_pair& bearer : new_rnti_obj) {
     tunnels[bearer.teid].rnti = new_rnti;
@@ -180,11 +178,13 @@ bool gtpu_tunnel_manager::remove_tunnel(uint32_t teidin)
   deactivate_tunnel(teidin);
 
   // erase keeping the relative order
-  auto& ue        = ue_teidin_db[tun.rnti];
-  auto  bearer_it = std::lower_bound(ue.begin(), ue.end(), bearer_teid_pair{tun.eps_bearer_id, tun.teid_in});
-  srsran_assert(bearer_it->teid == tun.teid_in and bearer_it->eps_bearer_id == tun.eps_bearer_id,
+  ue_bearer_tunnel_list* ue = find_rnti_tunnels(tun.rnti);
+  srsran_assert(ue != nullptr, "rnti=0x%x of " TEID_IN_FMT " not found", tun.rnti, teidin);
+  auto bearer_it = std::lower_bound(ue->begin(), ue->end(), bearer_teid_pair{tun.eps_bearer_id, tun.teid_in});
+  srsran_assert(bearer_it != ue->end() and bearer_it->teid == tun.teid_in and
+                    bearer_it->eps_bearer_id == tun.eps_bearer_id,
                 "TEID in undefined state");
-  ue.erase(bearer_it);
+  ue->erase(bearer_it);
 
   logger.info("Removed rnti=0x%x,eps-BearerID=%d tunnel with " TEID_IN_FMT, tun.rnti, tun.eps_bearer_id, teidin);
   tunnels.erase(teidin);
@@ -193,15 +193,16 @@ bool gtpu_tunnel_manager::remove_tunnel(uint32_t teidin)
 
 bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 {
-  auto it = ue_teidin_db.find(rnti);
-  if (it == ue_teidin_db.end()) {
+  ue_bearer_tunnel_list* ue = find_rnti_tunnels(rnti);
+  if (ue == nullptr) {
     logger.warning("Removing rnti. rnti=0x%x not found.", rnti);
     return false;
   }
   logger.info("Removing rnti=0x%x", rnti);
 
-  while (not ue_teidin_db[rnti].empty()) {
-    uint32_t teid = ue_teidin_db[rnti].front().teid;
+  // Removing the tunnels does not insert in ue_teidin_db, so the rnti entry stays in place
+  while (not ue->empty()) {
+    uint32_t teid = ue->front().teid;
     bool     ret  = remove_tunnel(teid);
     srsran_expect(
         ret, "Inconsistency detected between internal data structures for rnti=0x%x," TEID_IN_FMT, rnti, teid);
@@ -365,7 +366,8 @@ gtpu::gtpu(srsran::task_sched_handle   task_sched_,
   task_sched(task_sched_),
   logger(logger),
   tunnels(task_sched_, logger),
-  rx_socket_handler(rx_socket_handler_)
+  rx_socket_handler(rx_socket_handler_),
+  tx_batch(logger)
 {
   gtpu_queue = task_sched.make_task_queue();
 }
@@ -410,12 +412,13 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
     srsran::console("Failed to bind on address %s, port %d: %s\n", gtp_bind_addr.c_str(), int(GTPU_PORT), errbuf);
     return SRSRAN_ERROR;
   }
+  tx_batch.set_fd(fd);
 
   // Assign a handler to rx S1U packets
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
     handle_gtpu_s1u_rx_packet(std::move(pdu), from);
   };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback, &rx_batches));
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
@@ -429,6 +432,7 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 void gtpu::stop()
 {
   if (fd > 0) {
+    tx_batch.flush();
     close(fd);
     fd = -1;
   }
@@ -481,11 +485,25 @@ void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buf
     logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
     return;
   }
-  if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
-    perror("sendto");
+  if (tx_batch.empty()) {
+    task_sched.defer_task([this]() { flush_tx_batch(); });
+  }
+  tx_batch.push(std::move(pdu), servaddr);
+}
+
+void gtpu::flush_tx_batch()
+{
+  if (fd > 0) {
+    tx_batch.flush();
   }
 }
 
+void gtpu::get_metrics(gtpu_metrics_t& m)
+{
+  rx_batches.get_metrics(m.rx);
+  tx_batch.get_counter().get_metrics(m.tx);
+}
+
 srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
                                             uint32_t            eps_bearer_id,
                                             uint32_t            addr_out,
@@ -830,6 +848,8 @@ bool gtpu::send_end_marker(uint32_t teidin)
   servaddr.sin_addr.s_addr    = htonl(tx_tun->spgw_addr);
   servaddr.sin_port           = htons(GTPU_PORT);
 
+  // The end marker follows the data PDUs of the tunnel that are waiting in the batch
+  flush_tx_batch();
   bool success =
       sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) > 0;
   if (success) {
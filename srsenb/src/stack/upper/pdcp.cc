@@ -31,11 +31,18 @@ pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_)
   task_sched(task_sched_), logger(logger_)
 {}
 
-void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
+void pdcp::init(rlc_interface_pdcp*  rlc_,
+                rrc_interface_pdcp*  rrc_,
+                gtpu_interface_pdcp* gtpu_,
+                uint32_t             nof_security_workers)
 {
   rlc  = rlc_;
   rrc  = rrc_;
   gtpu = gtpu_;
+
+  if (nof_security_workers > 0) {
+    security_pool.reset(new srsran::pdcp_security_pool(task_sched, nof_security_workers));
+  }
 }
 
 void pdcp::stop()
@@ -44,6 +51,9 @@ void pdcp::stop()
     clear_user(&iter->second);
   }
   users.clear();
+  if (security_pool != nullptr) {
+    security_pool->stop();
+  }
 }
 
 void pdcp::add_user(uint16_t rnti)
@@ -51,6 +61,7 @@ void pdcp::add_user(uint16_t rnti)
   if (users.count(rnti) == 0) {
     unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
     obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
+    obj->set_security_pool(security_pool.get());
     users[rnti].rlc_itf.rnti  = rnti;
     users[rnti].gtpu_itf.rnti = rnti;
     users[rnti].rrc_itf.rnti  = rnti;
@@ -27,10 +27,86 @@
 
 namespace srsenb {
 
-void rlc::init(pdcp_interface_rlc*    pdcp_,
-               rrc_interface_rlc*     rrc_,
-               mac_interface_rlc*     mac_,
-               srsran::timer_handler* timers_)
+/****************************************************************************
+ * RLC workers
+ ***************************************************************************/
+rlc::worker_t::worker_t(rlc* parent_, uint32_t idx) :
+  thread("RLC" + std::to_string(idx)), pending_jobs(worker_queue_size), parent(parent_)
+{}
+
+void rlc::worker_t::stop()
+{
+  if (not pending_jobs.is_stopped()) {
+    {
+      std::lock_guard<std::mutex> lock(deferred_mutex);
+      stopping = true;
+    }
+    deferred_cvar.notify_one();
+    pending_jobs.stop();
+    wait_thread_finish();
+  }
+}
+
+void rlc::worker_t::run_thread()
+{
+  while (true) {
+    {
+      // The deferred SDUs hold pool buffers. The next job waits for the stack thread to catch up, which leaves the
+      // following PDUs to be dropped by the MAC when the job queue fills up
+      std::unique_lock<std::mutex> lock(deferred_mutex);
+      deferred_cvar.wait(lock, [this]() { return stopping or deferred_tasks.size() < max_deferred_tasks; });
+    }
+    bool          success;
+    rx_pdus_job_t job = pending_jobs.pop_blocking(&success);
+    if (not success) {
+      break;
+    }
+    parent->write_user_pdus(job.rnti, job.pdus);
+  }
+}
+
+void rlc::worker_t::defer_to_stack(srsran::move_task_t task)
+{
+  bool notify;
+  {
+    std::lock_guard<std::mutex> lock(deferred_mutex);
+    notify = deferred_tasks.empty();
+    deferred_tasks.push_back(std::move(task));
+  }
+  // Only the first task since the last run needs a notification, the stack thread runs all the deferred tasks
+  if (notify) {
+    stack_queue.push([this]() { run_deferred_tasks(); });
+  }
+}
+
+void rlc::worker_t::run_deferred_tasks()
+{
+  std::vector<srsran::move_task_t> tasks;
+  {
+    std::lock_guard<std::mutex> lock(deferred_mutex);
+    tasks.swap(deferred_tasks);
+  }
+  deferred_cvar.notify_one();
+  for (srsran::move_task_t& task : tasks) {
+    task();
+  }
+  // Keep the allocated vector for the next tasks, unless new tasks were deferred in the meantime
+  tasks.clear();
+  std::lock_guard<std::mutex> lock(deferred_mutex);
+  if (deferred_tasks.empty()) {
+    deferred_tasks.swap(tasks);
+  }
+}
+
+/****************************************************************************
+ * RLC
+ ***************************************************************************/
+void rlc::init(pdcp_interface_rlc*       pdcp_,
+               rrc_interface_rlc*        rrc_,
+               mac_interface_rlc*        mac_,
+               srsran::timer_handler*    timers_,
+               srsran::task_sched_handle task_sched_,
+               uint32_t                  nof_workers)
 {
   pdcp   = pdcp_;
   rrc    = rrc_;
@@ -38,10 +114,24 @@ void rlc::init(pdcp_interface_rlc*    pdcp_,
   timers = timers_;
 
   pthread_rwlock_init(&rwlock, nullptr);
+
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new worker_t(this, i));
+    workers.back()->stack_queue = task_sched_.make_task_queue();
+    workers.back()->start();
+  }
+  if (nof_workers > 0) {
+    logger.info("Started %d RLC workers", nof_workers);
+  }
 }
 
 void rlc::stop()
 {
+  // The workers are kept until the destruction of the RLC, for the tasks they deferred to the stack thread
+  for (auto& w : workers) {
+    w->stop();
+  }
+
   pthread_rwlock_wrlock(&rwlock);
   for (auto& user : users) {
     user.second.rlc->stop();
@@ -78,6 +168,9 @@ void rlc::add_user(uint16_t rnti)
     users[rnti].rrc    = rrc;
     users[rnti].rlc    = std::move(obj);
     users[rnti].parent = this;
+    if (not workers.empty()) {
+      users[rnti].worker = workers[rnti % workers.size()].get();
+    }
   }
   pthread_rwlock_unlock(&rwlock);
 }
@@ -222,6 +315,12 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
 
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  if (not workers.empty()) {
+    srsran::rlc_pdu_ref_t pdu = {lcid, payload, nof_bytes};
+    push_pdus(rnti, srsran::span<const srsran::rlc_pdu_ref_t>(&pdu, 1));
+    return;
+  }
+
   pthread_rwlock_rdlock(&rwlock);
   if (users.count(rnti)) {
     users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
@@ -229,6 +328,64 @@ void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof
   pthread_rwlock_unlock(&rwlock);
 }
 
+void rlc::write_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus)
+{
+  if (not workers.empty()) {
+    push_pdus(rnti, pdus);
+    return;
+  }
+  write_user_pdus(rnti, pdus);
+}
+
+// The payload of the PDUs belongs to the MAC, so the PDUs are copied before leaving them to the worker of the UE
+void rlc::push_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus)
+{
+  const uint32_t max_job_bytes = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t       worker_idx    = rnti % workers.size();
+
+  size_t i = 0;
+  while (i < pdus.size()) {
+    size_t   end       = i;
+    uint32_t nof_bytes = 0;
+    for (; end < pdus.size() and end - i < max_pdus_per_job and nof_bytes + pdus[end].nof_bytes <= max_job_bytes;
+         ++end) {
+      nof_bytes += pdus[end].nof_bytes;
+    }
+    if (end == i) {
+      logger.warning("Dropping RLC PDU of rnti=0x%x with %d bytes, too big for a buffer", rnti, pdus[i].nof_bytes);
+      i++;
+      continue;
+    }
+
+    rx_pdus_job_t job;
+    job.rnti = rnti;
+    job.buf  = srsran::make_byte_buffer_with_tailroom(nof_bytes);
+    if (job.buf == nullptr) {
+      logger.warning("Dropping %zd RLC PDUs of rnti=0x%x, no buffers available", end - i, rnti);
+      return;
+    }
+    for (; i < end; ++i) {
+      uint8_t* payload = job.buf->msg + job.buf->N_bytes;
+      memcpy(payload, pdus[i].payload, pdus[i].nof_bytes);
+      job.buf->N_bytes += pdus[i].nof_bytes;
+      job.pdus.push_back({pdus[i].lcid, payload, pdus[i].nof_bytes});
+    }
+    if (workers[worker_idx]->pending_jobs.try_push(std::move(job)).is_error()) {
+      logger.warning("Dropping RLC PDUs of rnti=0x%x, the queue of RLC worker %d is full", rnti, worker_idx);
+    }
+  }
+}
+
+void rlc::write_user_pdus(uint16_t rnti, srsran::span<const srsran::rlc_pdu_ref_t> pdus)
+{
+  pthread_rwlock_rdlock(&rwlock);
+  auto user_it = users.find(rnti);
+  if (user_it != users.end()) {
+    user_it->second.rlc->write_pdus(pdus);
+  }
+  pthread_rwlock_unlock(&rwlock);
+}
+
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
   pthread_rwlock_rdlock(&rwlock);
@@ -275,15 +432,27 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 
 void rlc::user_interface::max_retx_attempted()
 {
+  if (worker != nullptr) {
+    worker->defer_to_stack([rrc = rrc, rnti = rnti]() { rrc->max_retx_attempted(rnti); });
+    return;
+  }
   rrc->max_retx_attempted(rnti);
 }
 
 void rlc::user_interface::protocol_failure()
 {
+  if (worker != nullptr) {
+    worker->defer_to_stack([rrc = rrc, rnti = rnti]() { rrc->protocol_failure(rnti); });
+    return;
+  }
   rrc->protocol_failure(rnti);
 }
 
-void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
+static void deliver_sdu(srsenb::pdcp_interface_rlc*  pdcp,
+                        srsenb::rrc_interface_rlc*   rrc,
+                        uint16_t                     rnti,
+                        uint32_t                     lcid,
+                        srsran::unique_byte_buffer_t sdu)
 {
   if (lcid == srb_to_lcid(lte_srb::srb0)) {
     rrc->write_pdu(rnti, lcid, std::move(sdu));
@@ -292,13 +461,34 @@ void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t
   }
 }
 
+void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
+{
+  if (worker != nullptr) {
+    worker->defer_to_stack([pdcp = pdcp, rrc = rrc, rnti = rnti, lcid, sdu = std::move(sdu)]() mutable {
+      deliver_sdu(pdcp, rrc, rnti, lcid, std::move(sdu));
+    });
+    return;
+  }
+  deliver_sdu(pdcp, rrc, rnti, lcid, std::move(sdu));
+}
+
 void rlc::user_interface::notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  if (worker != nullptr) {
+    worker->defer_to_stack(
+        [pdcp = pdcp, rnti = rnti, lcid, pdcp_sns]() { pdcp->notify_delivery(rnti, lcid, pdcp_sns); });
+    return;
+  }
   pdcp->notify_delivery(rnti, lcid, pdcp_sns);
 }
 
 void rlc::user_interface::notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  if (worker != nullptr) {
+    worker->defer_to_stack(
+        [pdcp = pdcp, rnti = rnti, lcid, pdcp_sns]() { pdcp->notify_failure(rnti, lcid, pdcp_sns); });
+    return;
+  }
   pdcp->notify_failure(rnti, lcid, pdcp_sns);
 }
 
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/metrics_csv.h"
+#include "srsenb/hdr/metrics_json.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
@@ -66,6 +67,32 @@ public:
     metrics[0].phy[0].ul.mcs        = 20.2;
     metrics[0].phy[0].ul.pucch_sinr = 14.2;
     metrics[0].phy[0].ul.pusch_sinr = 14.2;
+    metrics[0].stack.mac.sched_events.nof_events      = 120;
+    metrics[0].stack.mac.sched_events.nof_overflows   = 3;
+    metrics[0].stack.mac.sched_events.max_queue_depth = 40;
+    metrics[0].stack.mac.sched_events.avg_latency_us  = 85.2;
+    metrics[0].stack.mac.sched_events.max_latency_us  = 950.7;
+    metrics[0].stack.mac.cc_info.resize(1);
+    metrics[0].stack.mac.dl_softbuffers.nof_cbs      = 1024;
+    metrics[0].stack.mac.dl_softbuffers.nof_used_cbs = 300;
+    metrics[0].stack.mac.dl_softbuffers.max_used_cbs = 1024;
+    metrics[0].stack.mac.dl_softbuffers.nof_failures = 2;
+    metrics[0].stack.mac.ul_softbuffers.nof_cbs      = 1024;
+    metrics[0].stack.mac.ul_softbuffers.nof_used_cbs = 100;
+    metrics[0].stack.mac.ul_softbuffers.max_used_cbs = 200;
+    metrics[0].stack.buffer_pools.small.nof_buffers      = 4096;
+    metrics[0].stack.buffer_pools.small.nof_used_buffers = 4096;
+    metrics[0].stack.buffer_pools.small.max_used_buffers = 4096;
+    metrics[0].stack.buffer_pools.small.nof_failures     = 10;
+    metrics[0].stack.buffer_pools.large.nof_buffers      = 1024;
+    metrics[0].stack.buffer_pools.large.nof_used_buffers = 12;
+    metrics[0].stack.buffer_pools.large.max_used_buffers = 40;
+    metrics[0].stack.gtpu.rx.nof_calls   = 100;
+    metrics[0].stack.gtpu.rx.nof_packets = 1600;
+    metrics[0].stack.gtpu.rx.max_batch   = 32;
+    metrics[0].stack.gtpu.tx.nof_calls   = 200;
+    metrics[0].stack.gtpu.tx.nof_packets = 400;
+    metrics[0].stack.gtpu.tx.max_batch   = 4;
 
     metrics[0].rf.rf_o = 10;
     metrics[0].nr_stack.mac.ues.resize(1);
@@ -212,11 +239,19 @@ int main(int argc, char** argv)
   // the CSV file writer
   metrics_csv metrics_file(csv_file_name, &enb);
 
+  // the JSON file writer
+  srslog::sink& json_sink =
+      srslog::fetch_file_sink(std::string(csv_file_name) + ".json", 0, false, srslog::create_json_formatter());
+  srslog::log_channel& json_channel = srslog::fetch_log_channel("JSON_channel", json_sink, {});
+  metrics_json         metrics_json_file(json_channel, &enb);
+  srslog::init();
+
   // create metrics hub and register metrics for stdout
   srsran::metrics_hub<enb_metrics_t> metricshub;
   metricshub.init(&enb, period);
   metricshub.add_listener(&metrics_screen);
   metricshub.add_listener(&metrics_file);
+  metricshub.add_listener(&metrics_json_file);
 
   // enable printing
   metrics_screen.toggle_print(true);
@@ -225,5 +260,6 @@ int main(int argc, char** argv)
   usleep(4e6);
 
   metricshub.stop();
+  srslog::flush();
   return 0;
 }
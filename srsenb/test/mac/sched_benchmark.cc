@@ -20,7 +20,9 @@
  */
 
 #include "sched_test_common.h"
+#include "sched_traffic_models.h"
 #include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
@@ -92,6 +94,7 @@ public:
     srsran::rolling_average<float>  mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
     srsran::rolling_average<double> avg_latency;
     std::vector<uint32_t>           latency_samples;
+    std::vector<uint32_t>           tti_latency_samples; ///< sum of the dl_sched+ul_sched latencies of all carriers
   };
   throughput_stats total_stats;
 
@@ -101,6 +104,7 @@ public:
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    std::chrono::nanoseconds tti_dur{0};
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
       std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
@@ -109,7 +113,9 @@ public:
       std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
       total_stats.avg_latency.push(tdur.count());
       total_stats.latency_samples.push_back(tdur.count());
+      tti_dur += tdur;
     }
+    total_stats.tti_latency_samples.push_back(tti_dur.count());
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -394,6 +400,411 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/*****************************************
+ *       PDCCH allocation benchmark
+ ****************************************/
+
+struct pdcch_run_data {
+  uint32_t                  nof_prbs;
+  uint32_t                  nof_ues;
+  float                     success_rate;  ///< ratio of DCI allocation attempts that succeeded
+  float                     avg_nof_dcis;  ///< average number of DCIs allocated per TTI
+  float                     avg_cfi;       ///< average CFI
+  float                     avg_cce_usage; ///< average ratio of used CCEs
+  std::chrono::microseconds avg_latency;
+  std::chrono::microseconds q0_9_latency;
+};
+
+/// Allocates one DL and one UL DCI for each UE, in random order, with an aggregation level derived from a random CQI
+int run_pdcch_scenario(uint32_t nof_prbs, uint32_t nof_ues, uint32_t nof_ttis, std::vector<pdcch_run_data>& results)
+{
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::cell_cfg_t      cell_cfg   = generate_default_cell_cfg(nof_prbs);
+  sched_interface::ue_cfg_t        ue_cfg     = generate_default_ue_cfg();
+  sched_interface::sched_args_t    sched_args = {};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+  std::vector<uint32_t> ue_order(nof_ues), aggr_idxs(nof_ues);
+  std::iota(ue_order.begin(), ue_order.end(), 0);
+
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[0]);
+
+  srsran::rolling_average<float>  nof_dcis, cfi, cce_usage;
+  srsran::rolling_average<double> avg_latency;
+  std::vector<uint32_t>           latency_samples;
+  latency_samples.reserve(nof_ttis);
+  uint32_t nof_attempts = 0, nof_success = 0;
+
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     pdcch_mask;
+  for (uint32_t count = 0; count < nof_ttis; ++count) {
+    tti_point tti_rx{count};
+    if (count % 5 == 0) {
+      for (auto& u : ues) {
+        u->set_dl_cqi(tti_rx, 0, std::uniform_int_distribution<uint32_t>{1, 15}(get_rand_gen()));
+      }
+    }
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      uint32_t nof_bits = srsran_dci_format_sizeof(&cell_cfg.cell, nullptr, nullptr, ues[i]->get_dci_format());
+      aggr_idxs[i]      = ues[i]->get_aggr_level(0, nof_bits);
+    }
+    std::shuffle(ue_order.begin(), ue_order.end(), get_rand_gen());
+
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+    pdcch.new_tti(tti_rx);
+    for (uint32_t ue_idx : ue_order) {
+      nof_success += pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idxs[ue_idx], ues[ue_idx].get(), false) ? 1 : 0;
+      nof_success += pdcch.alloc_dci(alloc_type_t::UL_DATA, aggr_idxs[ue_idx], ues[ue_idx].get()) ? 1 : 0;
+      nof_attempts += 2;
+    }
+    std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
+    avg_latency.push(tdur.count());
+    latency_samples.push_back(tdur.count());
+
+    // TEST: DCIs do not collide
+    pdcch.get_allocs(&dci_result, &pdcch_mask);
+    TESTASSERT(dci_result.size() == pdcch.nof_allocs());
+    pdcch_mask_t used_mask(pdcch.nof_cces());
+    for (const auto* dci : dci_result) {
+      TESTASSERT((used_mask & dci->current_mask).none());
+      used_mask |= dci->current_mask;
+    }
+    TESTASSERT(used_mask == pdcch_mask);
+
+    nof_dcis.push(pdcch.nof_allocs());
+    cfi.push(pdcch.get_cfi());
+    cce_usage.push(pdcch_mask.count() / (float)pdcch.nof_cces());
+  }
+  std::sort(latency_samples.begin(), latency_samples.end());
+
+  pdcch_run_data r = {};
+  r.nof_prbs       = nof_prbs;
+  r.nof_ues        = nof_ues;
+  r.success_rate   = nof_success / (float)nof_attempts;
+  r.avg_nof_dcis   = nof_dcis.value();
+  r.avg_cfi        = cfi.value();
+  r.avg_cce_usage  = cce_usage.value();
+  r.avg_latency    = std::chrono::microseconds(static_cast<int>(avg_latency.value() / 1000));
+  r.q0_9_latency   = std::chrono::microseconds(latency_samples[(size_t)(latency_samples.size() * 0.9)] / 1000);
+  results.push_back(r);
+
+  return SRSRAN_SUCCESS;
+}
+
+void print_pdcch_results(const std::vector<pdcch_run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run | Nprb | Nue | success [%] | DCIs/TTI | CFI | CCE usage [%] | latency | latency q0.9 [usec]\n");
+  fmt::print("---------------------------------------------------------------------------------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const pdcch_run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>7d}{:>6d}{:>14.1f}{:>11.1f}{:>6.2f}{:>16.1f}{:>10d}{:>22d}\n",
+               i,
+               r.nof_prbs,
+               r.nof_ues,
+               r.success_rate * 100,
+               r.avg_nof_dcis,
+               r.avg_cfi,
+               r.avg_cce_usage * 100,
+               r.avg_latency.count(),
+               r.q0_9_latency.count());
+  }
+}
+
+int run_pdcch_benchmark(uint32_t nof_ttis, const std::vector<uint32_t>& nof_prbs, const std::vector<uint32_t>& nof_ues)
+{
+  fmt::print("\n====== PDCCH Allocation Benchmark ======\n\n");
+  std::vector<pdcch_run_data> run_results;
+  for (uint32_t prbs : nof_prbs) {
+    for (uint32_t ues : nof_ues) {
+      TESTASSERT(run_pdcch_scenario(prbs, ues, nof_ttis, run_results) == SRSRAN_SUCCESS);
+    }
+  }
+  print_pdcch_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+/*****************************************
+ *     Large-scale scheduler benchmark
+ ****************************************/
+
+/// Share of the 1 msec TTI budget that the MAC scheduler may use (sum of all carriers dl_sched+ul_sched calls)
+const uint32_t sched_p99_slo_usec = 500;
+
+struct scale_run_params {
+  uint32_t    nof_prbs;
+  uint32_t    nof_ccs;
+  uint32_t    nof_ues;
+  uint32_t    nof_ttis;
+  const char* sched_policy;
+};
+
+struct scale_run_data {
+  scale_run_params          params;
+  float                     avg_dl_throughput;
+  float                     avg_ul_throughput;
+  float                     dl_prb_usage; ///< ratio of DL PRBs used for PDSCH
+  float                     ul_prb_usage; ///< ratio of UL PRBs used for PUSCH
+  float                     dl_fairness;  ///< Jain's index of the DL throughput of full-buffer UEs
+  float                     ul_fairness;  ///< Jain's index of the UL throughput of full-buffer UEs
+  std::chrono::microseconds p50_latency;
+  std::chrono::microseconds p99_latency;
+  std::chrono::microseconds max_latency;
+};
+
+/// Tester where each UE follows a traffic model and a CQI trace, instead of having full buffers and a fixed CQI
+class scale_sched_tester : public sched_tester
+{
+public:
+  using sched_tester::sched_tester;
+
+  struct ue_traffic_ctxt {
+    srsran::traffic_source source;
+    srsran::cqi_trace      cqi;
+    uint32_t               dl_pending = 0, ul_pending = 0; ///< bytes in the DL RLC and UL buffers
+    uint64_t               dl_bytes = 0, ul_bytes = 0;     ///< bytes allocated since the start of the measurements
+  };
+
+  std::map<uint16_t, ue_traffic_ctxt> ue_traffic;
+  bool                                traffic_active = false; ///< traffic is only generated after all UEs attached
+  bool                                measuring      = false;
+  uint64_t                            dl_prbs = 0, ul_prbs = 0;
+
+  void add_ue_traffic(uint16_t rnti, srsran::traffic_model_t model, uint32_t mean_cqi)
+  {
+    ue_traffic.insert(
+        std::make_pair(rnti, ue_traffic_ctxt{srsran::traffic_source{model}, srsran::cqi_trace{mean_cqi}}));
+  }
+
+  bool all_ues_connected()
+  {
+    return std::all_of(begin(), end(), [](const std::pair<const uint16_t, ue_sim>& u) {
+      return u.second.get_ctxt().conres_rx;
+    });
+  }
+
+  int run_tti()
+  {
+    TESTASSERT(advance_tti() == SRSRAN_SUCCESS);
+    update_traffic_stats();
+    return SRSRAN_SUCCESS;
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    auto it = ue_traffic.find(ue_ctxt.rnti);
+    if (not traffic_active or not ue_ctxt.conres_rx or it == ue_traffic.end()) {
+      return;
+    }
+    ue_traffic_ctxt& ue = it->second;
+
+    // New arrivals to the buffers. Full-buffer UEs are topped up every TTI
+    uint32_t dl_bytes, ul_bytes;
+    ue.source.new_tti(get_rand_gen(), dl_bytes, ul_bytes);
+    bool full_buffer = ue.source.get_model() == srsran::traffic_model_t::full_buffer;
+    ue.dl_pending    = full_buffer ? dl_bytes : ue.dl_pending + dl_bytes;
+    ue.ul_pending    = full_buffer ? ul_bytes : ue.ul_pending + ul_bytes;
+    if (dl_bytes > 0) {
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, drb_to_lcid(lte_drb::drb1), ue.dl_pending, 0);
+    }
+    if (ul_bytes > 0) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, ue.ul_pending);
+    }
+
+    if (get_tti_rx().to_uint() % 5 == 0) {
+      uint32_t cqi = ue.cqi.next(get_rand_gen());
+      for (auto& cc : pending_events.cc_list) {
+        cc.dl_cqi = cqi;
+        cc.ul_snr = 2 * cqi;
+      }
+    }
+  }
+
+  void update_traffic_stats()
+  {
+    auto consume = [](uint32_t& pending, uint64_t& total, uint32_t nbytes, bool count) {
+      pending -= std::min(pending, nbytes);
+      total += count ? nbytes : 0;
+    };
+    srsran::bounded_bitset<100, true> prb_mask;
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      const srsran_cell_t& cell = get_cell_params()[cc].cfg.cell;
+      for (const auto& data : dl_result[cc].data) {
+        auto it = ue_traffic.find(data.dci.rnti);
+        if (it != ue_traffic.end()) {
+          consume(it->second.dl_pending, it->second.dl_bytes, data.tbs[0] + data.tbs[1], measuring);
+        }
+        if (measuring and extract_dl_prbmask(cell, data.dci, prb_mask) == SRSRAN_SUCCESS) {
+          dl_prbs += prb_mask.count();
+        }
+      }
+      for (const auto& pusch : ul_result[cc].pusch) {
+        auto it = ue_traffic.find(pusch.dci.rnti);
+        if (it != ue_traffic.end()) {
+          consume(it->second.ul_pending, it->second.ul_bytes, pusch.tbs, measuring);
+        }
+        uint32_t L, RBstart;
+        srsran_ra_type2_from_riv(pusch.dci.type2_alloc.riv, &L, &RBstart, cell.nof_prb, cell.nof_prb);
+        ul_prbs += measuring ? L : 0;
+      }
+    }
+  }
+};
+
+int run_scale_scenario(scale_run_params params, std::vector<scale_run_data>& run_results)
+{
+  // All carriers can be aggregated by the UEs
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_ccs, generate_default_cell_cfg(params.nof_prbs));
+  for (uint32_t cc = 0; cc < params.nof_ccs; ++cc) {
+    for (uint32_t scc = 0; scc < params.nof_ccs; ++scc) {
+      if (scc != cc) {
+        cell_list[cc].scell_list.emplace_back();
+        cell_list[cc].scell_list.back().enb_cc_idx = scc;
+        cell_list[cc].scell_list.back().ul_allowed = true;
+      }
+    }
+  }
+  sched_interface::ue_cfg_t ue_cfg_default = generate_default_ue_cfg();
+  ue_cfg_default.supported_cc_list.resize(params.nof_ccs, ue_cfg_default.supported_cc_list[0]);
+  sched_interface::sched_args_t sched_args = {};
+  sched_args.sched_policy                  = params.sched_policy;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  scale_sched_tester tester(&sched_obj, sched_args, cell_list);
+
+  // Add users in batches, one per PRACH preamble, with their PCells spread across the carriers
+  const uint32_t nof_preambles_per_prach = 4;
+  for (uint32_t ue_idx = 0; ue_idx < params.nof_ues;) {
+    while (not srsran_prach_tti_opportunity_config_fdd(cell_list[0].prach_config, tester.get_tti_rx().to_uint(), -1)) {
+      TESTASSERT(tester.run_tti() == SRSRAN_SUCCESS);
+    }
+    for (uint32_t preamble_idx = 0; preamble_idx < nof_preambles_per_prach and ue_idx < params.nof_ues;
+         ++preamble_idx, ++ue_idx) {
+      uint16_t                  rnti   = 0x46 + ue_idx;
+      sched_interface::ue_cfg_t ue_cfg = ue_cfg_default;
+      for (uint32_t i = 0; i < params.nof_ccs; ++i) {
+        ue_cfg.supported_cc_list[i].enb_cc_idx = (ue_idx + i) % params.nof_ccs;
+      }
+      TESTASSERT(tester.add_user(rnti, ue_cfg, preamble_idx) == SRSRAN_SUCCESS);
+      uint32_t mean_cqi = std::uniform_int_distribution<uint32_t>{3, 15}(get_rand_gen());
+      tester.add_ue_traffic(rnti, srsran::get_mixed_traffic_model(ue_idx), mean_cqi);
+    }
+    TESTASSERT(tester.run_tti() == SRSRAN_SUCCESS);
+  }
+
+  // Ignore stats of the first TTIs until all UEs DRB1 are created. The traffic is only started afterwards, otherwise
+  // the last Msg4s compete with hundreds of full-buffer UEs and may take longer than the simulator TTI wrap-around
+  for (uint32_t count = 0; not tester.all_ues_connected(); ++count) {
+    CONDERROR(count >= 10000, "Not all UEs managed to connect");
+    TESTASSERT(tester.run_tti() == SRSRAN_SUCCESS);
+  }
+
+  // Run benchmark
+  tester.traffic_active = true;
+  tester.total_stats    = {};
+  tester.total_stats.tti_latency_samples.reserve(params.nof_ttis);
+  tester.measuring = true;
+  for (uint32_t count = 0; count < params.nof_ttis; ++count) {
+    TESTASSERT(tester.run_tti() == SRSRAN_SUCCESS);
+  }
+  std::vector<uint32_t>& samples = tester.total_stats.tti_latency_samples;
+  std::sort(samples.begin(), samples.end());
+
+  uint64_t              tot_dl_bytes = 0, tot_ul_bytes = 0;
+  std::vector<uint64_t> fb_dl_bytes, fb_ul_bytes;
+  for (const auto& u : tester.ue_traffic) {
+    tot_dl_bytes += u.second.dl_bytes;
+    tot_ul_bytes += u.second.ul_bytes;
+    if (u.second.source.get_model() == srsran::traffic_model_t::full_buffer) {
+      fb_dl_bytes.push_back(u.second.dl_bytes);
+      fb_ul_bytes.push_back(u.second.ul_bytes);
+    }
+  }
+  float tot_prbs = static_cast<float>(params.nof_ttis) * params.nof_prbs * params.nof_ccs;
+
+  scale_run_data r    = {};
+  r.params            = params;
+  r.avg_dl_throughput = tot_dl_bytes * 8.0F / (params.nof_ttis * 1e-3F);
+  r.avg_ul_throughput = tot_ul_bytes * 8.0F / (params.nof_ttis * 1e-3F);
+  r.dl_prb_usage      = tester.dl_prbs / tot_prbs;
+  r.ul_prb_usage      = tester.ul_prbs / tot_prbs;
+  r.dl_fairness       = srsran::jain_fairness_index(fb_dl_bytes);
+  r.ul_fairness       = srsran::jain_fairness_index(fb_ul_bytes);
+  r.p50_latency       = std::chrono::microseconds(srsran::get_sorted_quantile(samples, 0.5) / 1000);
+  r.p99_latency       = std::chrono::microseconds(srsran::get_sorted_quantile(samples, 0.99) / 1000);
+  r.max_latency       = std::chrono::microseconds(samples.empty() ? 0 : samples.back() / 1000);
+  run_results.push_back(r);
+
+  return SRSRAN_SUCCESS;
+}
+
+void print_scale_results(const std::vector<scale_run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run | Nprb | Ncc | sched pol |  Nue | DL/UL [Mbps] | DL/UL PRB [%] | DL/UL fairness | p50 [us] | "
+             "p99 [us] | max [us] | SLO\n");
+  fmt::print("------------------------------------------------------------------------------------------------------"
+             "----------------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const scale_run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>7d}{:>6d}{:>12}{:>7d}{:>9.1f}/{:>5.1f}{:>10.1f}/{:>5.1f}{:>11.2f}/{:>4.2f}"
+               "{:>11d}{:>11d}{:>11d}{:>6}\n",
+               i,
+               r.params.nof_prbs,
+               r.params.nof_ccs,
+               r.params.sched_policy,
+               r.params.nof_ues,
+               r.avg_dl_throughput / 1e6,
+               r.avg_ul_throughput / 1e6,
+               r.dl_prb_usage * 100,
+               r.ul_prb_usage * 100,
+               r.dl_fairness,
+               r.ul_fairness,
+               r.p50_latency.count(),
+               r.p99_latency.count(),
+               r.max_latency.count(),
+               r.p99_latency.count() <= sched_p99_slo_usec ? "ok" : "miss");
+  }
+  fmt::print("UE traffic mix: 20% full-buffer, 40% VoIP, 30% web, 10% IoT. SLO: p99 <= {} usec\n", sched_p99_slo_usec);
+}
+
+int run_scale_benchmark(uint32_t                     nof_ttis,
+                        const std::vector<uint32_t>& nof_prbs,
+                        const std::vector<uint32_t>& nof_ccs,
+                        const std::vector<uint32_t>& nof_ues)
+{
+  fmt::print("\n====== Large-scale Scheduler Benchmark ======\n\n");
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  // Scenarios with more UEs than the default SRSENB_MAX_UES need the *_benchmark_scale build of the scheduler
+  for (uint32_t ues : nof_ues) {
+    TESTASSERT(ues <= SRSENB_MAX_UES);
+  }
+
+  std::vector<scale_run_data> run_results;
+  for (uint32_t prbs : nof_prbs) {
+    for (uint32_t ccs : nof_ccs) {
+      for (uint32_t ues : nof_ues) {
+        for (const char* policy : {"time_rr", "time_pf"}) {
+          mac_logger.info("\n### New run {} ###\n", run_results.size());
+          scale_run_params params{prbs, ccs, ues, nof_ttis, policy};
+          TESTASSERT(run_scale_scenario(params, run_results) == SRSRAN_SUCCESS);
+        }
+      }
+    }
+  }
+  print_scale_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -422,8 +833,14 @@ int main(int argc, char* argv[])
 
   if (argc == 1 or strcmp(argv[1], "test") == 0) {
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_pdcch_benchmark(100, {100}, {64}) == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_scale_benchmark(500, {25}, {1, 2}, {50}) == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "pdcch") == 0) {
+    TESTASSERT(srsenb::run_pdcch_benchmark(10000, {25, 50, 100}, {16, 64, 128}) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "scale") == 0) {
+    TESTASSERT(srsenb::run_scale_benchmark(5000, {100}, {1, 2}, {100, 500, 1000}) == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
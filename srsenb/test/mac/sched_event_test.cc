@@ -0,0 +1,159 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+namespace srsenb {
+
+/// Scheduler with a single cell
+class sched_event_tester : public sched
+{
+public:
+  sched_event_tester()
+  {
+    sched::init(&rrc_ptr, {});
+    std::vector<sched_interface::cell_cfg_t> cell_cfg = {generate_default_cell_cfg(6)};
+    TESTASSERT(sched::cell_cfg(cell_cfg) == SRSRAN_SUCCESS);
+  }
+
+  using sched::event_queue_capacity;
+
+private:
+  rrc_dummy rrc_ptr;
+};
+
+/// Events of unknown RNTIs are rejected when pushed
+int test_unknown_rnti_event()
+{
+  sched_event_tester sched;
+  TESTASSERT(sched.ue_cfg(0x46, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+
+  TESTASSERT(sched.ul_bsr(0x46, 1, 100) == SRSRAN_SUCCESS);
+  TESTASSERT(sched.ul_bsr(0x47, 1, 100) == SRSRAN_ERROR);
+  // Same index in ue_db as the existing UE
+  TESTASSERT(sched.ul_bsr(0x46 + SRSENB_MAX_UES, 1, 100) == SRSRAN_ERROR);
+
+  TESTASSERT(sched.ue_rem(0x46) == SRSRAN_SUCCESS);
+  TESTASSERT(sched.ul_bsr(0x46, 1, 100) == SRSRAN_ERROR);
+
+  TESTASSERT(sched.ue_cfg(0x46, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+  TESTASSERT(sched.ul_bsr(0x46, 1, 100) == SRSRAN_SUCCESS);
+  sched.reset();
+  TESTASSERT(sched.ul_bsr(0x46, 1, 100) == SRSRAN_ERROR);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Events pushed by different threads, and so to different queues, are applied in the order they were pushed
+int test_cross_thread_event_order()
+{
+  const uint32_t nof_events = 1000;
+  const uint16_t rnti       = 0x46;
+
+  // Reference UL buffer after a BSR reset followed by a buffer increment
+  uint32_t expected_ul_buffer = 0;
+  {
+    sched_event_tester sched;
+    TESTASSERT(sched.ue_cfg(rnti, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+    TESTASSERT(sched.ul_bsr(rnti, 0, 0) == SRSRAN_SUCCESS);
+    TESTASSERT(sched.ul_buffer_add(rnti, 0, 10) == SRSRAN_SUCCESS);
+    expected_ul_buffer = sched.get_ul_buffer(rnti);
+    TESTASSERT(expected_ul_buffer > 0);
+  }
+
+  // One thread resets the BSR and the other increments the buffer, taking turns. Applying the events of one thread
+  // before the ones of the other would leave either an empty buffer or the sum of all the increments
+  sched_event_tester sched;
+  TESTASSERT(sched.ue_cfg(rnti, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+  std::atomic<uint32_t> next_event{0};
+  auto                  producer = [&sched, &next_event, nof_events, rnti](uint32_t thread_idx) {
+    for (uint32_t ev_idx = thread_idx; ev_idx < nof_events; ev_idx += 2) {
+      while (next_event.load(std::memory_order_acquire) != ev_idx) {
+        std::this_thread::yield();
+      }
+      int ret = (thread_idx == 0) ? sched.ul_bsr(rnti, 0, 0) : sched.ul_buffer_add(rnti, 0, 10);
+      TESTASSERT(ret == SRSRAN_SUCCESS);
+      next_event.store(ev_idx + 1, std::memory_order_release);
+    }
+  };
+  std::thread t0(producer, 0);
+  std::thread t1(producer, 1);
+  t0.join();
+  t1.join();
+
+  TESTASSERT(sched.get_ul_buffer(rnti) == expected_ul_buffer);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// An event that finds its queue full is applied after the events that the same thread queued before it
+int test_overflow_event_order()
+{
+  const uint16_t rnti = 0x46;
+
+  uint32_t expected_ul_buffer = 0;
+  {
+    sched_event_tester sched;
+    TESTASSERT(sched.ue_cfg(rnti, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+    TESTASSERT(sched.ul_bsr(rnti, 0, 0) == SRSRAN_SUCCESS);
+    expected_ul_buffer = sched.get_ul_buffer(rnti);
+  }
+
+  sched_event_tester sched;
+  TESTASSERT(sched.ue_cfg(rnti, generate_default_ue_cfg()) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < sched_event_tester::event_queue_capacity; ++i) {
+    TESTASSERT(sched.ul_buffer_add(rnti, 0, 10) == SRSRAN_SUCCESS);
+  }
+  // The queue is full, the BSR reset has to be applied last
+  TESTASSERT(sched.ul_bsr(rnti, 0, 0) == SRSRAN_SUCCESS);
+
+  TESTASSERT(sched.get_ul_buffer(rnti) == expected_ul_buffer);
+  mac_sched_event_metrics_t metrics;
+  sched.event_metrics_read(metrics);
+  TESTASSERT(metrics.nof_overflows == 1);
+  TESTASSERT(metrics.nof_events == sched_event_tester::event_queue_capacity + 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::info);
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::info);
+
+  // Start the log backend.
+  srslog::init();
+
+  TESTASSERT(srsenb::test_unknown_rnti_event() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_cross_thread_event_order() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_overflow_event_order() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -263,7 +263,9 @@ int common_sched_tester::run_tti(const tti_ev& tti_events)
   logger.info("---- tti=%u | nof_ues=%zd ----", tti_rx.to_uint(), ue_db.size());
 
   sched_sim->new_tti(tti_rx);
+  apply_ue_events();
   process_tti_events(tti_events);
+  apply_ue_events();
   before_sched();
 
   // Call scheduler for all carriers
@@ -281,6 +283,13 @@ int common_sched_tester::run_tti(const tti_ev& tti_events)
   return SRSRAN_SUCCESS;
 }
 
+/// Apply the UE feedback pushed so far, so that the tester inspects the same UE state that the scheduler will see
+void common_sched_tester::apply_ue_events()
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  process_ue_events();
+}
+
 int common_sched_tester::test_next_ttis(const std::vector<tti_ev>& tti_events)
 {
   while (tti_count < tti_events.size()) {
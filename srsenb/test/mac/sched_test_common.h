@@ -136,6 +136,7 @@ public:
 protected:
   virtual void new_test_tti();
   virtual void before_sched() {}
+  void         apply_ue_events();
 
   rrc_dummy rrc_ptr;
 };
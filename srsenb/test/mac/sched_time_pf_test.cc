@@ -0,0 +1,212 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include "srsran/common/test_common.h"
+#include <cmath>
+
+using namespace srsenb;
+const uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+using ue_ctxt       = sched_time_pf::ue_ctxt;
+using ue_rate       = sched_time_pf::ue_rate;
+using ue_dl_queue_t = sched_time_pf::ue_dl_queue_t;
+
+const float alpha = 0.01;
+
+/// Checks that the top of the queue has the highest priority among the queued users
+bool is_queue_top(const ue_dl_queue_t& queue, const std::vector<ue_ctxt>& ues)
+{
+  sched_time_pf::ue_dl_prio_compare comp;
+  for (const ue_ctxt& u : ues) {
+    if (u.dl_heap_pos >= 0 and comp(queue.top(), &u)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Random insertions, priority updates and removals, followed by popping the users in priority order
+int test_ue_heap()
+{
+  const uint32_t                         nof_ues = 50;
+  std::uniform_real_distribution<double> prio_dist(-10, 10);
+
+  std::vector<ue_ctxt> ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(0x46 + i, 1, 0);
+  }
+
+  ue_dl_queue_t queue;
+  queue.reserve(nof_ues);
+  for (uint32_t i = 0; i < 2000; ++i) {
+    ue_ctxt& u = ues[std::uniform_int_distribution<uint32_t>{0, nof_ues - 1}(get_rand_gen())];
+    if (randf() < 0.2) {
+      queue.erase(u);
+      TESTASSERT(u.dl_heap_pos == -1);
+    } else {
+      // Retransmissions go first, regardless of the PF metric
+      u.dl_retx = randf() < 0.1;
+      u.dl_prio = prio_dist(get_rand_gen());
+      queue.push_or_update(u);
+      TESTASSERT(u.dl_heap_pos >= 0);
+    }
+    TESTASSERT(queue.empty() or is_queue_top(queue, ues));
+  }
+
+  uint32_t nof_queued = std::count_if(ues.begin(), ues.end(), [](const ue_ctxt& u) { return u.dl_heap_pos >= 0; });
+  sched_time_pf::ue_dl_prio_compare comp;
+  ue_ctxt*                          prev = nullptr;
+  for (; not queue.empty(); --nof_queued) {
+    TESTASSERT(is_queue_top(queue, ues));
+    ue_ctxt* u = queue.top();
+    queue.pop();
+    TESTASSERT(u->dl_heap_pos == -1);
+    TESTASSERT(prev == nullptr or not comp(prev, u));
+    prev = u;
+  }
+  TESTASSERT(nof_queued == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The rate of a user that is only updated when it gets allocations shall match the rate of a user that gets a zero
+/// sample in every TTI without allocation, both during the fast start phase and after it
+int test_ue_rate_lazy_decay()
+{
+  ue_rate  eager_rate, lazy_rate;
+  ue_ctxt  eager_ue(0x46, 1, 0), lazy_ue(0x47, 1, 0);
+  uint32_t nof_checks = 0;
+  for (uint64_t tti = 1; tti < 2000; ++tti) {
+    // Bursts of allocations separated by idle periods, some of them longer than the fast start phase
+    bool     alloc       = (tti < 20) or (tti >= 60 and tti < 70) or (tti >= 400 and tti < 410) or tti == 1500;
+    uint32_t alloc_bytes = alloc ? 1000 + tti % 7 * 100 : 0;
+
+    eager_rate.save_alloc(tti, alloc_bytes, alpha);
+    if (alloc) {
+      lazy_rate.save_alloc(tti, alloc_bytes, alpha);
+    }
+
+    if (tti % 10 == 0) {
+      // Applying the pending zero samples on read
+      ue_rate lazy_read = lazy_rate;
+      lazy_read.apply_idle_ttis(tti + 1, alpha);
+      TESTASSERT(lazy_read.nof_samples == eager_rate.nof_samples);
+      TESTASSERT(lazy_read.last_tti == eager_rate.last_tti);
+      TESTASSERT(std::abs(lazy_read.avg_rate - eager_rate.avg_rate) <= 1e-3 * eager_rate.avg_rate);
+
+      // The priorities are computed at different TTIs, but keep the same order as if computed in the same TTI
+      eager_ue.dl_rate = eager_rate;
+      lazy_ue.dl_rate  = lazy_rate;
+      double eager_prio = eager_ue.get_prio(1000, eager_ue.dl_rate, tti + 1, alpha);
+      double lazy_prio  = lazy_ue.get_prio(1000, lazy_ue.dl_rate, tti + 1, alpha);
+      TESTASSERT(std::abs(eager_prio - lazy_prio) < 1e-3);
+      nof_checks++;
+    }
+  }
+  TESTASSERT(nof_checks > 0);
+
+  // The user with the lower rate keeps the higher priority while both are idle, even if their priorities are computed
+  // in different TTIs
+  ue_ctxt ue1(0x46, 1, 0), ue2(0x47, 1, 0);
+  for (uint64_t tti = 1; tti <= 200; ++tti) {
+    ue1.dl_rate.save_alloc(tti, 500, alpha);
+    ue2.dl_rate.save_alloc(tti, 1000, alpha);
+  }
+  double prio1 = ue1.get_prio(1000, ue1.dl_rate, 201, alpha);
+  double prio2 = ue2.get_prio(1000, ue2.dl_rate, 1000, alpha);
+  TESTASSERT(prio1 > prio2);
+  TESTASSERT(std::abs(ue1.get_prio(1000, ue1.dl_rate, 1000, alpha) - prio1) < 1e-3);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A user added in the same TTI in which another user that maps to the same slot of the UE db is removed shall be
+/// scheduled in that TTI
+int test_ue_replacement_same_tti()
+{
+  const uint32_t enb_cc_idx = 0;
+  const uint16_t old_rnti   = 0x46;
+  const uint16_t new_rnti   = old_rnti + SRSENB_MAX_UES;
+  const uint32_t lcid       = drb_to_lcid(lte_drb::drb1);
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg = generate_default_ue_cfg();
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[enb_cc_idx].set_cfg(enb_cc_idx, generate_default_cell_cfg(25), sched_args));
+
+  sched_time_pf             pf_sched{cell_params[enb_cc_idx], sched_args};
+  sched_ue_list             ue_db;
+  sf_sched_result           sf_result;
+  std::unique_ptr<sf_sched> tti_sched{new sf_sched()};
+  sf_result.enb_cc_list.resize(1);
+  tti_sched->init(cell_params[enb_cc_idx]);
+
+  auto run_tti = [&](tti_point tti_rx) {
+    sf_result.new_tti(tti_rx);
+    tti_sched->new_tti(tti_rx, &sf_result);
+    for (auto& u : ue_db) {
+      u.second->new_subframe(tti_rx, enb_cc_idx);
+    }
+    pf_sched.sched_dl_users(ue_db, tti_sched.get());
+  };
+
+  tti_point tti_rx{0};
+  TESTASSERT(ue_db.insert(old_rnti, std::unique_ptr<sched_ue>{new sched_ue(old_rnti, cell_params, ue_cfg)}));
+  ue_db[old_rnti]->dl_buffer_state(lcid, 1000, 0);
+  pf_sched.ue_event(old_rnti);
+  run_tti(tti_rx);
+  TESTASSERT(tti_sched->is_dl_alloc(old_rnti));
+
+  // Replace the user by another one that takes the same slot, before the next TTI
+  ue_db.erase(old_rnti);
+  pf_sched.ue_event(old_rnti);
+  TESTASSERT(ue_db.insert(new_rnti, std::unique_ptr<sched_ue>{new sched_ue(new_rnti, cell_params, ue_cfg)}));
+  ue_db[new_rnti]->dl_buffer_state(lcid, 1000, 0);
+  pf_sched.ue_event(new_rnti);
+  run_tti(++tti_rx);
+  TESTASSERT(not tti_sched->is_dl_alloc(old_rnti));
+  TESTASSERT(tti_sched->is_dl_alloc(new_rnti));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srsenb::set_randseed(seed);
+  srsran::console("This is the chosen seed: %u\n", seed);
+
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::info);
+
+  // Start the log backend.
+  srslog::init();
+
+  TESTASSERT(test_ue_heap() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ue_rate_lazy_decay() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ue_replacement_same_tti() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TRAFFIC_MODELS_H
+#define SRSRAN_SCHED_TRAFFIC_MODELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace srsran {
+
+/*****************************
+ *      UE traffic models
+ ****************************/
+
+enum class traffic_model_t { full_buffer, voip, web, iot };
+
+inline const char* to_string(traffic_model_t model)
+{
+  switch (model) {
+    case traffic_model_t::full_buffer:
+      return "full_buffer";
+    case traffic_model_t::voip:
+      return "voip";
+    case traffic_model_t::web:
+      return "web";
+    case traffic_model_t::iot:
+      return "iot";
+  }
+  return "invalid";
+}
+
+/// Mix of traffic models used in large-scale scenarios. The UE with index "ue_idx" gets the model "mix[ue_idx % 10]"
+inline traffic_model_t get_mixed_traffic_model(uint32_t ue_idx)
+{
+  static const traffic_model_t mix[] = {traffic_model_t::full_buffer,
+                                        traffic_model_t::voip,
+                                        traffic_model_t::web,
+                                        traffic_model_t::voip,
+                                        traffic_model_t::iot,
+                                        traffic_model_t::full_buffer,
+                                        traffic_model_t::voip,
+                                        traffic_model_t::web,
+                                        traffic_model_t::voip,
+                                        traffic_model_t::web};
+  return mix[ue_idx % 10];
+}
+
+/**
+ * Generator of the number of bytes that arrive at the DL (eNB RLC) and UL (UE) buffers of a UE in each TTI
+ * - full_buffer: the buffers never run empty
+ * - voip: 40 byte packets every 20 TTIs, in talk spurts with exponentially distributed on/off periods (mean 1s)
+ * - web: page downloads with log-normal size (median ~50KB) followed by exponentially distributed reading times
+ * - iot: small UL reports (and their DL acks) with exponentially distributed inter-arrival times (mean 2s)
+ */
+class traffic_source
+{
+public:
+  /// Buffer occupancy that a full-buffer UE is kept at
+  static const uint32_t full_buffer_bytes = 100000;
+
+  explicit traffic_source(traffic_model_t model_) : model(model_) {}
+
+  traffic_model_t get_model() const { return model; }
+
+  template <typename RandGen>
+  void new_tti(RandGen& rand_gen, uint32_t& dl_bytes, uint32_t& ul_bytes)
+  {
+    dl_bytes = 0;
+    ul_bytes = 0;
+    switch (model) {
+      case traffic_model_t::full_buffer:
+        dl_bytes = full_buffer_bytes;
+        ul_bytes = full_buffer_bytes;
+        break;
+      case traffic_model_t::voip:
+        if (active and ttis_to_packet == 0) {
+          dl_bytes       = voip_packet_bytes;
+          ul_bytes       = voip_packet_bytes;
+          ttis_to_packet = voip_period_ttis;
+        }
+        if (ttis_to_state_change == 0) {
+          active               = not active;
+          ttis_to_packet       = 0;
+          ttis_to_state_change = exp_ttis(rand_gen, 1000);
+        }
+        break;
+      case traffic_model_t::web:
+        if (ttis_to_state_change == 0) {
+          // request of a new page, after the reading time
+          std::lognormal_distribution<float> page_size{10.8, 1.0};
+          dl_bytes             = std::min(static_cast<uint32_t>(page_size(rand_gen)), 2000000u);
+          ul_bytes             = web_request_bytes;
+          ttis_to_state_change = exp_ttis(rand_gen, 5000);
+        }
+        break;
+      case traffic_model_t::iot:
+        if (ttis_to_state_change == 0) {
+          dl_bytes             = iot_ack_bytes;
+          ul_bytes             = iot_report_bytes;
+          ttis_to_state_change = exp_ttis(rand_gen, 2000);
+        }
+        break;
+    }
+    ttis_to_packet       = ttis_to_packet > 0 ? ttis_to_packet - 1 : 0;
+    ttis_to_state_change = ttis_to_state_change > 0 ? ttis_to_state_change - 1 : 0;
+  }
+
+private:
+  static const uint32_t voip_packet_bytes = 40, voip_period_ttis = 20;
+  static const uint32_t web_request_bytes = 500;
+  static const uint32_t iot_report_bytes = 100, iot_ack_bytes = 20;
+
+  template <typename RandGen>
+  static uint32_t exp_ttis(RandGen& rand_gen, float mean_ttis)
+  {
+    std::exponential_distribution<float> dist{1 / mean_ttis};
+    return 1 + static_cast<uint32_t>(dist(rand_gen));
+  }
+
+  traffic_model_t model;
+  bool            active               = false; ///< VoIP talk spurt is ongoing
+  uint32_t        ttis_to_packet       = 0;
+  uint32_t        ttis_to_state_change = 0;
+};
+
+/// CQI trace of a UE, which fluctuates around a mean value that depends on its (static) position in the cell
+class cqi_trace
+{
+public:
+  explicit cqi_trace(uint32_t mean_cqi_) : mean_cqi(mean_cqi_) {}
+
+  template <typename RandGen>
+  uint32_t next(RandGen& rand_gen)
+  {
+    std::normal_distribution<float> fading{0, 1.5};
+    int                             cqi = static_cast<int>(std::round(mean_cqi + fading(rand_gen)));
+    return std::max(1, std::min(15, cqi));
+  }
+
+private:
+  uint32_t mean_cqi;
+};
+
+/*****************************
+ *     Benchmark metrics
+ ****************************/
+
+/// Jain's fairness index of a set of per-UE throughputs. 1 is perfectly fair, 1/N means a single UE gets everything
+inline float jain_fairness_index(const std::vector<uint64_t>& samples)
+{
+  double sum = 0, sum_sq = 0;
+  for (uint64_t s : samples) {
+    sum += s;
+    sum_sq += static_cast<double>(s) * s;
+  }
+  return sum_sq > 0 ? static_cast<float>(sum * sum / (samples.size() * sum_sq)) : 1.0F;
+}
+
+/// Value of the quantile "q" of a sorted list of samples
+template <typename T>
+T get_sorted_quantile(const std::vector<T>& sorted_samples, double q)
+{
+  if (sorted_samples.empty()) {
+    return T{};
+  }
+  size_t idx = std::min(static_cast<size_t>(sorted_samples.size() * q), sorted_samples.size() - 1);
+  return sorted_samples[idx];
+}
+
+} // namespace srsran
+
+#endif // SRSRAN_SCHED_TRAFFIC_MODELS_H
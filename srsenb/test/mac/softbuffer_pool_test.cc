@@ -0,0 +1,272 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/common/softbuffer_pool.h"
+#include "srsenb/hdr/stack/mac/ue.h"
+#include "srsran/common/test_common.h"
+#include <set>
+extern "C" {
+#include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/utils/simd.h"
+}
+
+using namespace srsenb;
+
+const uint32_t cb_size = SRSRAN_TCOD_MAX_LEN_CB;
+
+/// The pool hands out distinct CB buffers from the reserved ones, and fails when there are not enough left
+int test_cb_pool_allocate()
+{
+  softbuffer_cb_pool pool(cb_size);
+
+  mac_softbuffer_pool_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 0 and metrics.nof_bytes == 0);
+  uint8_t* blocks[10] = {};
+  TESTASSERT(not pool.allocate(blocks, 1));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_failures == 1);
+
+  TESTASSERT(pool.reserve(12));
+  TESTASSERT(pool.allocate(blocks, 3));
+  TESTASSERT(pool.allocate(blocks + 3, 7));
+  std::set<uint8_t*> sorted_blocks(blocks, blocks + 10);
+  TESTASSERT(sorted_blocks.size() == 10);
+  uint8_t* prev = nullptr;
+  for (uint8_t* b : sorted_blocks) {
+    // CB buffers keep the SIMD alignment and do not overlap
+    TESTASSERT((uintptr_t)b % SRSRAN_SIMD_BIT_ALIGN == 0);
+    TESTASSERT(prev == nullptr or b >= prev + cb_size);
+    memset(b, 0xff, cb_size);
+    prev = b;
+  }
+
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 12);
+  TESTASSERT(metrics.nof_used_cbs == 10);
+  TESTASSERT(metrics.max_used_cbs == 10);
+  TESTASSERT(metrics.nof_bytes >= 12 * cb_size);
+  TESTASSERT(metrics.nof_failures == 0);
+
+  // The pool does not grow, and a failed allocation takes no CB buffer
+  uint8_t* more_blocks[7] = {};
+  TESTASSERT(not pool.allocate(more_blocks, 3));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 12);
+  TESTASSERT(metrics.nof_used_cbs == 10);
+  TESTASSERT(metrics.nof_failures == 1);
+  TESTASSERT(pool.allocate(more_blocks, 2));
+  pool.deallocate(more_blocks, 2);
+
+  // Returned CB buffers are reused
+  pool.deallocate(blocks, 5);
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 5);
+  TESTASSERT(metrics.max_used_cbs == 12);
+  TESTASSERT(pool.allocate(more_blocks, 7));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 12);
+  TESTASSERT(metrics.nof_used_cbs == 12);
+
+  // The maximum is reset on every read
+  pool.deallocate(more_blocks, 7);
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.max_used_cbs == 12);
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 5 and metrics.max_used_cbs == 5);
+  pool.deallocate(blocks + 5, 5);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// reserve() grows the pool to the requested number of CB buffers, and does not shrink it
+int test_cb_pool_reserve()
+{
+  softbuffer_cb_pool pool(cb_size);
+  TESTASSERT(pool.reserve(20));
+
+  mac_softbuffer_pool_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 20);
+  TESTASSERT(metrics.nof_used_cbs == 0);
+
+  TESTASSERT(pool.reserve(4));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 20);
+
+  TESTASSERT(pool.reserve(24));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 24);
+  TESTASSERT(metrics.nof_bytes >= 24 * cb_size);
+
+  std::vector<uint8_t*> blocks(24);
+  TESTASSERT(pool.allocate(blocks.data(), blocks.size()));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_cbs == 24);
+  pool.deallocate(blocks.data(), blocks.size());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The Tx softbuffer only holds CB buffers between bind() and release()
+int test_pooled_softbuffer_tx()
+{
+  const uint32_t     max_cb = 13;
+  softbuffer_cb_pool pool(cb_size);
+  TESTASSERT(pool.reserve(max_cb + 2));
+
+  pooled_softbuffer_tx sb(pool, cb_size, max_cb);
+  TESTASSERT(not sb.is_bound());
+  TESTASSERT(sb.get()->max_cb == 0);
+  TESTASSERT(sb.get()->max_cb_size == cb_size);
+
+  mac_softbuffer_pool_metrics_t metrics = {};
+  TESTASSERT(sb.bind(3));
+  TESTASSERT(sb.is_bound() and sb.nof_cb() == 3);
+  for (uint32_t i = 0; i < sb.nof_cb(); ++i) {
+    TESTASSERT(sb.get()->buffer_b[i] != nullptr);
+  }
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 3);
+
+  // Rebinding returns the previous CB buffers first
+  TESTASSERT(sb.bind(max_cb));
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == max_cb);
+
+  // More CBs than the softbuffer supports
+  TESTASSERT(not sb.bind(max_cb + 1));
+  TESTASSERT(not sb.is_bound());
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 0);
+
+  // Moving the softbuffer moves the CB buffers
+  TESTASSERT(sb.bind(2));
+  pooled_softbuffer_tx sb2(std::move(sb));
+  TESTASSERT(not sb.is_bound());
+  TESTASSERT(sb2.is_bound() and sb2.nof_cb() == 2);
+  sb.release();
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 2);
+
+  sb2.release();
+  TESTASSERT(not sb2.is_bound());
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 0);
+
+  // The destructor returns the CB buffers
+  {
+    pooled_softbuffer_tx sb3(pool, cb_size, max_cb);
+    TESTASSERT(sb3.bind(5));
+  }
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The Rx softbuffer splits every CB buffer in soft bits and decoded bits, and is reset when bound
+int test_pooled_softbuffer_rx()
+{
+  const uint32_t     max_cb = 4;
+  softbuffer_cb_pool pool(softbuffer_cb_pool::rx_block_size(cb_size));
+  TESTASSERT(pool.reserve(max_cb));
+
+  pooled_softbuffer_rx sb(pool, cb_size, max_cb);
+  TESTASSERT(not sb.is_bound());
+  TESTASSERT(sb.bind(3));
+  TESTASSERT(sb.nof_cb() == 3);
+
+  srsran_softbuffer_rx_t* buf = sb.get();
+  for (uint32_t i = 0; i < sb.nof_cb(); ++i) {
+    uint8_t* softbits = reinterpret_cast<uint8_t*>(buf->buffer_f[i]);
+    TESTASSERT(buf->data[i] == softbits + softbuffer_cb_pool::rx_data_offset(cb_size));
+    TESTASSERT(buf->data[i] + cb_size / 8 <= softbits + softbuffer_cb_pool::rx_block_size(cb_size));
+    TESTASSERT(not buf->cb_crc[i]);
+    buf->cb_crc[i] = true;
+  }
+  buf->tb_crc = true;
+
+  // Binding again resets the CRCs of the previous transmission
+  TESTASSERT(sb.bind(2));
+  TESTASSERT(not buf->tb_crc);
+  for (uint32_t i = 0; i < sb.nof_cb(); ++i) {
+    TESTASSERT(not buf->cb_crc[i]);
+  }
+
+  mac_softbuffer_pool_metrics_t metrics = {};
+  pooled_softbuffer_rx          sb2(std::move(sb));
+  TESTASSERT(not sb.is_bound());
+  TESTASSERT(sb2.nof_cb() == 2);
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 2);
+  sb2.release();
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_used_cbs == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The code blocks of an UL TB are returned when it is decoded, or after the maximum number of transmissions of the TB
+int test_ue_rx_softbuffers_max_nof_tx()
+{
+  const uint32_t     nof_prb = 25, tbs = 100;
+  softbuffer_cb_pool tx_pool(SOFTBUFFER_SIZE);
+  softbuffer_cb_pool rx_pool(softbuffer_cb_pool::rx_block_size(SOFTBUFFER_SIZE));
+  TESTASSERT(tx_pool.reserve(8) and rx_pool.reserve(8));
+  ue_cc_softbuffers  softbuffers(tx_pool, rx_pool, nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+
+  // E.g. a Msg3, with fewer transmissions than the other TBs
+  srsran::tti_point tti_rx{10};
+  TESTASSERT(softbuffers.get_rx(tti_rx, tbs, true, 2) != nullptr);
+  softbuffers.rx_crc_info(tti_rx, false);
+  TESTASSERT(softbuffers.softbuffer_rx_list[10 % SRSRAN_FDD_NOF_HARQ].buffer.is_bound());
+  TESTASSERT(softbuffers.get_rx(tti_rx + SRSRAN_FDD_NOF_HARQ, tbs, false, 4) != nullptr);
+  softbuffers.rx_crc_info(tti_rx + SRSRAN_FDD_NOF_HARQ, false);
+  TESTASSERT(not softbuffers.softbuffer_rx_list[10 % SRSRAN_FDD_NOF_HARQ].buffer.is_bound());
+
+  // Decoded TBs are returned before their maximum number of transmissions
+  TESTASSERT(softbuffers.get_rx(tti_rx, tbs, true, 4) != nullptr);
+  softbuffers.rx_crc_info(tti_rx, false);
+  TESTASSERT(softbuffers.get_rx(tti_rx + SRSRAN_FDD_NOF_HARQ, tbs, false, 2) != nullptr);
+  softbuffers.rx_crc_info(tti_rx + SRSRAN_FDD_NOF_HARQ, false);
+  TESTASSERT(softbuffers.softbuffer_rx_list[10 % SRSRAN_FDD_NOF_HARQ].buffer.is_bound());
+  TESTASSERT(softbuffers.get_rx(tti_rx + 2 * SRSRAN_FDD_NOF_HARQ, tbs, false, 2) != nullptr);
+  softbuffers.rx_crc_info(tti_rx + 2 * SRSRAN_FDD_NOF_HARQ, true);
+  TESTASSERT(not softbuffers.softbuffer_rx_list[10 % SRSRAN_FDD_NOF_HARQ].buffer.is_bound());
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_cb_pool_allocate() == SRSRAN_SUCCESS);
+  TESTASSERT(test_cb_pool_reserve() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pooled_softbuffer_tx() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pooled_softbuffer_rx() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ue_rx_softbuffers_max_nof_tx() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
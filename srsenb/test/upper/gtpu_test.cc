@@ -150,8 +150,10 @@ srsran::unique_byte_buffer_t encode_end_marker(uint32_t teid)
   return pdu;
 }
 
-srsran::unique_byte_buffer_t read_socket(int fd)
+srsran::unique_byte_buffer_t read_socket(srsran::task_scheduler& task_sched, int fd)
 {
+  // GTP-U sends its batch of PDUs at the end of the stack task
+  task_sched.run_pending_tasks();
   srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
   pdu->N_bytes                     = read(fd, pdu->msg, pdu->get_tailroom());
   return pdu;
@@ -213,6 +215,29 @@ void test_gtpu_tunnel_manager()
   tunnels.remove_tunnel(before_tun->teid_in);
   TESTASSERT(tunnels.find_rnti_bearer_tunnels(0x46, drb1_eps_bearer_id).size() == 1);
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
+
+  // TEST: rnti update and removal, with enough UEs for the rnti map to grow in between
+  const uint16_t first_rnti = 0x100, nof_ues = 32;
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_ues; ++rnti) {
+    TESTASSERT(tunnels.add_tunnel(rnti, drb1_eps_bearer_id, rnti, sgw_addr) != nullptr);
+  }
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_ues; ++rnti) {
+    uint16_t new_rnti = rnti + nof_ues;
+    TESTASSERT(tunnels.update_rnti(rnti, new_rnti));
+    TESTASSERT(tunnels.find_rnti_tunnels(rnti) != nullptr and tunnels.find_rnti_tunnels(rnti)->empty());
+    TESTASSERT(tunnels.find_rnti_bearer_tunnels(new_rnti, drb1_eps_bearer_id).size() == 1);
+    const gtpu_tunnel* moved_tun =
+        tunnels.find_tunnel(tunnels.find_rnti_bearer_tunnels(new_rnti, drb1_eps_bearer_id)[0].teid);
+    TESTASSERT(moved_tun != nullptr and moved_tun->rnti == new_rnti and moved_tun->teid_out == rnti);
+    TESTASSERT(tunnels.remove_rnti(rnti));
+  }
+  for (uint16_t rnti = first_rnti + nof_ues; rnti < first_rnti + 2 * nof_ues; ++rnti) {
+    TESTASSERT(tunnels.remove_rnti(rnti));
+    TESTASSERT(tunnels.find_rnti_tunnels(rnti) == nullptr);
+  }
+  TESTASSERT(not tunnels.remove_rnti(first_rnti));
+  TESTASSERT(tunnels.find_rnti_bearer_tunnels(0x46, drb1_eps_bearer_id).size() == 1);
+  TESTASSERT(tunnels.find_rnti_bearer_tunnels(0x47, drb1_eps_bearer_id + 1).size() == 1);
 }
 
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
@@ -284,9 +309,9 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   srsran::span<uint8_t> pdu_view{};
 
   // TEST: GTPU buffers incoming PDCP buffered SNs until the TEID is explicitly activated
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu == nullptr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu == nullptr);
   tenb_gtpu.set_tunnel_status(dl_tenb_teid_in, true);
   pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
@@ -297,7 +322,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
 
   // TEST: verify that PDCP buffered SNs have been forwarded through SeNB->TeNB tunnel
   for (size_t sn = 8; sn < 10; ++sn) {
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
     pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
     TESTASSERT(std::count(pdu_view.begin() + PDU_HEADER_SIZE, pdu_view.end(), sn) == 10);
     TESTASSERT(tenb_pdcp.last_rnti == rnti2);
@@ -310,7 +335,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   pdu = encode_gtpu_packet(data_vec, senb_teid_in, sgw_sockaddr, senb_sockaddr);
   encoded_data.assign(pdu->msg + 8u, pdu->msg + pdu->N_bytes);
   senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   pdu_view = srsran::make_span(tenb_pdcp.last_sdu);
   TESTASSERT(pdu_view.size() == encoded_data.size() and
              std::equal(pdu_view.begin(), pdu_view.end(), encoded_data.begin()));
@@ -332,7 +357,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   pdu = encode_gtpu_packet(data_vec, senb_teid_in, sgw_sockaddr, senb_sockaddr);
   encoded_data.assign(pdu->msg + 8u, pdu->msg + pdu->N_bytes);
   senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+  tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   TESTASSERT(tenb_pdcp.last_sdu->N_bytes == encoded_data.size() and
              memcmp(tenb_pdcp.last_sdu->msg, encoded_data.data(), encoded_data.size()) == 0);
   tenb_pdcp.clear();
@@ -347,7 +372,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
     // TEST: EndMarker may even reach SeNB, but the SeNB receives in tandem the UEContextReleaseCommand and closes
     //       the user tunnels before the chance to send an EndMarker
     senb_gtpu.rem_user(0x46);
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   } else if (event == tunnel_test_event::reest_senb) {
     // TEST: UE may start a Reestablishment to the SeNB. In such case, the rnti will be updated, the forwarding tunnel
     //       taken down, and the previous main tunnel reestablished
@@ -366,7 +391,7 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
     // TEST: EndMarker is forwarded via MME->SeNB->TeNB, and TeNB buffered PDUs are flushed
     pdu = encode_end_marker(senb_teid_in);
     senb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
-    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(tenb_rx_sockets.s1u_fd), senb_sockaddr);
+    tenb_gtpu.handle_gtpu_s1u_rx_packet(read_socket(task_sched, tenb_rx_sockets.s1u_fd), senb_sockaddr);
   }
   srsran::span<uint8_t> encoded_data2{tenb_pdcp.last_sdu->msg + 20u, tenb_pdcp.last_sdu->msg + 30u};
   TESTASSERT(std::all_of(encoded_data2.begin(), encoded_data2.end(), [N_pdus](uint8_t b) { return b == N_pdus - 1; }));
@@ -0,0 +1,244 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/rlc.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_rlc.h"
+#include <chrono>
+#include <thread>
+
+/*
+ * Tests the RX path of the eNB RLC with RLC workers. The PDUs are written on SRB0, whose TM entity returns each PDU as
+ * one SDU to the RRC. The payload of each PDU carries its RNTI and a sequence number.
+ */
+
+namespace srsenb {
+
+static const uint32_t nof_pdus_per_write = 100; // more than the PDUs of a RLC worker job
+
+class mac_tester : public mac_interface_rlc
+{
+public:
+  int rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+};
+
+class pdcp_tester : public pdcp_interface_rlc
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+  void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override {}
+  void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override {}
+};
+
+class rrc_tester : public rrc_interface_rlc
+{
+public:
+  struct rx_sdu_t {
+    uint16_t pdu_rnti;
+    uint32_t sn;
+  };
+
+  void max_retx_attempted(uint16_t rnti) override {}
+  void protocol_failure(uint16_t rnti) override {}
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    // The upcalls of the RLC workers are deferred to the stack thread
+    if (std::this_thread::get_id() != stack_thread_id) {
+      nof_upcalls_out_of_stack++;
+    }
+    TESTASSERT(sdu->N_bytes == 4);
+    rx_sdu_t rx_sdu;
+    rx_sdu.pdu_rnti = (sdu->msg[0] << 8u) | sdu->msg[1];
+    rx_sdu.sn       = (sdu->msg[2] << 8u) | sdu->msg[3];
+    rx_sdus[rnti].push_back(rx_sdu);
+    nof_rx_sdus++;
+  }
+
+  std::thread::id                             stack_thread_id = std::this_thread::get_id();
+  std::map<uint16_t, std::vector<rx_sdu_t> > rx_sdus;
+  uint32_t                                    nof_rx_sdus              = 0;
+  uint32_t                                    nof_upcalls_out_of_stack = 0;
+};
+
+struct rlc_test_bench {
+  explicit rlc_test_bench(uint32_t nof_workers) : rlc(srslog::fetch_basic_logger("RLC", false))
+  {
+    rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler(), &task_sched, nof_workers);
+  }
+
+  /// Writes nof_pdus_per_write PDUs to the RLC of the UE, in one call, and returns the next sequence number
+  uint32_t write_pdus(uint16_t rnti, uint32_t sn)
+  {
+    std::vector<std::array<uint8_t, 4> > payloads(nof_pdus_per_write);
+    std::vector<srsran::rlc_pdu_ref_t>   pdus;
+    for (auto& payload : payloads) {
+      payload = {(uint8_t)(rnti >> 8u), (uint8_t)rnti, (uint8_t)(sn >> 8u), (uint8_t)sn};
+      pdus.push_back({srb_to_lcid(lte_srb::srb0), payload.data(), (uint32_t)payload.size()});
+      sn++;
+    }
+    rlc.write_pdus(rnti, pdus);
+    return sn;
+  }
+
+  /// Runs the tasks deferred to the stack thread until nof_sdus SDUs are received. Gives up after waiting 5 seconds
+  /// in total for the workers to defer new tasks
+  bool run_stack_until(uint32_t nof_sdus)
+  {
+    const uint32_t max_waits = 5000;
+    for (uint32_t i = 0; i < max_waits and rrc.nof_rx_sdus < nof_sdus; ++i) {
+      task_sched.run_pending_tasks();
+      if (rrc.nof_rx_sdus < nof_sdus) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return rrc.nof_rx_sdus == nof_sdus;
+  }
+
+  srsran::task_scheduler task_sched;
+  mac_tester             mac;
+  pdcp_tester            pdcp;
+  rrc_tester             rrc;
+  srsenb::rlc            rlc;
+};
+
+/// Each UE shall receive all its PDUs, and only them, with the upcalls run in the stack thread
+int test_rlc_workers_split_by_rnti()
+{
+  const std::vector<uint16_t> rntis = {0x46, 0x47, 0x48, 0x49, 0x4a};
+  rlc_test_bench              bench(2);
+  for (uint16_t rnti : rntis) {
+    bench.rlc.add_user(rnti);
+  }
+
+  for (uint16_t rnti : rntis) {
+    bench.write_pdus(rnti, 0);
+  }
+  TESTASSERT(bench.run_stack_until(rntis.size() * nof_pdus_per_write));
+
+  TESTASSERT(bench.rrc.nof_upcalls_out_of_stack == 0);
+  TESTASSERT(bench.rrc.rx_sdus.size() == rntis.size());
+  for (uint16_t rnti : rntis) {
+    TESTASSERT(bench.rrc.rx_sdus[rnti].size() == nof_pdus_per_write);
+    for (const rrc_tester::rx_sdu_t& sdu : bench.rrc.rx_sdus[rnti]) {
+      TESTASSERT(sdu.pdu_rnti == rnti);
+    }
+  }
+
+  bench.rlc.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The deferred upcalls of each UE shall keep the order of its PDUs, also when the UEs share a RLC worker
+int test_rlc_workers_upcall_order()
+{
+  const std::vector<uint16_t> rntis      = {0x46, 0x47, 0x48, 0x49};
+  const uint32_t              nof_writes = 10;
+  rlc_test_bench              bench(2);
+  for (uint16_t rnti : rntis) {
+    bench.rlc.add_user(rnti);
+  }
+
+  std::map<uint16_t, uint32_t> next_sn;
+  for (uint32_t i = 0; i < nof_writes; ++i) {
+    for (uint16_t rnti : rntis) {
+      next_sn[rnti] = bench.write_pdus(rnti, next_sn[rnti]);
+    }
+    // Run the deferred tasks while the workers keep writing PDUs
+    bench.task_sched.run_pending_tasks();
+  }
+  TESTASSERT(bench.run_stack_until(rntis.size() * nof_writes * nof_pdus_per_write));
+
+  TESTASSERT(bench.rrc.nof_upcalls_out_of_stack == 0);
+  for (uint16_t rnti : rntis) {
+    const std::vector<rrc_tester::rx_sdu_t>& sdus = bench.rrc.rx_sdus[rnti];
+    TESTASSERT(sdus.size() == nof_writes * nof_pdus_per_write);
+    for (uint32_t sn = 0; sn < sdus.size(); ++sn) {
+      TESTASSERT(sdus[sn].pdu_rnti == rnti);
+      TESTASSERT(sdus[sn].sn == sn);
+    }
+  }
+
+  bench.rlc.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Stopping the RLC with PDUs still queued shall drop them, without reordering nor writing PDUs afterwards
+int test_rlc_workers_stop()
+{
+  const std::vector<uint16_t> rntis      = {0x46, 0x47, 0x48, 0x49};
+  const uint32_t              nof_writes = 10;
+  rlc_test_bench              bench(2);
+  for (uint16_t rnti : rntis) {
+    bench.rlc.add_user(rnti);
+  }
+
+  for (uint32_t i = 0; i < nof_writes; ++i) {
+    for (uint16_t rnti : rntis) {
+      bench.write_pdus(rnti, i * nof_pdus_per_write);
+    }
+  }
+  bench.rlc.stop();
+
+  // The tasks deferred before stopping still run. Each UE gets the first SDUs it was sent, in order
+  bench.task_sched.run_pending_tasks();
+  uint32_t nof_rx_sdus = bench.rrc.nof_rx_sdus;
+  TESTASSERT(nof_rx_sdus <= rntis.size() * nof_writes * nof_pdus_per_write);
+  for (auto& ue_sdus : bench.rrc.rx_sdus) {
+    for (uint32_t sn = 0; sn < ue_sdus.second.size(); ++sn) {
+      TESTASSERT(ue_sdus.second[sn].pdu_rnti == ue_sdus.first);
+      TESTASSERT(ue_sdus.second[sn].sn == sn);
+    }
+  }
+
+  // The workers were joined by stop(), so the PDUs written now are dropped and no task can be deferred anymore
+  bench.write_pdus(rntis[0], 0);
+  bench.task_sched.run_pending_tasks();
+  TESTASSERT(bench.rrc.nof_rx_sdus == nof_rx_sdus);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& logger = srslog::fetch_basic_logger("RLC", false);
+  logger.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsenb::test_rlc_workers_split_by_rnti() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_rlc_workers_upcall_order() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_rlc_workers_stop() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+
+  return SRSRAN_SUCCESS;
+}
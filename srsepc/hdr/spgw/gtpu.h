@@ -23,13 +23,21 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 namespace srsepc {
 
@@ -41,13 +49,19 @@ public:
   int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc);
   void stop();
 
-  int init_sgi(spgw_args_t* args);
-  int init_s1u(spgw_args_t* args);
-  int get_sgi();
-  int get_s1u();
-
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
+  int  init_sgi(spgw_args_t* args);
+  int  init_s1u(spgw_args_t* args);
+  int  start_sgi_workers();
+  void close_sgi();
+  int  get_sgi();
+  int  get_s1u();
+  int  get_paging_fd();
+
+  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg, srsran::udp_batch_sender& tx_batch);
+  void handle_paging_pdus();
+  void handle_s1u_pdus();
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
+  bool write_s1u_header(const srsran::gtp_fteid_t& enb_fteid, srsran::byte_buffer_t* msg, sockaddr_in& enb_addr);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
   virtual in_addr_t get_s1u_addr();
@@ -61,17 +75,51 @@ public:
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
 
-  bool m_sgi_up;
-  int  m_sgi;
+  /**
+   * Reads the downlink packets of one queue of the SGi TUN interface, and sends them to the eNBs in batches.
+   * The buffers of the packets are allocated and freed in the thread, so they come from its cache of the buffer pool.
+   */
+  class sgi_worker : public srsran::thread
+  {
+  public:
+    sgi_worker(spgw::gtpu* parent_, uint32_t idx, int sgi_fd_);
+
+  private:
+    void run_thread() override;
+    void read_pdus();
+
+    spgw::gtpu*                  parent;
+    int                          sgi_fd;
+    srsran::unique_byte_buffer_t next_pdu;
+    srsran::udp_batch_sender     tx_batch;
+  };
+
+  bool             m_sgi_up;
+  int              m_sgi;     // First queue of the TUN interface, to which the uplink packets are written
+  std::vector<int> m_sgi_fds; // All queues of the TUN interface
+  int              m_stop_fd; // Wakes up the SGi workers when the GTP-U stops
+
+  std::vector<std::unique_ptr<sgi_worker> > m_sgi_workers;
+
+  // Downlink packets of UEs without user plane, that the SGi workers pass to the SPGW thread for paging
+  int                                       m_paging_fd;
+  std::mutex                                m_paging_mutex;
+  std::vector<srsran::unique_byte_buffer_t> m_paging_pdus;
 
   bool        m_s1u_up;
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  // Uplink packets are received in batches into these buffers, and written to the SGi interface
+  std::array<srsran::unique_byte_buffer_t, srsran::udp_batch_sender::max_batch_size> m_s1u_rx_pdus;
+
+  // Protects the tunnel maps, modified by the SPGW thread and looked up by the SGi workers
+  pthread_rwlock_t m_tunnels_rwlock;
+  // Map IP to User-plane TEID for downlink traffic. Looked up for each downlink packet
+  srsran::flat_hash_map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid;
+  // IP to control TEID map. Important to check if UE is attached without an active user-plane for downlink
+  // notifications.
+  srsran::flat_hash_map<in_addr_t, uint32_t> m_ip_to_ctr_teid;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
@@ -86,6 +134,11 @@ inline int spgw::gtpu::get_s1u()
   return m_s1u;
 }
 
+inline int spgw::gtpu::get_paging_fd()
+{
+  return m_paging_fd;
+}
+
 inline in_addr_t spgw::gtpu::get_s1u_addr()
 {
   return m_s1u_addr.sin_addr.s_addr;
@@ -45,6 +45,7 @@ typedef struct {
   std::string gtpu_bind_addr;
   std::string sgi_if_addr;
   std::string sgi_if_name;
+  uint32_t    sgi_nof_queues;
   uint32_t    max_paging_queue;
 } spgw_args_t;
 
@@ -65,6 +66,9 @@ class spgw : public srsran::thread
   class gtpc;
   class gtpu;
 
+  // The GTP-U unit test drives spgw::gtpu directly
+  friend struct spgw_gtpu_test_bench;
+
 public:
   static spgw* get_instance(void);
   static void  cleanup(void);
@@ -90,6 +90,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
+  uint32_t sgi_nof_queues = 0;
   string   dns_addr;
   string   full_net_name;
   string   short_net_name;
@@ -130,6 +131,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
+    ("spgw.sgi_queues",     bpo::value<uint32_t>(&sgi_nof_queues)->default_value(1),         "Number of queues of the SGi TUN interface, each one read by a separate thread")
     ("spgw.max_paging_queue", bpo::value<uint32_t>(&max_paging_queue)->default_value(100), "Max number of packets in paging queue")
 
     ("pcap.enable",   bpo::value<bool>(&args->mme_args.s1ap_args.pcap_enable)->default_value(false),         "Enable S1AP PCAP")
@@ -294,6 +296,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->spgw_args.gtpu_bind_addr          = spgw_bind_addr;
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
+  args->spgw_args.sgi_nof_queues          = sgi_nof_queues;
   args->spgw_args.max_paging_queue        = max_paging_queue;
   args->hss_args.db_file                  = hss_db_file;
 
@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
+#include "srsran/asn1/liblte_byte_msg.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
 #include <cmath>
@@ -92,7 +93,7 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
   gtpc_interface_nas* gtpc = itf.gtpc;
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &attach_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
@@ -595,7 +596,8 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
   gtpc_interface_nas* gtpc = itf.gtpc;
   mme_interface_nas*  mme  = itf.mme;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_service_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &service_req);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_service_request_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &service_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Could not unpack service request");
     return false;
@@ -748,7 +750,7 @@ bool nas::handle_detach_request(uint32_t                m_tmsi,
   hss_interface_nas*  hss  = itf.hss;
   gtpc_interface_nas* gtpc = itf.gtpc;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &detach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &detach_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Could not unpack detach request");
     return false;
@@ -785,7 +787,7 @@ bool nas::handle_detach_request(uint32_t                m_tmsi,
     err                                               = liblte_mme_pack_detach_accept_msg(&detach_accept,
                                             LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS,
                                             sec_ctx->dl_nas_count,
-                                            (LIBLTE_BYTE_MSG_STRUCT*)nas_tx.get());
+                                            srsran::liblte_tx_byte_msg(nas_tx.get()).get());
     if (err != LIBLTE_SUCCESS) {
       nas_logger.error("Error packing Detach Accept\n");
     }
@@ -867,7 +869,7 @@ bool nas::handle_attach_request(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &attach_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
@@ -977,7 +979,7 @@ bool nas::handle_pdn_connectivity_request(srsran::byte_buffer_t* nas_rx)
 
   // Get PDN connectivity request messages
   LIBLTE_ERROR_ENUM err =
-      liblte_mme_unpack_pdn_connectivity_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx->msg, &pdn_con_req);
+      liblte_mme_unpack_pdn_connectivity_request_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &pdn_con_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS PDN Connectivity Request. Error: %s", liblte_error_text[err]);
     return false;
@@ -995,7 +997,7 @@ bool nas::handle_pdn_connectivity_request(srsran::byte_buffer_t* nas_rx)
   pdn_con_reject.proc_transaction_id                           = pdn_con_req.proc_transaction_id;
   pdn_con_reject.esm_cause                                     = LIBLTE_MME_ESM_CAUSE_SERVICE_OPTION_NOT_SUPPORTED;
 
-  err = liblte_mme_pack_pdn_connectivity_reject_msg(&pdn_con_reject, (LIBLTE_BYTE_MSG_STRUCT*)nas_tx.get());
+  err = liblte_mme_pack_pdn_connectivity_reject_msg(&pdn_con_reject, srsran::liblte_tx_byte_msg(nas_tx.get()).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing PDN connectivity reject");
     srsran::console("Error packing PDN connectivity reject\n");
@@ -1018,7 +1020,8 @@ bool nas::handle_authentication_response(srsran::byte_buffer_t* nas_rx)
   bool                                          ue_valid  = true;
 
   // Get NAS authentication response
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_authentication_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &auth_resp);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_authentication_response_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &auth_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1072,7 +1075,8 @@ bool nas::handle_security_mode_complete(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sm_comp = {};
 
   // Get NAS security mode complete
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_security_mode_complete_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &sm_comp);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_security_mode_complete_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &sm_comp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1117,7 +1121,8 @@ bool nas::handle_attach_complete(srsran::byte_buffer_t* nas_rx)
 
   // Get NAS authentication response
   std::memset(&attach_comp, 0, sizeof(attach_comp));
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_complete_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_comp);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_attach_complete_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &attach_comp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1166,7 +1171,7 @@ bool nas::handle_esm_information_response(srsran::byte_buffer_t* nas_rx)
 
   // Get NAS authentication response
   LIBLTE_ERROR_ENUM err =
-      srsran_mme_unpack_esm_information_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &esm_info_resp);
+      srsran_mme_unpack_esm_information_response_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &esm_info_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1199,7 +1204,7 @@ bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
   srsran::unique_byte_buffer_t      nas_tx;
   LIBLTE_MME_ID_RESPONSE_MSG_STRUCT id_resp;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_identity_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &id_resp);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_identity_response_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &id_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS identity response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1283,7 +1288,7 @@ bool nas::handle_authentication_failure(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT auth_fail;
   LIBLTE_ERROR_ENUM                            err;
 
-  err = liblte_mme_unpack_authentication_failure_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &auth_fail);
+  err = liblte_mme_unpack_authentication_failure_msg(srsran::liblte_rx_byte_msg(*nas_rx).get(), &auth_fail);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication failure. Error: %s", liblte_error_text[err]);
     return false;
@@ -1347,7 +1352,7 @@ bool nas::handle_detach_request(srsran::byte_buffer_t* nas_msg)
   m_logger.info("Detach request -- IMSI %015" PRIu64 "", m_emm_ctx.imsi);
   LIBLTE_MME_DETACH_REQUEST_MSG_STRUCT detach_req;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg, &detach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg(srsran::liblte_rx_byte_msg(*nas_msg).get(), &detach_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Could not unpack detach request");
     return false;
@@ -1379,7 +1384,8 @@ bool nas::pack_authentication_request(srsran::byte_buffer_t* nas_buffer)
   auth_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
   auth_req.nas_ksi.nas_ksi  = m_sec_ctx.eksi;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_authentication_request_msg(&auth_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_pack_authentication_request_msg(&auth_req, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Authentication Request");
     srsran::console("Error packing Authentication Request\n");
@@ -1393,7 +1399,8 @@ bool nas::pack_authentication_reject(srsran::byte_buffer_t* nas_buffer)
   m_logger.info("Packing Authentication Reject");
 
   LIBLTE_MME_AUTHENTICATION_REJECT_MSG_STRUCT auth_rej;
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_authentication_reject_msg(&auth_rej, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_pack_authentication_reject_msg(&auth_rej, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Authentication Reject");
     srsran::console("Error packing Authentication Reject\n");
@@ -1438,7 +1445,7 @@ bool nas::pack_security_mode_command(srsran::byte_buffer_t* nas_buffer)
 
   uint8_t           sec_hdr_type = 3;
   LIBLTE_ERROR_ENUM err          = liblte_mme_pack_security_mode_command_msg(
-      &sm_cmd, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &sm_cmd, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     srsran::console("Error packing Authentication Request\n");
     return false;
@@ -1476,7 +1483,7 @@ bool nas::pack_esm_information_request(srsran::byte_buffer_t* nas_buffer)
 
   m_sec_ctx.dl_nas_count++;
   LIBLTE_ERROR_ENUM err = srsran_mme_pack_esm_information_request_msg(
-      &esm_info_req, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &esm_info_req, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing ESM information request");
     srsran::console("Error packing ESM information request\n");
@@ -1612,7 +1619,7 @@ bool nas::pack_attach_accept(srsran::byte_buffer_t* nas_buffer)
   liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req,
                                                                   &attach_accept.esm_msg);
   liblte_mme_pack_attach_accept_msg(
-      &attach_accept, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &attach_accept, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_tx_byte_msg(nas_buffer).get());
 
   // Encrypt NAS message
   cipher_encrypt(nas_buffer);
@@ -1633,7 +1640,7 @@ bool nas::pack_identity_request(srsran::byte_buffer_t* nas_buffer)
 
   LIBLTE_MME_ID_REQUEST_MSG_STRUCT id_req;
   id_req.id_type        = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_identity_request_msg(&id_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err = liblte_mme_pack_identity_request_msg(&id_req, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Identity Request");
     srsran::console("Error packing Identity Request\n");
@@ -1676,7 +1683,7 @@ bool nas::pack_emm_information(srsran::byte_buffer_t* nas_buffer)
   uint8_t sec_hdr_type = LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED;
   m_sec_ctx.dl_nas_count++;
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_emm_information_msg(
-      &emm_info, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &emm_info, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing EMM Information");
     srsran::console("Error packing EMM Information\n");
@@ -1706,7 +1713,7 @@ bool nas::pack_service_reject(srsran::byte_buffer_t* nas_buffer, uint8_t emm_cau
   service_rej.emm_cause     = emm_cause;
 
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_service_reject_msg(
-      &service_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &service_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Service Reject");
     srsran::console("Error packing Service Reject\n");
@@ -1728,7 +1735,7 @@ bool nas::pack_tracking_area_update_reject(srsran::byte_buffer_t* nas_buffer, ui
   }
 
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_tracking_area_update_reject_msg(
-      &tau_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &tau_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, srsran::liblte_tx_byte_msg(nas_buffer).get());
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Tracking Area Update Reject");
     srsran::console("Error packing Tracking Area Update Reject\n");
@@ -22,6 +22,7 @@
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
 #include "srsepc/hdr/mme/mme.h"
 #include "srsepc/hdr/mme/s1ap.h"
+#include "srsran/asn1/liblte_byte_msg.h"
 #include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
@@ -102,7 +103,7 @@ bool s1ap_nas_transport::handle_initial_ue_message(const asn1::s1ap::init_ue_msg
   uint64_t imsi           = 0;
   uint32_t m_tmsi         = 0;
   uint32_t enb_ue_s1ap_id = init_ue->enb_ue_s1ap_id.value.value;
-  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  liblte_mme_parse_msg_header(srsran::liblte_rx_byte_msg(*nas_msg).get(), &pd, &msg_type);
 
   srsran::console("Initial UE message: %s\n", liblte_nas_msg_type_to_string(msg_type));
   m_logger.info("Initial UE message: %s", liblte_nas_msg_type_to_string(msg_type));
@@ -169,7 +170,7 @@ bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_tr
   bool msg_encrypted = false;
 
   // Parse the message security header
-  liblte_mme_parse_msg_sec_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &sec_hdr_type);
+  liblte_mme_parse_msg_sec_header(srsran::liblte_rx_byte_msg(*nas_msg).get(), &pd, &sec_hdr_type);
 
   // Invalid Security Header Type simply return function
   if (!(sec_hdr_type == LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS ||
@@ -186,7 +187,7 @@ bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_tr
   if (sec_hdr_type == LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY ||
       sec_hdr_type == LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_WITH_NEW_EPS_SECURITY_CONTEXT) {
     // Avoid unecessary warnings for identity response and authentication response.
-    liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+    liblte_mme_parse_msg_header(srsran::liblte_rx_byte_msg(*nas_msg).get(), &pd, &msg_type);
     if (msg_type == LIBLTE_MME_MSG_TYPE_IDENTITY_RESPONSE || msg_type == LIBLTE_MME_MSG_TYPE_AUTHENTICATION_RESPONSE) {
       warn_integrity_fail = false;
     }
@@ -215,7 +216,7 @@ bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_tr
   }
 
   // Now parse message header and handle message
-  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  liblte_mme_parse_msg_header(srsran::liblte_rx_byte_msg(*nas_msg).get(), &pd, &msg_type);
 
   // Find UE EMM context if message is security protected.
   if (sec_hdr_type != LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS) {
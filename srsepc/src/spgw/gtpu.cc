@@ -32,6 +32,9 @@
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
@@ -44,13 +47,15 @@ namespace srsepc {
  *
  **************************************/
 
-spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false)
+spgw::gtpu::gtpu() : m_sgi_up(false), m_stop_fd(-1), m_paging_fd(-1), m_s1u_up(false)
 {
+  pthread_rwlock_init(&m_tunnels_rwlock, nullptr);
   return;
 }
 
 spgw::gtpu::~gtpu()
 {
+  pthread_rwlock_destroy(&m_tunnels_rwlock);
   return;
 }
 
@@ -76,16 +81,54 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start one SGi worker per queue of the TUN interface
+  err = start_sgi_workers();
+  if (err != SRSRAN_SUCCESS) {
+    return err;
+  }
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
 }
 
+int spgw::gtpu::start_sgi_workers()
+{
+  m_stop_fd   = eventfd(0, 0);
+  m_paging_fd = eventfd(0, EFD_NONBLOCK);
+  if (m_stop_fd < 0 or m_paging_fd < 0) {
+    m_logger.error("Failed to create eventfd: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+  for (uint32_t i = 0; i < m_sgi_fds.size(); ++i) {
+    m_sgi_workers.emplace_back(new sgi_worker(this, i, m_sgi_fds[i]));
+    m_sgi_workers.back()->start();
+  }
+  return SRSRAN_SUCCESS;
+}
+
 void spgw::gtpu::stop()
 {
+  // Stop the SGi workers, before closing the queues they read
+  if (not m_sgi_workers.empty()) {
+    uint64_t one = 1;
+    if (write(m_stop_fd, &one, sizeof(one)) < 0) {
+      m_logger.error("Failed to stop the SGi workers: %s", strerror(errno));
+    }
+    for (std::unique_ptr<sgi_worker>& worker : m_sgi_workers) {
+      worker->wait_thread_finish();
+    }
+    m_sgi_workers.clear();
+  }
+  if (m_stop_fd >= 0) {
+    close(m_stop_fd);
+  }
+  if (m_paging_fd >= 0) {
+    close(m_paging_fd);
+  }
   // Clean up SGi interface
   if (m_sgi_up) {
-    close(m_sgi);
+    close_sgi();
   }
   // Clean up S1-U socket
   if (m_s1u_up) {
@@ -102,32 +145,42 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
 
-  // Construct the TUN device
-  m_sgi = open("/dev/net/tun", O_RDWR);
-  m_logger.info("TUN file descriptor = %d", m_sgi);
-  if (m_sgi < 0) {
-    m_logger.error("Failed to open TUN device: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-
+  // Construct the TUN device. Each queue of a multi-queue device is a separate file descriptor. The queues are
+  // non-blocking, so that the SGi workers read the waiting packets until the queue is empty
+  uint32_t nof_queues = std::max(args->sgi_nof_queues, 1U);
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (nof_queues > 1) {
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
 
-  if (ioctl(m_sgi, TUNSETIFF, &ifr) < 0) {
-    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
-    close(m_sgi);
-    return SRSRAN_ERROR_CANT_START;
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    int fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    m_logger.info("TUN file descriptor = %d", fd);
+    if (fd < 0) {
+      m_logger.error("Failed to open TUN device: %s", strerror(errno));
+      close_sgi();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_sgi_fds.push_back(fd);
+
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+      m_logger.error("Failed to set TUN device name: %s", strerror(errno));
+      close_sgi();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
+  m_sgi = m_sgi_fds[0];
 
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to bring up socket: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -135,7 +188,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to set socket flags: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -150,7 +203,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFADDR, &ifr) < 0) {
     m_logger.error(
         "Failed to set TUN interface IP. Address: %s, Error: %s", args->sgi_if_addr.c_str(), strerror(errno));
-    close(m_sgi);
+    close_sgi();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -162,17 +215,25 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
   if (ioctl(sgi_sock, SIOCSIFNETMASK, &ifr) < 0) {
     m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
-    close(m_sgi);
+    close_sgi();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
 
   close(sgi_sock);
   m_sgi_up = true;
-  m_logger.info("Initialized SGi interface");
+  m_logger.info("Initialized SGi interface with %d queues", nof_queues);
   return SRSRAN_SUCCESS;
 }
 
+void spgw::gtpu::close_sgi()
+{
+  for (int fd : m_sgi_fds) {
+    close(fd);
+  }
+  m_sgi_fds.clear();
+}
+
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
   // Open S1-U socket
@@ -196,6 +257,14 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
     m_logger.error("Failed to bind socket: %s", strerror(errno));
     return SRSRAN_ERROR_CANT_START;
   }
+  for (srsran::unique_byte_buffer_t& pdu : m_s1u_rx_pdus) {
+    pdu = srsran::make_byte_buffer("spgw::gtpu::s1u_rx");
+    if (pdu == nullptr) {
+      m_logger.error("Failed to allocate the S1-U receive buffers");
+      return SRSRAN_ERROR_CANT_START;
+    }
+  }
+
   m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
@@ -203,16 +272,88 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+/****************************************************************************
+ * SGi workers
+ ***************************************************************************/
+spgw::gtpu::sgi_worker::sgi_worker(spgw::gtpu* parent_, uint32_t idx, int sgi_fd_) :
+  thread("SPGW_SGI" + std::to_string(idx)), parent(parent_), sgi_fd(sgi_fd_), tx_batch(parent_->m_logger)
+{
+  tx_batch.set_fd(parent->m_s1u);
+}
+
+void spgw::gtpu::sgi_worker::run_thread()
+{
+  int epoll_fd = epoll_create1(0);
+  if (epoll_fd < 0) {
+    parent->m_logger.error("Failed to create epoll instance: %s", strerror(errno));
+    return;
+  }
+  for (int fd : {sgi_fd, parent->m_stop_fd}) {
+    struct epoll_event event = {};
+    event.events             = EPOLLIN;
+    event.data.fd            = fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+      parent->m_logger.error("Failed to add file descriptor to epoll: %s", strerror(errno));
+      close(epoll_fd);
+      return;
+    }
+  }
+
+  std::array<struct epoll_event, 2> events;
+  bool                              running = true;
+  while (running) {
+    int n = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+    if (n < 0 and errno != EINTR) {
+      parent->m_logger.error("Error from epoll_wait: %s", strerror(errno));
+      break;
+    }
+    for (int i = 0; i < n; ++i) {
+      if (events[i].data.fd == parent->m_stop_fd) {
+        running = false;
+      } else {
+        read_pdus();
+      }
+    }
+  }
+  close(epoll_fd);
+}
+
+void spgw::gtpu::sgi_worker::read_pdus()
+{
+  // A TUN queue returns one packet per read. The waiting packets are read until the queue is empty or there is a full
+  // batch for S1-U. In the latter case, epoll reports the queue as readable again.
+  // The buffers are allocated and, once sent, freed by this worker, so they come from its thread cache of the pool
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  for (uint32_t i = 0; i < srsran::udp_batch_sender::max_batch_size; ++i) {
+    if (next_pdu == nullptr) {
+      next_pdu = srsran::make_byte_buffer("spgw::gtpu::sgi_worker");
+      if (next_pdu == nullptr) {
+        break;
+      }
+    }
+    int n = read(sgi_fd, next_pdu->msg, buf_len);
+    if (n <= 0) {
+      if (n < 0 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        parent->m_logger.error("Error reading from TUN interface: %s", strerror(errno));
+      }
+      break;
+    }
+    next_pdu->N_bytes = n;
+    parent->handle_sgi_pdu(std::move(next_pdu), tx_batch);
+  }
+  tx_batch.flush();
+}
+
+/****************************************************************************
+ * Packet forwarding
+ ***************************************************************************/
+void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg, srsran::udp_batch_sender& tx_batch)
 {
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  srsran::gtpc_f_teid_ie enb_fteid;
+  struct iphdr*          iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -225,39 +366,127 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   }
 
   // Logging PDU info
-  m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
-  fmt::memory_buffer buffer;
-  srsran::gtpu_ntoa(buffer, iph->saddr);
-  m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
-  buffer.clear();
-  srsran::gtpu_ntoa(buffer, iph->daddr);
-  m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
-
-  // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
+  if (m_logger.debug.enabled()) {
+    m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
+    fmt::memory_buffer buffer;
+    srsran::gtpu_ntoa(buffer, iph->saddr);
+    m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
+    buffer.clear();
+    srsran::gtpu_ntoa(buffer, iph->daddr);
+    m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
   }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+
+  // Find user and control tunnel. The packets for paging are handed over to the SPGW thread while holding the lock of
+  // the tunnels, so that modify_gtpu_tunnel() finds them when it sets up the user plane tunnel
+  bool notify_paging = false;
+  {
+    srsran::rwlock_read_guard lock(m_tunnels_rwlock);
+    const srsran::gtpc_f_teid_ie* gtpu_fteid = m_ip_to_usr_teid.find(iph->daddr);
+    if (gtpu_fteid != nullptr) {
+      usr_found = true;
+      enb_fteid = *gtpu_fteid;
+    }
+    ctr_found = m_ip_to_ctr_teid.contains(iph->daddr);
+    if (usr_found == false && ctr_found == true) {
+      std::lock_guard<std::mutex> paging_lock(m_paging_mutex);
+      notify_paging = m_paging_pdus.empty();
+      m_paging_pdus.push_back(std::move(msg));
+    }
   }
 
   // Handle SGi packet
   if (usr_found == false && ctr_found == false) {
     m_logger.debug("Packet for unknown UE.");
   } else if (usr_found == false && ctr_found == true) {
+    /*
+     * The paging procedure runs in the SPGW thread, which keeps the packet in the paging queue of the UE.
+     * The packet is deallocated after gtpu::send_all_queued_packets() sends it, or at gtpc::free_all_queued_packets,
+     * which is called when the Downlink Data Notification procedure fails (see
+     * handle_downlink_data_notification_acknowledgment and handle_downlink_data_notification_failure)
+     */
     m_logger.debug("Packet for attached UE that is not ECM connected.");
-    m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
-    return;
+    uint64_t one = 1;
+    if (notify_paging and write(m_paging_fd, &one, sizeof(one)) < 0) {
+      m_logger.error("Failed to notify packet for paging: %s", strerror(errno));
+    }
   } else if (usr_found == true && ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    sockaddr_in enb_addr;
+    if (write_s1u_header(enb_fteid, msg.get(), enb_addr)) {
+      tx_batch.push(std::move(msg), enb_addr);
+    }
+  }
+}
+
+void spgw::gtpu::handle_paging_pdus()
+{
+  uint64_t nof_notifications;
+  if (read(m_paging_fd, &nof_notifications, sizeof(nof_notifications)) < 0 and errno != EAGAIN) {
+    m_logger.error("Failed to read paging notifications: %s", strerror(errno));
+  }
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  {
+    std::lock_guard<std::mutex> lock(m_paging_mutex);
+    pdus.swap(m_paging_pdus);
+  }
+
+  for (srsran::unique_byte_buffer_t& msg : pdus) {
+    struct iphdr*       iph       = (struct iphdr*)msg->msg;
+    bool                usr_found = false;
+    bool                ctr_found = false;
+    srsran::gtp_fteid_t enb_fteid;
+    uint32_t            spgw_teid;
+    {
+      srsran::rwlock_read_guard lock(m_tunnels_rwlock);
+      const srsran::gtp_fteid_t* gtpu_fteid = m_ip_to_usr_teid.find(iph->daddr);
+      if (gtpu_fteid != nullptr) {
+        usr_found = true;
+        enb_fteid = *gtpu_fteid;
+      }
+      const uint32_t* gtpc_teid = m_ip_to_ctr_teid.find(iph->daddr);
+      if (gtpc_teid != nullptr) {
+        ctr_found = true;
+        spgw_teid = *gtpc_teid;
+      }
+    }
+
+    if (usr_found and ctr_found) {
+      // The user plane was set up after the SGi worker looked up the tunnel
+      send_s1u_pdu(enb_fteid, msg.get());
+    } else if (ctr_found) {
+      m_logger.debug("Triggering Donwlink Notification Requset.");
+      m_gtpc->send_downlink_data_notification(spgw_teid);
+      m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
+    } else {
+      m_logger.debug("Packet for unknown UE.");
+    }
+  }
+}
+
+void spgw::gtpu::handle_s1u_pdus()
+{
+  std::array<struct mmsghdr, srsran::udp_batch_sender::max_batch_size> msgs;
+  std::array<struct iovec, srsran::udp_batch_sender::max_batch_size>   iovs;
+  for (uint32_t i = 0; i < msgs.size(); ++i) {
+    m_s1u_rx_pdus[i]->clear();
+    iovs[i].iov_base           = m_s1u_rx_pdus[i]->msg;
+    iovs[i].iov_len            = m_s1u_rx_pdus[i]->get_tailroom();
+    msgs[i]                    = {};
+    msgs[i].msg_hdr.msg_iov    = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = recvmmsg(m_s1u, msgs.data(), msgs.size(), MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno != EAGAIN and errno != EWOULDBLOCK) {
+      m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+    }
+    return;
+  }
+  for (int i = 0; i < n; ++i) {
+    m_s1u_rx_pdus[i]->N_bytes = msgs[i].msg_len;
+    handle_s1u_pdu(m_s1u_rx_pdus[i].get());
   }
 }
 
@@ -268,19 +497,30 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
+  // The TUN queue is non-blocking. When it is full, wait for room instead of dropping the packet
   int n = write(m_sgi, msg->msg, msg->N_bytes);
+  while (n < 0 and (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)) {
+    struct pollfd pfd = {};
+    pfd.fd            = m_sgi;
+    pfd.events        = POLLOUT;
+    if (poll(&pfd, 1, -1) < 0 and errno != EINTR) {
+      break;
+    }
+    n = write(m_sgi, msg->msg, msg->N_bytes);
+  }
   if (n < 0) {
-    m_logger.error("Could not write to TUN interface.");
+    m_logger.error("Could not write to TUN interface: %s", strerror(errno));
   } else {
     m_logger.debug("Forwarded packet to TUN interface. Bytes= %d/%d", n, msg->N_bytes);
   }
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+bool spgw::gtpu::write_s1u_header(const srsran::gtp_fteid_t& enb_fteid,
+                                  srsran::byte_buffer_t*     msg,
+                                  sockaddr_in&               enb_addr)
 {
   // Set eNB destination address
-  struct sockaddr_in enb_addr;
   enb_addr.sin_family      = AF_INET;
   enb_addr.sin_port        = htons(GTPU_RX_PORT);
   enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
@@ -296,23 +536,27 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
 
   // Write header into packet
-  int n;
   if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return false;
+  }
+  return true;
+}
+
+void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+{
+  struct sockaddr_in enb_addr;
+  if (not write_s1u_header(enb_fteid, msg, enb_addr)) {
+    return;
   }
 
   // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
+  int n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
   if (n < 0) {
     m_logger.error("Error sending packet to eNB");
   } else if ((unsigned int)n != msg->N_bytes) {
     m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
   }
-
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
@@ -340,17 +584,29 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
+  srsran::rwlock_write_guard lock(m_tunnels_rwlock);
   m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
   m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+
+  // The SGi workers send the new packets of the UE through the tunnel as soon as the lock is released. The packets
+  // they handed over for paging before are sent first, so that they are not overtaken
+  std::lock_guard<std::mutex> paging_lock(m_paging_mutex);
+  for (srsran::unique_byte_buffer_t& msg : m_paging_pdus) {
+    struct iphdr* iph = (struct iphdr*)msg->msg;
+    if (iph->daddr == ue_ipv4) {
+      send_s1u_pdu(dw_user_fteid, msg.get());
+      msg.reset();
+    }
+  }
+  m_paging_pdus.erase(std::remove(m_paging_pdus.begin(), m_paging_pdus.end(), nullptr), m_paging_pdus.end());
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  srsran::rwlock_write_guard lock(m_tunnels_rwlock);
+  if (not m_ip_to_usr_teid.erase(ue_ipv4)) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
@@ -360,9 +616,8 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  srsran::rwlock_write_guard lock(m_tunnels_rwlock);
+  if (not m_ip_to_ctr_teid.erase(ue_ipv4)) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
@@ -0,0 +1,342 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <linux/ip.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+
+/*
+ * Tests the user plane of the SPGW GTP-U: the batched S1-U reception, the SGi workers reading the queues of the SGi
+ * interface, and the hand-over of the packets for paging to the SPGW thread. Each queue of the SGi interface is a
+ * packet socket pair instead of a TUN queue, and the eNB is a UDP socket on the loopback interface.
+ */
+
+namespace srsepc {
+
+static const char*    spgw_addr     = "127.0.1.1";
+static const char*    enb_addr      = "127.0.1.2";
+static const char*    ue_addr       = "172.16.0.2";
+static const uint32_t enb_teid      = 0x10;
+static const uint32_t spgw_ctr_teid = 0x20;
+static const uint32_t nof_queues    = 2;
+
+class gtpc_tester : public gtpc_interface_gtpu
+{
+public:
+  bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override
+  {
+    queued_pdus.push_back(std::move(msg));
+    return true;
+  }
+  bool send_downlink_data_notification(uint32_t spgw_ctr_teid) override
+  {
+    notified_teids.push_back(spgw_ctr_teid);
+    return true;
+  }
+
+  std::vector<srsran::unique_byte_buffer_t> queued_pdus;
+  std::vector<uint32_t>                     notified_teids;
+};
+
+/// Downlink IP packet for the UE, carrying the SGi queue it is written to and a sequence number
+struct test_ip_pdu_t {
+  struct iphdr iph;
+  uint32_t     queue_idx;
+  uint32_t     sn;
+};
+
+struct spgw_gtpu_test_bench {
+  spgw_gtpu_test_bench()
+  {
+    gtpu.m_gtpc = &gtpc;
+
+    spgw_args_t args    = {};
+    args.gtpu_bind_addr = spgw_addr;
+    TESTASSERT(gtpu.init_s1u(&args) == SRSRAN_SUCCESS);
+
+    // The SPGW reads and writes one end of each socket pair, which is non-blocking like a TUN queue. The test uses the
+    // other end
+    for (uint32_t i = 0; i < nof_queues; ++i) {
+      int fds[2];
+      TESTASSERT(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, fds) == 0);
+      gtpu.m_sgi_fds.push_back(fds[0]);
+      sgi_peer_fds.push_back(fds[1]);
+    }
+    gtpu.m_sgi = gtpu.m_sgi_fds[0];
+    TESTASSERT(gtpu.start_sgi_workers() == SRSRAN_SUCCESS);
+
+    enb_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    TESTASSERT(enb_fd >= 0);
+    sockaddr_in addr = {};
+    TESTASSERT(srsran::net_utils::set_sockaddr(&addr, enb_addr, GTPU_RX_PORT));
+    TESTASSERT(bind(enb_fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    struct timeval timeout = {1, 0};
+    setsockopt(enb_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    inet_pton(AF_INET, ue_addr, &ue_ip);
+    inet_pton(AF_INET, enb_addr, &enb_fteid.ipv4);
+    enb_fteid.teid = enb_teid;
+  }
+  ~spgw_gtpu_test_bench()
+  {
+    gtpu.stop();
+    for (uint32_t i = 0; i < nof_queues; ++i) {
+      close(gtpu.m_sgi_fds[i]);
+      close(sgi_peer_fds[i]);
+    }
+    close(enb_fd);
+  }
+
+  /// Writes a downlink packet for the UE to a queue of the SGi interface
+  void write_sgi_pdu(uint32_t queue_idx, uint32_t sn)
+  {
+    test_ip_pdu_t pdu = {};
+    pdu.iph.version   = 4;
+    pdu.iph.ihl       = 5;
+    pdu.iph.tot_len   = htons(sizeof(pdu));
+    pdu.iph.daddr     = ue_ip;
+    pdu.queue_idx     = queue_idx;
+    pdu.sn            = sn;
+    TESTASSERT(write(sgi_peer_fds[queue_idx], &pdu, sizeof(pdu)) == (ssize_t)sizeof(pdu));
+  }
+
+  /// Sends an uplink packet from the eNB to S1-U, which carries a sequence number
+  void send_s1u_pdu(uint32_t sn)
+  {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    memcpy(pdu->msg, &sn, sizeof(sn));
+    pdu->N_bytes = sizeof(sn);
+
+    srsran::gtpu_header_t header = {};
+    header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type          = GTPU_MSG_DATA_PDU;
+    header.length                = pdu->N_bytes;
+    header.teid                  = 0x1;
+    TESTASSERT(srsran::gtpu_write_header(&header, pdu.get(), gtpu.m_logger));
+    sockaddr_in spgw_s1u_addr = {};
+    TESTASSERT(srsran::net_utils::set_sockaddr(&spgw_s1u_addr, spgw_addr, GTPU_RX_PORT));
+    TESTASSERT(sendto(enb_fd, pdu->msg, pdu->N_bytes, 0, (struct sockaddr*)&spgw_s1u_addr, sizeof(sockaddr_in)) ==
+               (int)pdu->N_bytes);
+  }
+
+  /// Receives a downlink packet at the eNB, and checks its TEID
+  test_ip_pdu_t recv_enb_pdu()
+  {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    int n = recv(enb_fd, pdu->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET, 0);
+    TESTASSERT(n > 0);
+    pdu->N_bytes = n;
+
+    srsran::gtpu_header_t header;
+    TESTASSERT(srsran::gtpu_read_header(pdu.get(), &header, gtpu.m_logger));
+    TESTASSERT(header.teid == enb_teid);
+    TESTASSERT(pdu->N_bytes == sizeof(test_ip_pdu_t));
+    test_ip_pdu_t ip_pdu;
+    memcpy(&ip_pdu, pdu->msg, sizeof(ip_pdu));
+    return ip_pdu;
+  }
+
+  /// Waits until the SGi workers have handed over nof_pdus packets for paging
+  bool wait_paging_pdus(uint32_t nof_pdus)
+  {
+    for (uint32_t i = 0; i < 1000; ++i) {
+      {
+        std::lock_guard<std::mutex> lock(gtpu.m_paging_mutex);
+        if (gtpu.m_paging_pdus.size() == nof_pdus) {
+          return true;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  spgw::gtpu          gtpu;
+  gtpc_tester         gtpc;
+  std::vector<int>    sgi_peer_fds;
+  int                 enb_fd = -1;
+  in_addr_t           ue_ip  = 0;
+  srsran::gtp_fteid_t enb_fteid;
+};
+
+/// The uplink packets received in batches from S1-U shall be written to the SGi interface in order
+int test_s1u_rx_batches()
+{
+  spgw_gtpu_test_bench bench;
+  const uint32_t       nof_pdus = srsran::udp_batch_sender::max_batch_size + 8;
+
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    bench.send_s1u_pdu(sn);
+  }
+
+  // One reception reads at most a batch
+  uint32_t nof_rx_batches = 0;
+  uint32_t next_sn        = 0;
+  while (next_sn < nof_pdus and nof_rx_batches < 100) {
+    struct pollfd pfd = {bench.gtpu.get_s1u(), POLLIN, 0};
+    TESTASSERT(poll(&pfd, 1, 1000) == 1);
+    bench.gtpu.handle_s1u_pdus();
+    nof_rx_batches++;
+
+    uint32_t sn;
+    while (read(bench.sgi_peer_fds[0], &sn, sizeof(sn)) == (ssize_t)sizeof(sn)) {
+      TESTASSERT(sn == next_sn);
+      next_sn++;
+    }
+  }
+  TESTASSERT(next_sn == nof_pdus);
+  TESTASSERT(nof_rx_batches >= 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The uplink packets shall wait for room in a full SGi queue instead of being dropped
+int test_s1u_rx_sgi_full()
+{
+  spgw_gtpu_test_bench bench;
+  const uint32_t       nof_pdus = 4;
+  const uint32_t       filler   = UINT32_MAX;
+
+  // Fill the SGi queue, so that the SPGW writes would block
+  while (write(bench.gtpu.m_sgi, &filler, sizeof(filler)) == (ssize_t)sizeof(filler)) {
+  }
+  TESTASSERT(errno == EAGAIN or errno == EWOULDBLOCK);
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    bench.send_s1u_pdu(sn);
+  }
+
+  // The SGi interface only starts to be read after the SPGW found the queue full
+  std::atomic<uint32_t> next_sn{0};
+  std::thread           sgi_reader([&bench, &next_sn, nof_pdus, filler]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (uint32_t i = 0; i < 2000 and next_sn < nof_pdus; ++i) {
+      uint32_t sn;
+      while (read(bench.sgi_peer_fds[0], &sn, sizeof(sn)) == (ssize_t)sizeof(sn)) {
+        if (sn != filler) {
+          TESTASSERT(sn == next_sn);
+          next_sn++;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  for (uint32_t i = 0; i < 100 and next_sn < nof_pdus; ++i) {
+    struct pollfd pfd = {bench.gtpu.get_s1u(), POLLIN, 0};
+    if (poll(&pfd, 1, 10) == 1) {
+      bench.gtpu.handle_s1u_pdus();
+    }
+  }
+  sgi_reader.join();
+  TESTASSERT(next_sn == nof_pdus);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The SGi workers shall send the downlink packets of each queue through the tunnel of the UE, in order
+int test_sgi_workers()
+{
+  spgw_gtpu_test_bench bench;
+  const uint32_t       nof_pdus = 100;
+
+  bench.gtpu.modify_gtpu_tunnel(bench.ue_ip, bench.enb_fteid, spgw_ctr_teid);
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    for (uint32_t q = 0; q < nof_queues; ++q) {
+      bench.write_sgi_pdu(q, sn);
+    }
+  }
+
+  std::array<uint32_t, nof_queues> next_sn = {};
+  for (uint32_t i = 0; i < nof_pdus * nof_queues; ++i) {
+    test_ip_pdu_t pdu = bench.recv_enb_pdu();
+    TESTASSERT(pdu.queue_idx < nof_queues);
+    TESTASSERT(pdu.sn == next_sn[pdu.queue_idx]);
+    next_sn[pdu.queue_idx]++;
+  }
+  TESTASSERT(bench.gtpc.notified_teids.empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The downlink packets of a UE without user plane shall trigger paging, and shall not be overtaken by the packets sent
+/// once the user plane is set up
+int test_sgi_paging()
+{
+  spgw_gtpu_test_bench bench;
+  const uint32_t       nof_pdus = 10;
+
+  // Attached UE, not ECM connected
+  bench.gtpu.modify_gtpu_tunnel(bench.ue_ip, bench.enb_fteid, spgw_ctr_teid);
+  bench.gtpu.delete_gtpu_tunnel(bench.ue_ip);
+
+  // The SPGW thread notifies GTP-C of the packets for paging
+  bench.write_sgi_pdu(0, 0);
+  TESTASSERT(bench.wait_paging_pdus(1));
+  struct pollfd pfd = {bench.gtpu.get_paging_fd(), POLLIN, 0};
+  TESTASSERT(poll(&pfd, 1, 1000) == 1);
+  bench.gtpu.handle_paging_pdus();
+  TESTASSERT(bench.gtpc.notified_teids.size() == 1 and bench.gtpc.notified_teids[0] == spgw_ctr_teid);
+  TESTASSERT(bench.gtpc.queued_pdus.size() == 1);
+
+  // The user plane is set up before the SPGW thread handles the packets for paging. They are sent first
+  for (uint32_t sn = 1; sn <= nof_pdus; ++sn) {
+    bench.write_sgi_pdu(0, sn);
+  }
+  TESTASSERT(bench.wait_paging_pdus(nof_pdus));
+  bench.gtpu.modify_gtpu_tunnel(bench.ue_ip, bench.enb_fteid, spgw_ctr_teid);
+  for (uint32_t sn = nof_pdus + 1; sn <= 2 * nof_pdus; ++sn) {
+    bench.write_sgi_pdu(0, sn);
+  }
+  for (uint32_t sn = 1; sn <= 2 * nof_pdus; ++sn) {
+    TESTASSERT(bench.recv_enb_pdu().sn == sn);
+  }
+  bench.gtpu.handle_paging_pdus();
+  TESTASSERT(bench.gtpc.notified_teids.size() == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsepc
+
+int main(int argc, char** argv)
+{
+  auto& logger = srslog::fetch_basic_logger("GTPU", false);
+  logger.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsepc::test_s1u_rx_batches() == SRSRAN_SUCCESS);
+  TESTASSERT(srsepc::test_s1u_rx_sgi_full() == SRSRAN_SUCCESS);
+  TESTASSERT(srsepc::test_sgi_workers() == SRSRAN_SUCCESS);
+  TESTASSERT(srsepc::test_sgi_paging() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+
+  return SRSRAN_SUCCESS;
+}
@@ -50,6 +50,7 @@ struct gnb_stack_args_t {
   mac_nr_args_t    mac;
   ngap_args_t      ngap;
   pcap_args_t      ngap_pcap;
+  uint32_t         rlc_nof_workers = 0;
 };
 
 class gnb_stack_nr final : public srsenb::enb_stack_base,
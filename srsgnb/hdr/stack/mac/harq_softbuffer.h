@@ -22,6 +22,7 @@
 #ifndef SRSRAN_HARQ_SOFTBUFFER_H
 #define SRSRAN_HARQ_SOFTBUFFER_H
 
+#include "srsenb/hdr/stack/mac/common/softbuffer_pool.h"
 #include "srsran/adt/pool/pool_interface.h"
 #include "srsran/adt/span.h"
 extern "C" {
@@ -128,9 +129,22 @@ public:
 
   void init_pool(uint32_t nof_prb, uint32_t batch_size = MAX_HARQ * 4, uint32_t thres = 0, uint32_t init_size = 0);
 
+  /// Reserves the code blocks of maximum size TBs in all the HARQ processes of nof_ues UEs. The code block pools do
+  /// not grow when the HARQ softbuffers are bound in the workers
+  void reserve_cbs(uint32_t nof_prb, uint32_t nof_ues);
+
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
+  /// HARQ process softbuffers, which only hold code blocks of the shared pools while a TB is in flight
+  pooled_softbuffer_tx make_harq_tx();
+  pooled_softbuffer_rx make_harq_rx();
+
+  /// Number of code blocks of a TB of tbs bits, for the LDPC base graph that requires the most
+  static uint32_t nof_cbs(uint32_t tbs);
+
+  void get_metrics(mac_softbuffer_pool_metrics_t& tx_metrics, mac_softbuffer_pool_metrics_t& rx_metrics);
+
   static harq_softbuffer_pool& get_instance()
   {
     static harq_softbuffer_pool pool;
@@ -140,7 +154,10 @@ public:
 private:
   const static uint32_t MAX_HARQ = 16;
 
-  harq_softbuffer_pool() = default;
+  harq_softbuffer_pool();
+
+  softbuffer_cb_pool tx_cb_pool;
+  softbuffer_cb_pool rx_cb_pool;
 
   std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> tx_pool;
   std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> rx_pool;
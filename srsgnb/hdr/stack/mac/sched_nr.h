@@ -29,6 +29,7 @@
 #include "srsran/adt/pool/circular_stack_pool.h"
 #include "srsran/common/slot_point.h"
 #include <array>
+#include <deque>
 extern "C" {
 #include "srsran/config.h"
 }
@@ -73,6 +74,10 @@ private:
   int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
   int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
 
+  void      start_slot(slot_point slot_tx);
+  dl_res_t* run_cc_slot(slot_point slot_tx, uint32_t cc);
+  void      run_pipelined_slot(slot_point slot_tx);
+
   // args
   sched_nr_impl::sched_params_t cfg;
   srslog::basic_logger*         logger = nullptr;
@@ -89,6 +94,13 @@ private:
   using ue_map_t = sched_nr_impl::ue_map_t;
   ue_map_t ue_db;
 
+  // Removed UEs, kept until the PHY consumed the results of the slots in which they were scheduled
+  struct removed_ue_t {
+    slot_point                   last_slot_tx;
+    sched_nr_impl::unique_ue_ptr u;
+  };
+  std::deque<removed_ue_t> removed_ues;
+
   // Feedback management
   class event_manager;
   std::unique_ptr<event_manager> pending_events;
@@ -96,6 +108,10 @@ private:
   // metrics extraction
   class ue_metrics_manager;
   std::unique_ptr<ue_metrics_manager> metrics_handler;
+
+  // Scheduler thread running ahead of the PHY, when pipelined
+  class slot_pipeline;
+  std::unique_ptr<slot_pipeline> pipeline;
 };
 
 } // namespace srsenb
@@ -68,6 +68,7 @@ public:
 protected:
   bool new_tx(slot_point slot_tx, slot_point slot_ack, const prb_grant& grant, uint32_t mcs, uint32_t max_retx);
   bool new_retx(slot_point slot_tx, slot_point slot_ack, const prb_grant& grant);
+  void cancel_new_tx();
 
   struct tb_t {
     bool     active    = false;
@@ -90,9 +91,13 @@ class dl_harq_proc : public harq_proc
 public:
   dl_harq_proc(uint32_t id_, uint32_t nprb);
 
-  tx_harq_softbuffer&           get_softbuffer() { return *softbuffer; }
+  pooled_softbuffer_tx&         get_softbuffer() { return softbuffer; }
   srsran::unique_byte_buffer_t* get_tx_pdu() { return &pdu; }
 
+  int  ack_info(uint32_t tb_idx, bool ack);
+  bool clear_if_maxretx(slot_point slot_rx);
+  bool set_tbs(uint32_t tbs);
+
   bool new_tx(slot_point          slot_tx,
               slot_point          slot_ack,
               const prb_grant&    grant,
@@ -102,36 +107,40 @@ public:
 
   bool new_retx(slot_point slot_tx, slot_point slot_ack, const prb_grant& grant, srsran_dci_dl_nr_t& dci);
 
+  /// Reverts new_tx() when the transmission could not be allocated. The code blocks are returned to the pool
+  void cancel_new_tx();
+
 private:
   void fill_dci(srsran_dci_dl_nr_t& dci);
 
-  srsran::unique_pool_ptr<tx_harq_softbuffer> softbuffer;
-  srsran::unique_byte_buffer_t                pdu;
+  pooled_softbuffer_tx         softbuffer;
+  srsran::unique_byte_buffer_t pdu;
 };
 
 class ul_harq_proc : public harq_proc
 {
 public:
   ul_harq_proc(uint32_t id_, uint32_t nprb) :
-    harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().get_rx(nprb))
+    harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().make_harq_rx())
   {}
 
   bool new_tx(slot_point slot_tx, const prb_grant& grant, uint32_t mcs, uint32_t max_retx, srsran_dci_ul_nr_t& dci);
 
   bool new_retx(slot_point slot_tx, const prb_grant& grant, srsran_dci_ul_nr_t& dci);
 
-  rx_harq_softbuffer& get_softbuffer() { return *softbuffer; }
+  /// Reverts new_tx() when the transmission could not be allocated. The code blocks are returned to the pool
+  void cancel_new_tx();
 
-  bool set_tbs(uint32_t tbs)
-  {
-    softbuffer->reset(tbs);
-    return harq_proc::set_tbs(tbs);
-  }
+  pooled_softbuffer_rx& get_softbuffer() { return softbuffer; }
+
+  int  ack_info(uint32_t tb_idx, bool ack);
+  bool clear_if_maxretx(slot_point slot_rx);
+  bool set_tbs(uint32_t tbs);
 
 private:
   void fill_dci(srsran_dci_ul_nr_t& dci);
 
-  srsran::unique_pool_ptr<rx_harq_softbuffer> softbuffer;
+  pooled_softbuffer_rx softbuffer;
 };
 
 class harq_entity
@@ -35,14 +35,15 @@
 
 namespace srsenb {
 
-const static size_t   SCHED_NR_MAX_CARRIERS     = 4;
-const static uint16_t SCHED_NR_INVALID_RNTI     = 0;
-const static size_t   SCHED_NR_MAX_NOF_RBGS     = 18;
-const static size_t   SCHED_NR_MAX_TB           = 1;
-const static size_t   SCHED_NR_MAX_HARQ         = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
-const static size_t   SCHED_NR_MAX_BWP_PER_CELL = 2;
-const static size_t   SCHED_NR_MAX_LCID         = srsran::MAX_NR_NOF_BEARERS;
-const static size_t   SCHED_NR_MAX_LC_GROUP     = 7;
+const static size_t   SCHED_NR_MAX_CARRIERS       = 4;
+const static uint16_t SCHED_NR_INVALID_RNTI       = 0;
+const static size_t   SCHED_NR_MAX_NOF_RBGS       = 18;
+const static size_t   SCHED_NR_MAX_TB             = 1;
+const static size_t   SCHED_NR_MAX_HARQ           = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
+const static size_t   SCHED_NR_MAX_BWP_PER_CELL   = 2;
+const static size_t   SCHED_NR_MAX_LCID           = srsran::MAX_NR_NOF_BEARERS;
+const static size_t   SCHED_NR_MAX_LC_GROUP       = 7;
+const static uint32_t SCHED_NR_MAX_PIPELINE_DEPTH = 4;
 
 struct sched_nr_ue_cc_cfg_t {
   bool     active = false;
@@ -123,6 +124,11 @@ public:
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
     std::string logger_name        = "MAC-NR";
+    /// Number of slots that a dedicated scheduler thread runs ahead of the PHY. 0 schedules each slot within the
+    /// PHY get_dl_sched() call
+    uint32_t pipeline_depth = 0;
+    /// Number of UEs whose HARQ softbuffers for maximum size TBs are reserved when the cells are configured
+    uint32_t nof_softbuffer_ues = 4;
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
@@ -146,7 +146,7 @@ public:
 
   /// UE state feedback
   void ul_bsr(uint32_t lcg, uint32_t bsr_val) { buffers.ul_bsr(lcg, bsr_val); }
-  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY; }
+  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY - sched_cfg.sched_cfg.pipeline_depth; }
 
   bool has_ca() const
   {
@@ -47,6 +47,7 @@ public:
   void dl_rach_info(const sched_nr_interface::rar_info_t& rar_info);
 
   dl_sched_res_t* run_slot(slot_point pdcch_slot, ue_map_t& ue_db_);
+  dl_sched_res_t* get_dl_sched(slot_point sl);
   ul_sched_t*     get_ul_sched(slot_point sl);
 
   // const params
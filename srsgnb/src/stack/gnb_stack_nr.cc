@@ -102,7 +102,7 @@ int gnb_stack_nr::init(const gnb_stack_args_t& args_,
     return SRSRAN_ERROR;
   }
 
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
+  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler(), &task_sched, args.rlc_nof_workers);
 
   if (rrc.init(rrc_cfg_, phy, &mac, &rlc, &pdcp, ngap.get(), gtpu.get(), *bearer_manager, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
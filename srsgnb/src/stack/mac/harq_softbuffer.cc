@@ -21,9 +21,17 @@
 
 #include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsran/adt/pool/obj_pool.h"
+extern "C" {
+#include "srsran/phy/fec/cbsegm.h"
+}
 
 namespace srsenb {
 
+harq_softbuffer_pool::harq_softbuffer_pool() :
+  tx_cb_pool(SRSRAN_LDPC_MAX_LEN_ENCODED_CB),
+  rx_cb_pool(softbuffer_cb_pool::rx_block_size(SRSRAN_LDPC_MAX_LEN_ENCODED_CB))
+{}
+
 void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint32_t thres, uint32_t init_size)
 {
   srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid nof prb=%d", nof_prb);
@@ -48,6 +56,14 @@ void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint
       batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
 }
 
+void harq_softbuffer_pool::reserve_cbs(uint32_t nof_prb, uint32_t nof_ues)
+{
+  uint32_t nof_cb = nof_ues * MAX_HARQ * nof_cbs(nof_prb * SRSRAN_MAX_NRE_NR * SRSRAN_MAX_QM);
+  srsran_always_assert(tx_cb_pool.reserve(nof_cb) and rx_cb_pool.reserve(nof_cb),
+                       "Failed to allocate the HARQ softbuffers of %d UEs",
+                       nof_ues);
+}
+
 srsran::unique_pool_ptr<tx_harq_softbuffer> harq_softbuffer_pool::get_tx(uint32_t nof_prb)
 {
   srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
@@ -68,4 +84,34 @@ srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx(uint32_
   return rx_pool[idx]->make();
 }
 
+pooled_softbuffer_tx harq_softbuffer_pool::make_harq_tx()
+{
+  return pooled_softbuffer_tx(tx_cb_pool, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC);
+}
+
+pooled_softbuffer_rx harq_softbuffer_pool::make_harq_rx()
+{
+  return pooled_softbuffer_rx(rx_cb_pool, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC);
+}
+
+uint32_t harq_softbuffer_pool::nof_cbs(uint32_t tbs)
+{
+  srsran_cbsegm_t cbsegm = {};
+  uint32_t        nof_cb = 0;
+  if (srsran_cbsegm_ldpc_bg1(&cbsegm, tbs) == SRSRAN_SUCCESS) {
+    nof_cb = cbsegm.C;
+  }
+  if (srsran_cbsegm_ldpc_bg2(&cbsegm, tbs) == SRSRAN_SUCCESS) {
+    nof_cb = std::max(nof_cb, cbsegm.C);
+  }
+  return nof_cb;
+}
+
+void harq_softbuffer_pool::get_metrics(mac_softbuffer_pool_metrics_t& tx_metrics,
+                                       mac_softbuffer_pool_metrics_t& rx_metrics)
+{
+  tx_cb_pool.get_metrics(tx_metrics);
+  rx_cb_pool.get_metrics(rx_metrics);
+}
+
 } // namespace srsenb
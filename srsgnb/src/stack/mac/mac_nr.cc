@@ -20,6 +20,7 @@
  */
 
 #include "srsgnb/hdr/stack/mac/mac_nr.h"
+#include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsgnb/hdr/stack/mac/sched_nr.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/phy_cfg_nr_default.h"
@@ -287,6 +288,7 @@ void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].pci : 0;
   }
+  harq_softbuffer_pool::get_instance().get_metrics(metrics.dl_softbuffers, metrics.ul_softbuffers);
 }
 
 int mac_nr::cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells)
@@ -550,6 +552,9 @@ mac_nr::ul_sched_t* mac_nr::get_ul_sched(const srsran_slot_cfg_t& slot_cfg)
 {
   slot_point  pusch_slot = srsran::slot_point{NUMEROLOGY_IDX, slot_cfg.idx};
   ul_sched_t* ul_sched   = sched->get_ul_sched(pusch_slot, 0);
+  if (ul_sched == nullptr) {
+    return nullptr;
+  }
 
   srsran::rwlock_read_guard rw_lock(rwmutex);
   for (auto& pusch : ul_sched->pusch) {
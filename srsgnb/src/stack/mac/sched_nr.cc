@@ -27,6 +27,8 @@
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/threads.h"
+#include <chrono>
 
 namespace srsenb {
 
@@ -292,6 +294,149 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Thread that generates the scheduling decisions of all carriers up to pipeline_depth slots ahead of the slot
+/// requested by the PHY. Each generated {slot, cc} result is published in a slot-indexed ring of flags, which the PHY
+/// workers check without locking. If the PHY requests a result that was not yet published, it waits for it, and the
+/// result is accounted as late.
+class sched_nr::slot_pipeline : public srsran::thread
+{
+public:
+  slot_pipeline(sched_nr& parent_, uint32_t depth_, uint32_t nof_cc_) :
+    thread("SCHED_NR"),
+    parent(parent_),
+    depth(depth_),
+    nof_cc(nof_cc_),
+    published(new std::atomic<uint32_t>[nof_cc_ * RING_SIZE]),
+    logger(*parent_.logger)
+  {
+    for (uint32_t i = 0; i < nof_cc * RING_SIZE; ++i) {
+      published[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (not running) {
+        return;
+      }
+      running = false;
+    }
+    slot_cvar.notify_one();
+    result_cvar.notify_all();
+    wait_thread_finish();
+  }
+
+  /// Called by the PHY at the start of slot_tx. The scheduler thread is allowed to run up to slot_tx + depth
+  void slot_indication(slot_point slot_tx)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (not next_slot.valid()) {
+        next_slot = slot_tx;
+      }
+      last_slot = slot_tx + depth;
+    }
+    slot_cvar.notify_one();
+  }
+
+  /// Waits until the {slot_tx, cc} result is published. Must be called after slot_indication(slot_tx)
+  /// @return false if the pipeline was stopped before the result was generated
+  bool wait_result(slot_point slot_tx, uint32_t cc, bool count_slot)
+  {
+    if (is_published(slot_tx, cc)) {
+      if (count_slot) {
+        nof_slots.fetch_add(1, std::memory_order_relaxed);
+      }
+      return true;
+    }
+
+    // The scheduler thread is running late
+    auto                         tp = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+    nof_waiting++;
+    result_cvar.wait(lock, [this, slot_tx, cc]() { return not running or is_published(slot_tx, cc); });
+    nof_waiting--;
+    if (count_slot) {
+      float wait_us = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp)
+                          .count() /
+                      1000.0f;
+      nof_slots.fetch_add(1, std::memory_order_relaxed);
+      nof_late_slots++;
+      max_wait_us = std::max(max_wait_us, wait_us);
+      logger.info("SCHED: Result for slot=%d, cc=%d was late. Waited %.1f usec", slot_tx.to_uint(), cc, wait_us);
+    }
+    return is_published(slot_tx, cc);
+  }
+
+  void get_metrics(mac_sched_pipeline_metrics_t& metrics)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.nof_slots      = nof_slots.exchange(0, std::memory_order_relaxed);
+    metrics.nof_late_slots = nof_late_slots;
+    metrics.max_wait_us    = max_wait_us;
+    nof_late_slots         = 0;
+    max_wait_us            = 0;
+  }
+
+private:
+  // The ring has the same size as the BWP resource grid, which holds the published results
+  static const uint32_t RING_SIZE = TTIMOD_SZ;
+
+  void run_thread() override
+  {
+    while (true) {
+      slot_point slot_tx;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        slot_cvar.wait(lock, [this]() { return not running or (next_slot.valid() and next_slot <= last_slot); });
+        if (not running) {
+          return;
+        }
+        slot_tx = next_slot++;
+      }
+
+      parent.run_pipelined_slot(slot_tx);
+
+      // Publish results and wake up PHY workers that are waiting for them
+      for (uint32_t cc = 0; cc < nof_cc; ++cc) {
+        published[cc * RING_SIZE + slot_tx.to_uint() % RING_SIZE].store(slot_tx.to_uint() + 1);
+      }
+      if (nof_waiting > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result_cvar.notify_all();
+      }
+    }
+  }
+
+  bool is_published(slot_point slot_tx, uint32_t cc) const
+  {
+    return published[cc * RING_SIZE + slot_tx.to_uint() % RING_SIZE].load() == slot_tx.to_uint() + 1;
+  }
+
+  sched_nr&      parent;
+  const uint32_t depth;
+  const uint32_t nof_cc;
+
+  // Ring of {slot, cc} published flags. Each position stores the slot count + 1 of its last published result
+  std::unique_ptr<std::atomic<uint32_t>[]> published;
+
+  std::mutex              mutex;
+  std::condition_variable slot_cvar, result_cvar;
+  bool                    running = true;
+  slot_point              next_slot, last_slot;
+  std::atomic<uint32_t>   nof_waiting{0};
+
+  // metrics
+  srslog::basic_logger& logger;
+  std::atomic<uint32_t> nof_slots{0};
+  uint32_t              nof_late_slots = 0;
+  float                 max_wait_us    = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 sched_nr::sched_nr() : logger(&srslog::fetch_basic_logger("MAC-NR")), metrics_handler(new ue_metrics_manager{ue_db}) {}
 
 sched_nr::~sched_nr()
@@ -301,6 +446,9 @@ sched_nr::~sched_nr()
 
 void sched_nr::stop()
 {
+  if (pipeline != nullptr) {
+    pipeline->stop();
+  }
   metrics_handler->stop();
 }
 
@@ -309,6 +457,12 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
   cfg    = sched_params_t{sched_cfg};
   logger = &srslog::fetch_basic_logger(sched_cfg.logger_name);
 
+  if (sched_cfg.pipeline_depth > SCHED_NR_MAX_PIPELINE_DEPTH) {
+    logger->error(
+        "SCHED: Invalid pipeline depth=%d (max=%d)", sched_cfg.pipeline_depth, SCHED_NR_MAX_PIPELINE_DEPTH);
+    return SRSRAN_ERROR;
+  }
+
   // Initiate UE memory pool
   ue_pool.reset(new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, sizeof(ue), 4));
 
@@ -326,6 +480,11 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  if (cfg.sched_cfg.pipeline_depth > 0) {
+    pipeline.reset(new slot_pipeline{*this, cfg.sched_cfg.pipeline_depth, (uint32_t)cfg.cells.size()});
+    pipeline->start();
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -344,6 +503,19 @@ void sched_nr::ue_cfg(uint16_t rnti, const ue_cfg_t& uecfg)
 void sched_nr::ue_rem(uint16_t rnti)
 {
   pending_events->enqueue_event("ue_rem", [this, rnti](event_manager::logger& ev_logger) {
+    auto ue_it = ue_db.find(rnti);
+    if (ue_it != ue_db.end()) {
+      // The results already generated for the UE point at its HARQ buffers, and the PHY may still read them, up to
+      // pipeline_depth slots later, or at the PUSCH slot for UL grants. The UE is destroyed once they are consumed
+      uint32_t k2 = 0;
+      for (const std::unique_ptr<ue_carrier>& ue_cc : ue_it->second->carriers) {
+        if (ue_cc != nullptr) {
+          k2 = std::max(k2, ue_cc->cfg().active_bwp().pusch_ra_list[0].K);
+        }
+      }
+      removed_ues.push_back(
+          removed_ue_t{current_slot_tx + cfg.sched_cfg.pipeline_depth + k2, std::move(ue_it->second)});
+    }
     ue_db.erase(rnti);
     logger->info("SCHED: Removed user rnti=0x%x", rnti);
     ev_logger.push("ue_rem(0x{:x})", rnti);
@@ -370,12 +542,67 @@ int sched_nr::ue_cfg_impl(uint16_t rnti, const ue_cfg_t& uecfg)
 // NOTE: there is no parallelism in these operations
 void sched_nr::slot_indication(slot_point slot_tx)
 {
+  if (pipeline != nullptr) {
+    // The slot is scheduled ahead of time by the scheduler thread
+    pipeline->slot_indication(slot_tx);
+    return;
+  }
+
   srsran_assert(worker_count.load(std::memory_order_relaxed) == 0,
                 "Call of sched slot_indication when previous TTI has not been completed");
   // mark the start of slot.
   current_slot_tx = slot_tx;
   worker_count.store(static_cast<int>(cfg.cells.size()), std::memory_order_relaxed);
 
+  start_slot(slot_tx);
+}
+
+/// Generate {pdcch_slot,cc} scheduling decision
+sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
+{
+  if (pipeline != nullptr) {
+    if (not pipeline->wait_result(pdsch_tti, cc, true)) {
+      return nullptr;
+    }
+    return cc_workers[cc]->get_dl_sched(pdsch_tti);
+  }
+
+  srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
+
+  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
+  sched_nr::dl_res_t* ret = run_cc_slot(pdsch_tti, cc);
+
+  // decrement the number of active workers
+  int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
+  srsran_assert(rem_workers >= 0, "invalid number of calls to get_dl_sched(slot, cc)");
+  if (rem_workers == 0) {
+    // Last Worker to finish slot
+    // TODO: Sync sched results with ue_db state
+  }
+
+  return ret;
+}
+
+/// Fetch {ul_slot,cc} UL scheduling decision
+sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
+{
+  if (pipeline != nullptr) {
+    // The UL result is completed when its slot is scheduled (e.g. PUCCH UCI)
+    if (not pipeline->wait_result(slot_ul, cc, false)) {
+      return nullptr;
+    }
+  }
+  return cc_workers[cc]->get_ul_sched(slot_ul);
+}
+
+/// Process feedback that is not CC-specific and prepare the CA-enabled UEs for slot_tx
+void sched_nr::start_slot(slot_point slot_tx)
+{
+  // Destroy the removed UEs whose results were all consumed by the PHY
+  while (not removed_ues.empty() and removed_ues.front().last_slot_tx < slot_tx) {
+    removed_ues.pop_front();
+  }
+
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for CA-enabled UEs
   // Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
   pending_events->process_common(ue_db);
@@ -392,44 +619,38 @@ void sched_nr::slot_indication(slot_point slot_tx)
   metrics_handler->save_metrics();
 }
 
-/// Generate {pdcch_slot,cc} scheduling decision
-sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
+/// Process CC-specific feedback and generate the {slot_tx,cc} scheduling decision
+sched_nr::dl_res_t* sched_nr::run_cc_slot(slot_point slot_tx, uint32_t cc)
 {
-  srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
-
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
   pending_events->process_cc_events(ue_db, cc);
 
   // prepare non-CA UEs internal state for new slot
   for (auto& u : ue_db) {
     if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
-      u.second->new_slot(current_slot_tx);
+      u.second->new_slot(slot_tx);
     }
   }
 
-  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
-
-  // decrement the number of active workers
-  int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
-  srsran_assert(rem_workers >= 0, "invalid number of calls to get_dl_sched(slot, cc)");
-  if (rem_workers == 0) {
-    // Last Worker to finish slot
-    // TODO: Sync sched results with ue_db state
-  }
-
-  return ret;
+  return cc_workers[cc]->run_slot(slot_tx, ue_db);
 }
 
-/// Fetch {ul_slot,cc} UL scheduling decision
-sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
+/// Generate the scheduling decisions of all CCs for slot_tx. Called from the scheduler thread, when pipelined
+void sched_nr::run_pipelined_slot(slot_point slot_tx)
 {
-  return cc_workers[cc]->get_ul_sched(slot_ul);
+  current_slot_tx = slot_tx;
+  start_slot(slot_tx);
+  for (uint32_t cc = 0; cc < cc_workers.size(); ++cc) {
+    run_cc_slot(slot_tx, cc);
+  }
 }
 
 void sched_nr::get_metrics(mac_metrics_t& metrics)
 {
   metrics_handler->get_metrics(metrics);
+  if (pipeline != nullptr) {
+    pipeline->get_metrics(metrics.sched_pipeline);
+  }
 }
 
 int sched_nr::dl_rach_info(const rar_info_t& rar_info)
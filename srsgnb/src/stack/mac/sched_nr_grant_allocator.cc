@@ -278,7 +278,20 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
     success = ue->phy().get_pusch_cfg(slot_cfg, rar_grant.msg3_dci, pusch.sch);
     srsran_assert(success, "Error converting DCI to PUSCH grant");
     pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
-    ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs);
+    if (not ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs)) {
+      // Msg3 cannot be decoded without code blocks. Cancel the RAR and the Msg3s allocated so far
+      logger.warning("SCHED: Failed to bind Msg3 softbuffer for rnti=0x%x. Postponing RAR", ue->rnti);
+      for (uint32_t i = 0; i < rar_out.grants.size(); ++i) {
+        slot_ue& msg3_ue = slot_ues[pending_rachs[i].temp_crnti];
+        msg3_ue.h_ul->cancel_new_tx();
+        msg3_ue.h_ul = nullptr;
+        bwp_msg3_slot.puschs.cancel_last_pusch();
+      }
+      bwp_pdcch_slot.dl.rar.pop_back();
+      bwp_pdcch_slot.pdschs.cancel_last_pdsch();
+      bwp_pdcch_slot.pdcchs.cancel_last_pdcch();
+      return alloc_result::other_cause;
+    }
   }
 
   return alloc_result::success;
@@ -395,7 +408,14 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   }
 
   ue.h_dl->set_mcs(mcs);
-  ue.h_dl->set_tbs(pdsch.sch.grant.tb[0].tbs); // set HARQ TBS
+  if (ue.h_dl->nof_retx() == 0 and not ue.h_dl->set_tbs(pdsch.sch.grant.tb[0].tbs)) {
+    // The new TB cannot be encoded without code blocks
+    logger.warning("SCHED: Failed to bind DL softbuffer for rnti=0x%x. Cancelling PDSCH allocation", ue->rnti);
+    ue.h_dl->cancel_new_tx();
+    bwp_pdcch_slot.pdschs.cancel_last_pdsch();
+    bwp_pdcch_slot.pdcchs.cancel_last_pdcch();
+    return alloc_result::other_cause;
+  }
   pdsch.sch.grant.tb[0].softbuffer.tx = ue.h_dl->get_softbuffer().get();
   pdsch.data[0]                       = ue.h_dl->get_tx_pdu()->get();
 
@@ -475,7 +495,14 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
   srsran_assert(success, "Error converting DCI to PUSCH grant");
   pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
   if (ue.h_ul->nof_retx() == 0) {
-    ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs); // update HARQ with correct TBS
+    if (not ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs)) {
+      // The new TB cannot be decoded without code blocks
+      logger.warning("SCHED: Failed to bind UL softbuffer for rnti=0x%x. Cancelling PUSCH allocation", ue->rnti);
+      ue.h_ul->cancel_new_tx();
+      bwp_pusch_slot.puschs.cancel_last_pusch();
+      bwp_pdcch_slot.pdcchs.cancel_last_pdcch();
+      return alloc_result::other_cause;
+    }
   } else {
     srsran_assert(pusch.sch.grant.tb[0].tbs == (int)ue.h_ul->tbs(), "The TBS did not remain constant in retx");
   }
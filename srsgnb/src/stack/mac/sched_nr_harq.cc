@@ -76,6 +76,13 @@ bool harq_proc::new_tx(slot_point       slot_tx_,
   return true;
 }
 
+void harq_proc::cancel_new_tx()
+{
+  // The UE did not see the NDI toggle
+  tb[0].ndi = !tb[0].ndi;
+  reset();
+}
+
 bool harq_proc::set_tbs(uint32_t tbs)
 {
   if (empty() or nof_retx() > 0) {
@@ -121,9 +128,36 @@ bool harq_proc::new_retx(slot_point slot_tx_, slot_point slot_ack_)
 }
 
 dl_harq_proc::dl_harq_proc(uint32_t id_, uint32_t nprb) :
-  harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().get_tx(nprb)), pdu(srsran::make_byte_buffer())
+  harq_proc(id_), softbuffer(harq_softbuffer_pool::get_instance().make_harq_tx()), pdu(srsran::make_byte_buffer())
 {}
 
+int dl_harq_proc::ack_info(uint32_t tb_idx, bool ack)
+{
+  int ret = harq_proc::ack_info(tb_idx, ack);
+  if (empty()) {
+    softbuffer.release();
+  }
+  return ret;
+}
+
+bool dl_harq_proc::clear_if_maxretx(slot_point slot_rx)
+{
+  if (harq_proc::clear_if_maxretx(slot_rx)) {
+    softbuffer.release();
+    return true;
+  }
+  return false;
+}
+
+bool dl_harq_proc::set_tbs(uint32_t tbs)
+{
+  // The code blocks are bound once the TBS of the new transmission is known
+  if (not harq_proc::set_tbs(tbs)) {
+    return false;
+  }
+  return softbuffer.bind(harq_softbuffer_pool::nof_cbs(tbs));
+}
+
 void dl_harq_proc::fill_dci(srsran_dci_dl_nr_t& dci)
 {
   const static uint32_t rv_idx[4] = {0, 2, 3, 1};
@@ -165,6 +199,12 @@ bool dl_harq_proc::new_retx(slot_point slot_tx, slot_point slot_ack, const prb_g
   return false;
 }
 
+void dl_harq_proc::cancel_new_tx()
+{
+  harq_proc::cancel_new_tx();
+  softbuffer.release();
+}
+
 void ul_harq_proc::fill_dci(srsran_dci_ul_nr_t& dci)
 {
   const static uint32_t rv_idx[4] = {0, 2, 3, 1};
@@ -199,6 +239,39 @@ bool ul_harq_proc::new_retx(slot_point slot_tx, const prb_grant& grant, srsran_d
   return false;
 }
 
+void ul_harq_proc::cancel_new_tx()
+{
+  harq_proc::cancel_new_tx();
+  softbuffer.release();
+}
+
+int ul_harq_proc::ack_info(uint32_t tb_idx, bool ack)
+{
+  int ret = harq_proc::ack_info(tb_idx, ack);
+  if (empty()) {
+    softbuffer.release();
+  }
+  return ret;
+}
+
+bool ul_harq_proc::clear_if_maxretx(slot_point slot_rx)
+{
+  if (harq_proc::clear_if_maxretx(slot_rx)) {
+    softbuffer.release();
+    return true;
+  }
+  return false;
+}
+
+bool ul_harq_proc::set_tbs(uint32_t tbs)
+{
+  // The code blocks are bound (and reset) once the TBS of the new transmission is known
+  if (not harq_proc::set_tbs(tbs)) {
+    return false;
+  }
+  return softbuffer.bind(harq_softbuffer_pool::nof_cbs(tbs));
+}
+
 harq_entity::harq_entity(uint16_t rnti_, uint32_t nprb, uint32_t nof_harq_procs, srslog::basic_logger& logger_) :
   rnti(rnti_), logger(logger_)
 {
@@ -214,7 +287,7 @@ harq_entity::harq_entity(uint16_t rnti_, uint32_t nprb, uint32_t nof_harq_procs,
 void harq_entity::new_slot(slot_point slot_rx_)
 {
   slot_rx = slot_rx_;
-  for (harq_proc& dl_h : dl_harqs) {
+  for (dl_harq_proc& dl_h : dl_harqs) {
     if (dl_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, DL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
@@ -222,7 +295,7 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   dl_h.max_nof_retx());
     }
   }
-  for (harq_proc& ul_h : ul_harqs) {
+  for (ul_harq_proc& ul_h : ul_harqs) {
     if (ul_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, UL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
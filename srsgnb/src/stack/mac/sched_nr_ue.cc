@@ -220,7 +220,8 @@ void ue::new_slot(slot_point pdcch_slot)
 
   for (std::unique_ptr<ue_carrier>& cc : carriers) {
     if (cc != nullptr) {
-      cc->harq_ent.new_slot(pdcch_slot - TX_ENB_DELAY);
+      // HARQ feedback trails the scheduled slot by the scheduler pipeline depth
+      cc->harq_ent.new_slot(pdcch_slot - TX_ENB_DELAY - sched_cfg.sched_cfg.pipeline_depth);
     }
   }
 
@@ -36,6 +36,7 @@ cc_worker::cc_worker(const cell_config_manager& params) :
 
   // Pre-allocate HARQs in common pool of softbuffers
   harq_softbuffer_pool::get_instance().init_pool(cfg.nof_prb());
+  harq_softbuffer_pool::get_instance().reserve_cbs(cfg.nof_prb(), cfg.sched_args.nof_softbuffer_ues);
 }
 
 void cc_worker::dl_rach_info(const sched_nr_interface::rar_info_t& rar_info)
@@ -53,7 +54,8 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   }
   while (last_tx_sl != tx_sl) {
     last_tx_sl++;
-    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1;
+    // Note: when pipelined, the PHY may still be reading the results of the last pipeline_depth slots
+    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1 - cfg.sched_args.pipeline_depth;
     for (bwp_manager& bwp : bwps) {
       bwp.grid[old_slot].reset();
     }
@@ -114,6 +116,11 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   return &bwp_alloc.tx_slot_grid().dl;
 }
 
+dl_sched_res_t* cc_worker::get_dl_sched(slot_point sl)
+{
+  return &bwps[0].grid[sl].dl;
+}
+
 ul_sched_t* cc_worker::get_ul_sched(slot_point sl)
 {
   return &bwps[0].grid[sl].ul;
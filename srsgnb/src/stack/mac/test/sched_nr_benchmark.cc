@@ -0,0 +1,306 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsenb/test/mac/sched_traffic_models.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <random>
+
+namespace srsenb {
+
+std::default_random_engine rand_gen;
+
+/// Target p99 of the time taken to generate the results of all carriers of a slot
+const uint32_t sched_p99_slo_usec = 500;
+
+struct nr_scale_run_params {
+  uint32_t nof_cells;
+  uint32_t nof_ues;
+  uint32_t nof_slots;
+};
+
+struct nr_scale_run_data {
+  nr_scale_run_params params;
+  float               avg_dl_throughput_mbps;
+  float               avg_ul_throughput_mbps;
+  float               avg_dl_prb_usage;
+  float               avg_ul_prb_usage;
+  float               dl_fairness;
+  uint32_t            p50_latency_usec, p99_latency_usec, max_latency_usec;
+};
+
+/// NR scheduler test bench that feeds the UE buffers from a mixture of traffic models and collects throughput,
+/// PRB usage and slot latency metrics
+class sched_nr_scale_tester : public sched_nr_base_test_bench
+{
+public:
+  /// DRB used to carry the generated traffic
+  const static uint32_t drb_lcid = 4, drb_lcg = 1;
+
+  struct ue_traffic_ctxt {
+    ue_traffic_ctxt(srsran::traffic_model_t model, uint32_t mean_cqi) : source(model), cqi(mean_cqi) {}
+
+    srsran::traffic_source source;
+    srsran::cqi_trace      cqi;
+    uint32_t               ul_pending = 0;
+    uint64_t               dl_bytes = 0, ul_bytes = 0;
+  };
+
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void add_ue_traffic(uint16_t                            rnti,
+                      const sched_nr_interface::ue_cfg_t& uecfg,
+                      srsran::traffic_model_t             model,
+                      uint32_t                            cqi)
+  {
+    user_cfg(rnti, uecfg);
+    ue_traffic.insert(std::make_pair(rnti, ue_traffic_ctxt{model, cqi}));
+  }
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    auto it = ue_traffic.find(ue_ctxt.rnti);
+    if (it == ue_traffic.end()) {
+      return;
+    }
+    ue_traffic_ctxt& ue = it->second;
+
+    uint32_t dl_arrivals, ul_arrivals;
+    ue.source.new_tti(rand_gen, dl_arrivals, ul_arrivals);
+    if (ue.source.get_model() == srsran::traffic_model_t::full_buffer) {
+      // top up the buffers rather than letting them grow without bound
+      uint32_t dl_unacked = gnb_ue_db[ue_ctxt.rnti].logical_channels[drb_lcid].rlc_unacked;
+      dl_arrivals         = dl_unacked < dl_arrivals ? dl_arrivals - dl_unacked : 0;
+      ue.ul_pending       = ul_arrivals;
+    } else {
+      ue.ul_pending += ul_arrivals;
+    }
+    if (dl_arrivals > 0) {
+      add_rlc_dl_bytes(ue_ctxt.rnti, drb_lcid, dl_arrivals);
+    }
+    if (ul_arrivals > 0) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, drb_lcg, ue.ul_pending);
+    }
+
+    // Replace the default CQI=15 reports with the UE CQI trace
+    for (auto& cc_feedback : pending_events.cc_list) {
+      if (cc_feedback.cqi >= 0) {
+        cc_feedback.cqi = ue.cqi.next(rand_gen);
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    if (not measuring) {
+      return;
+    }
+    std::chrono::nanoseconds slot_latency{0};
+    for (const cc_result_t& cc_out : cc_list) {
+      slot_latency = std::max(slot_latency, cc_out.cc_latency_ns);
+
+      const sched_nr_impl::cell_config_manager& cell = cell_params[cc_out.res.cc];
+      if (srsran_duplex_nr_is_dl(&cell.duplex, 0, cc_out.res.slot.slot_idx())) {
+        dl_prb_capacity += cell.bwps[0].nof_prb;
+        for (const auto& pdsch : cc_out.res.dl->phy.pdsch) {
+          auto it = ue_traffic.find(pdsch.sch.grant.rnti);
+          if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c and it != ue_traffic.end()) {
+            it->second.dl_bytes += pdsch.sch.grant.tb[0].tbs / 8;
+            dl_prbs += pdsch.sch.grant.nof_prb;
+          }
+        }
+      }
+      if (srsran_duplex_nr_is_ul(&cell.duplex, 0, cc_out.res.slot.slot_idx())) {
+        ul_prb_capacity += cell.bwps[0].nof_prb;
+        for (const auto& pusch : cc_out.res.ul->pusch) {
+          auto it = ue_traffic.find(pusch.sch.grant.rnti);
+          if (pusch.sch.grant.rnti_type == srsran_rnti_type_c and it != ue_traffic.end()) {
+            uint32_t tbs_bytes = pusch.sch.grant.tb[0].tbs / 8;
+            it->second.ul_bytes += tbs_bytes;
+            it->second.ul_pending -= std::min(it->second.ul_pending, tbs_bytes);
+            ul_prbs += pusch.sch.grant.nof_prb;
+          }
+        }
+      }
+    }
+    slot_latency_samples.push_back(slot_latency.count() / 1000);
+  }
+
+  std::map<uint16_t, ue_traffic_ctxt> ue_traffic;
+  bool                                measuring       = false;
+  uint64_t                            dl_prbs         = 0;
+  uint64_t                            ul_prbs         = 0;
+  uint64_t                            dl_prb_capacity = 0;
+  uint64_t                            ul_prb_capacity = 0;
+  std::vector<uint32_t>               slot_latency_samples;
+};
+
+const uint32_t sched_nr_scale_tester::drb_lcid;
+const uint32_t sched_nr_scale_tester::drb_lcg;
+
+nr_scale_run_data run_nr_scale_scenario(const nr_scale_run_params& params)
+{
+  const uint32_t warmup_slots = 100;
+
+  sched_nr_interface::sched_args_t sched_args;
+  sched_args.auto_refill_buffer = false;
+
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(params.nof_cells);
+  std::string test_name = fmt::format("NR scale benchmark: nof_cells={}, nof_ues={}", params.nof_cells, params.nof_ues);
+  sched_nr_scale_tester tester(sched_args, cells_cfg, test_name);
+
+  // All UEs are configured with the full set of carriers, a DRB and a CQI trace that depends on their position
+  std::uniform_int_distribution<uint32_t> mean_cqi_dist{3, 15};
+  for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+    sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(params.nof_cells);
+    uecfg.lc_ch_to_add.emplace_back();
+    uecfg.lc_ch_to_add.back().lcid          = sched_nr_scale_tester::drb_lcid;
+    uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+    uecfg.lc_ch_to_add.back().cfg.group     = sched_nr_scale_tester::drb_lcg;
+    tester.add_ue_traffic(0x4601 + ue_idx, uecfg, srsran::get_mixed_traffic_model(ue_idx), mean_cqi_dist(rand_gen));
+  }
+
+  for (uint32_t count = 0; count < warmup_slots + params.nof_slots; ++count) {
+    tester.measuring = count >= warmup_slots;
+    slot_point slot_rx(0, count % 10240);
+    tester.run_slot(slot_rx + TX_ENB_DELAY);
+  }
+  tester.stop();
+
+  nr_scale_run_data run_results = {};
+  run_results.params            = params;
+
+  double                duration_sec = params.nof_slots / 1000.0;
+  uint64_t              tot_dl_bytes = 0, tot_ul_bytes = 0;
+  std::vector<uint64_t> full_buffer_dl_bytes;
+  for (const auto& u : tester.ue_traffic) {
+    tot_dl_bytes += u.second.dl_bytes;
+    tot_ul_bytes += u.second.ul_bytes;
+    if (u.second.source.get_model() == srsran::traffic_model_t::full_buffer) {
+      full_buffer_dl_bytes.push_back(u.second.dl_bytes);
+    }
+  }
+  run_results.avg_dl_throughput_mbps = tot_dl_bytes * 8 / duration_sec / 1e6;
+  run_results.avg_ul_throughput_mbps = tot_ul_bytes * 8 / duration_sec / 1e6;
+  run_results.avg_dl_prb_usage =
+      tester.dl_prb_capacity > 0 ? tester.dl_prbs / static_cast<float>(tester.dl_prb_capacity) * 100 : 0;
+  run_results.avg_ul_prb_usage =
+      tester.ul_prb_capacity > 0 ? tester.ul_prbs / static_cast<float>(tester.ul_prb_capacity) * 100 : 0;
+  run_results.dl_fairness = srsran::jain_fairness_index(full_buffer_dl_bytes);
+
+  std::vector<uint32_t>& latencies = tester.slot_latency_samples;
+  std::sort(latencies.begin(), latencies.end());
+  run_results.p50_latency_usec = srsran::get_sorted_quantile(latencies, 0.5);
+  run_results.p99_latency_usec = srsran::get_sorted_quantile(latencies, 0.99);
+  run_results.max_latency_usec = latencies.empty() ? 0 : latencies.back();
+
+  return run_results;
+}
+
+void print_nr_scale_results(const std::vector<nr_scale_run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("\n{:<3} | {:>5} | {:>5} | {:>12} | {:>12} | {:>8} | {:>8} | {:>8} | {:>8} | {:>8} | {:>8} | {:>4}\n",
+             "run",
+             "Ncell",
+             "Nue",
+             "DL [Mbps]",
+             "UL [Mbps]",
+             "DL [%]",
+             "UL [%]",
+             "fairness",
+             "p50 [us]",
+             "p99 [us]",
+             "max [us]",
+             "SLO");
+  fmt::print("{:->{}}\n", "", 122);
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const nr_scale_run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>8d}{:>8d}{:>15.2f}{:>15.2f}{:>11.1f}{:>11.1f}{:>11.3f}{:>11d}{:>11d}{:>11d}{:>7}\n",
+               i,
+               r.params.nof_cells,
+               r.params.nof_ues,
+               r.avg_dl_throughput_mbps,
+               r.avg_ul_throughput_mbps,
+               r.avg_dl_prb_usage,
+               r.avg_ul_prb_usage,
+               r.dl_fairness,
+               r.p50_latency_usec,
+               r.p99_latency_usec,
+               r.max_latency_usec,
+               r.p99_latency_usec <= sched_p99_slo_usec ? "ok" : "miss");
+  }
+  fmt::print("Traffic mix: 20% full buffer, 40% VoIP, 30% web, 10% IoT. Fairness is computed among full-buffer UEs. "
+             "SLO: p99 slot latency <= {} usec\n",
+             sched_p99_slo_usec);
+}
+
+void run_nr_scale_benchmark(uint32_t                     nof_slots,
+                            const std::vector<uint32_t>& nof_cells,
+                            const std::vector<uint32_t>& nof_ues)
+{
+  // Scenarios with more UEs than the default SRSENB_MAX_UES need the *_benchmark_scale build of the scheduler
+  for (uint32_t ues : nof_ues) {
+    TESTASSERT(ues <= SRSENB_MAX_UES);
+  }
+
+  // Every DL HARQ process holds a byte buffer for its MAC PDU, so the global pool is sized for the largest scenario
+  uint32_t max_cells = *std::max_element(nof_cells.begin(), nof_cells.end());
+  uint32_t max_ues   = *std::max_element(nof_ues.begin(), nof_ues.end());
+  srsran::byte_buffer_pool::get_instance(max_cells * max_ues * SCHED_NR_MAX_HARQ + 4096);
+
+  std::vector<nr_scale_run_data> run_results;
+  for (uint32_t cells : nof_cells) {
+    for (uint32_t ues : nof_ues) {
+      run_results.push_back(run_nr_scale_scenario(nr_scale_run_params{cells, ues, nof_slots}));
+    }
+  }
+  print_nr_scale_results(run_results);
+
+  for (const nr_scale_run_data& r : run_results) {
+    TESTASSERT(r.avg_dl_throughput_mbps > 0);
+    TESTASSERT(r.avg_ul_throughput_mbps > 0);
+  }
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  // With many UEs, the scheduler regularly runs out of PUCCH resources, which is not relevant for the benchmark
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  // Start the log backend.
+  srslog::init();
+
+  if (argc > 1 and std::string(argv[1]) == "scale") {
+    srsenb::run_nr_scale_benchmark(5000, {1, 2}, {100, 500, 1000});
+  } else {
+    srsenb::run_nr_scale_benchmark(500, {1, 2}, {50});
+  }
+
+  return 0;
+}
@@ -21,6 +21,8 @@
 
 #include "sched_nr_cfg_generators.h"
 #include "sched_nr_sim_ue.h"
+#include "srsenb/hdr/stack/mac/common/mac_metrics.h"
+#include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/test_common.h"
 #include <chrono>
@@ -50,16 +52,22 @@ public:
 
       bool is_dl_slot = srsran_duplex_nr_is_dl(&cell_params[cc_out.res.cc].duplex, 0, current_slot_tx.slot_idx());
 
+      // When pipelined, the slots scheduled before the UE was added have no UE grants
+      bool ue_scheduled = not slot_ctxt.ue_db.empty() and current_slot_tx >= first_ue_slot + pipeline_depth;
+
       if (is_dl_slot) {
-        if (cc_out.res.dl->phy.ssb.empty() and not slot_ctxt.ue_db.empty()) {
-          TESTASSERT(slot_ctxt.ue_db.empty() or cc_out.res.dl->phy.pdcch_dl.size() >= 1);
-        } else {
+        if (not cc_out.res.dl->phy.ssb.empty() or slot_ctxt.ue_db.empty()) {
           TESTASSERT(cc_out.res.dl->phy.pdcch_dl.size() == 0);
+        } else if (ue_scheduled) {
+          TESTASSERT(cc_out.res.dl->phy.pdcch_dl.size() >= 1);
         }
       }
     }
   }
 
+  /// Note: must be called after stop()
+  void get_sched_metrics(mac_metrics_t& metrics) { sched_ptr->get_metrics(metrics); }
+
   void print_results() const
   {
     test_logger.info("TESTER: %f PDSCH/{slot,cc} were allocated", pdsch_count / (double)cc_res_count);
@@ -68,12 +76,15 @@ public:
 
   srslog::basic_logger& test_logger = srslog::fetch_basic_logger("TEST");
 
+  uint32_t   pipeline_depth = 0;
+  slot_point first_ue_slot;
+
   uint64_t tot_latency_sched_ns = 0;
   uint32_t cc_res_count         = 0;
   uint32_t pdsch_count          = 0;
 };
 
-void run_sched_nr_test(uint32_t nof_workers)
+void run_sched_nr_test(uint32_t nof_workers, uint32_t pipeline_depth = 0)
 {
   srsran_assert(nof_workers > 0, "There must be at least one worker");
   uint32_t max_nof_ttis = 1000, nof_sectors = 4;
@@ -81,6 +92,7 @@ void run_sched_nr_test(uint32_t nof_workers)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer = true;
+  cfg.pipeline_depth     = pipeline_depth;
 
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
@@ -88,7 +100,11 @@ void run_sched_nr_test(uint32_t nof_workers)
   if (nof_workers > 1) {
     test_name = fmt::format("Parallel Test with {} workers", nof_workers);
   }
+  if (pipeline_depth > 0) {
+    test_name += fmt::format(", pipeline depth={}", pipeline_depth);
+  }
   sched_nr_tester tester(cfg, cells_cfg, test_name, nof_workers);
+  tester.pipeline_depth = pipeline_depth;
 
   for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
     slot_point slot_rx(0, nof_slots % 10240);
@@ -99,6 +115,7 @@ void run_sched_nr_test(uint32_t nof_workers)
       uecfg.lc_ch_to_add.back().lcid          = 1;
       uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
       tester.user_cfg(rnti, uecfg);
+      tester.first_ue_slot = slot_tx;
     }
     tester.run_slot(slot_tx);
   }
@@ -111,6 +128,72 @@ void run_sched_nr_test(uint32_t nof_workers)
   double final_avg_usec = tester.tot_latency_sched_ns;
   final_avg_usec        = final_avg_usec / 1000.0 / max_nof_ttis;
   printf("Total time taken per slot: %f usec\n", final_avg_usec);
+
+  if (pipeline_depth > 0) {
+    mac_metrics_t metrics = {};
+    tester.get_sched_metrics(metrics);
+    printf("Late slot results: %u/%u, max wait: %.1f usec\n",
+           metrics.sched_pipeline.nof_late_slots,
+           metrics.sched_pipeline.nof_slots,
+           metrics.sched_pipeline.max_wait_us);
+  }
+}
+
+/// Number of code blocks bound to the HARQ softbuffers of all UEs
+static uint32_t nof_bound_harq_cbs()
+{
+  mac_softbuffer_pool_metrics_t tx_metrics = {}, rx_metrics = {};
+  harq_softbuffer_pool::get_instance().get_metrics(tx_metrics, rx_metrics);
+  return tx_metrics.nof_used_cbs + rx_metrics.nof_used_cbs;
+}
+
+/// A removed UE shall be kept until the PHY consumed the pipelined results that point at its HARQ buffers
+void test_ue_rem_pipelined()
+{
+  srsran::test_delimit_logger delimiter{"UE removal with pipeline depth=2"};
+  const uint32_t              pipeline_depth = 2;
+  const uint16_t              rnti           = 0x4601;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.pipeline_depth     = pipeline_depth;
+  sched_nr sched;
+  TESTASSERT(sched.config(cfg, get_default_cells_cfg(1)) == SRSRAN_SUCCESS);
+
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+  uecfg.lc_ch_to_add.emplace_back();
+  uecfg.lc_ch_to_add.back().lcid          = 1;
+  uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+  sched.ue_cfg(rnti, uecfg);
+
+  // Indicates slot_tx, and waits until the scheduler thread generated the results up to the end of the pipeline. No
+  // HARQ feedback is given, so the UE keeps its HARQ processes busy
+  slot_point slot_tx{0, TX_ENB_DELAY};
+  auto       run_slot = [&sched, &slot_tx, pipeline_depth]() {
+    sched.slot_indication(slot_tx);
+    TESTASSERT(sched.get_dl_sched(slot_tx, 0) != nullptr);
+    TESTASSERT(sched.get_dl_sched(slot_tx + pipeline_depth, 0) != nullptr);
+    slot_tx++;
+  };
+  for (uint32_t i = 0; i < 20; ++i) {
+    run_slot();
+  }
+  TESTASSERT(nof_bound_harq_cbs() > 0);
+
+  // The removal is handled in the next scheduled slot. The results already published still point at the UE buffers
+  sched.ue_rem(rnti);
+  for (uint32_t i = 0; i <= pipeline_depth; ++i) {
+    run_slot();
+    TESTASSERT(nof_bound_harq_cbs() > 0);
+  }
+
+  // Once the PHY is past the slots of its last PDSCHs and PUSCHs, the UE is destroyed
+  for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; ++i) {
+    run_slot();
+  }
+  TESTASSERT(nof_bound_harq_cbs() == 0);
+
+  sched.stop();
 }
 
 } // namespace srsenb
@@ -130,4 +213,8 @@ int main()
   srsenb::run_sched_nr_test(1);
   srsenb::run_sched_nr_test(2);
   srsenb::run_sched_nr_test(4);
+  srsenb::run_sched_nr_test(1, 1);
+  srsenb::run_sched_nr_test(1, 2);
+  srsenb::run_sched_nr_test(4, 2);
+  srsenb::test_ue_rem_pipelined();
 }
@@ -212,6 +212,7 @@ void sched_nr_base_test_bench::stop()
     for (auto& worker : cc_workers) {
       worker->stop();
     }
+    sched_ptr->stop();
     sem_destroy(&slot_sem);
     test_delimiter.reset();
   }
@@ -51,13 +51,14 @@ public:
   void stop();
 
 private:
-  void set_metrics_helper(const srsran::rf_metrics_t&  rf,
-                          const srsran::sys_metrics_t& sys,
-                          const phy_metrics_t&         phy,
-                          const mac_metrics_t          mac[SRSRAN_MAX_CARRIERS],
-                          const rrc_metrics_t&         rrc,
-                          const uint32_t               cc,
-                          const uint32_t               r);
+  void set_metrics_helper(const srsran::rf_metrics_t&                rf,
+                          const srsran::sys_metrics_t&               sys,
+                          const srsran::byte_buffer_pools_metrics_t& pools,
+                          const phy_metrics_t&                       phy,
+                          const mac_metrics_t                        mac[SRSRAN_MAX_CARRIERS],
+                          const rrc_metrics_t&                       rrc,
+                          const uint32_t                             cc,
+                          const uint32_t                             r);
 
   std::string float_to_string(float f, int digits, bool add_semicolon = true);
 
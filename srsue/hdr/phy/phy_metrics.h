@@ -149,19 +149,28 @@ struct ul_metrics_t {
 
   float mcs;
   float power;
+  float cfr_papr_in;  ///< PAPR at the CFR input, in dB
+  float cfr_papr_out; ///< PAPR at the CFR output, in dB
+  float cfr_evm;      ///< EVM introduced by the CFR, in percent
 
   void set(const ul_metrics_t& other)
   {
     count++;
     PHY_METRICS_SET(mcs);
     PHY_METRICS_SET(power);
+    PHY_METRICS_SET(cfr_papr_in);
+    PHY_METRICS_SET(cfr_papr_out);
+    PHY_METRICS_SET(cfr_evm);
   }
 
   void reset()
   {
-    count = 0;
-    mcs   = 0.0f;
-    power = 0.0f;
+    count        = 0;
+    mcs          = 0.0f;
+    power        = 0.0f;
+    cfr_papr_in  = 0.0f;
+    cfr_papr_out = 0.0f;
+    cfr_evm      = 0.0f;
   }
 
 private:
@@ -211,6 +211,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_workers",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_workers)->default_value(0),            "Number of extra threads processing channels in parallel")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),            "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),           "SNR in dB")
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
@@ -231,6 +232,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_workers",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_workers)->default_value(0),             "Number of extra threads processing channels in parallel")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
@@ -256,6 +258,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
     ("cfr.ema_alpha", bpo::value<float>(&args->phy.cfr_args.ema_alpha)->default_value(args->phy.cfr_args.ema_alpha), "Alpha coefficient for the power average in auto_ema mode (0 to 1)")
+    ("cfr.iterations", bpo::value<uint32_t>(&args->phy.cfr_args.iterations)->default_value(args->phy.cfr_args.iterations), "Number of CFR clipping and filtering iterations (1 to 4)")
+    ("cfr.measure_metrics", bpo::value<bool>(&args->phy.cfr_args.measure_metrics)->default_value(args->phy.cfr_args.measure_metrics), "Measure the CFR PAPR and EVM, and report them in the UL metrics")
 
     /* PHY section */
     ("phy.worker_cpu_mask",
@@ -76,13 +76,14 @@ void metrics_csv::stop()
   }
 }
 
-void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&  rf,
-                                     const srsran::sys_metrics_t& sys,
-                                     const phy_metrics_t&         phy,
-                                     const mac_metrics_t          mac[SRSRAN_MAX_CARRIERS],
-                                     const rrc_metrics_t&         rrc,
-                                     const uint32_t               cc,
-                                     const uint32_t               r)
+void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&                rf,
+                                     const srsran::sys_metrics_t&               sys,
+                                     const srsran::byte_buffer_pools_metrics_t& pools,
+                                     const phy_metrics_t&                       phy,
+                                     const mac_metrics_t                        mac[SRSRAN_MAX_CARRIERS],
+                                     const rrc_metrics_t&                       rrc,
+                                     const uint32_t                             cc,
+                                     const uint32_t                             r)
 {
   if (not file.is_open()) {
     return;
@@ -170,6 +171,13 @@ void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&  rf,
   file << float_to_string(m.process_cpu_usage, 2);
   file << std::to_string(m.thread_count) << ";";
 
+  // Write the byte buffer pool metrics.
+  for (const srsran::byte_buffer_pool_metrics_t* pool : {&pools.small, &pools.medium, &pools.large}) {
+    file << std::to_string(pool->nof_used_buffers) << ";";
+    file << std::to_string(pool->max_used_buffers) << ";";
+    file << std::to_string(pool->nof_failures) << ";";
+  }
+
   // Write the cpu metrics.
   for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
     file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
@@ -191,7 +199,9 @@ void metrics_csv::set_metrics(const ue_metrics_t& metrics, const uint32_t period
               "bler;"
               "rf_o;rf_"
               "u;rf_l;is_attached;"
-              "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;sys_load;thread_count";
+              "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;sys_load;thread_count;"
+              "pool_small_used;pool_small_max;pool_small_fail;pool_medium_used;pool_medium_max;pool_medium_fail;"
+              "pool_large_used;pool_large_max;pool_large_fail";
 
       // Add the cores.
       for (uint32_t i = 0, e = metrics.sys.cpu_count; i != e; ++i) {
@@ -204,13 +214,15 @@ void metrics_csv::set_metrics(const ue_metrics_t& metrics, const uint32_t period
 
     // Metrics for LTE carrier
     for (uint32_t r = 0; r < metrics.phy.nof_active_cc; r++) {
-      set_metrics_helper(metrics.rf, metrics.sys, metrics.phy, metrics.stack.mac, metrics.stack.rrc, r, r);
+      set_metrics_helper(
+          metrics.rf, metrics.sys, metrics.stack.buffer_pools, metrics.phy, metrics.stack.mac, metrics.stack.rrc, r, r);
     }
 
     // Metrics for NR carrier
     for (uint32_t r = 0; r < metrics.phy_nr.nof_active_cc; r++) {
       set_metrics_helper(metrics.rf,
                          metrics.sys,
+                         metrics.stack.buffer_pools,
                          metrics.phy_nr,
                          metrics.stack.mac_nr,
                          metrics.stack.rrc,
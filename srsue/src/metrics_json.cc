@@ -57,6 +57,9 @@ DECLARE_METRIC("cfo", metric_cfo, float, "");
 DECLARE_METRIC("dl_snr", metric_dl_snr, float, "");
 DECLARE_METRIC("dl_mcs", metric_dl_mcs, float, "");
 DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
+DECLARE_METRIC("ul_cfr_papr_in", metric_ul_cfr_papr_in, float, "");
+DECLARE_METRIC("ul_cfr_papr_out", metric_ul_cfr_papr_out, float, "");
+DECLARE_METRIC("ul_cfr_evm", metric_ul_cfr_evm, float, "");
 DECLARE_METRIC("ul_ta", metric_ul_ta, float, "");
 DECLARE_METRIC("distance_km", metric_distance_km, float, "");
 DECLARE_METRIC("speed_kmph", metric_speed_kmph, float, "");
@@ -70,6 +73,9 @@ DECLARE_METRIC_SET("carrier_container",
                    metric_dl_snr,
                    metric_dl_mcs,
                    metric_ul_mcs,
+                   metric_ul_cfr_papr_in,
+                   metric_ul_cfr_papr_out,
+                   metric_ul_cfr_evm,
                    metric_ul_ta,
                    metric_distance_km,
                    metric_speed_kmph,
@@ -121,6 +127,39 @@ DECLARE_METRIC_SET("sys_cpu_container",
                    metric_thread_count,
                    mlist_cpu_core_list);
 
+/// Byte buffer pools container.
+DECLARE_METRIC("buffer_size", metric_pool_buffer_size, uint32_t, "");
+DECLARE_METRIC("nof_buffers", metric_pool_nof_buffers, uint32_t, "");
+DECLARE_METRIC("nof_used_buffers", metric_pool_nof_used_buffers, uint32_t, "");
+DECLARE_METRIC("max_used_buffers", metric_pool_max_used_buffers, uint32_t, "");
+DECLARE_METRIC("nof_failures", metric_pool_nof_failures, uint32_t, "");
+DECLARE_METRIC_SET("small",
+                   mset_small_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_pool_nof_failures);
+DECLARE_METRIC_SET("medium",
+                   mset_medium_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_pool_nof_failures);
+DECLARE_METRIC_SET("large",
+                   mset_large_pool,
+                   metric_pool_buffer_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_used_buffers,
+                   metric_pool_max_used_buffers,
+                   metric_pool_nof_failures);
+DECLARE_METRIC_SET("buffer_pools_container",
+                   mset_buffer_pools_container,
+                   mset_small_pool,
+                   mset_medium_pool,
+                   mset_large_pool);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
@@ -135,10 +174,22 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     mset_nas_container,
                                                     mset_rf_container,
                                                     mset_sys_mem_container,
-                                                    mset_sys_cpu_container>;
+                                                    mset_sys_cpu_container,
+                                                    mset_buffer_pools_container>;
 
 } // namespace
 
+/// Fill the metrics of a byte buffer pool.
+template <typename Set>
+static void fill_buffer_pool_metrics(Set& set, const srsran::byte_buffer_pool_metrics_t& m)
+{
+  set.template write<metric_pool_buffer_size>(m.buffer_size);
+  set.template write<metric_pool_nof_buffers>(m.nof_buffers);
+  set.template write<metric_pool_nof_used_buffers>(m.nof_used_buffers);
+  set.template write<metric_pool_max_used_buffers>(m.max_used_buffers);
+  set.template write<metric_pool_nof_failures>(m.nof_failures);
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -180,6 +231,9 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     carrier.write<metric_dl_snr>(metrics.phy.ch[i].sinr);
     carrier.write<metric_dl_mcs>(metrics.phy.dl[i].mcs);
     carrier.write<metric_ul_mcs>(metrics.phy.ul[i].mcs);
+    carrier.write<metric_ul_cfr_papr_in>(metrics.phy.ul[i].cfr_papr_in);
+    carrier.write<metric_ul_cfr_papr_out>(metrics.phy.ul[i].cfr_papr_out);
+    carrier.write<metric_ul_cfr_evm>(metrics.phy.ul[i].cfr_evm);
     carrier.write<metric_ul_ta>(metrics.phy.sync[i].ta_us);
     carrier.write<metric_distance_km>(metrics.phy.sync[i].distance_km);
     carrier.write<metric_speed_kmph>(metrics.phy.sync[i].speed_kmph);
@@ -238,6 +292,12 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     core_list[i].write<metric_proc_core_usage>(metrics.sys.cpu_load[i]);
   }
 
+  // Fill byte buffer pools container.
+  auto& buffer_pools = ctx.get<mset_buffer_pools_container>();
+  fill_buffer_pool_metrics(buffer_pools.get<mset_small_pool>(), metrics.stack.buffer_pools.small);
+  fill_buffer_pool_metrics(buffer_pools.get<mset_medium_pool>(), metrics.stack.buffer_pools.medium);
+  fill_buffer_pool_metrics(buffer_pools.get<mset_large_pool>(), metrics.stack.buffer_pools.large);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -186,6 +186,19 @@ void metrics_stdout::set_metrics(const ue_metrics_t& metrics, const uint32_t per
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  // always print buffer pool exhaustion
+  const srsran::byte_buffer_pools_metrics_t& pools = metrics.stack.buffer_pools;
+  if (pools.small.nof_failures > 0 or pools.medium.nof_failures > 0 or pools.large.nof_failures > 0) {
+    fmt::print("Buffer pools: small={}/{} medium={}/{} large={}/{}, failures={}\n",
+               pools.small.max_used_buffers,
+               pools.small.nof_buffers,
+               pools.medium.max_used_buffers,
+               pools.medium.nof_buffers,
+               pools.large.max_used_buffers,
+               pools.large.nof_buffers,
+               pools.small.nof_failures + pools.medium.nof_failures + pools.large.nof_failures);
+  }
+
   if (!do_print) {
     return;
   }
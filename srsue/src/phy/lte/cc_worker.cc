@@ -801,6 +801,15 @@ bool cc_worker::encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srs
     ul_metrics_t ul_metrics = {};
     ul_metrics.mcs          = ue_ul_cfg.ul_cfg.pusch.grant.tb.mcs_idx;
     ul_metrics.power        = 0;
+
+    // CFR metrics of the symbols transmitted since the previous report, if they are measured
+    srsran_cfr_metrics_t cfr_metrics = {};
+    srsran_ue_ul_get_cfr_metrics(&ue_ul, &cfr_metrics);
+    if (cfr_metrics.nof_iterations > 0) {
+      ul_metrics.cfr_papr_in  = cfr_metrics.papr_in_db;
+      ul_metrics.cfr_papr_out = cfr_metrics.iter[cfr_metrics.nof_iterations - 1].papr_db;
+      ul_metrics.cfr_evm      = cfr_metrics.iter[cfr_metrics.nof_iterations - 1].evm;
+    }
     phy->set_ul_metrics(cc_idx, ul_metrics);
   }
 
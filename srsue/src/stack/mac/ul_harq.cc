@@ -148,7 +148,7 @@ bool ul_harq_entity::ul_harq_process::init(uint32_t pid_, ul_harq_entity* parent
   is_initiated = true;
   pid          = pid_;
 
-  payload_buffer = std::unique_ptr<byte_buffer_t>(new byte_buffer_t);
+  payload_buffer = srsran::make_byte_buffer();
   if (!payload_buffer) {
     Error("Allocating memory");
     return false;
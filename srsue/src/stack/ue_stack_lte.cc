@@ -375,6 +375,7 @@ bool ue_stack_lte::get_metrics(stack_metrics_t* metrics)
     nas.get_metrics(&metrics.nas);
     rrc.get_metrics(metrics.rrc);
     rrc_nr.get_metrics(metrics.rrc_nr);
+    srsran::get_byte_buffer_pools_metrics(metrics.buffer_pools);
     pending_stack_metrics.push(metrics);
   });
   // wait for result
@@ -34,6 +34,7 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace srsue {
@@ -277,11 +278,13 @@ void gw::run_thread()
   uint32 idx     = 0;
   int32  N_bytes = 0;
 
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  srsran::unique_byte_buffer_t pdu = srsran::make_rx_byte_buffer();
   if (!pdu) {
     logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
     return;
   }
+  // Receives the bytes of the packets that do not fit in pdu
+  std::vector<uint8_t> overflow(srsran::rx_byte_buffer_overflow_size);
 
   const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
   uint32_t              register_wait = 0, service_wait = 0;
@@ -292,7 +295,10 @@ void gw::run_thread()
   while (run_enable) {
     // Read packet from TUN
     if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
+      uint32_t capacity = srsran::get_rx_byte_buffer_capacity(*pdu);
+      iovec    iov[2]   = {{&pdu->msg[idx], capacity - idx},
+                           {overflow.data(), SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - capacity}};
+      N_bytes           = readv(tun_fd, iov, 2);
     } else {
       logger.error("GW pdu buffer full - gw receive thread exiting.");
       srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
@@ -306,13 +312,20 @@ void gw::run_thread()
       break;
     }
 
+    // Move the packets that did not fit in pdu to a large byte buffer
+    pdu->N_bytes = idx + N_bytes;
+    if (not srsran::merge_rx_byte_buffer_overflow(pdu, overflow.data())) {
+      logger.error("Couldn't allocate PDU for a packet of %d bytes. Dropping packet.", pdu->N_bytes);
+      idx = 0;
+      continue;
+    }
+
     {
       std::unique_lock<std::mutex> lock(gw_mutex);
       // Check if IP version makes sense and get packtet length
       struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
       struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
       uint16_t        pkt_len = 0;
-      pdu->N_bytes            = idx + N_bytes;
       if (ip_pkt->version == 4) {
         pkt_len = ntohs(ip_pkt->tot_len);
       } else if (ip_pkt->version == 6) {
@@ -376,7 +389,7 @@ void gw::run_thread()
         ul_tput_bytes += pdu->N_bytes;
         stack->write_sdu(eps_bearer_id, std::move(pdu));
         do {
-          pdu = srsran::make_byte_buffer();
+          pdu = srsran::make_rx_byte_buffer();
           if (!pdu) {
             logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
             usleep(100000);
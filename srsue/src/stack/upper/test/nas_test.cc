@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/asn1/liblte_byte_msg.h"
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
@@ -34,14 +35,10 @@
 using namespace srsue;
 using namespace srsran;
 
-static_assert(alignof(LIBLTE_BYTE_MSG_STRUCT) == alignof(byte_buffer_t),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, N_bytes) == offsetof(byte_buffer_t, N_bytes),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, header) == offsetof(byte_buffer_t, buffer),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(sizeof(LIBLTE_BYTE_MSG_STRUCT) <= offsetof(byte_buffer_t, msg),
-              "liblte buffer and byte buffer members misaligned");
+// NAS messages are packed in liblte messages and copied to byte buffers, see liblte_byte_msg.h
+static_assert(LIBLTE_MSG_HEADER_OFFSET == SRSRAN_BUFFER_HEADER_OFFSET, "liblte buffer and byte buffer headroom differ");
+static_assert(sizeof(LIBLTE_BYTE_MSG_STRUCT::msg) <= SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET,
+              "liblte buffer does not fit in a byte buffer");
 
 int mme_attach_request_test()
 {
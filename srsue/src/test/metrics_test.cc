@@ -75,6 +75,11 @@ public:
     m->phy.ch[0].rsrp            = -10.0f;
     m->phy.ch[0].pathloss        = 32;
 
+    m->stack.buffer_pools.small.nof_buffers      = 4096;
+    m->stack.buffer_pools.small.nof_used_buffers = 100;
+    m->stack.buffer_pools.small.max_used_buffers = 4096;
+    m->stack.buffer_pools.small.nof_failures     = (rand() % 2 == 0) ? 5 : 0;
+
     m->stack.rrc.state = (rand() % 2 == 0) ? RRC_STATE_CONNECTED : RRC_STATE_IDLE;
 
     return true;
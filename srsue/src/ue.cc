@@ -301,6 +301,7 @@ int ue::parse_args(const all_args_t& args_)
   cfr_test_cfg.manual_thr       = args.phy.cfr_args.manual_thres;
   cfr_test_cfg.max_papr_db      = args.phy.cfr_args.auto_target_papr;
   cfr_test_cfg.ema_alpha        = args.phy.cfr_args.ema_alpha;
+  cfr_test_cfg.nof_iterations   = args.phy.cfr_args.iterations;
 
   if (!srsran_cfr_params_valid(&cfr_test_cfg)) {
     srsran::console("Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, \n "